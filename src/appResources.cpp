@@ -0,0 +1,256 @@
+// File:  appResources.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Application-wide resources that are expensive to create, built on
+//        first use and shared by all windows.
+
+// wxWidgets headers
+#include <wx/log.h>
+#include <wx/filename.h>
+#include <wx/imagpng.h>
+#include <wx/imagjpeg.h>
+#include <wx/imaggif.h>
+#include <wx/imagtiff.h>
+#include <wx/imagpnm.h>
+#include <wx/imagpcx.h>
+#include <wx/imagtga.h>
+#include <wx/imagxpm.h>
+
+// Local headers
+#include "appResources.h"
+
+// *nix Icons
+#ifdef __WXGTK__
+#include "../res/icons/pointPicker16.xpm"
+#include "../res/icons/pointPicker24.xpm"
+#include "../res/icons/pointPicker32.xpm"
+#include "../res/icons/pointPicker48.xpm"
+#include "../res/icons/pointPicker64.xpm"
+#include "../res/icons/pointPicker128.xpm"
+#include "../res/icons/pointPicker256.xpm"
+#endif
+
+//==========================================================================
+// Class:			AppResources
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the AppResources class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+std::unique_ptr<wxIconBundle> AppResources::icons;
+bool AppResources::allHandlersRegistered(false);
+
+//==========================================================================
+// Class:			AppResources
+// Function:		GetIcons
+//
+// Description:		Returns the application icons, creating them on the first
+//					call.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const wxIconBundle&
+//
+//==========================================================================
+const wxIconBundle& AppResources::GetIcons()
+{
+	if (icons)
+		return *icons;
+
+	icons = std::make_unique<wxIconBundle>();
+#ifdef __WXMSW__
+	icons->AddIcon(wxIcon(_T("ICON_ID_MAIN"), wxBITMAP_TYPE_ICO_RESOURCE));
+#elif __WXGTK__
+	icons->AddIcon(wxIcon(pointPicker16_xpm));
+	icons->AddIcon(wxIcon(pointPicker24_xpm));
+	icons->AddIcon(wxIcon(pointPicker32_xpm));
+	icons->AddIcon(wxIcon(pointPicker48_xpm));
+	icons->AddIcon(wxIcon(pointPicker64_xpm));
+	icons->AddIcon(wxIcon(pointPicker128_xpm));
+	icons->AddIcon(wxIcon(pointPicker256_xpm));
+#endif
+
+	return *icons;
+}
+
+//==========================================================================
+// Class:			AppResources
+// Function:		Release
+//
+// Description:		Frees the shared resources.  Windows that are still open
+//					keep their own references.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void AppResources::Release()
+{
+	icons.reset();
+}
+
+//==========================================================================
+// Class:			AppResources
+// Function:		LoadImageFile
+//
+// Description:		Loads the specified image file, registering image handlers
+//					as needed.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		image		= wxImage&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool AppResources::LoadImageFile(const wxString& fileName, wxImage& image)
+{
+	if (RegisterImageHandler(fileName))
+	{
+		wxLogNull suppressLogging;// We'll try again if this fails
+		if (image.LoadFile(fileName))
+			return true;
+	}
+
+	RegisterAllImageHandlers();
+	return image.LoadFile(fileName);
+}
+
+//==========================================================================
+// Class:			AppResources
+// Function:		RegisterImageHandler
+//
+// Description:		Makes sure a handler for the specified file is registered.
+//					BMP support is built in, so it never needs registering.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if the extension is not recognized
+//
+//==========================================================================
+bool AppResources::RegisterImageHandler(const wxString& fileName)
+{
+	if (allHandlersRegistered)
+		return true;
+
+	const wxString extension(wxFileName(fileName).GetExt().Lower());
+	if (extension.IsEmpty())
+		return false;
+	else if (wxImage::FindHandler(extension, wxBITMAP_TYPE_ANY))
+		return true;
+
+	wxImageHandler* handler(CreateImageHandler(extension));
+	if (!handler)
+		return false;
+
+	wxImage::AddHandler(handler);
+	return true;
+}
+
+//==========================================================================
+// Class:			AppResources
+// Function:		RegisterAllImageHandlers
+//
+// Description:		Registers every available image handler.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void AppResources::RegisterAllImageHandlers()
+{
+	if (allHandlersRegistered)
+		return;
+
+	// Handlers that were already registered are skipped
+	wxInitAllImageHandlers();
+	allHandlersRegistered = true;
+}
+
+//==========================================================================
+// Class:			AppResources
+// Function:		CreateImageHandler
+//
+// Description:		Creates the handler for files with the specified extension.
+//
+// Input Arguments:
+//		extension	= const wxString&, lower case
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxImageHandler*, nullptr for unrecognized extensions
+//
+//==========================================================================
+wxImageHandler* AppResources::CreateImageHandler(const wxString& extension)
+{
+#if wxUSE_LIBPNG
+	if (extension == _T("png"))
+		return new wxPNGHandler;
+#endif
+#if wxUSE_LIBJPEG
+	if (extension == _T("jpg") || extension == _T("jpeg") || extension == _T("jpe"))
+		return new wxJPEGHandler;
+#endif
+#if wxUSE_GIF
+	if (extension == _T("gif"))
+		return new wxGIFHandler;
+#endif
+#if wxUSE_LIBTIFF
+	if (extension == _T("tif") || extension == _T("tiff"))
+		return new wxTIFFHandler;
+#endif
+#if wxUSE_PNM
+	if (extension == _T("pnm") || extension == _T("ppm") || extension == _T("pgm") || extension == _T("pbm"))
+		return new wxPNMHandler;
+#endif
+#if wxUSE_PCX
+	if (extension == _T("pcx"))
+		return new wxPCXHandler;
+#endif
+#if wxUSE_TGA
+	if (extension == _T("tga"))
+		return new wxTGAHandler;
+#endif
+#if wxUSE_XPM
+	if (extension == _T("xpm"))
+		return new wxXPMHandler;
+#endif
+
+	return nullptr;
+}
@@ -0,0 +1,41 @@
+// File:  appResources.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Application-wide resources that are expensive to create, built on
+//        first use and shared by all windows.
+
+#ifndef APP_RESOURCES_H_
+#define APP_RESOURCES_H_
+
+// Standard C++ headers
+#include <memory>
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/iconbndl.h>
+
+class AppResources
+{
+public:
+	// Built once, the first time any window asks for it
+	static const wxIconBundle& GetIcons();
+
+	// Call before wxWidgets shuts down
+	static void Release();
+
+	// Loads the image after registering only the handler for its extension.
+	// If that fails (unknown extension or mislabeled file), all handlers are
+	// registered and the format is detected from the contents.  Must be called
+	// from the main thread.
+	static bool LoadImageFile(const wxString& fileName, wxImage& image);
+
+private:
+	static std::unique_ptr<wxIconBundle> icons;
+	static bool allHandlersRegistered;
+
+	static bool RegisterImageHandler(const wxString& fileName);
+	static void RegisterAllImageHandlers();
+	static wxImageHandler* CreateImageHandler(const wxString& extension);
+};
+
+#endif// APP_RESOURCES_H_
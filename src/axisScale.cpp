@@ -0,0 +1,359 @@
+// File:  axisScale.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Axis scale families.
+
+// Standard C++ headers
+#include <sstream>
+#include <cctype>
+
+// Local headers
+#include "axisScale.h"
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		GetName
+//
+// Description:		Returns the display name for the scale.
+//
+// Input Arguments:
+//		type	= const Type&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char*
+//
+//==========================================================================
+const char* AxisScale::GetName(const Type& type)
+{
+	switch (type)
+	{
+	case Type::Logarithmic:
+		return "Logarithmic";
+
+	case Type::Reciprocal:
+		return "Reciprocal";
+
+	case Type::Probability:
+		return "Probability";
+
+	default:
+		return "Linear";
+	}
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		GetMaskNames
+//
+// Description:		Returns the names of the scales in the mask, separated by
+//					commas.
+//
+// Input Arguments:
+//		mask	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string AxisScale::GetMaskNames(const unsigned int& mask)
+{
+	std::string names;
+	unsigned int i;
+	for (i = 0; i < typeCount; ++i)
+	{
+		const Type type(static_cast<Type>(i));
+		if ((mask & Mask(type)) == 0)
+			continue;
+
+		if (!names.empty())
+			names.push_back(',');
+		names.append(GetName(type));
+	}
+
+	return names;
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		ParseMask
+//
+// Description:		Parses a comma-separated list of scale names.
+//
+// Input Arguments:
+//		names	= const std::string&
+//
+// Output Arguments:
+//		mask	= unsigned int&
+//
+// Return Value:
+//		bool, false for an unknown name or an empty list
+//
+//==========================================================================
+bool AxisScale::ParseMask(const std::string& names, unsigned int& mask)
+{
+	auto equalsIgnoringCase([](const std::string& a, const std::string& b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		std::string::size_type i;
+		for (i = 0; i < a.size(); ++i)
+		{
+			if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+				return false;
+		}
+		return true;
+	});
+
+	unsigned int parsed(0);
+	std::istringstream ss(names);
+	std::string name;
+	while (std::getline(ss, name, ','))
+	{
+		if (equalsIgnoringCase(name, "Any"))
+		{
+			parsed |= allMask;
+			continue;
+		}
+
+		unsigned int i;
+		for (i = 0; i < typeCount; ++i)
+		{
+			if (equalsIgnoringCase(name, GetName(static_cast<Type>(i))))
+				break;
+		}
+
+		if (i == typeCount)
+			return false;
+		parsed |= Mask(static_cast<Type>(i));
+	}
+
+	if (parsed == 0)
+		return false;
+
+	mask = parsed;
+	return true;
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		IsValid
+//
+// Description:		Checks that the value is within the domain of the scale.
+//
+// Input Arguments:
+//		type	= const Type&
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool AxisScale::IsValid(const Type& type, const double& value)
+{
+	return AreValid(type, 1, &value);
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		Forward
+//
+// Description:		Maps a plot value to the linear space.
+//
+// Input Arguments:
+//		type	= const Type&
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double AxisScale::Forward(const Type& type, const double& value)
+{
+	double result(value);
+	Forward(type, 1, &result);
+	return result;
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		Inverse
+//
+// Description:		Maps a value from the linear space to a plot value.
+//
+// Input Arguments:
+//		type	= const Type&
+//		linear	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double AxisScale::Inverse(const Type& type, const double& linear)
+{
+	double result(linear);
+	Inverse(type, 1, &result);
+	return result;
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		AreValid
+//
+// Description:		Checks that all of the values are within the domain of the
+//					scale.
+//
+// Input Arguments:
+//		type	= const Type&
+//		count	= const std::size_t&
+//		values	= const double*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool AxisScale::AreValid(const Type& type, const std::size_t& count, const double* values)
+{
+	bool valid(true);
+	Visit(type, [count, values, &valid](auto family)
+	{
+		std::size_t i;
+		for (i = 0; i < count && valid; ++i)
+			valid = decltype(family)::IsValid(values[i]);
+	});
+
+	return valid;
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		Forward
+//
+// Description:		Maps plot values to the linear space, in place.
+//
+// Input Arguments:
+//		type	= const Type&
+//		count	= const std::size_t&
+//		values	= double*
+//
+// Output Arguments:
+//		values	= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void AxisScale::Forward(const Type& type, const std::size_t& count, double* values)
+{
+	if (type == Type::Linear)
+		return;
+
+	Visit(type, [count, values](auto family)
+	{
+		std::size_t i;
+		for (i = 0; i < count; ++i)
+			values[i] = decltype(family)::Forward(values[i]);
+	});
+}
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		Inverse
+//
+// Description:		Maps values from the linear space to plot values, in place.
+//
+// Input Arguments:
+//		type	= const Type&
+//		count	= const std::size_t&
+//		values	= double*
+//
+// Output Arguments:
+//		values	= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void AxisScale::Inverse(const Type& type, const std::size_t& count, double* values)
+{
+	if (type == Type::Linear)
+		return;
+
+	Visit(type, [count, values](auto family)
+	{
+		std::size_t i;
+		for (i = 0; i < count; ++i)
+			values[i] = decltype(family)::Inverse(values[i]);
+	});
+}
+
+//==========================================================================
+// Class:			AxisScale::Probability
+// Function:		NormalQuantile
+//
+// Description:		Returns the standard normal quantile (inverse CDF) using
+//					Acklam's rational approximation, polished with one Halley
+//					step to full double precision.
+//
+// Input Arguments:
+//		p	= const double&, in (0, 1)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double AxisScale::Probability::NormalQuantile(const double& p)
+{
+	static constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+		-2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+	static constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+		-1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+	static constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+		-2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+	static constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+		2.445134137142996e+00, 3.754408661907416e+00};
+	static constexpr double lowerBreak = 0.02425;
+	static constexpr double sqrtTwoPi = 2.50662827463100050242;
+
+	double x;
+	if (p < lowerBreak || p > 1.0 - lowerBreak)
+	{
+		const double q(std::sqrt(-2.0 * std::log(p < lowerBreak ? p : 1.0 - p)));
+		x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+			/ ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+		if (p > 1.0 - lowerBreak)
+			x = -x;
+	}
+	else
+	{
+		const double q(p - 0.5);
+		const double r(q * q);
+		x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+			/ (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+	}
+
+	const double e(Inverse(x) - p);
+	const double u(e * sqrtTwoPi * std::exp(0.5 * x * x));
+	return x - u / (1.0 + 0.5 * x * u);
+}
@@ -0,0 +1,140 @@
+// File:  axisScale.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Axis scale families.  Each family is a functor type that maps plot
+//        values to the space in which the axis is linear (Forward) and back
+//        (Inverse).  The transformation matrix is fit in that linear space, so
+//        any scale whose forward map is affine in a family (i.e. dB, which is
+//        20*log10) is already covered by that family.  To add a family, add a
+//        Type, a functor with the same static members as the others, and a case
+//        in Visit().
+//
+//        Date/time axes are linear in time, so they need no family of their
+//        own; their values are entered as numbers (i.e. days or seconds since
+//        some epoch) and fit with Linear.
+//
+//        Every family on an axis adds candidate fits, and with few references
+//        a wrong combination can fit the noise slightly better than the right
+//        one, so the fit only considers the families in a mask (see Mask()).
+
+#ifndef AXIS_SCALE_H_
+#define AXIS_SCALE_H_
+
+// Standard C++ headers
+#include <cstddef>
+#include <cmath>
+#include <string>
+
+class AxisScale
+{
+public:
+	enum class Type
+	{
+		Linear,
+		Logarithmic,
+		Reciprocal,
+		Probability// Normal probability scale; values are fractions in (0, 1)
+	};
+
+	static constexpr unsigned int typeCount = 4;
+
+	// Sets of families are bit masks with one bit per Type
+	static constexpr unsigned int Mask(const Type& type) { return 1U << static_cast<unsigned int>(type); }
+	static constexpr unsigned int allMask = (1U << typeCount) - 1;
+	static constexpr unsigned int defaultMask = (1U << static_cast<unsigned int>(Type::Linear)) |
+		(1U << static_cast<unsigned int>(Type::Logarithmic));
+
+	// Masks are written as comma-separated names (i.e. "Linear,Logarithmic");
+	// parsing is case-insensitive and also accepts "Any"
+	static std::string GetMaskNames(const unsigned int& mask);
+	static bool ParseMask(const std::string& names, unsigned int& mask);
+
+	struct Linear
+	{
+		static bool IsValid(const double& value) { return std::isfinite(value); }
+		static double Forward(const double& value) { return value; }
+		static double Inverse(const double& linear) { return linear; }
+	};
+
+	struct Logarithmic
+	{
+		static bool IsValid(const double& value) { return value > 0.0 && std::isfinite(value); }
+		static double Forward(const double& value) { return std::log10(value); }
+		static double Inverse(const double& linear) { return std::pow(10.0, linear); }
+	};
+
+	struct Reciprocal
+	{
+		static bool IsValid(const double& value) { return value != 0.0 && std::isfinite(value); }
+		static double Forward(const double& value) { return 1.0 / value; }
+		static double Inverse(const double& linear) { return 1.0 / linear; }
+	};
+
+	struct Probability
+	{
+		static bool IsValid(const double& value) { return value > 0.0 && value < 1.0; }
+		static double Forward(const double& value) { return NormalQuantile(value); }
+		static double Inverse(const double& linear) { return 0.5 * std::erfc(-linear * sqrtHalf); }
+
+	private:
+		static constexpr double sqrtHalf = 0.70710678118654752440;
+		static double NormalQuantile(const double& p);
+	};
+
+	// Calls visitor(Family()) with the functor type for the specified scale, so
+	// the visitor's loops are compiled once per family with no per-point branch
+	template <typename Visitor>
+	static void Visit(const Type& type, Visitor&& visitor);
+
+	static const char* GetName(const Type& type);
+
+	static bool IsValid(const Type& type, const double& value);
+	static double Forward(const Type& type, const double& value);
+	static double Inverse(const Type& type, const double& linear);
+
+	// In place, for arrays of values
+	static bool AreValid(const Type& type, const std::size_t& count, const double* values);
+	static void Forward(const Type& type, const std::size_t& count, double* values);
+	static void Inverse(const Type& type, const std::size_t& count, double* values);
+};
+
+//==========================================================================
+// Class:			AxisScale
+// Function:		Visit
+//
+// Description:		Dispatches to the functor type for the specified scale.
+//
+// Input Arguments:
+//		type	= const Type&
+//		visitor	= Visitor&&, callable with any of the functor types
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <typename Visitor>
+void AxisScale::Visit(const Type& type, Visitor&& visitor)
+{
+	switch (type)
+	{
+	case Type::Logarithmic:
+		visitor(Logarithmic());
+		break;
+
+	case Type::Reciprocal:
+		visitor(Reciprocal());
+		break;
+
+	case Type::Probability:
+		visitor(Probability());
+		break;
+
+	default:
+		visitor(Linear());
+	}
+}
+
+#endif// AXIS_SCALE_H_
@@ -0,0 +1,544 @@
+// File:  batchProcessor.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Converts curve data for many images in parallel.
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <chrono>
+#include <filesystem>
+#include <cstdio>
+
+// wxWidgets headers
+#include <wx/image.h>
+#include <wx/log.h>
+
+// Local headers
+#include "batchProcessor.h"
+#include "threadPool.h"
+#include "dataExporter.h"
+#include "traceRecorder.h"
+#include "imageHeader.h"
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		BatchProcessor
+//
+// Description:		Constructor for BatchProcessor class.
+//
+// Input Arguments:
+//		outputDirectory	= const std::string&
+//		extension		= const std::string&, determines the output format
+//		threadCount		= const unsigned int&
+//		maxInFlight		= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BatchProcessor::BatchProcessor(const std::string& outputDirectory, const std::string& extension,
+	const unsigned int& threadCount, const std::size_t& maxInFlight) : outputDirectory(outputDirectory),
+	extension(extension), threadCount(threadCount), maxInFlight(maxInFlight), elapsedSeconds(0.0),
+	threadsUsed(0), failureCount(0), nextToDeliver(0), delivering(false), inFlight(0)
+{
+	for (auto& s : statistics)
+	{
+		s.nanoseconds = 0;
+		s.count = 0;
+	}
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		LoadManifest
+//
+// Description:		Reads the list of images to process.  Templates are resolved
+//					here, in manifest order, so that jobs are independent of
+//					each other once processing starts.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::LoadManifest(const std::string& fileName)
+{
+	std::ifstream file(fileName.c_str());
+	if (!file.is_open())
+	{
+		errorString = "Failed to open '" + fileName + "'.";
+		return false;
+	}
+
+	std::map<std::string, std::vector<PointPicker::ReferencePair>> templates;
+	std::set<std::string> outputNames;
+	std::shared_ptr<Job> job(std::make_shared<Job>());
+	std::string line;
+	unsigned int lineNumber(0);
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+		if (!job->request.ParseLine(line))
+		{
+			errorString = fileName + ", line " + std::to_string(lineNumber) + ": " + job->request.GetErrorString();
+			return false;
+		}
+
+		if (!job->request.IsComplete())
+			continue;
+
+		const ServiceRequest& request(job->request);
+		if (request.GetImagePath().empty())
+		{
+			errorString = fileName + ", line " + std::to_string(lineNumber) + ": Request has no IMAGE.";
+			return false;
+		}
+
+		job->references = request.GetReferences();
+		if (!request.GetTemplateName().empty())
+		{
+			if (!job->references.empty())
+				templates[request.GetTemplateName()] = job->references;
+			else if (templates.find(request.GetTemplateName()) != templates.end())
+				job->references = templates[request.GetTemplateName()];
+			else
+			{
+				errorString = fileName + ", line " + std::to_string(lineNumber)
+					+ ": Unknown template '" + request.GetTemplateName() + "'.";
+				return false;
+			}
+		}
+
+		// Images with the same name (from different directories) get a suffix
+		const std::string stem(std::filesystem::path(request.GetImagePath()).stem().string());
+		std::string name(stem);
+		for (unsigned int i = 2; !outputNames.insert(name).second; ++i)
+			name = stem + "_" + std::to_string(i);
+
+		job->index = jobs.size();
+		job->result.imagePath = request.GetImagePath();
+		job->result.outputPath = (std::filesystem::path(outputDirectory) / (name + "." + extension)).string();
+		job->result.success = true;
+		jobs.push_back(job);
+		job = std::make_shared<Job>();
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Run
+//
+// Description:		Processes all of the images in the manifest.
+//
+// Input Arguments:
+//		callback	= const ResultCallback&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if every image was processed successfully
+//
+//==========================================================================
+bool BatchProcessor::Run(const ResultCallback& callback)
+{
+	resultCallback = callback;
+
+	std::error_code error;
+	std::filesystem::create_directories(outputDirectory, error);
+	if (error)
+	{
+		errorString = "Failed to create '" + outputDirectory + "': " + error.message();
+		return false;
+	}
+
+	const auto start(std::chrono::steady_clock::now());
+	{
+		ThreadPool pool(threadCount);
+		threadsUsed = pool.GetThreadCount();
+		const std::size_t inFlightLimit(maxInFlight > 0 ? maxInFlight : 2 * threadsUsed);
+
+		for (const auto& job : jobs)
+		{
+			// Limit the number of images (and their curve data) held at once
+			{
+				std::unique_lock<std::mutex> lock(deliveryMutex);
+				slotAvailable.wait(lock, [this, inFlightLimit]()
+				{
+					return inFlight < inFlightLimit;
+				});
+				++inFlight;
+			}
+
+			pool.Submit([this, &pool, job]()
+			{
+				RunStage(pool, job, StageSize);
+			});
+		}
+
+		pool.WaitIdle();
+	}
+	elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	return failureCount == 0;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		RunStage
+//
+// Description:		Runs one stage for one image and queues the next stage.  A
+//					job that has failed skips the remaining stages.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//		job		= const std::shared_ptr<Job>&
+//		stage	= const Stage&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BatchProcessor::RunStage(ThreadPool& pool, const std::shared_ptr<Job>& job, const Stage& stage)
+{
+	if (job->result.success)
+	{
+		const auto start(std::chrono::steady_clock::now());
+		if (stage == StageSize)
+			job->result.success = ReadSize(*job);
+		else if (stage == StageExtract)
+			job->result.success = Extract(*job);
+		else if (stage == StageFit)
+			job->result.success = Fit(*job);
+		else
+			job->result.success = Export(*job);
+
+		const auto end(std::chrono::steady_clock::now());
+		statistics[stage].nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		++statistics[stage].count;
+		TraceRecorder::AddComplete(GetStageName(stage), "batch", start, end);
+	}
+
+	const Stage next(static_cast<Stage>(stage + 1));
+	if (next == StageCount)
+	{
+		Deliver(job);
+		return;
+	}
+
+	pool.Submit([this, &pool, job, next]()
+	{
+		RunStage(pool, job, next);
+	});
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		ReadSize
+//
+// Description:		Reads the image dimensions from the file header, falling
+//					back to decoding the image for other formats.
+//
+// Input Arguments:
+//		job	= Job&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::ReadSize(Job& job)
+{
+	if (ImageHeader::ReadSize(job.result.imagePath, job.width, job.height))
+		return true;
+
+	wxLogNull suppressLogging;
+	wxImage image;
+	if (!image.LoadFile(wxString::FromUTF8(job.result.imagePath.c_str())) || !image.IsOk())
+	{
+		job.result.errorString = "Failed to load image.";
+		return false;
+	}
+
+	job.width = image.GetWidth();
+	job.height = image.GetHeight();
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Extract
+//
+// Description:		Checks the reference and curve points against the image and
+//					loads them into the job's picker.
+//
+// Input Arguments:
+//		job	= Job&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::Extract(Job& job)
+{
+	const double width(job.width), height(job.height);
+
+	auto isInside([width, height](const PointPicker::Point& p)
+	{
+		return p.x >= 0.0 && p.x <= width && p.y >= 0.0 && p.y <= height;
+	});
+
+	if (job.references.size() < 4)
+	{
+		job.result.errorString = "At least four references are required.";
+		return false;
+	}
+
+	job.picker.SetFitRequestHandler([]()
+	{
+		// Fit once, in the fit stage, after all of the references have been added
+	});
+
+	for (const auto& r : job.request.GetRegions())
+		job.picker.AddRegion(PointPicker::Point(r.xMin, r.yMin), PointPicker::Point(r.xMax, r.yMax));
+
+	for (const auto& r : job.references)
+	{
+		if (!isInside(r.imageCoords))
+		{
+			job.result.errorString = "Reference lies outside of the image.";
+			return false;
+		}
+		job.picker.AddReference(r.imageCoords, r.valueCoords, r.weight);
+	}
+
+	const std::vector<std::vector<PointPicker::Point>>& curves(job.request.GetCurves());
+	for (unsigned int i = 0; i < curves.size(); ++i)
+	{
+		for (const auto& p : curves[i])
+		{
+			if (!isInside(p))
+			{
+				job.result.errorString = "Curve point lies outside of the image.";
+				return false;
+			}
+			job.picker.AddCurvePoint(i, p);
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Fit
+//
+// Description:		Fits the transformations for the job's references and regions.
+//
+// Input Arguments:
+//		job	= Job&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::Fit(Job& job)
+{
+	// Already running on a pool thread, so a robust fit stays on this thread
+	if (!job.picker.ApplyTransformations(PointPicker::FitTransformations(job.picker.GetReferencePairs(),
+		job.picker.GetRegions(), job.request.GetFitOptions()), job.picker.GetReferenceVersion()))
+	{
+		job.result.errorString = "The references changed while they were being fit.";
+		return false;
+	}
+
+	if (!job.picker.GetErrorString().empty())
+	{
+		job.result.errorString = std::string(job.picker.GetErrorString().ToUTF8()) + '.';
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Export
+//
+// Description:		Converts the curves and writes the output file.  The
+//					exporters convert while they write, so this stage covers
+//					both.
+//
+// Input Arguments:
+//		job	= Job&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::Export(Job& job)
+{
+	std::unique_ptr<DataExporter> exporter(DataExporter::Create(extension, DataExporter::Padding::Empty));
+	if (!exporter->Export(job.result.outputPath, job.picker, job.request.GetLabels()))
+	{
+		job.result.errorString = exporter->GetErrorString();
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Deliver
+//
+// Description:		Passes finished jobs to the result callback in manifest
+//					order.  Whichever thread finishes the next job in sequence
+//					delivers it along with any later jobs that are already done;
+//					other threads just leave their job in the queue and move on.
+//
+// Input Arguments:
+//		job	= const std::shared_ptr<Job>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BatchProcessor::Deliver(const std::shared_ptr<Job>& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(deliveryMutex);
+		finished[job->index] = job;
+		if (delivering)
+			return;
+		delivering = true;
+	}
+
+	while (true)
+	{
+		std::shared_ptr<Job> next;
+		{
+			std::lock_guard<std::mutex> lock(deliveryMutex);
+			const auto it(finished.find(nextToDeliver));
+			if (it == finished.end())
+			{
+				delivering = false;
+				return;
+			}
+
+			next = it->second;
+			finished.erase(it);
+		}
+
+		if (!next->result.success)
+			++failureCount;
+
+		if (resultCallback)
+			resultCallback(next->result);
+
+		{
+			std::lock_guard<std::mutex> lock(deliveryMutex);
+			++nextToDeliver;
+			--inFlight;
+		}
+		slotAvailable.notify_one();
+	}
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		GetReport
+//
+// Description:		Summarizes the throughput of the last run.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string BatchProcessor::GetReport() const
+{
+	std::ostringstream ss;
+	char line[128];
+	std::snprintf(line, sizeof(line), "Processed %zu images (%zu failed) in %.3f s, %.1f images/s on %u threads\n",
+		jobs.size(), failureCount, elapsedSeconds,
+		elapsedSeconds > 0.0 ? jobs.size() / elapsedSeconds : 0.0, threadsUsed);
+	ss << line;
+
+	std::snprintf(line, sizeof(line), "%-10s %10s %12s %22s\n", "Stage", "Images", "Busy (s)", "Images/s per thread");
+	ss << line;
+	for (unsigned int i = 0; i < StageCount; ++i)
+	{
+		const double busy(statistics[i].nanoseconds * 1.0e-9);
+		const std::uint64_t count(statistics[i].count);
+		std::snprintf(line, sizeof(line), "%-10s %10llu %12.3f %22.1f\n", GetStageName(static_cast<Stage>(i)),
+			static_cast<unsigned long long>(count), busy, busy > 0.0 ? count / busy : 0.0);
+		ss << line;
+	}
+
+	return ss.str();
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		GetStageName
+//
+// Description:		Returns the name of the stage for reporting.
+//
+// Input Arguments:
+//		stage	= const Stage&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char*
+//
+//==========================================================================
+const char* BatchProcessor::GetStageName(const Stage& stage)
+{
+	if (stage == StageSize)
+		return "size";
+	else if (stage == StageExtract)
+		return "extract";
+	else if (stage == StageFit)
+		return "fit";
+	else if (stage == StageExport)
+		return "export";
+
+	return "";
+}
@@ -0,0 +1,120 @@
+// File:  batchProcessor.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Converts curve data for many images in parallel.  The manifest is a
+//        series of requests in the format described in serviceRequest.h, each
+//        of which must name an image.  Every image passes through the size,
+//        extract, fit and export stages as separate tasks on a work-stealing
+//        pool, with a limit on how many images are in flight at once.  Only
+//        the image dimensions are needed (to check the points against), so
+//        the pixels are decoded only for formats ImageHeader can't read.
+
+#ifndef BATCH_PROCESSOR_H_
+#define BATCH_PROCESSOR_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+// Local headers
+#include "pointPicker.h"
+#include "serviceRequest.h"
+
+// Local forward declarations
+class ThreadPool;
+
+class BatchProcessor
+{
+public:
+	// Zero for threadCount uses one thread per core; zero for maxInFlight uses
+	// twice the thread count
+	BatchProcessor(const std::string& outputDirectory, const std::string& extension,
+		const unsigned int& threadCount = 0, const std::size_t& maxInFlight = 0);
+
+	bool LoadManifest(const std::string& fileName);
+
+	struct Result
+	{
+		std::string imagePath;
+		std::string outputPath;
+		bool success;
+		std::string errorString;
+	};
+
+	// The callback is called from pool threads, one image at a time, in
+	// manifest order
+	typedef std::function<void(const Result& result)> ResultCallback;
+	bool Run(const ResultCallback& callback);
+
+	std::string GetReport() const;
+	std::string GetErrorString() const { return errorString; }
+
+private:
+	const std::string outputDirectory;
+	const std::string extension;
+	const unsigned int threadCount;
+	const std::size_t maxInFlight;
+	std::string errorString;
+
+	struct Job
+	{
+		std::size_t index;
+		ServiceRequest request;
+		std::vector<PointPicker::ReferencePair> references;
+		unsigned int width;
+		unsigned int height;
+		PointPicker picker;
+		Result result;
+	};
+
+	std::vector<std::shared_ptr<Job>> jobs;
+
+	enum Stage
+	{
+		StageSize,
+		StageExtract,
+		StageFit,
+		StageExport,
+
+		StageCount
+	};
+
+	struct StageStatistics
+	{
+		std::atomic<std::uint64_t> nanoseconds;
+		std::atomic<std::uint64_t> count;
+	};
+
+	StageStatistics statistics[StageCount];
+	double elapsedSeconds;
+	unsigned int threadsUsed;
+	std::size_t failureCount;
+
+	void RunStage(ThreadPool& pool, const std::shared_ptr<Job>& job, const Stage& stage);
+	bool ReadSize(Job& job);
+	bool Extract(Job& job);
+	bool Fit(Job& job);
+	bool Export(Job& job);
+
+	// Finished jobs wait here until every job before them has been delivered
+	std::map<std::size_t, std::shared_ptr<Job>> finished;
+	std::size_t nextToDeliver;
+	bool delivering;
+	std::size_t inFlight;
+	std::mutex deliveryMutex;
+	std::condition_variable slotAvailable;
+	ResultCallback resultCallback;
+
+	void Deliver(const std::shared_ptr<Job>& job);
+
+	static const char* GetStageName(const Stage& stage);
+};
+
+#endif// BATCH_PROCESSOR_H_
@@ -0,0 +1,653 @@
+// File:  binaryDataExporter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Writer for binary files containing converted curve data.
+
+// Standard C++ headers
+#include <fstream>
+#include <algorithm>
+#include <set>
+#include <ctime>
+
+// Local headers
+#include "binaryDataExporter.h"
+#include "bufferedWriter.h"
+#include "littleEndian.h"
+#include "crc32.h"
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the BinaryDataExporter class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char BinaryDataExporter::columnarMagic[8] = { 'P', 'P', 'C', 'U', 'R', 'V', 'E', 'S' };
+const std::uint32_t BinaryDataExporter::columnarVersion(1);
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		BinaryDataExporter
+//
+// Description:		Constructor for BinaryDataExporter class.
+//
+// Input Arguments:
+//		format		= const Format&
+//		padValue	= const double&, used in place of values for curves with
+//					  fewer points than the longest curve (NumPy format only)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BinaryDataExporter::BinaryDataExporter(const Format& format, const double& padValue)
+	: format(format), padValue(padValue)
+{
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		Export
+//
+// Description:		Writes the curve data to file.  Points are converted in
+//					blocks directly from the source, so no full copy of the
+//					converted data is made.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//		source		= const CurveSource&
+//		labels		= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BinaryDataExporter::Export(const std::string& fileName, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	ResetStatus();
+
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	if (!file.is_open() || !file.good())
+	{
+		errorString = "Failed to open '" + fileName + "' for output.";
+		return false;
+	}
+
+	if (!Write(file, source, labels))
+	{
+		if (errorString.empty())
+			errorString = "Failed while writing to '" + fileName + "'.";
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		Write
+//
+// Description:		Writes the curve data to the specified stream.
+//
+// Input Arguments:
+//		stream		= std::ostream&
+//		source		= const CurveSource&
+//		labels		= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BinaryDataExporter::Write(std::ostream& stream, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	ResetStatus();
+
+	bool ok;
+	if (format == Format::NumPy)
+		ok = WriteNumPy(stream, source, labels);
+	else if (format == Format::NumPyArchive)
+		ok = WriteNumPyArchive(stream, source, labels);
+	else
+		ok = WriteColumnar(stream, source, labels);
+
+	return ok && stream.good();
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		WriteNumPy
+//
+// Description:		Writes a single structured .npy array with one row per
+//					point index.  Rows written counts array rows.
+//
+// Input Arguments:
+//		file	= std::ostream&
+//		source	= const CurveSource&
+//		labels	= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BinaryDataExporter::WriteNumPy(std::ostream& file, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	const unsigned int curveCount(source.GetCurveCount());
+	const std::string typeString(GetNumPyTypeString());
+
+	// NumPy rejects duplicate field names, so make them unique
+	std::set<std::string> usedNames;
+	auto uniqueName([&usedNames](const std::string& name)
+	{
+		std::string candidate(name);
+		unsigned int suffix(2);
+		while (!usedNames.insert(candidate).second)
+			candidate = name + " (" + std::to_string(suffix++) + ")";
+		return candidate;
+	});
+
+	// With bootstrap results, each curve also gets standard deviation fields
+	const bool includeDeviation(source.HasUncertainty());
+	const std::size_t columnsPerCurve(includeDeviation ? 4 : 2);
+
+	std::string descr("[");
+	unsigned int i;
+	std::size_t rowCount(0);
+	for (i = 0; i < curveCount; ++i)
+	{
+		const std::string name(GetCurveName(labels, i));
+		descr.append("(" + QuotePythonString(uniqueName(name + " X")) + ", '" + typeString + "'), ");
+		descr.append("(" + QuotePythonString(uniqueName(name + " Y")) + ", '" + typeString + "'), ");
+		if (includeDeviation)
+		{
+			descr.append("(" + QuotePythonString(uniqueName(name + " X SD")) + ", '" + typeString + "'), ");
+			descr.append("(" + QuotePythonString(uniqueName(name + " Y SD")) + ", '" + typeString + "'), ");
+		}
+		rowCount = std::max(rowCount, source.GetCurveSize(i));
+	}
+	descr.append("]");
+
+	BufferedWriter writer(file);
+	writer.Write(BuildNumPyHeader(descr, "(" + std::to_string(rowCount) + ",)"));
+
+	std::vector<double> x(blockSize), y(blockSize);
+	std::vector<double> xDeviation(includeDeviation ? blockSize : 0), yDeviation(includeDeviation ? blockSize : 0);
+	const std::size_t rowSize(curveCount * columnsPerCurve);
+	std::vector<double> rows(blockSize * rowSize);
+	const std::uint64_t totalPoints(GetTotalPointCount(source));
+	std::uint64_t pointsDone(0);
+	for (std::size_t blockStart = 0; blockStart < rowCount; blockStart += blockSize)
+	{
+		const std::size_t blockRows(std::min(blockSize, rowCount - blockStart));
+		for (i = 0; i < curveCount; ++i)
+		{
+			const std::size_t curveSize(source.GetCurveSize(i));
+			const std::size_t available(curveSize > blockStart ? std::min(blockRows, curveSize - blockStart) : 0);
+			if (available > 0)
+			{
+				source.ConvertCurve(i, blockStart, available, x.data(), y.data());
+				if (includeDeviation)
+					source.ConvertCurveDeviation(i, blockStart, available, xDeviation.data(), yDeviation.data());
+			}
+			pointsDone += available;
+
+			double* column(rows.data() + i * columnsPerCurve);
+			std::size_t j;
+			for (j = 0; j < available; ++j)
+			{
+				column[j * rowSize] = x[j];
+				column[j * rowSize + 1] = y[j];
+				if (includeDeviation)
+				{
+					column[j * rowSize + 2] = xDeviation[j];
+					column[j * rowSize + 3] = yDeviation[j];
+				}
+			}
+
+			for (; j < blockRows; ++j)
+			{
+				std::size_t k;
+				for (k = 0; k < columnsPerCurve; ++k)
+					column[j * rowSize + k] = padValue;
+			}
+		}
+
+		writer.Write(reinterpret_cast<const char*>(rows.data()), blockRows * rowSize * sizeof(double));
+		if (!ReportProgress(pointsDone, totalPoints))
+			return false;
+	}
+
+	writer.Flush();
+	bytesWritten = writer.GetBytesWritten();
+	rowsWritten = rowCount;
+	return true;
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		WriteNumPyArchive
+//
+// Description:		Writes an uncompressed .npz archive containing one (n, 2)
+//					array per curve.  Each member's checksum is computed while
+//					the data streams out and patched into its local header.
+//					Rows written counts the total number of points.
+//
+// Input Arguments:
+//		file	= std::ostream&
+//		source	= const CurveSource&
+//		labels	= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BinaryDataExporter::WriteNumPyArchive(std::ostream& file, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	const std::time_t now(std::time(nullptr));
+	const std::tm* local(std::localtime(&now));
+	const std::uint16_t dosTime(static_cast<std::uint16_t>((local->tm_hour << 11) | (local->tm_min << 5) | (local->tm_sec / 2)));
+	const std::uint16_t dosDate(static_cast<std::uint16_t>(((std::max(local->tm_year, 80) - 80) << 9) | ((local->tm_mon + 1) << 5) | local->tm_mday));
+
+	const std::uint16_t zipVersion(20);
+	const std::uint16_t utf8NameFlag(0x0800);
+	const std::uint64_t zipLimit(0xFFFFFFFF);
+
+	struct Entry
+	{
+		std::string name;
+		std::uint32_t crc;
+		std::uint32_t size;
+		std::uint32_t offset;
+	};
+
+	std::vector<Entry> entries;
+	std::set<std::string> usedNames;
+	std::uint64_t position(0);
+
+	std::vector<double> x(blockSize), y(blockSize), interleaved(2 * blockSize);
+	const unsigned int curveCount(source.GetCurveCount());
+	const std::uint64_t totalPoints(GetTotalPointCount(source));
+	for (unsigned int i = 0; i < curveCount; ++i)
+	{
+		std::string baseName(GetCurveName(labels, i));
+		std::replace(baseName.begin(), baseName.end(), '/', '_');
+		std::replace(baseName.begin(), baseName.end(), '\\', '_');
+		std::string name(baseName);
+		unsigned int suffix(2);
+		while (!usedNames.insert(name).second)
+			name = baseName + "_" + std::to_string(suffix++);
+		name.append(".npy");
+
+		const std::size_t curveSize(source.GetCurveSize(i));
+		const std::string npyHeader(BuildNumPyHeader("'" + GetNumPyTypeString() + "'",
+			"(" + std::to_string(curveSize) + ", 2)"));
+		const std::uint64_t entrySize(npyHeader.size() + curveSize * 2 * sizeof(double));
+		if (position + 30 + name.size() + entrySize > zipLimit)
+		{
+			errorString = "Data is too large for the .npz format; use the .ppc format instead.";
+			return false;
+		}
+
+		Entry entry;
+		entry.name = name;
+		entry.size = static_cast<std::uint32_t>(entrySize);
+		entry.offset = static_cast<std::uint32_t>(position);
+
+		std::string localHeader;
+		LittleEndian::Append(localHeader, static_cast<std::uint32_t>(0x04034b50));
+		LittleEndian::Append(localHeader, zipVersion);
+		LittleEndian::Append(localHeader, utf8NameFlag);
+		LittleEndian::Append(localHeader, static_cast<std::uint16_t>(0));// Stored (no compression)
+		LittleEndian::Append(localHeader, dosTime);
+		LittleEndian::Append(localHeader, dosDate);
+		const std::size_t crcOffset(localHeader.size());
+		LittleEndian::Append(localHeader, static_cast<std::uint32_t>(0));// CRC, patched below
+		LittleEndian::Append(localHeader, entry.size);
+		LittleEndian::Append(localHeader, entry.size);
+		LittleEndian::Append(localHeader, static_cast<std::uint16_t>(name.size()));
+		LittleEndian::Append(localHeader, static_cast<std::uint16_t>(0));
+		localHeader.append(name);
+
+		CRC32 crc;
+		crc.Update(npyHeader.data(), npyHeader.size());
+
+		{
+			BufferedWriter writer(file);
+			writer.Write(localHeader);
+			writer.Write(npyHeader);
+
+			for (std::size_t blockStart = 0; blockStart < curveSize; blockStart += blockSize)
+			{
+				const std::size_t count(std::min(blockSize, curveSize - blockStart));
+				source.ConvertCurve(i, blockStart, count, x.data(), y.data());
+				for (std::size_t j = 0; j < count; ++j)
+				{
+					interleaved[2 * j] = x[j];
+					interleaved[2 * j + 1] = y[j];
+				}
+
+				crc.Update(interleaved.data(), count * 2 * sizeof(double));
+				writer.Write(reinterpret_cast<const char*>(interleaved.data()), count * 2 * sizeof(double));
+				if (!ReportProgress(rowsWritten + blockStart + count, totalPoints))
+					return false;
+			}
+
+			writer.Flush();
+			position += writer.GetBytesWritten();
+		}
+
+		entry.crc = crc.Get();
+		std::string crcBytes;
+		LittleEndian::Append(crcBytes, entry.crc);
+		file.seekp(entry.offset + crcOffset);
+		file.write(crcBytes.data(), crcBytes.size());
+		file.seekp(0, std::ios::end);
+
+		entries.push_back(entry);
+		rowsWritten += curveSize;
+	}
+
+	std::string directory;
+	for (const auto& entry : entries)
+	{
+		LittleEndian::Append(directory, static_cast<std::uint32_t>(0x02014b50));
+		LittleEndian::Append(directory, zipVersion);// Made by
+		LittleEndian::Append(directory, zipVersion);// Needed to extract
+		LittleEndian::Append(directory, utf8NameFlag);
+		LittleEndian::Append(directory, static_cast<std::uint16_t>(0));
+		LittleEndian::Append(directory, dosTime);
+		LittleEndian::Append(directory, dosDate);
+		LittleEndian::Append(directory, entry.crc);
+		LittleEndian::Append(directory, entry.size);
+		LittleEndian::Append(directory, entry.size);
+		LittleEndian::Append(directory, static_cast<std::uint16_t>(entry.name.size()));
+		LittleEndian::Append(directory, static_cast<std::uint16_t>(0));// Extra field length
+		LittleEndian::Append(directory, static_cast<std::uint16_t>(0));// Comment length
+		LittleEndian::Append(directory, static_cast<std::uint16_t>(0));// Disk number
+		LittleEndian::Append(directory, static_cast<std::uint16_t>(0));// Internal attributes
+		LittleEndian::Append(directory, static_cast<std::uint32_t>(0));// External attributes
+		LittleEndian::Append(directory, entry.offset);
+		directory.append(entry.name);
+	}
+
+	if (position + directory.size() + 22 > zipLimit)
+	{
+		errorString = "Data is too large for the .npz format; use the .ppc format instead.";
+		return false;
+	}
+
+	const std::uint32_t directorySize(static_cast<std::uint32_t>(directory.size()));
+	LittleEndian::Append(directory, static_cast<std::uint32_t>(0x06054b50));
+	LittleEndian::Append(directory, static_cast<std::uint16_t>(0));
+	LittleEndian::Append(directory, static_cast<std::uint16_t>(0));
+	LittleEndian::Append(directory, static_cast<std::uint16_t>(entries.size()));
+	LittleEndian::Append(directory, static_cast<std::uint16_t>(entries.size()));
+	LittleEndian::Append(directory, directorySize);
+	LittleEndian::Append(directory, static_cast<std::uint32_t>(position));
+	LittleEndian::Append(directory, static_cast<std::uint16_t>(0));
+
+	file.write(directory.data(), directory.size());
+	bytesWritten = position + directory.size();
+	return true;
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		WriteColumnar
+//
+// Description:		Writes the memory-mappable columnar format described in
+//					binaryDataExporter.h.  Rows written counts the total number
+//					of points.
+//
+// Input Arguments:
+//		file	= std::ostream&
+//		source	= const CurveSource&
+//		labels	= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BinaryDataExporter::WriteColumnar(std::ostream& file, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	const std::uint64_t alignment(64);
+	auto align([alignment](const std::uint64_t& offset)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	});
+
+	const unsigned int curveCount(source.GetCurveCount());
+	const std::uint64_t headerSize(32);
+	const std::uint64_t directoryEntrySize(32);
+
+	std::string stringTable;
+	std::vector<std::uint32_t> labelOffsets(curveCount);
+	unsigned int i;
+	for (i = 0; i < curveCount; ++i)
+	{
+		labelOffsets[i] = static_cast<std::uint32_t>(stringTable.size());
+		stringTable.append(GetCurveName(labels, i));
+	}
+
+	const std::uint64_t stringTableOffset(headerSize + directoryEntrySize * curveCount);
+	const std::uint64_t dataOffset(align(stringTableOffset + stringTable.size()));
+
+	std::string directory;
+	std::vector<std::uint64_t> xOffsets(curveCount), yOffsets(curveCount);
+	std::uint64_t fileSize(dataOffset);
+	for (i = 0; i < curveCount; ++i)
+	{
+		const std::uint64_t pointCount(source.GetCurveSize(i));
+		xOffsets[i] = align(fileSize);
+		yOffsets[i] = align(xOffsets[i] + pointCount * sizeof(double));
+		fileSize = yOffsets[i] + pointCount * sizeof(double);
+
+		LittleEndian::Append(directory, pointCount);
+		LittleEndian::Append(directory, xOffsets[i]);
+		LittleEndian::Append(directory, yOffsets[i]);
+		LittleEndian::Append(directory, labelOffsets[i]);
+		LittleEndian::Append(directory, static_cast<std::uint32_t>(GetCurveName(labels, i).size()));
+	}
+
+	std::string header(columnarMagic, sizeof(columnarMagic));
+	LittleEndian::Append(header, columnarVersion);
+	LittleEndian::Append(header, static_cast<std::uint32_t>(curveCount));
+	LittleEndian::Append(header, fileSize);
+	LittleEndian::Append(header, stringTableOffset);
+	header.append(directory);
+	header.append(stringTable);
+	header.resize(std::min(dataOffset, fileSize), '\0');
+	file.write(header.data(), header.size());
+
+	// Columns are written a block at a time, alternating between the x and y
+	// regions of each curve
+	std::vector<double> x(blockSize), y(blockSize);
+	const std::uint64_t totalPoints(GetTotalPointCount(source));
+	for (i = 0; i < curveCount; ++i)
+	{
+		const std::size_t curveSize(source.GetCurveSize(i));
+		for (std::size_t blockStart = 0; blockStart < curveSize; blockStart += blockSize)
+		{
+			const std::size_t count(std::min(blockSize, curveSize - blockStart));
+			source.ConvertCurve(i, blockStart, count, x.data(), y.data());
+			LittleEndian::Convert(x.data(), count);
+			LittleEndian::Convert(y.data(), count);
+
+			file.seekp(xOffsets[i] + blockStart * sizeof(double));
+			file.write(reinterpret_cast<const char*>(x.data()), count * sizeof(double));
+			file.seekp(yOffsets[i] + blockStart * sizeof(double));
+			file.write(reinterpret_cast<const char*>(y.data()), count * sizeof(double));
+			if (!ReportProgress(rowsWritten + blockStart + count, totalPoints))
+				return false;
+		}
+
+		rowsWritten += curveSize;
+	}
+
+	// Trailing empty curves leave alignment padding that no write has reached yet
+	file.seekp(0, std::ios::end);
+	if (static_cast<std::uint64_t>(file.tellp()) < fileSize)
+	{
+		file.seekp(fileSize - 1);
+		file.put('\0');
+	}
+
+	bytesWritten = fileSize;
+	return true;
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		BuildNumPyHeader
+//
+// Description:		Builds the .npy preamble and header dictionary, padded so the
+//					array data starts on a 64-byte boundary.  Falls back to
+//					version 2.0 for very long headers and 3.0 for non-ASCII
+//					field names.
+//
+// Input Arguments:
+//		descr	= const std::string&
+//		shape	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string BinaryDataExporter::BuildNumPyHeader(const std::string& descr, const std::string& shape)
+{
+	std::string dictionary("{'descr': " + descr + ", 'fortran_order': False, 'shape': " + shape + ", }");
+
+	const bool isAscii(std::all_of(dictionary.begin(), dictionary.end(),
+		[](const char& c) { return static_cast<unsigned char>(c) < 0x80; }));
+	unsigned char majorVersion(isAscii ? 1 : 3);
+	if (majorVersion == 1 && dictionary.size() + 11 + 64 > 0xFFFF)
+		majorVersion = 2;
+
+	const std::size_t preambleSize(majorVersion == 1 ? 10 : 12);
+	const std::size_t alignment(64);
+	const std::size_t totalSize((preambleSize + dictionary.size() + 1 + alignment - 1) / alignment * alignment);
+	dictionary.append(totalSize - preambleSize - dictionary.size() - 1, ' ');
+	dictionary.push_back('\n');
+
+	std::string header("\x93NUMPY");
+	header.push_back(static_cast<char>(majorVersion));
+	header.push_back('\0');
+	if (majorVersion == 1)
+		LittleEndian::Append(header, static_cast<std::uint16_t>(dictionary.size()));
+	else
+		LittleEndian::Append(header, static_cast<std::uint32_t>(dictionary.size()));
+
+	return header + dictionary;
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		GetNumPyTypeString
+//
+// Description:		Returns the NumPy type string for doubles in host byte order.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string BinaryDataExporter::GetNumPyTypeString()
+{
+	if (LittleEndian::HostIsLittleEndian())
+		return "<f8";
+	return ">f8";
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		QuotePythonString
+//
+// Description:		Returns the string as a single-quoted Python literal.
+//
+// Input Arguments:
+//		s	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string BinaryDataExporter::QuotePythonString(const std::string& s)
+{
+	std::string quoted("'");
+	for (const auto& c : s)
+	{
+		if (c == '\\' || c == '\'')
+			quoted.push_back('\\');
+		quoted.push_back(c);
+	}
+	quoted.push_back('\'');
+
+	return quoted;
+}
+
+//==========================================================================
+// Class:			BinaryDataExporter
+// Function:		GetCurveName
+//
+// Description:		Returns the label for the specified curve, or a default name
+//					if no label was given.
+//
+// Input Arguments:
+//		labels	= const std::vector<std::string>&
+//		i		= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string BinaryDataExporter::GetCurveName(const std::vector<std::string>& labels, const unsigned int& i)
+{
+	if (i >= labels.size() || labels[i].empty())
+		return "Curve" + std::to_string(i);
+	return labels[i];
+}
@@ -0,0 +1,93 @@
+// File:  binaryDataExporter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Writer for binary files containing converted curve data.
+//
+//        Three formats are supported:
+//
+//        NumPy (.npy) - A one-dimensional structured array with one float64 field
+//        per column ("<label> X", "<label> Y", ...), so the labels travel in
+//        the array header.  Curves are lined up by point index and short
+//        curves are padded.  When the source has bootstrap results, each curve
+//        also gets "<label> X SD" and "<label> Y SD" fields.
+//
+//        NumPy archive (.npz) - An uncompressed zip archive holding one (n, 2)
+//        float64 array per curve, named after the curve label.
+//
+//        PointPicker columns (.ppc) - A flat little-endian file intended to be
+//        memory-mapped.  Offsets are from the start of the file:
+//
+//          offset  size    contents
+//          0       8       magic "PPCURVES"
+//          8       4       uint32 format version (currently 1)
+//          12      4       uint32 curve count N
+//          16      8       uint64 total file size
+//          24      8       uint64 offset of the label string table
+//          32      32*N    curve directory, one entry per curve:
+//                            uint64 point count
+//                            uint64 offset of x column
+//                            uint64 offset of y column
+//                            uint32 label offset within the string table
+//                            uint32 label length in bytes (UTF-8, not terminated)
+//          ...             label string table
+//          ...             x and y columns of float64 values, each column starting
+//                          on a 64-byte boundary
+
+#ifndef BINARY_DATA_EXPORTER_H_
+#define BINARY_DATA_EXPORTER_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+// Local headers
+#include "dataExporter.h"
+#include "curveSource.h"
+
+class BinaryDataExporter : public DataExporter
+{
+public:
+	enum class Format
+	{
+		NumPy,
+		NumPyArchive,
+		Columnar
+	};
+
+	BinaryDataExporter(const Format& format, const double& padValue);
+
+	bool Export(const std::string& fileName, const CurveSource& source,
+		const std::vector<std::string>& labels) override;
+
+	// Writes to an already-open stream; the archive and columnar formats seek
+	// while writing, so only NumPy output may go to a non-seekable stream
+	bool Write(std::ostream& stream, const CurveSource& source,
+		const std::vector<std::string>& labels);
+
+	static const char columnarMagic[8];
+	static const std::uint32_t columnarVersion;
+
+	static std::string BuildNumPyHeader(const std::string& descr, const std::string& shape);
+	static std::string GetNumPyTypeString();
+	static std::string QuotePythonString(const std::string& s);
+
+private:
+	const Format format;
+	const double padValue;
+
+	bool WriteNumPy(std::ostream& file, const CurveSource& source,
+		const std::vector<std::string>& labels);
+	bool WriteNumPyArchive(std::ostream& file, const CurveSource& source,
+		const std::vector<std::string>& labels);
+	bool WriteColumnar(std::ostream& file, const CurveSource& source,
+		const std::vector<std::string>& labels);
+
+	static std::string GetCurveName(const std::vector<std::string>& labels, const unsigned int& i);
+
+	// Number of points converted at a time
+	static constexpr std::size_t blockSize = 8192;
+};
+
+#endif// BINARY_DATA_EXPORTER_H_
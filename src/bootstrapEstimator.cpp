@@ -0,0 +1,163 @@
+// File:  bootstrapEstimator.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Bootstrap estimate of the transformation uncertainty.
+
+// Standard C++ headers
+#include <random>
+#include <algorithm>
+
+// Local headers
+#include "bootstrapEstimator.h"
+#include "threadPool.h"
+
+//==========================================================================
+// Class:			BootstrapEstimator
+// Function:		FitReplicates
+//
+// Description:		Fits the transformation to resampled sets of references.
+//					Each replicate's sample depends only on its index, so the
+//					result does not depend on the number of threads.
+//
+// Input Arguments:
+//		pairs	= const std::vector<PointPicker::ReferencePair>&
+//		fit		= const PointPicker::Transformation&, fit to all of the references
+//		count	= const unsigned int&
+//		pool	= ThreadPool*, may be null to run on the calling thread
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<PointPicker::Transformation>
+//
+//==========================================================================
+std::vector<PointPicker::Transformation> BootstrapEstimator::FitReplicates(
+	const std::vector<PointPicker::ReferencePair>& pairs,
+	const PointPicker::Transformation& fit, const unsigned int& count, ThreadPool* pool)
+{
+	std::vector<PointPicker::Transformation> replicates(count);
+	std::vector<char> valid(count, 0);
+
+	auto fitRange([&pairs, &fit, &replicates, &valid](const unsigned int& first, const unsigned int& last)
+	{
+		unsigned int i;
+		for (i = first; i < last; ++i)
+			valid[i] = FitReplicate(pairs, fit, i, replicates[i]);
+	});
+
+	if (pool && pool->GetThreadCount() > 1)
+	{
+		unsigned int first;
+		for (first = 0; first < count; first += replicatesPerTask)
+		{
+			const unsigned int last(std::min(first + replicatesPerTask, count));
+			pool->Submit([&fitRange, first, last]()
+			{
+				fitRange(first, last);
+			});
+		}
+		pool->WaitIdle();
+	}
+	else
+		fitRange(0, count);
+
+	std::size_t kept(0);
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+	{
+		if (!valid[i])
+			continue;
+		if (kept != i)
+			replicates[kept] = std::move(replicates[i]);
+		++kept;
+	}
+	replicates.resize(kept);
+
+	return replicates;
+}
+
+//==========================================================================
+// Class:			BootstrapEstimator
+// Function:		FitReplicate
+//
+// Description:		Draws and fits one replicate.  Only the spread of the
+//					transformation is wanted, so the model (axis scales and
+//					distortion) is the one chosen for all of the references.
+//
+// Input Arguments:
+//		pairs		= const std::vector<PointPicker::ReferencePair>&
+//		fit			= const PointPicker::Transformation&
+//		index		= const unsigned int&
+//
+// Output Arguments:
+//		replicate	= PointPicker::Transformation&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BootstrapEstimator::FitReplicate(const std::vector<PointPicker::ReferencePair>& pairs,
+	const PointPicker::Transformation& fit, const unsigned int& index,
+	PointPicker::Transformation& replicate)
+{
+	std::vector<PointPicker::ReferencePair> sample;
+	if (!DrawReplicate(pairs, index, sample))
+		return false;
+
+	if (!PointPicker::FitScales(sample, fit.xScale, fit.yScale, fit.distortion.GetType(), replicate))
+		return false;
+	return replicate.matrix.allFinite();
+}
+
+//==========================================================================
+// Class:			BootstrapEstimator
+// Function:		DrawReplicate
+//
+// Description:		Draws as many references as there are in the original set,
+//					with replacement.  Samples with fewer than four distinct
+//					references can't be fit and are drawn again.
+//
+// Input Arguments:
+//		pairs	= const std::vector<PointPicker::ReferencePair>&
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		sample	= std::vector<PointPicker::ReferencePair>&
+//
+// Return Value:
+//		bool, false if no usable sample was drawn
+//
+//==========================================================================
+bool BootstrapEstimator::DrawReplicate(const std::vector<PointPicker::ReferencePair>& pairs,
+	const unsigned int& index, std::vector<PointPicker::ReferencePair>& sample)
+{
+	std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(index)};
+	std::mt19937 generator(sequence);
+	std::uniform_int_distribution<std::size_t> distribution(0, pairs.size() - 1);
+	std::vector<unsigned int> draws(pairs.size());
+
+	unsigned int attempt;
+	for (attempt = 0; attempt < maxDrawAttempts; ++attempt)
+	{
+		std::fill(draws.begin(), draws.end(), 0);
+		std::size_t i;
+		for (i = 0; i < pairs.size(); ++i)
+			++draws[distribution(generator)];
+
+		sample.clear();
+		for (i = 0; i < pairs.size(); ++i)
+		{
+			if (draws[i] == 0)
+				continue;
+
+			sample.push_back(pairs[i]);
+			sample.back().weight *= draws[i];
+		}
+
+		if (sample.size() >= 4)
+			return true;
+	}
+
+	return false;
+}
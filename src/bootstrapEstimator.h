@@ -0,0 +1,49 @@
+// File:  bootstrapEstimator.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Bootstrap estimate of the transformation uncertainty.  The
+//        transformation is refit to many sets of references drawn (with
+//        replacement) from the originals; the spread of the converted curve
+//        points across these replicates gives their standard deviations.
+//        Resampling is expressed through the reference weights, so a reference
+//        drawn twice is fit once with twice the weight.
+
+#ifndef BOOTSTRAP_ESTIMATOR_H_
+#define BOOTSTRAP_ESTIMATOR_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstdint>
+
+// Local headers
+#include "pointPicker.h"
+
+// Local forward declarations
+class ThreadPool;
+
+class BootstrapEstimator
+{
+public:
+	// Fits the specified number of replicates with the axis scales and
+	// distortion model of the fit to all of the references (these are never
+	// chosen again for a replicate).  When a pool is given, the fits are
+	// spread over its threads; the pool must not be busy with other work,
+	// since this waits for it to go idle.  Replicates that can't be fit are
+	// left out.
+	static std::vector<PointPicker::Transformation> FitReplicates(
+		const std::vector<PointPicker::ReferencePair>& pairs,
+		const PointPicker::Transformation& fit, const unsigned int& count, ThreadPool* pool);
+
+private:
+	static constexpr unsigned int replicatesPerTask = 8;
+	static constexpr unsigned int maxDrawAttempts = 20;
+	static constexpr std::uint64_t seed = 1;
+
+	static bool DrawReplicate(const std::vector<PointPicker::ReferencePair>& pairs,
+		const unsigned int& index, std::vector<PointPicker::ReferencePair>& sample);
+	static bool FitReplicate(const std::vector<PointPicker::ReferencePair>& pairs,
+		const PointPicker::Transformation& fit, const unsigned int& index,
+		PointPicker::Transformation& replicate);
+};
+
+#endif// BOOTSTRAP_ESTIMATOR_H_
@@ -0,0 +1,214 @@
+// File:  bufferedWriter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Output stream wrapper that collects text in a large user-space buffer
+//        and formats numbers without going through iostreams.
+
+// Standard C++ headers
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+// Local headers
+#include "bufferedWriter.h"
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		BufferedWriter
+//
+// Description:		Constructor for BufferedWriter class.
+//
+// Input Arguments:
+//		stream		= std::ostream&, opened in binary mode
+//		bufferSize	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BufferedWriter::BufferedWriter(std::ostream& stream, const std::size_t& bufferSize)
+	: stream(stream), buffer(std::max(bufferSize, maxNumberLength)), used(0), bytesWritten(0)
+{
+}
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		~BufferedWriter
+//
+// Description:		Destructor for BufferedWriter class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BufferedWriter::~BufferedWriter()
+{
+	Flush();
+}
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		Write
+//
+// Description:		Appends the specified characters to the buffer.
+//
+// Input Arguments:
+//		s		= const char*
+//		length	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BufferedWriter::Write(const char* s, const std::size_t& length)
+{
+	if (used + length > buffer.size())
+	{
+		Flush();
+
+		// Large blocks bypass the buffer entirely
+		if (length > buffer.size())
+		{
+			stream.write(s, length);
+			bytesWritten += length;
+			return;
+		}
+	}
+
+	std::memcpy(buffer.data() + used, s, length);
+	used += length;
+}
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		Write
+//
+// Description:		Appends the specified character to the buffer.
+//
+// Input Arguments:
+//		c	= const char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BufferedWriter::Write(const char& c)
+{
+	if (used == buffer.size())
+		Flush();
+
+	buffer[used++] = c;
+}
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		Write
+//
+// Description:		Formats the specified value directly into the buffer.
+//
+// Input Arguments:
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BufferedWriter::Write(const double& value)
+{
+	if (used + maxNumberLength > buffer.size())
+		Flush();
+
+	char* start(buffer.data() + used);
+	used += FormatNumber(start, value) - start;
+}
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		FormatNumber
+//
+// Description:		Formats the value using the shortest round-trip representation.
+//					Non-finite values are written as NaN, Inf or -Inf so they match
+//					the text used for padding.
+//
+// Input Arguments:
+//		s		= char*, must have room for maxNumberLength characters
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		char*, one past the last character written
+//
+//==========================================================================
+char* BufferedWriter::FormatNumber(char* s, const double& value)
+{
+	if (std::isnan(value))
+	{
+		std::memcpy(s, "NaN", 3);
+		return s + 3;
+	}
+	else if (std::isinf(value))
+	{
+		if (value < 0.0)
+		{
+			std::memcpy(s, "-Inf", 4);
+			return s + 4;
+		}
+
+		std::memcpy(s, "Inf", 3);
+		return s + 3;
+	}
+
+	const std::to_chars_result result(std::to_chars(s, s + maxNumberLength, value));
+	assert(result.ec == std::errc());
+	return result.ptr;
+}
+
+//==========================================================================
+// Class:			BufferedWriter
+// Function:		Flush
+//
+// Description:		Writes the contents of the buffer to the stream.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the stream is still good
+//
+//==========================================================================
+bool BufferedWriter::Flush()
+{
+	if (used > 0)
+	{
+		stream.write(buffer.data(), used);
+		bytesWritten += used;
+		used = 0;
+	}
+
+	return stream.good();
+}
@@ -0,0 +1,48 @@
+// File:  bufferedWriter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Output stream wrapper that collects text in a large user-space buffer
+//        and formats numbers without going through iostreams.
+
+#ifndef BUFFERED_WRITER_H_
+#define BUFFERED_WRITER_H_
+
+// Standard C++ headers
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class BufferedWriter
+{
+public:
+	explicit BufferedWriter(std::ostream& stream, const std::size_t& bufferSize = defaultBufferSize);
+	~BufferedWriter();
+
+	void Write(const char* s, const std::size_t& length);
+	void Write(const std::string& s) { Write(s.data(), s.length()); }
+	void Write(const char& c);
+	void Write(const double& value);
+
+	bool Flush();
+
+	std::uint64_t GetBytesWritten() const { return bytesWritten + used; }
+
+	static constexpr std::size_t defaultBufferSize = 1 << 20;
+
+	// Largest number of characters produced by Write(const double&)
+	static constexpr std::size_t maxNumberLength = 32;
+
+	// Formats value into the buffer starting at s using the shortest representation
+	// that round-trips; returns pointer to one past the last character written
+	static char* FormatNumber(char* s, const double& value);
+
+private:
+	std::ostream& stream;
+	std::vector<char> buffer;
+	std::size_t used;
+	std::uint64_t bytesWritten;
+};
+
+#endif// BUFFERED_WRITER_H_
@@ -0,0 +1,300 @@
+// File:  calibrationGrid.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Axis grid lines and tick labels computed from fitted transformations.
+
+// Standard C++ headers
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+
+// Local headers
+#include "calibrationGrid.h"
+
+//==========================================================================
+// Class:			CalibrationGrid
+// Function:		Add
+//
+// Description:		Adds grid lines and labels for the specified transformation.
+//					The plot range is found by converting a lattice of points
+//					over the bounds.
+//
+// Input Arguments:
+//		transformation	= const PointPicker::Transformation&, must be fit
+//		bounds			= const RegionIndex::Bounds&, image coordinates
+//		contains		= const Membership&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CalibrationGrid::Add(const PointPicker::Transformation& transformation,
+	const RegionIndex::Bounds& bounds, const Membership& contains)
+{
+	std::vector<PointPicker::Point> samples;
+	samples.reserve(rangeSamples * rangeSamples);
+	unsigned int i, j;
+	for (i = 0; i < rangeSamples; ++i)
+	{
+		for (j = 0; j < rangeSamples; ++j)
+		{
+			const PointPicker::Point point(
+				bounds.xMin + (bounds.xMax - bounds.xMin) * i / (rangeSamples - 1),
+				bounds.yMin + (bounds.yMax - bounds.yMin) * j / (rangeSamples - 1));
+			if (contains(point))
+				samples.push_back(point);
+		}
+	}
+
+	std::vector<double> x(samples.size()), y(samples.size());
+	PointPicker::Convert(transformation, samples.data(), samples.size(), x.data(), y.data());
+
+	double xMin(std::numeric_limits<double>::max()), xMax(-xMin);
+	double yMin(xMin), yMax(-xMin);
+	std::size_t k;
+	for (k = 0; k < samples.size(); ++k)
+	{
+		if (!AxisScale::IsValid(transformation.xScale, x[k]) || !AxisScale::IsValid(transformation.yScale, y[k]))
+			continue;
+
+		xMin = std::min(xMin, x[k]);
+		xMax = std::max(xMax, x[k]);
+		yMin = std::min(yMin, y[k]);
+		yMax = std::max(yMax, y[k]);
+	}
+
+	if (xMin >= xMax || yMin >= yMax)
+		return;
+
+	for (const auto& value : ComputeTicks(transformation.xScale, xMin, xMax))
+		AddLine(transformation, true, value, yMin, yMax, transformation.yScale, contains);
+	for (const auto& value : ComputeTicks(transformation.yScale, yMin, yMax))
+		AddLine(transformation, false, value, xMin, xMax, transformation.xScale, contains);
+}
+
+//==========================================================================
+// Class:			CalibrationGrid
+// Function:		AddLine
+//
+// Description:		Adds the line along which one coordinate has the specified
+//					value.  Points are spaced evenly in the other axis' linear
+//					space, so log axes are sampled per decade rather than
+//					bunched at one end.
+//
+// Input Arguments:
+//		transformation	= const PointPicker::Transformation&
+//		isX				= const bool&, true if value is an x value
+//		value			= const double&
+//		minimum			= const double&, range of the other coordinate
+//		maximum			= const double&
+//		otherScale		= const AxisScale::Type&
+//		contains		= const Membership&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CalibrationGrid::AddLine(const PointPicker::Transformation& transformation, const bool& isX,
+	const double& value, const double& minimum, const double& maximum,
+	const AxisScale::Type& otherScale, const Membership& contains)
+{
+	const double start(AxisScale::Forward(otherScale, minimum));
+	const double end(AxisScale::Forward(otherScale, maximum));
+
+	std::vector<double> fixed(lineSamples, value), along(lineSamples);
+	unsigned int i;
+	for (i = 0; i < lineSamples; ++i)
+		along[i] = AxisScale::Inverse(otherScale, start + (end - start) * i / (lineSamples - 1));
+
+	std::vector<PointPicker::Point> points(lineSamples);
+	if (isX)
+		PointPicker::Invert(transformation, lineSamples, fixed.data(), along.data(), points.data());
+	else
+		PointPicker::Invert(transformation, lineSamples, along.data(), fixed.data(), points.data());
+
+	// Split into pieces wherever the line leaves the area
+	const std::size_t firstLine(lines.size());
+	bool inPiece(false);
+	for (i = 0; i < lineSamples; ++i)
+	{
+		if (!std::isfinite(points[i].x) || !contains(points[i]))
+		{
+			inPiece = false;
+			continue;
+		}
+
+		if (!inPiece)
+			lines.push_back(std::vector<PointPicker::Point>());
+		lines.back().push_back(points[i]);
+		inPiece = true;
+	}
+
+	// Single points aren't drawable
+	lines.erase(std::remove_if(lines.begin() + firstLine, lines.end(), [](const std::vector<PointPicker::Point>& line)
+	{
+		return line.size() < 2;
+	}), lines.end());
+
+	if (lines.size() == firstLine)
+		return;
+
+	// Labels go where the line is lowest (x values) or leftmost (y values) in
+	// the image, which is where the plot's own tick labels usually are
+	Label label;
+	label.isX = isX;
+	label.text = FormatTick(value);
+	label.position = lines[firstLine].front();
+	std::size_t j;
+	for (j = firstLine; j < lines.size(); ++j)
+	{
+		for (const auto& point : lines[j])
+		{
+			if ((isX && point.y > label.position.y) || (!isX && point.x < label.position.x))
+				label.position = point;
+		}
+	}
+
+	labels.push_back(label);
+}
+
+//==========================================================================
+// Class:			CalibrationGrid
+// Function:		ComputeTicks
+//
+// Description:		Chooses tick values for an axis.  Log axes get decades (with
+//					2 and 5 between them when there are only a few), and
+//					probability axes get the usual percentiles; other scales
+//					(or log axes spanning less than a decade) get round numbers.
+//
+// Input Arguments:
+//		scale	= const AxisScale::Type&
+//		minimum	= const double&
+//		maximum	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<double>, ascending
+//
+//==========================================================================
+std::vector<double> CalibrationGrid::ComputeTicks(const AxisScale::Type& scale,
+	const double& minimum, const double& maximum)
+{
+	std::vector<double> ticks;
+	if (scale == AxisScale::Type::Logarithmic && minimum > 0.0)
+	{
+		const int first(static_cast<int>(std::floor(std::log10(minimum))));
+		const int last(static_cast<int>(std::ceil(std::log10(maximum))));
+		if (last - first >= 2)
+		{
+			const double multiples[] = { 1.0, 2.0, 5.0 };
+			const unsigned int multipleCount(last - first <= 3 ? 3 : 1);
+			int decade;
+			for (decade = first; decade <= last; ++decade)
+			{
+				unsigned int i;
+				for (i = 0; i < multipleCount; ++i)
+				{
+					const double value(multiples[i] * std::pow(10.0, decade));
+					if (value >= minimum && value <= maximum)
+						ticks.push_back(value);
+				}
+			}
+
+			return ticks;
+		}
+	}
+	else if (scale == AxisScale::Type::Probability)
+	{
+		const double percentiles[] = { 0.001, 0.01, 0.05, 0.1, 0.2, 0.3, 0.4, 0.5,
+			0.6, 0.7, 0.8, 0.9, 0.95, 0.99, 0.999 };
+		for (const auto& value : percentiles)
+		{
+			if (value >= minimum && value <= maximum)
+				ticks.push_back(value);
+		}
+
+		return ticks;
+	}
+
+	return ComputeLinearTicks(minimum, maximum);
+}
+
+//==========================================================================
+// Class:			CalibrationGrid
+// Function:		ComputeLinearTicks
+//
+// Description:		Chooses evenly spaced round tick values (steps of 1, 2 or 5
+//					times a power of ten).
+//
+// Input Arguments:
+//		minimum	= const double&
+//		maximum	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<double>, ascending
+//
+//==========================================================================
+std::vector<double> CalibrationGrid::ComputeLinearTicks(const double& minimum, const double& maximum)
+{
+	std::vector<double> ticks;
+	const double range(maximum - minimum);
+	if (!(range > 0.0) || !std::isfinite(range))
+		return ticks;
+
+	const double roughStep(range / targetTickCount);
+	const double magnitude(std::pow(10.0, std::floor(std::log10(roughStep))));
+	const double normalized(roughStep / magnitude);
+	double step;
+	if (normalized < 1.5)
+		step = magnitude;
+	else if (normalized < 3.0)
+		step = 2.0 * magnitude;
+	else if (normalized < 7.0)
+		step = 5.0 * magnitude;
+	else
+		step = 10.0 * magnitude;
+
+	const double first(std::ceil(minimum / step));
+	const double last(std::floor(maximum / step));
+	double k;
+	for (k = first; k <= last; ++k)
+		ticks.push_back(k == 0.0 ? 0.0 : k * step);// Not -0
+
+	return ticks;
+}
+
+//==========================================================================
+// Class:			CalibrationGrid
+// Function:		FormatTick
+//
+// Description:		Formats a tick value for display.  Six significant digits
+//					hide the rounding error in k * step.
+//
+// Input Arguments:
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string CalibrationGrid::FormatTick(const double& value)
+{
+	char s[32];
+	std::snprintf(s, sizeof(s), "%g", value);
+	return s;
+}
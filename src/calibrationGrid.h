@@ -0,0 +1,63 @@
+// File:  calibrationGrid.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Axis grid lines and tick labels computed from fitted transformations,
+//        in image coordinates, for drawing over the image as a check on the
+//        calibration.  Ticks are chosen in plot space for the visible range
+//        of each region and mapped back through the inverse transformation,
+//        so a bad fit shows up as a grid that doesn't line up with the plot.
+
+#ifndef CALIBRATION_GRID_H_
+#define CALIBRATION_GRID_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <functional>
+
+// Local headers
+#include "pointPicker.h"
+#include "regionIndex.h"
+#include "axisScale.h"
+
+class CalibrationGrid
+{
+public:
+	// Adds the grid for one transformation over the specified part of the
+	// image; lines are cut wherever contains() is false (i.e. where another
+	// region or panel takes over)
+	typedef std::function<bool(const PointPicker::Point&)> Membership;
+	void Add(const PointPicker::Transformation& transformation, const RegionIndex::Bounds& bounds,
+		const Membership& contains);
+
+	struct Label
+	{
+		PointPicker::Point position;// Image coordinates of the end of the line
+		std::string text;
+		bool isX;// Labels an x value (at the bottom of a vertical-ish line)
+	};
+
+	// Polylines in image coordinates
+	const std::vector<std::vector<PointPicker::Point>>& GetLines() const { return lines; }
+	const std::vector<Label>& GetLabels() const { return labels; }
+
+	// Tick values for the specified range of an axis
+	static std::vector<double> ComputeTicks(const AxisScale::Type& scale, const double& minimum,
+		const double& maximum);
+
+private:
+	std::vector<std::vector<PointPicker::Point>> lines;
+	std::vector<Label> labels;
+
+	static constexpr unsigned int rangeSamples = 24;// Per side, for finding the visible range
+	static constexpr unsigned int lineSamples = 64;// Per line (lines curve with distortion)
+	static constexpr unsigned int targetTickCount = 6;
+
+	void AddLine(const PointPicker::Transformation& transformation, const bool& isX, const double& value,
+		const double& minimum, const double& maximum, const AxisScale::Type& otherScale, const Membership& contains);
+
+	static std::vector<double> ComputeLinearTicks(const double& minimum, const double& maximum);
+	static std::string FormatTick(const double& value);
+};
+
+#endif// CALIBRATION_GRID_H_
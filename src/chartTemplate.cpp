@@ -0,0 +1,536 @@
+// File:  chartTemplate.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Named, saved calibration for a chart layout.
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+// wxWidgets headers
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
+#include <wx/dir.h>
+
+// Local headers
+#include "chartTemplate.h"
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		ChartTemplate
+//
+// Description:		Constructor for ChartTemplate class.  Captures the picker's
+//					current calibration.
+//
+// Input Arguments:
+//		name			= const wxString&
+//		picker			= const PointPicker&
+//		imageWidth		= const unsigned int&, of the full image
+//		imageHeight		= const unsigned int&, of the full image
+//		alignmentImage	= const ImagePyramid::Level&, coarse copy of the image
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ChartTemplate::ChartTemplate(const wxString& name, const PointPicker& picker, const unsigned int& imageWidth,
+	const unsigned int& imageHeight, const ImagePyramid::Level& alignmentImage) : name(name),
+	imageWidth(imageWidth), imageHeight(imageHeight), references(picker.GetReferencePairs()),
+	regions(picker.GetRegions()), fitOptions(picker.GetFitOptions()), alignmentImage(alignmentImage)
+{
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		GetDirectory
+//
+// Description:		Returns the folder where templates are kept.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString ChartTemplate::GetDirectory()
+{
+	return wxStandardPaths::Get().GetUserDataDir() + wxFileName::GetPathSeparator() + _T("templates");
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		GetNames
+//
+// Description:		Returns the names of the saved templates, sorted.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxArrayString
+//
+//==========================================================================
+wxArrayString ChartTemplate::GetNames()
+{
+	wxArrayString names;
+	if (!wxDir::Exists(GetDirectory()))
+		return names;
+
+	wxArrayString files;
+	wxDir::GetAllFiles(GetDirectory(), &files, _T("*.ppt"), wxDIR_FILES);
+	for (const auto& f : files)
+		names.Add(wxFileName(f).GetName());
+	names.Sort();
+
+	return names;
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		IsValidName
+//
+// Description:		Checks that the name can be used as a file name.
+//
+// Input Arguments:
+//		name	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool ChartTemplate::IsValidName(const wxString& name)
+{
+	if (name.IsEmpty() || name.Strip(wxString::both) != name || name.StartsWith(_T(".")))
+		return false;
+
+	const wxString forbidden(wxFileName::GetForbiddenChars() + wxFileName::GetPathSeparators());
+	return name.find_first_of(forbidden) == wxString::npos;
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		GetFileName
+//
+// Description:		Returns the full path to one of the template's files.
+//
+// Input Arguments:
+//		templateName	= const wxString&
+//		extension		= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString ChartTemplate::GetFileName(const wxString& templateName, const wxString& extension)
+{
+	return wxFileName(GetDirectory(), templateName, extension).GetFullPath();
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		Save
+//
+// Description:		Writes the template to the template directory, replacing
+//					any existing template with the same name.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::Save() const
+{
+	if (!IsValidName(name))
+	{
+		errorString = _T("'") + name + _T("' is not a valid template name.");
+		return false;
+	}
+
+	if (!wxFileName::Mkdir(GetDirectory(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+	{
+		errorString = _T("Failed to create '") + GetDirectory() + _T("'.");
+		return false;
+	}
+
+	if (!WriteImage(GetFileName(name, _T("pgm")).ToStdString(), alignmentImage) ||
+		!WriteCalibration(GetFileName(name, _T("ppt")).ToStdString()))
+	{
+		errorString = _T("Failed to write template '") + name + _T("'.");
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		Load
+//
+// Description:		Reads the named template from the template directory.
+//
+// Input Arguments:
+//		templateName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::Load(const wxString& templateName)
+{
+	name = templateName;
+	if (!ReadCalibration(GetFileName(name, _T("ppt")).ToStdString()))
+	{
+		if (errorString.IsEmpty())
+			errorString = _T("Failed to read template '") + name + _T("'.");
+		return false;
+	}
+
+	// Without its image, the template still works; it just can't be aligned
+	if (!ReadImage(GetFileName(name, _T("pgm")).ToStdString(), alignmentImage))
+		alignmentImage = ImagePyramid::Level();
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		Delete
+//
+// Description:		Removes the named template's files.
+//
+// Input Arguments:
+//		templateName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::Delete(const wxString& templateName)
+{
+	const wxString imageFileName(GetFileName(templateName, _T("pgm")));
+	if (wxFileExists(imageFileName))
+		wxRemoveFile(imageFileName);
+	return wxRemoveFile(GetFileName(templateName, _T("ppt")));
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		Apply
+//
+// Description:		Replaces the picker's calibration with the template's.  The
+//					references and regions are moved by the offset found by
+//					phase correlation (if requested and the match is good), and
+//					scaled if the image size differs from the template's.
+//
+// Input Arguments:
+//		picker	= PointPicker&
+//		width	= const unsigned int&, of the full image
+//		height	= const unsigned int&, of the full image
+//		image	= const ImagePyramid::Level&, coarse copy of the image
+//		align	= const bool&
+//
+// Output Arguments:
+//		picker	= PointPicker&
+//
+// Return Value:
+//		Alignment
+//
+//==========================================================================
+ChartTemplate::Alignment ChartTemplate::Apply(PointPicker& picker, const unsigned int& width,
+	const unsigned int& height, const ImagePyramid::Level& image, const bool& align) const
+{
+	Alignment alignment;
+	if (align && alignmentImage.width > 0 && ImagePyramid::PhaseCorrelate(alignmentImage, image,
+		alignment.dx, alignment.dy, alignment.peak) && alignment.peak >= minimumPeak)
+	{
+		// From alignment image pixels to template pixels
+		alignment.dx *= static_cast<double>(imageWidth) / alignmentImage.width;
+		alignment.dy *= static_cast<double>(imageHeight) / alignmentImage.height;
+		alignment.aligned = true;
+	}
+	else
+	{
+		alignment.dx = 0.0;
+		alignment.dy = 0.0;
+	}
+
+	const double xScale(imageWidth > 0 ? static_cast<double>(width) / imageWidth : 1.0);
+	const double yScale(imageHeight > 0 ? static_cast<double>(height) / imageHeight : 1.0);
+	auto move([&](const double& x, const double& y)
+	{
+		return PointPicker::Point((x + alignment.dx) * xScale, (y + alignment.dy) * yScale);
+	});
+
+	std::vector<PointPicker::ReferencePair> movedReferences(references);
+	for (auto& r : movedReferences)
+		r.imageCoords = move(r.imageCoords.x, r.imageCoords.y);
+
+	std::vector<RegionIndex::Bounds> movedRegions;
+	for (const auto& r : regions)
+	{
+		const PointPicker::Point minimum(move(r.xMin, r.yMin)), maximum(move(r.xMax, r.yMax));
+		movedRegions.push_back(RegionIndex::Bounds(minimum.x, minimum.y, maximum.x, maximum.y));
+	}
+
+	picker.SetCalibration(movedReferences, movedRegions, fitOptions);
+
+	alignment.dx *= xScale;
+	alignment.dy *= yScale;
+	return alignment;
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		WriteCalibration
+//
+// Description:		Writes the calibration file.  Commands are similar to those
+//					of service requests:
+//
+//					  SIZE <width> <height>
+//					  MODEL <distortion model index>
+//					  SCALES <x scale names> <y scale names>
+//					  ROBUST <threshold>
+//					  BOOTSTRAP <replicates>
+//					  REGION <x1> <y1> <x2> <y2>
+//					  REF <px> <py> <x> <y> <weight>
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::WriteCalibration(const std::string& fileName) const
+{
+	std::ofstream file(fileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	file << std::setprecision(17);
+	file << "# PointPicker chart template\n";
+	file << "SIZE " << imageWidth << ' ' << imageHeight << '\n';
+	file << "MODEL " << static_cast<int>(fitOptions.distortion) << '\n';
+	if (fitOptions.xScales != AxisScale::defaultMask || fitOptions.yScales != AxisScale::defaultMask)
+		file << "SCALES " << AxisScale::GetMaskNames(fitOptions.xScales) << ' '
+			<< AxisScale::GetMaskNames(fitOptions.yScales) << '\n';
+	if (fitOptions.robust)
+		file << "ROBUST " << fitOptions.inlierThreshold << '\n';
+	if (fitOptions.bootstrapReplicates > 0)
+		file << "BOOTSTRAP " << fitOptions.bootstrapReplicates << '\n';
+
+	for (const auto& r : regions)
+		file << "REGION " << r.xMin << ' ' << r.yMin << ' ' << r.xMax << ' ' << r.yMax << '\n';
+
+	for (const auto& r : references)
+		file << "REF " << r.imageCoords.x << ' ' << r.imageCoords.y << ' '
+			<< r.valueCoords.x << ' ' << r.valueCoords.y << ' ' << r.weight << '\n';
+
+	return file.good();
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		ReadCalibration
+//
+// Description:		Reads the calibration file.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::ReadCalibration(const std::string& fileName)
+{
+	errorString.Clear();
+	std::ifstream file(fileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	imageWidth = 0;
+	imageHeight = 0;
+	references.clear();
+	regions.clear();
+	fitOptions = PointPicker::FitOptions();
+
+	std::string line;
+	unsigned int lineNumber(0);
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream ss(line);
+		std::string command;
+		ss >> command;
+
+		bool ok(true);
+		if (command == "SIZE")
+			ok = static_cast<bool>(ss >> imageWidth >> imageHeight);
+		else if (command == "MODEL")
+		{
+			int model;
+			ok = (ss >> model) && model >= 0 && model <= static_cast<int>(DistortionModel::Type::Radial);
+			if (ok)
+				fitOptions.distortion = static_cast<DistortionModel::Type>(model);
+		}
+		else if (command == "SCALES")
+		{
+			std::string xNames, yNames;
+			ok = (ss >> xNames >> yNames) && AxisScale::ParseMask(xNames, fitOptions.xScales) &&
+				AxisScale::ParseMask(yNames, fitOptions.yScales);
+		}
+		else if (command == "ROBUST")
+		{
+			fitOptions.robust = true;
+			ok = (ss >> fitOptions.inlierThreshold) && fitOptions.inlierThreshold > 0.0;
+		}
+		else if (command == "BOOTSTRAP")
+			ok = static_cast<bool>(ss >> fitOptions.bootstrapReplicates);
+		else if (command == "REGION")
+		{
+			double x1, y1, x2, y2;
+			ok = static_cast<bool>(ss >> x1 >> y1 >> x2 >> y2);
+			if (ok)
+				regions.push_back(RegionIndex::Bounds(x1, y1, x2, y2));
+		}
+		else if (command == "REF")
+		{
+			PointPicker::ReferencePair pair;
+			ok = (ss >> pair.imageCoords.x >> pair.imageCoords.y >> pair.valueCoords.x
+				>> pair.valueCoords.y >> pair.weight) && pair.weight > 0.0;
+			if (ok)
+				references.push_back(pair);
+		}
+		else
+			ok = false;
+
+		if (!ok)
+		{
+			errorString = wxString::Format(_T("Error reading template '%s' (line %u)."), name, lineNumber);
+			return false;
+		}
+	}
+
+	if (imageWidth == 0 || imageHeight == 0)
+	{
+		errorString = _T("Template '") + name + _T("' is missing its image size.");
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		WriteImage
+//
+// Description:		Writes the image as an 8-bit binary PGM file.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//		image		= const ImagePyramid::Level&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::WriteImage(const std::string& fileName, const ImagePyramid::Level& image)
+{
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	file << "P5\n" << image.width << ' ' << image.height << "\n255\n";
+	std::string bytes(image.pixels.size(), '\0');
+	std::size_t i;
+	for (i = 0; i < bytes.size(); ++i)
+		bytes[i] = static_cast<char>(static_cast<unsigned char>(
+			std::min(std::max(image.pixels[i], 0.0f), 1.0f) * 255.0f + 0.5f));
+	file.write(bytes.data(), bytes.size());
+
+	return file.good();
+}
+
+//==========================================================================
+// Class:			ChartTemplate
+// Function:		ReadImage
+//
+// Description:		Reads an 8-bit binary PGM file (as written by WriteImage).
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		image		= ImagePyramid::Level&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ChartTemplate::ReadImage(const std::string& fileName, ImagePyramid::Level& image)
+{
+	std::ifstream file(fileName.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	std::string magic;
+	unsigned int width, height, maxValue;
+	if (!(file >> magic >> width >> height >> maxValue) || magic != "P5" || maxValue != 255 ||
+		width == 0 || height == 0 || width > 4 * alignmentSize || height > 4 * alignmentSize)
+		return false;
+	file.get();// Single whitespace character ends the header
+
+	std::string bytes(static_cast<std::size_t>(width) * height, '\0');
+	if (!file.read(&bytes[0], bytes.size()))
+		return false;
+
+	image = ImagePyramid::Level(width, height);
+	std::size_t i;
+	for (i = 0; i < bytes.size(); ++i)
+		image.pixels[i] = static_cast<unsigned char>(bytes[i]) / 255.0f;
+
+	return true;
+}
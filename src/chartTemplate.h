@@ -0,0 +1,84 @@
+// File:  chartTemplate.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Named, saved calibration (references, regions and fit options) for
+//        a chart layout, so that images of the same layout don't need their
+//        references entered again.  A coarse copy of the image the template
+//        was made from is kept with it; applying the template to a new image
+//        phase correlates the two to correct for small offsets.
+//
+//        Templates are kept in the user data directory as two files, the
+//        calibration (<name>.ppt, text) and the alignment image (<name>.pgm).
+
+#ifndef CHART_TEMPLATE_H_
+#define CHART_TEMPLATE_H_
+
+// Standard C++ headers
+#include <vector>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "pointPicker.h"
+#include "imagePyramid.h"
+
+class ChartTemplate
+{
+public:
+	ChartTemplate() : imageWidth(0), imageHeight(0) {}
+	ChartTemplate(const wxString& name, const PointPicker& picker, const unsigned int& imageWidth,
+		const unsigned int& imageHeight, const ImagePyramid::Level& alignmentImage);
+
+	// Largest dimension of the alignment image
+	static constexpr unsigned int alignmentSize = 256;
+
+	// Correlation peaks below this are treated as a failure to align
+	static constexpr double minimumPeak = 0.1;
+
+	const wxString& GetName() const { return name; }
+
+	static wxString GetDirectory();
+	static wxArrayString GetNames();
+	static bool IsValidName(const wxString& name);
+
+	bool Save() const;
+	bool Load(const wxString& templateName);
+	static bool Delete(const wxString& templateName);
+
+	struct Alignment
+	{
+		Alignment() : aligned(false), dx(0.0), dy(0.0), peak(0.0) {}
+
+		bool aligned;
+		double dx, dy;// Offset applied to the references [image pixels]
+		double peak;
+	};
+
+	// Replaces the picker's calibration with the template's, moved to line up
+	// with the image (or scaled, if the image size is different)
+	Alignment Apply(PointPicker& picker, const unsigned int& width, const unsigned int& height,
+		const ImagePyramid::Level& image, const bool& align) const;
+
+	wxString GetErrorString() const { return errorString; }
+
+private:
+	wxString name;
+	unsigned int imageWidth;
+	unsigned int imageHeight;
+	std::vector<PointPicker::ReferencePair> references;
+	std::vector<RegionIndex::Bounds> regions;
+	PointPicker::FitOptions fitOptions;
+	ImagePyramid::Level alignmentImage;
+
+	mutable wxString errorString;
+
+	static wxString GetFileName(const wxString& templateName, const wxString& extension);
+
+	bool WriteCalibration(const std::string& fileName) const;
+	bool ReadCalibration(const std::string& fileName);
+	static bool WriteImage(const std::string& fileName, const ImagePyramid::Level& image);
+	static bool ReadImage(const std::string& fileName, ImagePyramid::Level& image);
+};
+
+#endif// CHART_TEMPLATE_H_
@@ -0,0 +1,451 @@
+// File:  clipboardTable.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Converted curves or the reference table, formatted for pasting into a
+//        spreadsheet.
+
+// Standard C++ headers
+#include <algorithm>
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/clipbrd.h>
+#include <wx/dataobj.h>
+
+// Local headers
+#include "clipboardTable.h"
+#include "curveSource.h"
+#include "bufferedWriter.h"
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		ClipboardTable
+//
+// Description:		Constructor for ClipboardTable class.
+//
+// Input Arguments:
+//		padding	= const DataExporter::Padding&, for curves shorter than the
+//				  longest
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ClipboardTable::ClipboardTable(const DataExporter::Padding& padding) : padding(padding),
+	rowCount(0), rowStarted(false)
+{
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		BuildCurves
+//
+// Description:		Formats the specified curves.
+//
+// Input Arguments:
+//		source	= const CurveSource&
+//		labels	= const std::vector<std::string>&, empty entries are replaced
+//				  with default column names
+//		first	= const unsigned int&
+//		count	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::BuildCurves(const CurveSource& source, const std::vector<std::string>& labels,
+	const unsigned int& first, const unsigned int& count)
+{
+	const bool includeDeviation(source.HasUncertainty());
+	const unsigned int columnsPerCurve(includeDeviation ? 4 : 2);
+	const unsigned int last(first + count);
+
+	std::size_t rows(0);
+	unsigned int i;
+	for (i = first; i < last; ++i)
+		rows = std::max(rows, source.GetCurveSize(i));
+
+	Begin(rows, count * columnsPerCurve);
+
+	BeginRow();
+	for (i = first; i < last; ++i)
+	{
+		std::string xName, yName;
+		if (i >= labels.size() || labels[i].empty())
+		{
+			const std::string index(std::to_string(i));
+			xName = "X" + index;
+			yName = "Y" + index;
+		}
+		else
+		{
+			xName = labels[i] + " X";
+			yName = labels[i] + " Y";
+		}
+
+		AddHeader(xName);
+		AddHeader(yName);
+		if (includeDeviation)
+		{
+			AddHeader(xName + " SD");
+			AddHeader(yName + " SD");
+		}
+	}
+	EndRow();
+
+	std::vector<std::vector<double>> x(count, std::vector<double>(blockSize));
+	std::vector<std::vector<double>> y(count, std::vector<double>(blockSize));
+	std::vector<std::vector<double>> xDeviation(includeDeviation ? count : 0, std::vector<double>(blockSize));
+	std::vector<std::vector<double>> yDeviation(includeDeviation ? count : 0, std::vector<double>(blockSize));
+	std::vector<std::size_t> available(count);
+
+	for (std::size_t blockStart = 0; blockStart < rows; blockStart += blockSize)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			const std::size_t curveSize(source.GetCurveSize(first + i));
+			if (curveSize > blockStart)
+			{
+				available[i] = std::min(blockSize, curveSize - blockStart);
+				source.ConvertCurve(first + i, blockStart, available[i], x[i].data(), y[i].data());
+				if (includeDeviation)
+					source.ConvertCurveDeviation(first + i, blockStart, available[i],
+						xDeviation[i].data(), yDeviation[i].data());
+			}
+			else
+				available[i] = 0;
+		}
+
+		const std::size_t blockRows(std::min(blockSize, rows - blockStart));
+		for (std::size_t j = 0; j < blockRows; ++j)
+		{
+			BeginRow();
+			for (i = 0; i < count; ++i)
+			{
+				if (j >= available[i])
+				{
+					unsigned int k;
+					for (k = 0; k < columnsPerCurve; ++k)
+						AddPadding();
+					continue;
+				}
+
+				AddNumber(x[i][j]);
+				AddNumber(y[i][j]);
+				if (includeDeviation)
+				{
+					AddNumber(xDeviation[i][j]);
+					AddNumber(yDeviation[i][j]);
+				}
+			}
+			EndRow();
+		}
+	}
+
+	End();
+	rowCount = rows;
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		BuildReferences
+//
+// Description:		Formats the specified references.
+//
+// Input Arguments:
+//		references	= const std::vector<PointPicker::ReferencePair>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::BuildReferences(const std::vector<PointPicker::ReferencePair>& references)
+{
+	Begin(references.size(), 5);
+
+	BeginRow();
+	AddHeader("Image X");
+	AddHeader("Image Y");
+	AddHeader("X");
+	AddHeader("Y");
+	AddHeader("Weight");
+	EndRow();
+
+	for (const auto& reference : references)
+	{
+		BeginRow();
+		AddNumber(reference.imageCoords.x);
+		AddNumber(reference.imageCoords.y);
+		AddNumber(reference.valueCoords.x);
+		AddNumber(reference.valueCoords.y);
+		AddNumber(reference.weight);
+		EndRow();
+	}
+
+	End();
+	rowCount = references.size();
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		CopyToClipboard
+//
+// Description:		Puts both formats on the clipboard.  Applications that
+//					understand HTML (i.e. spreadsheets) get a table; the rest
+//					get the text.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ClipboardTable::CopyToClipboard() const
+{
+	if (!wxTheClipboard->Open())
+		return false;
+
+	wxDataObjectComposite* data(new wxDataObjectComposite);
+	data->Add(new wxHTMLDataObject(wxString::FromUTF8(html.data(), html.size())));
+	data->Add(new wxTextDataObject(wxString::FromUTF8(text.data(), text.size())), true);
+
+	const bool ok(wxTheClipboard->SetData(data));
+	wxTheClipboard->Close();
+	return ok;
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		Begin
+//
+// Description:		Clears the table and reserves space for it, so the strings
+//					aren't reallocated as they grow.
+//
+// Input Arguments:
+//		rows	= const std::size_t&, not including the header
+//		columns	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::Begin(const std::size_t& rows, const std::size_t& columns)
+{
+	// Typical lengths of a number, and of the tags around it
+	const std::size_t numberLength(12);
+	const std::size_t tagLength(9);
+
+	const std::size_t cells((rows + 1) * columns);
+	text.clear();
+	text.reserve(cells * (numberLength + 1));
+	html.clear();
+	html.reserve(cells * (numberLength + tagLength) + (rows + 1) * 10 + 32);
+
+	html.append("<table>\n");
+	rowCount = 0;
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		End
+//
+// Description:		Closes the HTML table.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::End()
+{
+	html.append("</table>\n");
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		BeginRow
+//
+// Description:		Starts a new row.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::BeginRow()
+{
+	html.append("<tr>");
+	rowStarted = true;
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		EndRow
+//
+// Description:		Finishes the current row.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::EndRow()
+{
+	text.push_back('\n');
+	html.append("</tr>\n");
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		AddHeader
+//
+// Description:		Adds a column name to the current row.
+//
+// Input Arguments:
+//		name	= const std::string&, UTF-8
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::AddHeader(const std::string& name)
+{
+	Separate();
+	html.append("<th>");
+	for (const auto& c : name)
+	{
+		// Tabs and line breaks would split the text cell
+		if (c == '\t' || c == '\n' || c == '\r')
+			text.push_back(' ');
+		else
+			text.push_back(c);
+
+		if (c == '&')
+			html.append("&amp;");
+		else if (c == '<')
+			html.append("&lt;");
+		else if (c == '>')
+			html.append("&gt;");
+		else
+			html.push_back(c);
+	}
+	html.append("</th>");
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		AddNumber
+//
+// Description:		Adds a value to the current row.
+//
+// Input Arguments:
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::AddNumber(const double& value)
+{
+	Separate();
+
+	char s[BufferedWriter::maxNumberLength];
+	const std::size_t length(BufferedWriter::FormatNumber(s, value) - s);
+	text.append(s, length);
+	html.append("<td>");
+	html.append(s, length);
+	html.append("</td>");
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		AddPadding
+//
+// Description:		Adds the padding value to the current row.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::AddPadding()
+{
+	Separate();
+
+	const char* value("");
+	if (padding == DataExporter::Padding::NaN)
+		value = "NaN";
+	else if (padding == DataExporter::Padding::Zero)
+		value = "0";
+
+	text.append(value);
+	html.append("<td>");
+	html.append(value);
+	html.append("</td>");
+}
+
+//==========================================================================
+// Class:			ClipboardTable
+// Function:		Separate
+//
+// Description:		Adds the delimiter before every cell but the first in a row.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ClipboardTable::Separate()
+{
+	if (rowStarted)
+		rowStarted = false;
+	else
+		text.push_back('\t');
+}
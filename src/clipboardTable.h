@@ -0,0 +1,64 @@
+// File:  clipboardTable.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Converted curves or the reference table, formatted for pasting into a
+//        spreadsheet.  The table is built once as both tab-separated text and
+//        an HTML table and put on the clipboard in a single operation.
+
+#ifndef CLIPBOARD_TABLE_H_
+#define CLIPBOARD_TABLE_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "pointPicker.h"
+#include "dataExporter.h"
+
+// Local forward declarations
+class CurveSource;
+
+class ClipboardTable
+{
+public:
+	explicit ClipboardTable(const DataExporter::Padding& padding = DataExporter::Padding::Empty);
+
+	// Curves first to first + count - 1 as X/Y column pairs lined up by point
+	// index, with the same columns as the text export
+	void BuildCurves(const CurveSource& source, const std::vector<std::string>& labels,
+		const unsigned int& first, const unsigned int& count);
+
+	// Image coordinates, values and weights (the layout the reference import
+	// reads)
+	void BuildReferences(const std::vector<PointPicker::ReferencePair>& references);
+
+	const std::string& GetText() const { return text; }// UTF-8
+	const std::string& GetHtml() const { return html; }// UTF-8
+	std::size_t GetRowCount() const { return rowCount; }
+
+	// Must be called from the main thread
+	bool CopyToClipboard() const;
+
+private:
+	const DataExporter::Padding padding;
+
+	std::string text;
+	std::string html;
+	std::size_t rowCount;// Not including the header
+	bool rowStarted;
+
+	// Number of rows converted at a time
+	static constexpr std::size_t blockSize = 4096;
+
+	void Begin(const std::size_t& rows, const std::size_t& columns);
+	void End();
+	void BeginRow();
+	void EndRow();
+	void AddHeader(const std::string& name);
+	void AddNumber(const double& value);
+	void AddPadding();
+	void Separate();
+};
+
+#endif// CLIPBOARD_TABLE_H_
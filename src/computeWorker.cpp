@@ -0,0 +1,223 @@
+// File:  computeWorker.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Background thread for transformation fitting and batch conversion work.
+
+// Local headers
+#include "computeWorker.h"
+#include "threadPool.h"
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			ComputeWorker
+// Function:		ComputeWorker
+//
+// Description:		Constructor for ComputeWorker class.  Starts the worker thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ComputeWorker::ComputeWorker() : stopRequested(false)
+{
+	thread = std::thread(&ComputeWorker::Run, this);
+}
+
+//==========================================================================
+// Class:			ComputeWorker
+// Function:		~ComputeWorker
+//
+// Description:		Destructor for ComputeWorker class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ComputeWorker::~ComputeWorker()
+{
+	Stop();
+}
+
+//==========================================================================
+// Class:			ComputeWorker
+// Function:		RequestFit
+//
+// Description:		Queues a transformation fit, replacing any fit with the same
+//					key that has not started yet.
+//
+// Input Arguments:
+//		key			= const unsigned int&
+//		references	= const std::vector<PointPicker::ReferencePair>&, copied
+//		regions		= const std::vector<RegionIndex::Bounds>&, copied
+//		options		= const PointPicker::FitOptions&
+//		version		= const unsigned int&, passed through to the callback
+//		callback	= const FitCallback&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ComputeWorker::RequestFit(const unsigned int& key, const std::vector<PointPicker::ReferencePair>& references,
+	const std::vector<RegionIndex::Bounds>& regions, const PointPicker::FitOptions& options,
+	const unsigned int& version, const FitCallback& callback)
+{
+	std::unique_ptr<FitRequest> request(std::make_unique<FitRequest>());
+	request->key = key;
+	request->references = references;
+	request->regions = regions;
+	request->options = options;
+	request->version = version;
+	request->callback = callback;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopRequested)
+			return;
+
+		for (auto& pending : pendingFits)
+		{
+			if (pending->key == key)
+			{
+				pending = std::move(request);
+				break;
+			}
+		}
+
+		if (request)
+			pendingFits.push_back(std::move(request));
+	}
+	condition.notify_one();
+}
+
+//==========================================================================
+// Class:			ComputeWorker
+// Function:		Submit
+//
+// Description:		Queues a general task.
+//
+// Input Arguments:
+//		task	= const Task&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ComputeWorker::Submit(const Task& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopRequested)
+			return;
+		tasks.push_back(task);
+	}
+	condition.notify_one();
+}
+
+//==========================================================================
+// Class:			ComputeWorker
+// Function:		Stop
+//
+// Description:		Discards queued work and waits for the worker thread to
+//					finish whatever it is currently doing.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ComputeWorker::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopRequested = true;
+		pendingFits.clear();
+		tasks.clear();
+	}
+	condition.notify_one();
+
+	if (thread.joinable())
+		thread.join();
+}
+
+//==========================================================================
+// Class:			ComputeWorker
+// Function:		Run
+//
+// Description:		Worker thread entry point.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ComputeWorker::Run()
+{
+	TraceRecorder::SetThreadName("Compute worker");
+	while (true)
+	{
+		std::unique_ptr<FitRequest> fit;
+		Task task;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]()
+			{
+				return stopRequested || !pendingFits.empty() || !tasks.empty();
+			});
+
+			if (stopRequested)
+				return;
+
+			if (!pendingFits.empty())
+			{
+				fit = std::move(pendingFits.front());
+				pendingFits.pop_front();
+			}
+			else
+			{
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+		}
+
+		if (fit)
+		{
+			// With more than four references, every valid combination of axis
+			// scales is fit, and those fits are spread over the pool
+			if (fit->references.size() > 4 && !fitPool)
+				fitPool = std::make_unique<ThreadPool>();
+			fit->callback(PointPicker::FitTransformations(fit->references, fit->regions,
+				fit->options, fitPool.get()), fit->version);
+		}
+		else
+			task();
+	}
+}
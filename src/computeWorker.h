@@ -0,0 +1,75 @@
+// File:  computeWorker.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Background thread for transformation fitting and batch conversion work.
+
+#ifndef COMPUTE_WORKER_H_
+#define COMPUTE_WORKER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Local headers
+#include "pointPicker.h"
+
+// Local forward declarations
+class ThreadPool;
+
+class ComputeWorker
+{
+public:
+	ComputeWorker();
+	~ComputeWorker();
+
+	// Callbacks are invoked on the worker thread
+	typedef std::function<void(const PointPicker::TransformationSet& transformations,
+		const unsigned int& version)> FitCallback;
+	typedef std::function<void()> Task;
+
+	// Only the newest fit request for each key (e.g. plot panel) is kept; a
+	// request that has not started yet is replaced, since its result would be
+	// stale anyway
+	void RequestFit(const unsigned int& key, const std::vector<PointPicker::ReferencePair>& references,
+		const std::vector<RegionIndex::Bounds>& regions, const PointPicker::FitOptions& options,
+		const unsigned int& version, const FitCallback& callback);
+
+	// Runs general work (e.g. converting a picker snapshot) in submission order;
+	// pending fits are always run first
+	void Submit(const Task& task);
+
+	// Discards queued work and waits for the thread to exit
+	void Stop();
+
+private:
+	struct FitRequest
+	{
+		unsigned int key;
+		std::vector<PointPicker::ReferencePair> references;
+		std::vector<RegionIndex::Bounds> regions;
+		PointPicker::FitOptions options;
+		unsigned int version;
+		FitCallback callback;
+	};
+
+	std::deque<std::unique_ptr<FitRequest>> pendingFits;// in request order
+	std::deque<Task> tasks;
+	bool stopRequested;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::thread thread;
+
+	// The axis scale search, robust and bootstrap fits spread their work over
+	// these threads; created on first use
+	std::unique_ptr<ThreadPool> fitPool;
+
+	void Run();
+};
+
+#endif// COMPUTE_WORKER_H_
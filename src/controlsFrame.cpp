@@ -4,29 +4,31 @@
 // Desc:  Frame object for point picker application where user can select options, etc.
 
 // Standard C++ headers
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <limits>
 
 // wxWidgets headers
 #include <wx/tglbtn.h>
 #include <wx/notebook.h>
+#include <wx/filename.h>
 
 // Local headers
 #include "controlsFrame.h"
 #include "imageFrame.h"
 #include "imageDropTarget.h"
 #include "pointPickerApp.h"
-
-// *nix Icons
-#ifdef __WXGTK__
-#include "../res/icons/pointPicker16.xpm"
-#include "../res/icons/pointPicker24.xpm"
-#include "../res/icons/pointPicker32.xpm"
-#include "../res/icons/pointPicker48.xpm"
-#include "../res/icons/pointPicker64.xpm"
-#include "../res/icons/pointPicker128.xpm"
-#include "../res/icons/pointPicker256.xpm"
-#endif
+#include "dataExporter.h"
+#include "panelSet.h"
+#include "diagnosticsPanel.h"
+#include "profiler.h"
+#include "appResources.h"
+#include "imageCache.h"
+#include "curveGridTable.h"
+#include "referenceImporter.h"
+#include "clipboardTable.h"
+#include "calibrationGrid.h"
 
 //==========================================================================
 // Class:			ControlsFrame
@@ -46,15 +48,19 @@
 //
 //==========================================================================
 ControlsFrame::ControlsFrame() : wxFrame(nullptr, wxID_ANY, wxEmptyString, wxDefaultPosition,
-								 wxDefaultSize, wxDEFAULT_FRAME_STYLE)
+								 wxDefaultSize, wxDEFAULT_FRAME_STYLE), activePanel(0), nextPanelId(0),
+								 pointsArePanelCorners(false), hasPanelCorner(false), imageWidth(0), imageHeight(0),
+								 hasImageHash(false), imageHash(0), imageFrame(nullptr)
 {
+	AddPanel(RegionIndex::Bounds());// The whole image
+
 	CreateControls();
 	SetProperties();
 
 	imageFrame = new ImageFrame(*this);
 	imageFrame->Show();
 
-	wxInitAllImageHandlers();
+	RecoverSession();
 }
 
 //==========================================================================
@@ -99,6 +105,13 @@ void ControlsFrame::OnActivate(wxActivateEvent& event)
 //==========================================================================
 void ControlsFrame::OnClose(wxCloseEvent& event)
 {
+	CacheSession();
+	journal.Close();
+
+	// Stop any background work before the frame starts coming apart
+	exportJob.reset();
+	computeWorker.Stop();
+
 	if (!IsActive())
 		wxQueueEvent(this, new wxActivateEvent());// fix for application not closing if closed from taskbar when not focused; see https://forums.wxwidgets.org/viewtopic.php?t=43498
 		
@@ -147,20 +160,50 @@ void ControlsFrame::CreateControls()
 
 	radioSizer->Add(new wxRadioButton(plotDataGroup->GetStaticBox(), idPointsAreReferences, _T("Points are references")));
 	radioSizer->Add(new wxRadioButton(plotDataGroup->GetStaticBox(), idPointsAreCurveData, _T("Points are on curve")));
+	radioSizer->Add(new wxRadioButton(plotDataGroup->GetStaticBox(), idPointsAreRegionCorners, _T("Points are region corners")));
+	radioSizer->Add(new wxRadioButton(plotDataGroup->GetStaticBox(), idPointsArePanelCorners, _T("Points are panel corners")));
 	plotUpperSizer->Add(radioSizer);
 	plotUpperSizer->AddSpacer(15);
 
-	plotUpperSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idResetReferences, _T("Reset References")));
+	wxSizer *editSizer = new wxBoxSizer(wxVERTICAL);
+	editSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), wxID_UNDO, _T("Undo")), wxSizerFlags().Expand());
+	editSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), wxID_REDO, _T("Redo")), wxSizerFlags().Expand());
+	plotUpperSizer->Add(editSizer);
+	plotUpperSizer->AddSpacer(15);
+
+	wxSizer *resetSizer = new wxBoxSizer(wxVERTICAL);
+	resetSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idResetReferences, _T("Reset References")), wxSizerFlags().Expand());
+	resetSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idResetRegions, _T("Reset Regions")), wxSizerFlags().Expand());
+	resetSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idResetPanels, _T("Reset Panels")), wxSizerFlags().Expand());
+	plotUpperSizer->Add(resetSizer);
+	plotUpperSizer->AddSpacer(15);
+
+	wxSizer *panelChoiceSizer = new wxBoxSizer(wxVERTICAL);
+	panelChoiceSizer->Add(new wxStaticText(plotDataGroup->GetStaticBox(), wxID_ANY, _T("Panel")));
+	panelChoice = new wxChoice(plotDataGroup->GetStaticBox(), idPanel);
+	panelChoiceSizer->Add(panelChoice, wxSizerFlags().Expand());
+	plotUpperSizer->Add(panelChoiceSizer);
 	plotUpperSizer->AddStretchSpacer();
-	plotUpperSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idSavePlotData, _T("Save Data")));
+
+	wxSizer *fileSizer = new wxBoxSizer(wxVERTICAL);
+	fileSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idSavePlotData, _T("Save Data")), wxSizerFlags().Expand());
+	fileSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idSaveSession, _T("Save Session...")), wxSizerFlags().Expand());
+	fileSizer->Add(new wxButton(plotDataGroup->GetStaticBox(), idOpenSession, _T("Open Session...")), wxSizerFlags().Expand());
+	plotUpperSizer->Add(fileSizer);
 	plotDataGroup->AddSpacer(15);
 
 	auto notebook(new wxNotebook(plotDataGroup->GetStaticBox(), wxID_ANY));
 
 	curveGrid = new wxGrid(notebook, idCurveGrid);
 	curveGrid->BeginBatch();
-	curveGrid->CreateGrid(1, 2, wxGrid::wxGridSelectColumns);
-	curveGrid->SetCellSize(0, 0, 1, 2);
+	curveGridTable = new CurveGridTable([this]() -> const PointPicker&
+	{
+		return GetPicker();
+	}, [this]() -> std::vector<wxString>&
+	{
+		return panels[activePanel].labels;
+	});
+	curveGrid->SetTable(curveGridTable, true, wxGrid::wxGridSelectColumns);
 	curveGrid->SetColLabelSize(0);
 	curveGrid->SetRowLabelSize(0);
 #ifdef __WXMSW__
@@ -170,27 +213,173 @@ void ControlsFrame::CreateControls()
 #endif
 	curveGrid->EndBatch();
 
-	referenceGrid = new wxGrid(notebook, idReferenceGrid);
+	wxPanel* referencePanel(new wxPanel(notebook));
+	wxSizer* referencePanelSizer(new wxBoxSizer(wxVERTICAL));
+	referencePanel->SetSizer(referencePanelSizer);
+
+	referenceGrid = new wxGrid(referencePanel, idReferenceGrid);
 	referenceGrid->BeginBatch();
 	referenceGrid->CreateGrid(1, 2, wxGrid::wxGridSelectRows);
 	referenceGrid->SetCellSize(0, 0, 1, 2);
 	referenceGrid->SetColLabelSize(0);
 	referenceGrid->SetRowLabelSize(0);
+	referenceGrid->SetTabBehaviour(wxGrid::Tab_Wrap);
 #ifdef __WXMSW__
 	referenceGrid->SetMinSize(wxSize(-1, 200));
 #else
 	referenceGrid->SetMinSize(wxSize(450, 200));
 #endif
 	referenceGrid->EndBatch();
+	referencePanelSizer->Add(referenceGrid, wxSizerFlags().Expand().Proportion(1));
+
+	// Deferred entry is for clicking all of the tick marks first, then typing
+	// (or importing) their values in one pass
+	wxSizer* referenceEntrySizer(new wxBoxSizer(wxHORIZONTAL));
+	deferReferencesCheckBox = new wxCheckBox(referencePanel, idDeferReferences, _T("Enter values in grid"));
+	referenceEntrySizer->Add(deferReferencesCheckBox, wxSizerFlags().CenterVertical());
+	referenceEntrySizer->AddStretchSpacer();
+	referenceEntrySizer->Add(new wxButton(referencePanel, idImportReferences, _T("Import Values...")));
+	referencePanelSizer->Add(referenceEntrySizer, wxSizerFlags().Expand().Border(wxALL, 5));
+
+	wxPanel* exportPanel(new wxPanel(notebook));
+	wxFlexGridSizer* exportSizer(new wxFlexGridSizer(2, 5, 5));
+	wxSizer* exportPanelSizer(new wxBoxSizer(wxVERTICAL));
+	exportPanelSizer->Add(exportSizer, wxSizerFlags().Border(wxALL, 5));
+	exportPanel->SetSizer(exportPanelSizer);
+
+	wxArrayString paddingChoices;
+	paddingChoices.Add(_T("Empty"));
+	paddingChoices.Add(_T("NaN"));
+	paddingChoices.Add(_T("Zero"));
+	paddingChoice = new wxChoice(exportPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, paddingChoices);
+	paddingChoice->SetSelection(0);
+	exportSizer->Add(new wxStaticText(exportPanel, wxID_ANY, _T("Pad short curves with")), wxSizerFlags().CenterVertical());
+	exportSizer->Add(paddingChoice);
+
+	wxArrayString alignmentChoices;
+	alignmentChoices.Add(_T("By point index"));
+	alignmentChoices.Add(_T("Uniform x step"));
+	alignmentChoices.Add(_T("Union of x values"));
+	alignmentChoice = new wxChoice(exportPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, alignmentChoices);
+	alignmentChoice->SetSelection(0);
+	exportSizer->Add(new wxStaticText(exportPanel, wxID_ANY, _T("Align curves")), wxSizerFlags().CenterVertical());
+	exportSizer->Add(alignmentChoice);
+
+	gridStepText = new wxTextCtrl(exportPanel, wxID_ANY, _T("1"));
+	gridStepText->SetValidator(wxTextValidator(wxFILTER_NUMERIC));
+	exportSizer->Add(new wxStaticText(exportPanel, wxID_ANY, _T("X step")), wxSizerFlags().CenterVertical());
+	exportSizer->Add(gridStepText);
+
+	wxArrayString interpolationChoices;
+	interpolationChoices.Add(_T("Linear"));
+	interpolationChoices.Add(_T("Monotone cubic"));
+	interpolationChoice = new wxChoice(exportPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, interpolationChoices);
+	interpolationChoice->SetSelection(0);
+	exportSizer->Add(new wxStaticText(exportPanel, wxID_ANY, _T("Interpolation")), wxSizerFlags().CenterVertical());
+	exportSizer->Add(interpolationChoice);
+
+	wxPanel* calibrationPanel(new wxPanel(notebook));
+	wxFlexGridSizer* calibrationSizer(new wxFlexGridSizer(2, 5, 5));
+	wxSizer* calibrationPanelSizer(new wxBoxSizer(wxVERTICAL));
+	calibrationPanelSizer->Add(calibrationSizer, wxSizerFlags().Border(wxALL, 5));
+	calibrationPanel->SetSizer(calibrationPanelSizer);
+
+	wxArrayString modelChoices;
+	modelChoices.Add(DistortionModel::GetName(DistortionModel::Type::None));
+	modelChoices.Add(DistortionModel::GetName(DistortionModel::Type::Polynomial2));
+	modelChoices.Add(DistortionModel::GetName(DistortionModel::Type::Polynomial3));
+	modelChoices.Add(DistortionModel::GetName(DistortionModel::Type::Radial));
+	calibrationModelChoice = new wxChoice(calibrationPanel, idCalibrationModel, wxDefaultPosition, wxDefaultSize, modelChoices);
+	calibrationModelChoice->SetSelection(0);
+	calibrationSizer->Add(new wxStaticText(calibrationPanel, wxID_ANY, _T("Model")), wxSizerFlags().CenterVertical());
+	calibrationSizer->Add(calibrationModelChoice);
+
+	// The client data of each choice is the mask of scale families the fit
+	// chooses among on that axis
+	xScaleChoice = new wxChoice(calibrationPanel, idXScales);
+	yScaleChoice = new wxChoice(calibrationPanel, idYScales);
+	wxChoice* scaleChoices[] = { xScaleChoice, yScaleChoice };
+	for (wxChoice* choice : scaleChoices)
+	{
+		choice->Append(_T("Linear or logarithmic"), wxUIntToPtr(AxisScale::defaultMask));
+		choice->Append(_T("Any"), wxUIntToPtr(AxisScale::allMask));
+		unsigned int type;
+		for (type = 0; type < AxisScale::typeCount; ++type)
+			choice->Append(AxisScale::GetName(static_cast<AxisScale::Type>(type)),
+				wxUIntToPtr(AxisScale::Mask(static_cast<AxisScale::Type>(type))));
+		choice->SetSelection(0);
+	}
+	calibrationSizer->Add(new wxStaticText(calibrationPanel, wxID_ANY, _T("X scale")), wxSizerFlags().CenterVertical());
+	calibrationSizer->Add(xScaleChoice);
+	calibrationSizer->Add(new wxStaticText(calibrationPanel, wxID_ANY, _T("Y scale")), wxSizerFlags().CenterVertical());
+	calibrationSizer->Add(yScaleChoice);
+
+	robustFitCheckBox = new wxCheckBox(calibrationPanel, idRobustFit, _T("Reject outliers"));
+	calibrationSizer->AddSpacer(0);
+	calibrationSizer->Add(robustFitCheckBox);
+
+	inlierThresholdText = new wxTextCtrl(calibrationPanel, idInlierThreshold,
+		wxString::Format(_T("%g"), GetPicker().GetFitOptions().inlierThreshold));
+	inlierThresholdText->SetValidator(wxTextValidator(wxFILTER_NUMERIC));
+	inlierThresholdText->Enable(false);
+	calibrationSizer->Add(new wxStaticText(calibrationPanel, wxID_ANY, _T("Outlier threshold [px]")), wxSizerFlags().CenterVertical());
+	calibrationSizer->Add(inlierThresholdText);
+
+	inlierCountText = new wxStaticText(calibrationPanel, wxID_ANY, wxEmptyString);
+	calibrationSizer->AddSpacer(0);
+	calibrationSizer->Add(inlierCountText);
+
+	// Choices are the number of bootstrap replicates
+	wxArrayString bootstrapChoices;
+	bootstrapChoices.Add(_T("Off"));
+	bootstrapChoices.Add(_T("100"));
+	bootstrapChoices.Add(_T("200"));
+	bootstrapChoices.Add(_T("500"));
+	bootstrapChoice = new wxChoice(calibrationPanel, idBootstrap, wxDefaultPosition, wxDefaultSize, bootstrapChoices);
+	bootstrapChoice->SetSelection(0);
+	calibrationSizer->Add(new wxStaticText(calibrationPanel, wxID_ANY, _T("Uncertainty (bootstrap)")), wxSizerFlags().CenterVertical());
+	calibrationSizer->Add(bootstrapChoice);
+
+	showGridCheckBox = new wxCheckBox(calibrationPanel, idShowGrid, _T("Show calibration grid"));
+	calibrationSizer->AddSpacer(0);
+	calibrationSizer->Add(showGridCheckBox);
+
+	// Templates hold the references of the active panel for reuse on other
+	// images of the same chart layout
+	templateChoice = new wxChoice(calibrationPanel, idTemplate);
+	calibrationSizer->Add(new wxStaticText(calibrationPanel, wxID_ANY, _T("Template")), wxSizerFlags().CenterVertical());
+	calibrationSizer->Add(templateChoice, wxSizerFlags().Expand());
+
+	wxSizer* templateButtonSizer(new wxBoxSizer(wxHORIZONTAL));
+	templateButtonSizer->Add(new wxButton(calibrationPanel, idApplyTemplate, _T("Apply")));
+	templateButtonSizer->Add(new wxButton(calibrationPanel, idSaveTemplate, _T("Save As...")));
+	templateButtonSizer->Add(new wxButton(calibrationPanel, idDeleteTemplate, _T("Delete")));
+	calibrationSizer->AddSpacer(0);
+	calibrationSizer->Add(templateButtonSizer);
+
+	alignTemplateCheckBox = new wxCheckBox(calibrationPanel, wxID_ANY, _T("Align template to image"));
+	alignTemplateCheckBox->SetValue(true);
+	calibrationSizer->AddSpacer(0);
+	calibrationSizer->Add(alignTemplateCheckBox);
+
+	autoApplyTemplateCheckBox = new wxCheckBox(calibrationPanel, wxID_ANY, _T("Apply template to new images"));
+	calibrationSizer->AddSpacer(0);
+	calibrationSizer->Add(autoApplyTemplateCheckBox);
+
+	UpdateTemplateChoice(wxEmptyString);
 
 	notebook->AddPage(curveGrid, _T("Curve"));
-	notebook->AddPage(referenceGrid, _T("References"));
+	notebook->AddPage(referencePanel, _T("References"));
+	notebook->AddPage(calibrationPanel, _T("Calibration"));
+	notebook->AddPage(exportPanel, _T("Export"));
+	notebook->AddPage(new DiagnosticsPanel(notebook), _T("Diagnostics"));
 
 	plotDataGroup->Add(notebook, wxSizerFlags().Expand().Proportion(1));
 
 	// Set defaults
 	plotDataGroup->GetStaticBox()->Enable(false);
 	static_cast<wxRadioButton*>(this->FindWindow(idPointsAreReferences))->SetValue(true);
+	UpdatePanelChoice();
 
 	statusBar = BuildStatusBar();
 	SetStatusBar(statusBar);
@@ -221,17 +410,13 @@ void ControlsFrame::SetProperties()
 	SetName(PointPickerApp::name);
 	Center();
 
-#ifdef __WXMSW__
-	SetIcon(wxIcon(_T("ICON_ID_MAIN"), wxBITMAP_TYPE_ICO_RESOURCE));
-#elif __WXGTK__
-	SetIcon(wxIcon(pointPicker16_xpm));
-	SetIcon(wxIcon(pointPicker24_xpm));
-	SetIcon(wxIcon(pointPicker32_xpm));
-	SetIcon(wxIcon(pointPicker48_xpm));
-	SetIcon(wxIcon(pointPicker64_xpm));
-	SetIcon(wxIcon(pointPicker128_xpm));
-	SetIcon(wxIcon(pointPicker256_xpm));
-#endif
+	SetIcons(AppResources::GetIcons());
+
+	wxAcceleratorEntry accelerators[3];
+	accelerators[0].Set(wxACCEL_CTRL, static_cast<int>('Z'), wxID_UNDO);
+	accelerators[1].Set(wxACCEL_CTRL, static_cast<int>('Y'), wxID_REDO);
+	accelerators[2].Set(wxACCEL_CTRL | wxACCEL_SHIFT, static_cast<int>('Z'), wxID_REDO);
+	SetAcceleratorTable(wxAcceleratorTable(3, accelerators));
 
 	SetDropTarget(dynamic_cast<wxDropTarget*>(new ImageDropTarget(*this)));
 }
@@ -262,6 +447,7 @@ wxStatusBar* ControlsFrame::BuildStatusBar()
 		wxSB_SUNKEN,	// StatusRaw
 		wxSB_FLAT,		// StatusProcessedLabel
 		wxSB_SUNKEN,	// StatusProcessed
+		wxSB_FLAT,		// StatusExportInfo
 		wxSB_FLAT		// StatusVersionInfo
 	};
 	sb->SetStatusStyles(StatusFieldCount, styles);
@@ -278,6 +464,7 @@ wxStatusBar* ControlsFrame::BuildStatusBar()
 		-1,		// StatusRaw
 		20,		// StatusProcessedLabel
 		-2,		// StatusProcessed
+		-2,		// StatusExportInfo
 		75		// StatusVersionInfo
 	};
 #else
@@ -287,6 +474,7 @@ wxStatusBar* ControlsFrame::BuildStatusBar()
 		-1,		// StatusRaw
 		40,		// StatusProcessedLabel
 		-2,		// StatusProcessed
+		-2,		// StatusExportInfo
 		135		// StatusVersionInfo
 	};
 #endif
@@ -315,14 +503,47 @@ BEGIN_EVENT_TABLE(ControlsFrame, wxFrame)
 	EVT_TOGGLEBUTTON(idCopyToClipboard, ControlsFrame::CopyToClipboardToggle)
 	EVT_TOGGLEBUTTON(idExtractPlotData, ControlsFrame::ExtractPlotDataToggle)
 	EVT_BUTTON(idResetReferences, ControlsFrame::ResetReferencesClicked)
+	EVT_BUTTON(idResetRegions, ControlsFrame::ResetRegionsClicked)
+	EVT_BUTTON(idResetPanels, ControlsFrame::ResetPanelsClicked)
+	EVT_CHOICE(idPanel, ControlsFrame::PanelChanged)
 	EVT_BUTTON(idSavePlotData, ControlsFrame::SavePlotDataClicked)
+	EVT_BUTTON(idSaveSession, ControlsFrame::SaveSessionClicked)
+	EVT_BUTTON(idOpenSession, ControlsFrame::OpenSessionClicked)
+	EVT_BUTTON(wxID_UNDO, ControlsFrame::UndoClicked)
+	EVT_BUTTON(wxID_REDO, ControlsFrame::RedoClicked)
+	EVT_MENU(wxID_UNDO, ControlsFrame::UndoClicked)
+	EVT_MENU(wxID_REDO, ControlsFrame::RedoClicked)
+	EVT_UPDATE_UI(wxID_UNDO, ControlsFrame::OnUpdateUndo)
+	EVT_UPDATE_UI(wxID_REDO, ControlsFrame::OnUpdateRedo)
 	EVT_RADIOBUTTON(idPointsAreReferences, ControlsFrame::PointAreReferencesClicked)
 	EVT_RADIOBUTTON(idPointsAreCurveData, ControlsFrame::PointAreCurveDataClicked)
+	EVT_RADIOBUTTON(idPointsAreRegionCorners, ControlsFrame::PointAreRegionCornersClicked)
+	EVT_RADIOBUTTON(idPointsArePanelCorners, ControlsFrame::PointArePanelCornersClicked)
 	EVT_ACTIVATE(ControlsFrame::OnActivate)
 	EVT_GRID_CMD_CELL_LEFT_CLICK(idCurveGrid, ControlsFrame::CurveGridClicked)
 	EVT_GRID_CMD_SELECT_CELL(idCurveGrid, ControlsFrame::CurveGridClicked)
+	EVT_GRID_CMD_CELL_RIGHT_CLICK(idCurveGrid, ControlsFrame::CurveGridRightClicked)
+	EVT_GRID_CMD_CELL_CHANGED(idCurveGrid, ControlsFrame::CurveGridChanged)
 	EVT_GRID_CMD_CELL_RIGHT_CLICK(idReferenceGrid, ControlsFrame::ReferenceGridRightClicked)
+	EVT_GRID_CMD_CELL_CHANGED(idReferenceGrid, ControlsFrame::ReferenceGridChanged)
+	EVT_CHECKBOX(idDeferReferences, ControlsFrame::DeferReferencesChanged)
+	EVT_BUTTON(idImportReferences, ControlsFrame::ImportReferencesClicked)
 	EVT_MENU(idMenuRemoveReference, ControlsFrame::RemoveReferenceMenuClicked)
+	EVT_MENU(idMenuRemoveCurve, ControlsFrame::RemoveCurveMenuClicked)
+	EVT_MENU(idMenuCopyCurve, ControlsFrame::CopyCurveMenuClicked)
+	EVT_MENU(idMenuCopyAllCurves, ControlsFrame::CopyAllCurvesMenuClicked)
+	EVT_MENU(idMenuCopyReferences, ControlsFrame::CopyReferencesMenuClicked)
+	EVT_CHOICE(idCalibrationModel, ControlsFrame::CalibrationModelChanged)
+	EVT_CHOICE(idXScales, ControlsFrame::ScalesChanged)
+	EVT_CHOICE(idYScales, ControlsFrame::ScalesChanged)
+	EVT_CHECKBOX(idRobustFit, ControlsFrame::RobustFitChanged)
+	EVT_TEXT(idInlierThreshold, ControlsFrame::InlierThresholdChanged)
+	EVT_CHOICE(idBootstrap, ControlsFrame::BootstrapChanged)
+	EVT_CHECKBOX(idShowGrid, ControlsFrame::ShowGridChanged)
+	EVT_CHOICE(idTemplate, ControlsFrame::TemplateChanged)
+	EVT_BUTTON(idApplyTemplate, ControlsFrame::ApplyTemplateClicked)
+	EVT_BUTTON(idSaveTemplate, ControlsFrame::SaveTemplateClicked)
+	EVT_BUTTON(idDeleteTemplate, ControlsFrame::DeleteTemplateClicked)
 END_EVENT_TABLE()
 
 //==========================================================================
@@ -343,10 +564,13 @@ END_EVENT_TABLE()
 //==========================================================================
 void ControlsFrame::CopyToClipboardToggle(wxCommandEvent& event)
 {
-	if (event.IsChecked())
-		picker.SetClipboardMode(PointPicker::ClipboardMode::Both);
-	else
-		picker.SetClipboardMode(PointPicker::ClipboardMode::None);
+	for (auto& panel : panels)
+	{
+		if (event.IsChecked())
+			panel.picker.SetClipboardMode(PointPicker::ClipboardMode::Both);
+		else
+			panel.picker.SetClipboardMode(PointPicker::ClipboardMode::None);
+	}
 }
 
 //==========================================================================
@@ -368,28 +592,19 @@ void ControlsFrame::CopyToClipboardToggle(wxCommandEvent& event)
 void ControlsFrame::ExtractPlotDataToggle(wxCommandEvent& event)
 {
 	plotDataGroup->GetStaticBox()->Enable(event.IsChecked());
-	if (event.IsChecked())
-	{
-		wxRadioButton* references(static_cast<wxRadioButton*>(FindWindowById(idPointsAreReferences, this)));
-		assert(references);
-
-		if (references->GetValue())
-			picker.SetDataExtractionMode(PointPicker::DataExtractionMode::References);
-		else
-			picker.SetDataExtractionMode(PointPicker::DataExtractionMode::Curve);
-	}
-	else
-		picker.SetDataExtractionMode(PointPicker::DataExtractionMode::None);
+	UpdateDataExtractionMode();
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		ResetReferencesClicked
+// Function:		UpdateDataExtractionMode
 //
-// Description:		Handles button click events.
+// Description:		Sets the data extraction mode of every panel to match the
+//					controls.  While points are panel corners, the pickers do
+//					not extract anything.
 //
 // Input Arguments:
-//		event	= wxCommandEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -398,20 +613,41 @@ void ControlsFrame::ExtractPlotDataToggle(wxCommandEvent& event)
 //		None
 //
 //==========================================================================
-void ControlsFrame::ResetReferencesClicked(wxCommandEvent& WXUNUSED(event))
+void ControlsFrame::UpdateDataExtractionMode()
 {
-	picker.ResetReferences();
-	UpdateReferenceGrid();
+	PointPicker::DataExtractionMode mode(PointPicker::DataExtractionMode::None);
+	pointsArePanelCorners = false;
+	hasPanelCorner = false;
+
+	if (plotDataGroup->GetStaticBox()->IsEnabled())
+	{
+		wxRadioButton* references(static_cast<wxRadioButton*>(FindWindowById(idPointsAreReferences, this)));
+		wxRadioButton* regionCorners(static_cast<wxRadioButton*>(FindWindowById(idPointsAreRegionCorners, this)));
+		wxRadioButton* panelCorners(static_cast<wxRadioButton*>(FindWindowById(idPointsArePanelCorners, this)));
+		assert(references && regionCorners && panelCorners);
+
+		if (references->GetValue())
+			mode = PointPicker::DataExtractionMode::References;
+		else if (regionCorners->GetValue())
+			mode = PointPicker::DataExtractionMode::Regions;
+		else if (panelCorners->GetValue())
+			pointsArePanelCorners = true;
+		else
+			mode = PointPicker::DataExtractionMode::Curve;
+	}
+
+	for (auto& panel : panels)
+		panel.picker.SetDataExtractionMode(mode);
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		SavePlotDataClicked
+// Function:		SetFitOptions
 //
-// Description:		Handles button click events.
+// Description:		Sets the fit options of every panel (each refits).
 //
 // Input Arguments:
-//		event	= wxCommandEvent&
+//		options	= const PointPicker::FitOptions&
 //
 // Output Arguments:
 //		None
@@ -420,81 +656,18 @@ void ControlsFrame::ResetReferencesClicked(wxCommandEvent& WXUNUSED(event))
 //		None
 //
 //==========================================================================
-void ControlsFrame::SavePlotDataClicked(wxCommandEvent& WXUNUSED(event))
+void ControlsFrame::SetFitOptions(const PointPicker::FitOptions& options)
 {
-	if (!picker.GetErrorString().empty())
-	{
-		wxMessageBox(_T("The following errors occurred while estimating curve data:\n")
-			+ picker.GetErrorString(), _T("Error"));
-		return;
-	}
-
-	std::vector<std::vector<PointPicker::Point>> data(picker.GetCurveData());
-	if (data.size() == 0)
-	{
-		wxMessageBox(_T("No point data specified."), _T("No Data"));
-		return;
-	}
-
-	wxFileDialog dialog(this, _T("Save Plot Data"), wxEmptyString, wxEmptyString,
-		_T("Comma-Separated Values (*.csv)|*.csv|Tab Delimited (*.txt)|*.txt"),
-		wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
-
-	if (dialog.ShowModal() == wxID_CANCEL)
-		return;
-
-	std::ofstream file(dialog.GetPath().ToStdString().c_str());
-	if (!file.is_open() || !file.good())
-	{
-		wxMessageBox(_T("Failed to open '") + dialog.GetPath() + _T("' for output."), _T("Error"));
-		return;
-	}
-
-	wxString delimiter;
-	if (dialog.GetPath().Mid(dialog.GetPath().find_last_of('.')).CmpNoCase(_T(".txt")) == 0)
-		delimiter = _T("\t");
-	else
-		delimiter = _T(",");
-
-	std::stringstream ss;
-	unsigned int i;
-	for (i = 0; i < data.size(); i++)
-	{
-		wxString label(curveGrid->GetCellValue(0, i * 2));
-		if (label.IsEmpty())
-			ss << "X" << i << delimiter << "Y" << i << delimiter;
-		else
-			ss << label << " X" << delimiter << label << " Y" << delimiter;
-	}
-
-	unsigned int j(0);
-	bool finished(false);
-	while (!finished)
-	{
-		finished = true;
-
-		file << ss.str() << "\n";
-		ss.str("");
-		ss.clear();
-		for (i = 0; i < data.size(); i++)
-		{
-			if (j < data[i].size())
-			{
-				ss << data[i][j].x << delimiter << data[i][j].y << delimiter;
-				finished = false;
-			}
-			else
-				ss << "0" << delimiter << "0" << delimiter;// TODO:  Better to leave blank, or use zeros?
-		}
-		j++;
-	}
+	for (auto& panel : panels)
+		panel.picker.SetFitOptions(options);
+	CheckpointJournal();
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		PointAreReferencesClicked
+// Function:		ResetReferencesClicked
 //
-// Description:		Handles radio button click events.
+// Description:		Handles button click events.
 //
 // Input Arguments:
 //		event	= wxCommandEvent&
@@ -506,16 +679,20 @@ void ControlsFrame::SavePlotDataClicked(wxCommandEvent& WXUNUSED(event))
 //		None
 //
 //==========================================================================
-void ControlsFrame::PointAreReferencesClicked(wxCommandEvent& WXUNUSED(event))
+void ControlsFrame::ResetReferencesClicked(wxCommandEvent& WXUNUSED(event))
 {
-	picker.SetDataExtractionMode(PointPicker::DataExtractionMode::References);
+	GetPicker().ResetReferences();
+	history.Clear();
+	journal.ResetReferences(activePanel);
+	CompactJournal();
+	UpdateReferenceGrid();
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		PointAreCurveDataClicked
+// Function:		ResetRegionsClicked
 //
-// Description:		Handles radio button click events.
+// Description:		Handles button click events.
 //
 // Input Arguments:
 //		event	= wxCommandEvent&
@@ -527,19 +704,21 @@ void ControlsFrame::PointAreReferencesClicked(wxCommandEvent& WXUNUSED(event))
 //		None
 //
 //==========================================================================
-void ControlsFrame::PointAreCurveDataClicked(wxCommandEvent& WXUNUSED(event))
+void ControlsFrame::ResetRegionsClicked(wxCommandEvent& WXUNUSED(event))
 {
-	picker.SetDataExtractionMode(PointPicker::DataExtractionMode::Curve);
+	GetPicker().ResetRegions();
+	CheckpointJournal();
+	UpdateReferenceGrid();
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		CurveGridClicked
+// Function:		ResetPanelsClicked
 //
-// Description:		Handles grid click events.
+// Description:		Handles button click events.
 //
 // Input Arguments:
-//		event	= wxGridEvent&
+//		event	= wxCommandEvent&
 //
 // Output Arguments:
 //		None
@@ -548,27 +727,24 @@ void ControlsFrame::PointAreCurveDataClicked(wxCommandEvent& WXUNUSED(event))
 //		None
 //
 //==========================================================================
-void ControlsFrame::CurveGridClicked(wxGridEvent& event)
+void ControlsFrame::ResetPanelsClicked(wxCommandEvent& WXUNUSED(event))
 {
-	picker.SetCurveIndex(event.GetCol() / 2);
-
-	curveGrid->SelectCol(event.GetCol());
-	if (event.GetCol() % 2 == 0)
-		curveGrid->SelectCol(event.GetCol() + 1, true);
-	else
-		curveGrid->SelectCol(event.GetCol() - 1, true);
+	if (panels.size() > 1 && wxMessageBox(_T("Remove all panels, along with their references and curves?"),
+		_T("Reset Panels"), wxYES_NO | wxICON_QUESTION, this) != wxYES)
+		return;
 
-	event.Skip();
+	ResetPanels();
+	CheckpointJournal();
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		ReferenceGridRightClicked
+// Function:		PanelChanged
 //
-// Description:		Handles grid right-click events.
+// Description:		Handles panel selection events.
 //
 // Input Arguments:
-//		event	= wxGridEvent&
+//		event	= wxCommandEvent&
 //
 // Output Arguments:
 //		None
@@ -577,19 +753,17 @@ void ControlsFrame::CurveGridClicked(wxGridEvent& event)
 //		None
 //
 //==========================================================================
-void ControlsFrame::ReferenceGridRightClicked(wxGridEvent& event)
+void ControlsFrame::PanelChanged(wxCommandEvent& event)
 {
-	referenceGrid->SelectRow(event.GetRow(), event.ControlDown());
-	wxMenu menu;
-	menu.Append(idMenuRemoveReference, _T("Remove"), _T("Remove selected reference(s)"));
-	PopupMenu(&menu);
+	if (event.GetSelection() >= 0)
+		SetActivePanel(static_cast<unsigned int>(event.GetSelection()));
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		RemoveReferenceMenuClicked
+// Function:		SavePlotDataClicked
 //
-// Description:		Handles remove reference menu item clicks.
+// Description:		Handles button click events.
 //
 // Input Arguments:
 //		event	= wxCommandEvent&
@@ -601,98 +775,146 @@ void ControlsFrame::ReferenceGridRightClicked(wxGridEvent& event)
 //		None
 //
 //==========================================================================
-void ControlsFrame::RemoveReferenceMenuClicked(wxCommandEvent& WXUNUSED(event))
+void ControlsFrame::SavePlotDataClicked(wxCommandEvent& WXUNUSED(event))
 {
-	auto selections(referenceGrid->GetSelectedRows());
+	// While an export is running, this button cancels it
+	if (exportJob)
+	{
+		exportJob->Cancel();
+		return;
+	}
 
-	auto sortDescending([](int *a, int *b) -> int
+	// All panels are written to the same file, one after the other
+	PanelSet panelSet;
+	std::vector<std::string> labels;
+	if (!CollectCurves(false, panelSet, labels))
+		return;
+
+	wxFileDialog dialog(this, _T("Save Plot Data"), wxEmptyString, wxEmptyString,
+		_T("Comma-Separated Values (*.csv)|*.csv|Tab Delimited (*.txt)|*.txt|")
+		_T("NumPy Array (*.npy)|*.npy|NumPy Archive (*.npz)|*.npz|")
+		_T("PointPicker Columns (*.ppc)|*.ppc"),
+		wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	const std::string extension(wxFileName(dialog.GetPath()).GetExt().Lower().ToStdString());
+	const DataExporter::Padding padding(static_cast<DataExporter::Padding>(paddingChoice->GetSelection()));
+
+	CurveResampler::Settings resampling;
+	resampling.grid = static_cast<CurveResampler::Grid>(alignmentChoice->GetSelection());
+	resampling.interpolation = static_cast<CurveResampler::Interpolation>(interpolationChoice->GetSelection());
+	if (resampling.grid == CurveResampler::Grid::UniformStep &&
+		(!gridStepText->GetValue().ToDouble(&resampling.step) || resampling.step <= 0.0))
 	{
-		if (*a < *b)
-			return 1;
-		else if (*a > *b)
-			return -1;
-		return 0;
+		wxMessageBox(_T("X step must be a positive number."), _T("Error"));
+		return;
+	}
+
+	std::unique_ptr<DataExporter> exporter(DataExporter::Create(extension, padding, resampling));
+	if (!exporter)
+	{
+		wxMessageBox(_T("Aligned curves can only be saved as .csv, .txt or .npy files."), _T("Error"));
+		return;
+	}
+
+	// The job works on its own copy of the panels so the user can keep adding points
+	exportJob = std::make_unique<ExportJob>(panelSet, std::move(exporter),
+		dialog.GetPath().ToStdString(), labels);
+	exportJob->Start([this](const int& percent)
+	{
+		CallAfter([this, percent]()
+		{
+			OnExportProgress(percent);
+		});
+	}, [this](const ExportJob::Result& result)
+	{
+		CallAfter([this, result]()
+		{
+			OnExportComplete(result);
+		});
 	});
 
-	selections.Sort(sortDescending);
-	for (const auto& r : selections)
-		picker.RemoveReference(r);
-	UpdateReferenceGrid();
+	FindWindowById(idSavePlotData, this)->SetLabel(_T("Cancel Save"));
+	statusBar->SetStatusText(_T("Exporting..."), StatusExportInfo);
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		AddNewPoint
+// Function:		CollectCurves
 //
-//
-// Description:		Adds the next point to the grid.
+// Description:		Gathers the curves to export, and their column names.
+//					Panels without curves are skipped.  Reports problems to
+//					the user.
 //
 // Input Arguments:
-//		None
+//		activePanelOnly	= const bool&
 //
 // Output Arguments:
-//		None
+//		panelSet	= PanelSet&
+//		labels		= std::vector<std::string>&, UTF-8
 //
 // Return Value:
-//		None
+//		bool, false if there is nothing to export or a panel could not be fit
 //
 //==========================================================================
-void ControlsFrame::AddNewPoint()
+bool ControlsFrame::CollectCurves(const bool& activePanelOnly, PanelSet& panelSet, std::vector<std::string>& labels)
 {
-	if (picker.GetDataExtractionMode() == PointPicker::DataExtractionMode::References)
-		UpdateReferenceGrid();
-	
-	if (picker.GetDataExtractionMode() != PointPicker::DataExtractionMode::Curve)
-		return;
+	SaveCurveLabels();
+	unsigned int p;
+	for (p = 0; p < panels.size(); ++p)
+	{
+		const PointPicker& picker(panels[p].picker);
+		if ((activePanelOnly && p != activePanel) || picker.GetCurveCount() == 0)
+			continue;
 
-	const unsigned int xCol(picker.GetCurveIndex() * 2);
-	const unsigned int yCol(xCol + 1);
+		// A pending fit is not an error; it is completed before converting
+		if (picker.IsTransformationCurrent() && !picker.GetErrorString().empty())
+		{
+			wxString message(_T("The following errors occurred while estimating curve data"));
+			if (panels.size() > 1)
+				message.Append(_T(" (") + GetPanelName(p) + _T(")"));
+			wxMessageBox(message + _T(":\n") + picker.GetErrorString(), _T("Error"));
+			return false;
+		}
 
-	curveGrid->BeginBatch();
+		panelSet.Add(picker);
 
-	int i(1);
-	while (true)
-	{
-		if (curveGrid->GetNumberRows() == i)
+		unsigned int i;
+		for (i = 0; i < picker.GetCurveCount(); ++i)
 		{
-			curveGrid->AppendRows();
-			for (int j = 0; j < curveGrid->GetNumberCols(); j++)
-				curveGrid->SetReadOnly(i, j);
-			break;
+			wxString label(i < panels[p].labels.size() ? panels[p].labels[i] : wxString());
+			if (panels.size() > 1 && !activePanelOnly)
+			{
+				if (label.IsEmpty())
+					label = GetPanelName(p) + wxString::Format(_T(" Curve %u"), i);
+				else
+					label = GetPanelName(p) + _T(": ") + label;
+			}
+			labels.push_back(label.ToUTF8().data());
 		}
-		else if (curveGrid->GetCellValue(i, xCol).IsEmpty())
-			break;
-
-		i++;
 	}
 
-	curveGrid->SetCellValue(i, xCol, wxString::Format(_T("%f"), picker.GetNewestPoint().x));
-	curveGrid->SetCellValue(i, yCol, wxString::Format(_T("%f"), picker.GetNewestPoint().y));
-
-	// If first point in new column, append two columns to the grid, too
-	if (i == 1)
+	if (panelSet.GetCurveCount() == 0)
 	{
-		curveGrid->AppendCols(2);
-		curveGrid->SetCellSize(0, yCol + 1, 1, 2);
-		curveGrid->SetReadOnly(0, yCol + 1, false);
-		for (int j = 1; j < curveGrid->GetNumberRows(); j++)
-		{
-			curveGrid->SetReadOnly(j, yCol + 1);
-			curveGrid->SetReadOnly(j, yCol + 2);
-		}
+		wxMessageBox(_T("No point data specified."), _T("No Data"));
+		return false;
 	}
 
-	curveGrid->EndBatch();
+	return true;
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		LoadFiles
+// Function:		CopyCurves
 //
-// Description:		Loads the first file from the specified list of files.
+// Description:		Puts converted curves on the clipboard.
 //
 // Input Arguments:
-//		None
+//		activePanelOnly	= const bool&
+//		curve			= const int&, index within the active panel, or -1 for
+//						  all curves
 //
 // Output Arguments:
 //		None
@@ -701,27 +923,43 @@ void ControlsFrame::AddNewPoint()
 //		None
 //
 //==========================================================================
-bool ControlsFrame::LoadFiles(const wxArrayString &fileList)
+void ControlsFrame::CopyCurves(const bool& activePanelOnly, const int& curve)
 {
-	if (fileList.Count() == 0)
-		return false;
+	PanelSet panelSet;
+	std::vector<std::string> labels;
+	if (!CollectCurves(activePanelOnly, panelSet, labels))
+		return;
+
+	if (curve >= static_cast<int>(panelSet.GetCurveCount()))
+		return;
 
-	wxImage newImage(fileList[0]);
-	imageFrame->SetImage(newImage);
-	picker.Reset();
-	ResetGrids();
+	wxBusyCursor busy;
+	panelSet.UpdateTransformations();
 
-	return true;
+	ClipboardTable table(static_cast<DataExporter::Padding>(paddingChoice->GetSelection()));
+	if (curve < 0)
+		table.BuildCurves(panelSet, labels, 0, panelSet.GetCurveCount());
+	else
+		table.BuildCurves(panelSet, labels, static_cast<unsigned int>(curve), 1);
+
+	if (!table.CopyToClipboard())
+	{
+		wxMessageBox(_T("Failed to open the clipboard."), _T("Error"));
+		return;
+	}
+
+	statusBar->SetStatusText(wxString::Format(_T("Copied %u rows"),
+		static_cast<unsigned int>(table.GetRowCount())), StatusExportInfo);
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		ResetGrids
+// Function:		CopyCurveMenuClicked
 //
-// Description:		Resets the grids.
+// Description:		Copies the selected curve to the clipboard.
 //
 // Input Arguments:
-//		None
+//		event	= wxCommandEvent&
 //
 // Output Arguments:
 //		None
@@ -730,28 +968,41 @@ bool ControlsFrame::LoadFiles(const wxArrayString &fileList)
 //		None
 //
 //==========================================================================
-void ControlsFrame::ResetGrids()
+void ControlsFrame::CopyCurveMenuClicked(wxCommandEvent& WXUNUSED(event))
 {
-	curveGrid->BeginBatch();
-	if (curveGrid->GetNumberCols() > 2)
-		curveGrid->DeleteCols(2, curveGrid->GetNumberCols() - 2);
-	if (curveGrid->GetNumberRows() > 1)
-		curveGrid->DeleteRows(1, curveGrid->GetNumberRows() - 1);
-	curveGrid->SetCellValue(0, 0, wxEmptyString);
-	curveGrid->EndBatch();
-
-	UpdateReferenceGrid();
+	CopyCurves(true, static_cast<int>(GetPicker().GetCurveIndex()));
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		UpdateReferenceGrid
+// Function:		CopyAllCurvesMenuClicked
 //
-// Description:		Updates the reference grid to match the picker references.
+// Description:		Copies the curves of every panel to the clipboard.
 //
 // Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
 //		None
 //
+//==========================================================================
+void ControlsFrame::CopyAllCurvesMenuClicked(wxCommandEvent& WXUNUSED(event))
+{
+	CopyCurves(false, -1);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CopyReferencesMenuClicked
+//
+// Description:		Copies the active panel's references to the clipboard.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
 // Output Arguments:
 //		None
 //
@@ -759,38 +1010,58 @@ void ControlsFrame::ResetGrids()
 //		None
 //
 //==========================================================================
-void ControlsFrame::UpdateReferenceGrid()
+void ControlsFrame::CopyReferencesMenuClicked(wxCommandEvent& WXUNUSED(event))
 {
-	const auto refs(picker.GetReferences());
-	referenceGrid->BeginBatch();
-	if (static_cast<size_t>(referenceGrid->GetNumberRows()) > refs.size())
-		referenceGrid->DeleteRows(0, referenceGrid->GetNumberRows() - refs.size());
-	if (static_cast<size_t>(referenceGrid->GetNumberRows()) < refs.size())
-		referenceGrid->AppendRows(refs.size() - referenceGrid->GetNumberRows());
+	ClipboardTable table;
+	table.BuildReferences(GetPicker().GetReferencePairs());
+	if (!table.CopyToClipboard())
+		wxMessageBox(_T("Failed to open the clipboard."), _T("Error"));
+}
 
-	for (unsigned int r = 0; r < refs.size(); ++r)
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OnTransformationFitted
+//
+// Description:		Applies a transformation computed on the worker thread.
+//
+// Input Arguments:
+//		panelId			= const unsigned int&
+//		transformations	= const PointPicker::TransformationSet&
+//		version			= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::OnTransformationFitted(const unsigned int& panelId,
+	const PointPicker::TransformationSet& transformations, const unsigned int& version)
+{
+	// The panel may have been removed while the fit was running, and applying
+	// returns false (and does nothing) if the references changed in the meantime
+	Panel* panel(FindPanelById(panelId));
+	if (!panel || !panel->picker.ApplyTransformations(transformations, version))
 	{
-		referenceGrid->SetCellValue(r, 0, wxString::Format(_T("%f"), refs[r].x));
-		referenceGrid->SetCellValue(r, 1, wxString::Format(_T("%f"), refs[r].y));
+		Profiler::Increment(Profiler::Counter::FitsDiscarded);
+		return;
 	}
 
-	referenceGrid->EndBatch();
+	if (panel == &panels[activePanel])
+		UpdateReferenceGrid();
+	else
+		UpdateOverlay();
 }
 
 //==========================================================================
 // Class:			ControlsFrame
-// Function:		UpdateStatusBar
+// Function:		OnExportProgress
 //
-// Description:		Updates the status bar text with information for the current
-//					cursor position.
+// Description:		Updates the status bar with export progress.
 //
 // Input Arguments:
-//		rawX	= const double&
-//		rawY	= const double&
-//		xScale	= const double&
-//		yScale	= const double&
-//		xOffset	= const double&
-//		yOffset	= const double&
+//		percent	= const int&
 //
 // Output Arguments:
 //		None
@@ -799,10 +1070,2335 @@ void ControlsFrame::UpdateReferenceGrid()
 //		None
 //
 //==========================================================================
-void ControlsFrame::UpdateStatusBar(const double& rawX, const double& rawY,
+void ControlsFrame::OnExportProgress(const int& percent)
+{
+	if (exportJob)
+		statusBar->SetStatusText(wxString::Format(_T("Exporting... %d%%"), percent), StatusExportInfo);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OnExportComplete
+//
+// Description:		Cleans up after the background export finishes.
+//
+// Input Arguments:
+//		result	= const ExportJob::Result&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::OnExportComplete(const ExportJob::Result& result)
+{
+	if (exportJob)
+	{
+		exportJob->Wait();
+		exportJob.reset();
+	}
+
+	FindWindowById(idSavePlotData, this)->SetLabel(_T("Save Data"));
+
+	if (result.cancelled)
+	{
+		statusBar->SetStatusText(_T("Export cancelled"), StatusExportInfo);
+		return;
+	}
+	else if (!result.success)
+	{
+		statusBar->SetStatusText(wxEmptyString, StatusExportInfo);
+		wxMessageBox(wxString::FromUTF8(result.errorString.c_str()), _T("Error"));
+		return;
+	}
+
+	statusBar->SetStatusText(wxString::Format(_T("Wrote %llu rows (%s)"),
+		static_cast<unsigned long long>(result.rowsWritten),
+		wxFileName::GetHumanReadableSize(wxULongLong(result.bytesWritten))), StatusExportInfo);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		PointAreReferencesClicked
+//
+// Description:		Handles radio button click events.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::PointAreReferencesClicked(wxCommandEvent& WXUNUSED(event))
+{
+	UpdateDataExtractionMode();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		PointAreCurveDataClicked
+//
+// Description:		Handles radio button click events.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::PointAreCurveDataClicked(wxCommandEvent& WXUNUSED(event))
+{
+	UpdateDataExtractionMode();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		PointAreRegionCornersClicked
+//
+// Description:		Handles radio button click events.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::PointAreRegionCornersClicked(wxCommandEvent& WXUNUSED(event))
+{
+	UpdateDataExtractionMode();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		PointArePanelCornersClicked
+//
+// Description:		Handles radio button click events.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::PointArePanelCornersClicked(wxCommandEvent& WXUNUSED(event))
+{
+	UpdateDataExtractionMode();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CurveGridClicked
+//
+// Description:		Handles grid click events.
+//
+// Input Arguments:
+//		event	= wxGridEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CurveGridClicked(wxGridEvent& event)
+{
+	GetPicker().SetCurveIndex(event.GetCol() / 2);
+
+	curveGrid->SelectCol(event.GetCol());
+	if (event.GetCol() % 2 == 0)
+		curveGrid->SelectCol(event.GetCol() + 1, true);
+	else
+		curveGrid->SelectCol(event.GetCol() - 1, true);
+
+	event.Skip();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CurveGridRightClicked
+//
+// Description:		Handles grid right-click events.
+//
+// Input Arguments:
+//		event	= wxGridEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CurveGridRightClicked(wxGridEvent& event)
+{
+	if (static_cast<unsigned int>(event.GetCol() / 2) >= GetPicker().GetCurveCount())
+		return;
+
+	GetPicker().SetCurveIndex(event.GetCol() / 2);
+	curveGrid->SelectCol(event.GetCol() - event.GetCol() % 2);
+	curveGrid->SelectCol(event.GetCol() - event.GetCol() % 2 + 1, true);
+
+	wxMenu menu;
+	menu.Append(idMenuCopyCurve, _T("Copy"), _T("Copy selected curve's converted points"));
+	menu.Append(idMenuCopyAllCurves, _T("Copy All"), _T("Copy converted points of all curves in all panels"));
+	menu.AppendSeparator();
+	menu.Append(idMenuRemoveCurve, _T("Remove"), _T("Remove selected curve"));
+	PopupMenu(&menu);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CurveGridChanged
+//
+// Description:		Handles grid cell change events (the grid's table has
+//					already stored the new curve name).
+//
+// Input Arguments:
+//		event	= wxGridEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CurveGridChanged(wxGridEvent& event)
+{
+	const unsigned int curve(event.GetCol() / 2);
+	const std::vector<wxString>& labels(panels[activePanel].labels);
+	if (event.GetRow() == 0 && curve < labels.size())
+	{
+		journal.SetLabel(activePanel, curve, labels[curve]);
+		CompactJournal();
+	}
+
+	event.Skip();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		RemoveCurveMenuClicked
+//
+// Description:		Handles remove curve menu item clicks.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::RemoveCurveMenuClicked(wxCommandEvent& WXUNUSED(event))
+{
+	const unsigned int curve(GetPicker().GetCurveIndex());
+	if (curve >= GetPicker().GetCurveCount())
+		return;
+
+	EditHistory::Command command(EditHistory::Type::ResetCurveData, activePanel, curve);
+	command.detail = std::make_unique<EditHistory::Command::Detail>();
+	command.detail->points = GetPicker().ResetCurveData(curve);
+
+	std::vector<wxString>& labels(panels[activePanel].labels);
+	if (curve < labels.size())
+	{
+		command.detail->label = labels[curve];
+		labels.erase(labels.begin() + curve);
+	}
+
+	history.Add(std::move(command));
+	journal.ResetCurveData(activePanel, curve);
+	CompactJournal();
+	UpdateCurveGrid();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ReferenceGridRightClicked
+//
+// Description:		Handles grid right-click events.
+//
+// Input Arguments:
+//		event	= wxGridEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ReferenceGridRightClicked(wxGridEvent& event)
+{
+	referenceGrid->SelectRow(event.GetRow(), event.ControlDown());
+	wxMenu menu;
+	menu.Append(idMenuCopyReferences, _T("Copy Table"), _T("Copy all references"));
+	menu.AppendSeparator();
+	menu.Append(idMenuRemoveReference, _T("Remove"), _T("Remove selected reference(s)"));
+	PopupMenu(&menu);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		RemoveReferenceMenuClicked
+//
+// Description:		Handles remove reference menu item clicks.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::RemoveReferenceMenuClicked(wxCommandEvent& WXUNUSED(event))
+{
+	auto selections(referenceGrid->GetSelectedRows());
+
+	auto sortDescending([](int *a, int *b) -> int
+	{
+		if (*a < *b)
+			return 1;
+		else if (*a > *b)
+			return -1;
+		return 0;
+	});
+
+	selections.Sort(sortDescending);
+	const unsigned int referenceCount(static_cast<unsigned int>(GetPicker().GetReferencePairs().size()));
+	for (const auto& r : selections)
+	{
+		// Pending rows come after the references and aren't part of the history
+		if (static_cast<unsigned int>(r) >= referenceCount)
+		{
+			GetPicker().RemovePendingReference(r - referenceCount);
+			continue;
+		}
+
+		EditHistory::Command command(EditHistory::Type::RemoveReference, activePanel, r);
+		command.reference = GetPicker().GetReferencePairs()[r];
+		command.detail = std::make_unique<EditHistory::Command::Detail>();
+		GetPicker().RemoveReference(r, command.detail->fit);
+		history.Add(std::move(command));
+		journal.RemoveReference(activePanel, r);
+	}
+
+	CompactJournal();
+	UpdateReferenceGrid();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ReferenceGridChanged
+//
+// Description:		Handles values typed into pending reference rows.  Once
+//					every pending reference has a value, they are committed.
+//
+// Input Arguments:
+//		event	= wxGridEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ReferenceGridChanged(wxGridEvent& event)
+{
+	const std::size_t referenceCount(GetPicker().GetReferencePairs().size());
+	if (static_cast<std::size_t>(event.GetRow()) < referenceCount)
+		return;
+
+	const unsigned int i(static_cast<unsigned int>(event.GetRow() - referenceCount));
+	PointPicker::Point value(GetPicker().GetPendingReferences()[i].valueCoords);
+	double& ordinate(event.GetCol() == 0 ? value.x : value.y);
+
+	const wxString text(referenceGrid->GetCellValue(event.GetRow(), event.GetCol()).Trim().Trim(false));
+	if (text.IsEmpty())
+		ordinate = std::numeric_limits<double>::quiet_NaN();
+	else if (!text.ToDouble(&ordinate) || !std::isfinite(ordinate))
+	{
+		event.Veto();
+		return;
+	}
+
+	GetPicker().SetPendingValue(i, value);
+
+	// Committing rebuilds the grid, which can't be done while it is
+	// processing the edit
+	if (GetPicker().PendingReferencesComplete())
+		CallAfter([this]()
+		{
+			CommitPendingReferences();
+		});
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		DeferReferencesChanged
+//
+// Description:		Switches between entering reference values in a dialog
+//					after each click and entering them later in the grid.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::DeferReferencesChanged(wxCommandEvent& event)
+{
+	const PointPicker::ReferenceEntry entry(event.IsChecked() ?
+		PointPicker::ReferenceEntry::Deferred : PointPicker::ReferenceEntry::Dialog);
+	for (auto& panel : panels)
+		panel.picker.SetReferenceEntry(entry);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ImportReferencesClicked
+//
+// Description:		Reads reference values from a file.  Values are given to
+//					the pending references in the order they were clicked, and
+//					complete references are added as they are; all of them are
+//					then committed together.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ImportReferencesClicked(wxCommandEvent& WXUNUSED(event))
+{
+	wxFileDialog dialog(this, _T("Import References"), wxEmptyString, wxEmptyString,
+		_T("Comma-Separated Values (*.csv)|*.csv|Tab Delimited (*.txt)|*.txt|All Files|*.*"),
+		wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	ReferenceImporter importer;
+	if (!importer.Read(dialog.GetPath().ToStdString()))
+	{
+		wxMessageBox(importer.GetErrorString(), _T("Error"));
+		return;
+	}
+
+	const std::vector<PointPicker::ReferencePair>& pending(GetPicker().GetPendingReferences());
+	unsigned int used(0);
+	for (unsigned int i = 0; i < pending.size() && used < importer.values.size(); ++i)
+	{
+		if (!std::isfinite(pending[i].valueCoords.x) || !std::isfinite(pending[i].valueCoords.y))
+			GetPicker().SetPendingValue(i, importer.values[used++]);
+	}
+
+	for (const auto& reference : importer.references)
+		GetPicker().AddPendingReference(reference);
+
+	CommitPendingReferences();
+
+	if (used < importer.values.size())
+		wxMessageBox(wxString::Format(_T("%u of the imported values were not used (there were only %u clicked references without values)."),
+			static_cast<unsigned int>(importer.values.size()) - used, used), _T("Warning"));
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UndoClicked
+//
+// Description:		Handles undo button clicks and accelerator keys.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UndoClicked(wxCommandEvent& WXUNUSED(event))
+{
+	Undo();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		RedoClicked
+//
+// Description:		Handles redo button clicks and accelerator keys.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::RedoClicked(wxCommandEvent& WXUNUSED(event))
+{
+	Redo();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OnUpdateUndo
+//
+// Description:		Enables the undo button when there is something to undo.
+//
+// Input Arguments:
+//		event	= wxUpdateUIEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::OnUpdateUndo(wxUpdateUIEvent& event)
+{
+	event.Enable(history.CanUndo());
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OnUpdateRedo
+//
+// Description:		Enables the redo button when there is something to redo.
+//
+// Input Arguments:
+//		event	= wxUpdateUIEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::OnUpdateRedo(wxUpdateUIEvent& event)
+{
+	event.Enable(history.CanRedo());
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		Undo
+//
+// Description:		Reverses the newest edit.  Reference edits restore the fit
+//					that was in place before the edit rather than refitting.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::Undo()
+{
+	if (!history.CanUndo())
+		return;
+
+	EditHistory::Command& command(history.Undo());
+	SetActivePanel(command.panel);
+	switch (command.type)
+	{
+	case EditHistory::Type::AddCurvePoint:
+		GetPicker().RemoveNewestCurvePoint(command.index);
+		journal.RemoveNewestCurvePoint(command.panel, command.index);
+		break;
+
+	case EditHistory::Type::AddReference:
+		GetPicker().RemoveReference(command.index, command.detail->fit);
+		journal.RemoveReference(command.panel, command.index);
+		break;
+
+	case EditHistory::Type::RemoveReference:
+		GetPicker().InsertReference(command.index, command.reference, command.detail->fit);
+		journal.InsertReference(command.panel, command.index, command.reference);
+		break;
+
+	case EditHistory::Type::ResetCurveData:
+	{
+		GetPicker().InsertCurve(command.index, std::move(command.detail->points));
+		std::vector<wxString>& labels(panels[activePanel].labels);
+		if (command.index < labels.size())
+			labels.insert(labels.begin() + command.index, command.detail->label);
+		else if (!command.detail->label.IsEmpty())
+		{
+			labels.resize(command.index);
+			labels.push_back(command.detail->label);
+		}
+
+		// The restored points aren't in the log
+		CheckpointJournal();
+		break;
+	}
+	}
+
+	ShowEdit(command);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		Redo
+//
+// Description:		Repeats the most recently undone edit.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::Redo()
+{
+	if (!history.CanRedo())
+		return;
+
+	EditHistory::Command& command(history.Redo());
+	SetActivePanel(command.panel);
+	switch (command.type)
+	{
+	case EditHistory::Type::AddCurvePoint:
+		GetPicker().AddCurvePoint(command.index, command.reference.imageCoords);
+		journal.AddCurvePoint(command.panel, command.index, command.reference.imageCoords);
+		break;
+
+	case EditHistory::Type::AddReference:
+		GetPicker().InsertReference(command.index, command.reference, command.detail->fit);
+		journal.InsertReference(command.panel, command.index, command.reference);
+		break;
+
+	case EditHistory::Type::RemoveReference:
+		GetPicker().RemoveReference(command.index, command.detail->fit);
+		journal.RemoveReference(command.panel, command.index);
+		break;
+
+	case EditHistory::Type::ResetCurveData:
+	{
+		command.detail->points = GetPicker().ResetCurveData(command.index);
+		std::vector<wxString>& labels(panels[activePanel].labels);
+		if (command.index < labels.size())
+		{
+			command.detail->label = labels[command.index];
+			labels.erase(labels.begin() + command.index);
+		}
+
+		journal.ResetCurveData(command.panel, command.index);
+		break;
+	}
+	}
+
+	ShowEdit(command);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ShowEdit
+//
+// Description:		Updates the grids after an edit is undone or redone.
+//
+// Input Arguments:
+//		command	= const EditHistory::Command&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ShowEdit(const EditHistory::Command& command)
+{
+	if (command.type == EditHistory::Type::AddCurvePoint ||
+		command.type == EditHistory::Type::ResetCurveData)
+		UpdateCurveGrid();
+	else
+		UpdateReferenceGrid();
+
+	CompactJournal();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CalibrationModelChanged
+//
+// Description:		Refits the transformation using the selected model.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CalibrationModelChanged(wxCommandEvent& event)
+{
+	PointPicker::FitOptions options(GetPicker().GetFitOptions());
+	options.distortion = static_cast<DistortionModel::Type>(event.GetSelection());
+	SetFitOptions(options);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ScalesChanged
+//
+// Description:		Refits choosing among the selected axis scales.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ScalesChanged(wxCommandEvent& event)
+{
+	PointPicker::FitOptions options(GetPicker().GetFitOptions());
+	const unsigned int mask(wxPtrToUInt(event.GetClientData()));
+	if (event.GetId() == idXScales)
+		options.xScales = mask;
+	else
+		options.yScales = mask;
+	SetFitOptions(options);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		RobustFitChanged
+//
+// Description:		Turns outlier rejection on or off and refits.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::RobustFitChanged(wxCommandEvent& event)
+{
+	PointPicker::FitOptions options(GetPicker().GetFitOptions());
+	options.robust = event.IsChecked();
+	inlierThresholdText->Enable(options.robust);
+	SetFitOptions(options);
+	UpdateReferenceGrid();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		InlierThresholdChanged
+//
+// Description:		Refits using the new outlier threshold.  Incomplete or
+//					non-positive values are ignored.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::InlierThresholdChanged(wxCommandEvent& event)
+{
+	double threshold;
+	if (!event.GetString().ToDouble(&threshold) || threshold <= 0.0)
+		return;
+
+	PointPicker::FitOptions options(GetPicker().GetFitOptions());
+	if (options.inlierThreshold == threshold)
+		return;
+
+	options.inlierThreshold = threshold;
+	SetFitOptions(options);
+	UpdateReferenceGrid();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		BootstrapChanged
+//
+// Description:		Sets the number of bootstrap replicates and refits.  When
+//					enabled, exported files include standard deviation columns.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::BootstrapChanged(wxCommandEvent& event)
+{
+	unsigned long replicates(0);
+	if (event.GetSelection() > 0)
+		event.GetString().ToULong(&replicates);
+
+	PointPicker::FitOptions options(GetPicker().GetFitOptions());
+	options.bootstrapReplicates = static_cast<unsigned int>(replicates);
+	SetFitOptions(options);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ShowGridChanged
+//
+// Description:		Shows or hides the calibration grid over the image.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ShowGridChanged(wxCommandEvent& WXUNUSED(event))
+{
+	UpdateOverlay();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		TemplateChanged
+//
+// Description:		Loads the selected template.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::TemplateChanged(wxCommandEvent& event)
+{
+	chartTemplate = std::make_unique<ChartTemplate>();
+	if (!chartTemplate->Load(event.GetString()))
+	{
+		wxMessageBox(chartTemplate->GetErrorString(), _T("Error"));
+		chartTemplate.reset();
+		templateChoice->SetSelection(wxNOT_FOUND);
+	}
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ApplyTemplateClicked
+//
+// Description:		Handles button click events.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ApplyTemplateClicked(wxCommandEvent& WXUNUSED(event))
+{
+	if (!chartTemplate)
+	{
+		wxMessageBox(_T("No template selected."), _T("Error"));
+		return;
+	}
+
+	if (!GetPicker().GetReferencePairs().empty() && wxMessageBox(_T("Replace the references with the template's?"),
+		_T("Apply Template"), wxYES_NO | wxICON_QUESTION, this) != wxYES)
+		return;
+
+	{
+		Profiler::ScopedTimer timer(Profiler::Probe::TemplateAlignment);
+		ApplyTemplate();
+	}
+
+	history.Clear();
+	CheckpointJournal();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		SaveTemplateClicked
+//
+// Description:		Saves the active panel's calibration as a template.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::SaveTemplateClicked(wxCommandEvent& WXUNUSED(event))
+{
+	if (imageWidth == 0 || GetPicker().GetReferencePairs().empty())
+	{
+		wxMessageBox(_T("No references to save."), _T("Error"));
+		return;
+	}
+
+	const wxString name(wxGetTextFromUser(_T("Template name:"), _T("Save Template"),
+		chartTemplate ? chartTemplate->GetName() : wxString(), this));
+	if (name.IsEmpty())
+		return;
+
+	if (!ChartTemplate::IsValidName(name))
+	{
+		wxMessageBox(_T("'") + name + _T("' is not a valid template name."), _T("Error"));
+		return;
+	}
+
+	if (ChartTemplate::GetNames().Index(name) != wxNOT_FOUND && wxMessageBox(_T("Replace template '") + name + _T("'?"),
+		_T("Save Template"), wxYES_NO | wxICON_QUESTION, this) != wxYES)
+		return;
+
+	std::unique_ptr<ChartTemplate> newTemplate(std::make_unique<ChartTemplate>(name, GetPicker(),
+		imageWidth, imageHeight, alignmentImage));
+	if (!newTemplate->Save())
+	{
+		wxMessageBox(newTemplate->GetErrorString(), _T("Error"));
+		return;
+	}
+
+	chartTemplate = std::move(newTemplate);
+	UpdateTemplateChoice(name);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		DeleteTemplateClicked
+//
+// Description:		Deletes the selected template.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::DeleteTemplateClicked(wxCommandEvent& WXUNUSED(event))
+{
+	if (!chartTemplate)
+		return;
+
+	if (wxMessageBox(_T("Delete template '") + chartTemplate->GetName() + _T("'?"),
+		_T("Delete Template"), wxYES_NO | wxICON_QUESTION, this) != wxYES)
+		return;
+
+	if (!ChartTemplate::Delete(chartTemplate->GetName()))
+		wxMessageBox(_T("Failed to delete template '") + chartTemplate->GetName() + _T("'."), _T("Error"));
+
+	chartTemplate.reset();
+	UpdateTemplateChoice(wxEmptyString);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdateTemplateChoice
+//
+// Description:		Refills the template selector from the saved templates.
+//
+// Input Arguments:
+//		selection	= const wxString&, name to select (if it exists)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdateTemplateChoice(const wxString& selection)
+{
+	templateChoice->Set(ChartTemplate::GetNames());
+	templateChoice->SetStringSelection(selection);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ApplyTemplate
+//
+// Description:		Replaces the active panel's calibration with the selected
+//					template's.  Its fit options become those of every panel.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ApplyTemplate()
+{
+	if (!chartTemplate || imageWidth == 0)
+		return;
+
+	const ChartTemplate::Alignment alignment(chartTemplate->Apply(GetPicker(),
+		imageWidth, imageHeight, alignmentImage, alignTemplateCheckBox->GetValue()));
+
+	unsigned int i;
+	for (i = 0; i < panels.size(); ++i)
+	{
+		if (i != activePanel)
+			panels[i].picker.SetFitOptions(GetPicker().GetFitOptions());
+	}
+
+	UpdateFitOptionControls();
+	UpdateReferenceGrid();
+
+	wxString message(_T("Applied template '") + chartTemplate->GetName() + _T("'"));
+	if (alignment.aligned)
+		message.Append(wxString::Format(_T(" (moved %.1f, %.1f px)"), alignment.dx, alignment.dy));
+	else if (alignTemplateCheckBox->GetValue())
+		message.Append(_T(" (could not align)"));
+	statusBar->SetStatusText(message, StatusExportInfo);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdateFitOptionControls
+//
+// Description:		Updates the calibration controls to match the fit options,
+//					without generating change events.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdateFitOptionControls()
+{
+	const PointPicker::FitOptions& options(GetPicker().GetFitOptions());
+	calibrationModelChoice->SetSelection(static_cast<int>(options.distortion));
+	SelectScaleChoice(xScaleChoice, options.xScales);
+	SelectScaleChoice(yScaleChoice, options.yScales);
+	robustFitCheckBox->SetValue(options.robust);
+	inlierThresholdText->ChangeValue(wxString::Format(_T("%g"), options.inlierThreshold));
+	inlierThresholdText->Enable(options.robust);
+
+	if (options.bootstrapReplicates == 0)
+		bootstrapChoice->SetSelection(0);
+	else
+	{
+		const wxString replicates(wxString::Format(_T("%u"), options.bootstrapReplicates));
+		if (bootstrapChoice->FindString(replicates) == wxNOT_FOUND)
+			bootstrapChoice->Append(replicates);
+		bootstrapChoice->SetStringSelection(replicates);
+	}
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		SelectScaleChoice
+//
+// Description:		Selects the entry for the mask, adding one if the mask is
+//					not among the choices (i.e. when it came from a template).
+//
+// Input Arguments:
+//		choice	= wxChoice*
+//		mask	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::SelectScaleChoice(wxChoice* choice, const unsigned int& mask)
+{
+	unsigned int i;
+	for (i = 0; i < choice->GetCount(); ++i)
+	{
+		if (wxPtrToUInt(choice->GetClientData(i)) == mask)
+		{
+			choice->SetSelection(i);
+			return;
+		}
+	}
+
+	choice->SetSelection(choice->Append(AxisScale::GetMaskNames(mask), wxUIntToPtr(mask)));
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		AddPoint
+//
+// Description:		Handles a click on the image.  References and curve points
+//					go to the panel that was clicked, which becomes the active
+//					panel; region corners always go to the active panel.
+//
+// Input Arguments:
+//		rawX	= const double&
+//		rawY	= const double&
+//		xScale	= const double&
+//		yScale	= const double&
+//		xOffset	= const double&
+//		yOffset	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::AddPoint(const double& rawX, const double& rawY,
+	const double& xScale, const double& yScale,
+	const double& xOffset, const double& yOffset)
+{
+	const double x(rawX * xScale + xOffset);
+	const double y(rawY * yScale + yOffset);
+
+	if (pointsArePanelCorners)
+	{
+		// Data extraction is off, so this only handles the clipboard
+		GetPicker().AddPoint(rawX, rawY, xScale, yScale, xOffset, yOffset);
+		if (!hasPanelCorner)
+		{
+			panelCorner = PointPicker::Point(x, y);
+			hasPanelCorner = true;
+			return;
+		}
+
+		hasPanelCorner = false;
+		AddPanel(RegionIndex::Bounds(panelCorner.x, panelCorner.y, x, y));
+		UpdatePanelChoice();
+		SetActivePanel(static_cast<unsigned int>(panels.size()) - 1);
+		CheckpointJournal();
+		return;
+	}
+
+	const PointPicker::DataExtractionMode mode(GetPicker().GetDataExtractionMode());
+	if (mode == PointPicker::DataExtractionMode::References || mode == PointPicker::DataExtractionMode::Curve)
+		SetActivePanel(FindPanel(x, y));
+
+	const std::size_t referenceCount(GetPicker().GetReferencePairs().size());
+	const std::size_t pendingCount(GetPicker().GetPendingReferences().size());
+	const std::size_t regionCount(GetPicker().GetRegions().size());
+	PointPicker::SavedFit fit;
+	if (mode == PointPicker::DataExtractionMode::References)
+		fit = GetPicker().SaveFit();
+
+	GetPicker().AddPoint(rawX, rawY, xScale, yScale, xOffset, yOffset);
+
+	// The reference dialog may have been cancelled, and regions take two clicks
+	if (mode == PointPicker::DataExtractionMode::Curve)
+	{
+		EditHistory::Command command(EditHistory::Type::AddCurvePoint, activePanel, GetPicker().GetCurveIndex());
+		command.reference.imageCoords = GetPicker().GetNewestPoint();
+		history.Add(std::move(command));
+		journal.AddCurvePoint(activePanel, GetPicker().GetCurveIndex(), GetPicker().GetNewestPoint());
+	}
+	else if (GetPicker().GetReferencePairs().size() > referenceCount)
+	{
+		EditHistory::Command command(EditHistory::Type::AddReference, activePanel,
+			static_cast<unsigned int>(referenceCount));
+		command.reference = GetPicker().GetReferencePairs().back();
+		command.detail = std::make_unique<EditHistory::Command::Detail>();
+		command.detail->fit = std::move(fit);
+		history.Add(std::move(command));
+		journal.AddReference(activePanel, GetPicker().GetReferencePairs().back());
+	}
+	else if (GetPicker().GetRegions().size() != regionCount)
+		CheckpointJournal();
+	CompactJournal();
+
+	AddNewPoint();
+
+	// Pending references aren't logged until they have values; the first one
+	// takes the grid cursor so the values can be typed straight in
+	if (GetPicker().GetPendingReferences().size() > pendingCount)
+	{
+		const int row(static_cast<int>(referenceCount + pendingCount));
+		if (pendingCount == 0)
+			referenceGrid->SetGridCursor(row, 0);
+		referenceGrid->MakeCellVisible(row, 0);
+	}
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		AddNewPoint
+//
+//
+// Description:		Adds the next point to the grid.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::AddNewPoint()
+{
+	Profiler::ScopedTimer timer(Profiler::Probe::AddNewPoint);
+
+	if (GetPicker().GetDataExtractionMode() == PointPicker::DataExtractionMode::References)
+		UpdateReferenceGrid();
+	else if (GetPicker().GetDataExtractionMode() == PointPicker::DataExtractionMode::Curve)
+		curveGridTable->Update();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CommitPendingReferences
+//
+// Description:		Moves pending references that have values into the active
+//					panel's references, fitting once for all of them.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CommitPendingReferences()
+{
+	const std::size_t referenceCount(GetPicker().GetReferencePairs().size());
+	PointPicker::SavedFit fit(GetPicker().SaveFit());
+	if (GetPicker().CommitPendingReferences() > 0)
+	{
+		// Each reference is its own edit.  Only undoing the first one can
+		// restore a fit; the sets in between were never fit.
+		const std::vector<PointPicker::ReferencePair>& pairs(GetPicker().GetReferencePairs());
+		for (std::size_t i = referenceCount; i < pairs.size(); ++i)
+		{
+			EditHistory::Command command(EditHistory::Type::AddReference, activePanel, static_cast<unsigned int>(i));
+			command.reference = pairs[i];
+			command.detail = std::make_unique<EditHistory::Command::Detail>();
+			if (i == referenceCount)
+				command.detail->fit = std::move(fit);
+			history.Add(std::move(command));
+			journal.AddReference(activePanel, pairs[i]);
+		}
+
+		CompactJournal();
+	}
+
+	UpdateReferenceGrid();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		LoadFiles
+//
+// Description:		Loads the first file from the specified list of files (an
+//					image, or a session file).  If the image can't be opened,
+//					the current one and its work are left as they were.
+//
+// Input Arguments:
+//		fileList	= const wxArrayString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the file was loaded
+//
+//==========================================================================
+bool ControlsFrame::LoadFiles(const wxArrayString &fileList)
+{
+	if (fileList.Count() == 0)
+		return false;
+
+	if (wxFileName(fileList[0]).GetExt().Lower() == SessionFile::extension)
+		return OpenSession(fileList[0]);
+
+	// The work done on the outgoing image is cached under its hash, but only
+	// once the new image has opened (which replaces the hash)
+	const bool cacheOutgoing(hasImageHash);
+	const std::uint64_t outgoingHash(imageHash);
+	const SessionFile outgoing(cacheOutgoing ? CaptureSession() : SessionFile());
+
+	Profiler::ScopedTimer timer(Profiler::Probe::LoadFiles);
+	if (!OpenImage(fileList[0]))
+		return false;
+
+	if (cacheOutgoing)
+		ImageCache::WriteSession(outgoingHash, outgoing);
+
+	ResetPanels();
+	GetPicker().Reset();
+	panels.front().labels.clear();
+
+	// A previous session with this image takes priority over the template
+	SessionFile session;
+	if (hasImageHash && ImageCache::ReadSession(imageHash, session))
+		RestoreSession(std::move(session));
+	else if (autoApplyTemplateCheckBox->GetValue())
+	{
+		Profiler::ScopedTimer alignmentTimer(Profiler::Probe::TemplateAlignment);
+		ApplyTemplate();
+	}
+
+	UpdateCurveGrid();
+	UpdateReferenceGrid();
+	CheckpointJournal();
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OpenImage
+//
+// Description:		Shows the specified image, taking it from the image cache
+//					if possible.  Otherwise the file is decoded and a copy is
+//					added to the cache.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the image was loaded
+//
+//==========================================================================
+bool ControlsFrame::OpenImage(const wxString& fileName)
+{
+	wxImage newImage;
+	ImagePyramid::Level newAlignmentImage;
+	std::uint64_t newHash(0);
+	bool newHasHash, cached;
+	{
+		Profiler::ScopedTimer cacheTimer(Profiler::Probe::ImageCache);
+		newHasHash = ImageCache::HashFile(fileName, newHash);
+		cached = newHasHash && ImageCache::ReadImage(newHash, newImage, newAlignmentImage);
+	}
+
+	if (cached)
+		Profiler::Increment(Profiler::Counter::ImageCacheHits);
+	else
+	{
+		{
+			Profiler::ScopedTimer decodeTimer(Profiler::Probe::ImageDecode);
+			AppResources::LoadImageFile(fileName, newImage);
+		}
+
+		// Leave the image that's shown alone
+		if (!newImage.IsOk())
+			return false;
+
+		{
+			Profiler::ScopedTimer alignmentTimer(Profiler::Probe::TemplateAlignment);
+			newAlignmentImage = ImagePyramid(newImage, ChartTemplate::alignmentSize).GetCoarsest();
+		}
+
+		// The raw pixels can be large, so they are written in the background
+		// (from a copy, since wxImage data is not safe to share between threads)
+		if (newHasHash)
+		{
+			Profiler::Increment(Profiler::Counter::ImageCacheMisses);
+			const std::shared_ptr<const ImageCache::Entry> entry(
+				std::make_shared<ImageCache::Entry>(newImage, newAlignmentImage));
+			const std::uint64_t hash(newHash);
+			computeWorker.Submit([entry, hash]()
+			{
+				if (ImageCache::WriteImage(hash, *entry))
+					ImageCache::Trim();
+			});
+		}
+	}
+
+	wxFileName absoluteName(fileName);
+	absoluteName.MakeAbsolute();
+	imageFileName = absoluteName.GetFullPath();
+	hasImageHash = newHasHash;
+	imageHash = newHash;
+
+	ShowImage(newImage, newAlignmentImage);
+	return true;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OpenCachedImage
+//
+// Description:		Shows the image with the specified hash from the image
+//					cache, for when the original file can't be found.
+//
+// Input Arguments:
+//		hash		= const std::uint64_t&
+//		fileName	= const wxString&, where the image used to be
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the image was in the cache
+//
+//==========================================================================
+bool ControlsFrame::OpenCachedImage(const std::uint64_t& hash, const wxString& fileName)
+{
+	wxImage newImage;
+	ImagePyramid::Level newAlignmentImage;
+	{
+		Profiler::ScopedTimer cacheTimer(Profiler::Probe::ImageCache);
+		if (!ImageCache::ReadImage(hash, newImage, newAlignmentImage))
+			return false;
+	}
+
+	Profiler::Increment(Profiler::Counter::ImageCacheHits);
+	hasImageHash = true;
+	imageHash = hash;
+	imageFileName = fileName;
+	ShowImage(newImage, newAlignmentImage);
+	return true;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ShowImage
+//
+// Description:		Makes the specified image the current image.
+//
+// Input Arguments:
+//		image		= const wxImage&
+//		alignment	= const ImagePyramid::Level&, coarse copy for templates
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ShowImage(const wxImage& image, const ImagePyramid::Level& alignment)
+{
+	// Without an image (i.e. it failed to decode, or a session's image is
+	// missing) the image frame is left blank
+	if (image.IsOk())
+		imageFrame->SetImage(image);
+	else
+	{
+		wxImage blank(1, 1);
+		blank.SetRGB(0, 0, 255, 255, 255);
+		imageFrame->SetImage(blank);
+	}
+
+	alignmentImage = alignment;
+	imageWidth = image.IsOk() ? image.GetWidth() : 0;
+	imageHeight = image.IsOk() ? image.GetHeight() : 0;
+	UpdateOverlay();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OpenSession
+//
+// Description:		Replaces the current image and panels with those from the
+//					specified session file.  The image is looked for where it
+//					was when the session was saved, then next to the session
+//					file, then in the image cache.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ControlsFrame::OpenSession(const wxString& fileName)
+{
+	SessionFile session;
+	{
+		Profiler::ScopedTimer timer(Profiler::Probe::LoadFiles);
+		if (!session.Read(fileName.ToStdString()))
+		{
+			wxMessageBox(session.GetErrorString(), _T("Error"));
+			return false;
+		}
+	}
+
+	CacheSession();
+
+	const wxString note(OpenSessionImage(session, wxFileName(fileName).GetPath()));
+	RestoreSession(std::move(session));
+
+	UpdateCurveGrid();
+	UpdateReferenceGrid();
+	CheckpointJournal();
+	statusBar->SetStatusText(_T("Opened session '") + wxFileName(fileName).GetFullName() + _T("'") + note,
+		StatusExportInfo);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OpenSessionImage
+//
+// Description:		Shows the image a session was made from.  The image is
+//					looked for where it was when the session was saved, then
+//					in the specified directory, then in the image cache.
+//
+// Input Arguments:
+//		session		= const SessionFile&
+//		directory	= const wxString&, may be empty
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString, note for the status bar if the image is missing or has
+//		changed
+//
+//==========================================================================
+wxString ControlsFrame::OpenSessionImage(const SessionFile& session, const wxString& directory)
+{
+	bool imageFound(false);
+	if (!session.imageFileName.IsEmpty())
+	{
+		wxString imagePath(session.imageFileName);
+		if (!wxFileExists(imagePath) && !directory.IsEmpty())
+			imagePath = wxFileName(directory, wxFileName(session.imageFileName).GetFullName()).GetFullPath();
+
+		if (wxFileExists(imagePath))
+			imageFound = OpenImage(imagePath);
+		if (!imageFound && session.hasImageHash)
+			imageFound = OpenCachedImage(session.imageHash, session.imageFileName);
+	}
+
+	if (!imageFound)
+	{
+		// References from the session don't belong on whatever was shown before
+		ShowImage(wxImage(), ImagePyramid::Level());
+		hasImageHash = false;
+		imageFileName = session.imageFileName;
+		if (!session.imageFileName.IsEmpty())
+			return _T(" (image not found)");
+	}
+	else if (session.hasImageHash && (!hasImageHash || imageHash != session.imageHash))
+		return _T(" (image has changed since the session was saved)");
+
+	return wxEmptyString;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		SaveSessionClicked
+//
+// Description:		Event handler for Save Session button clicks.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::SaveSessionClicked(wxCommandEvent& WXUNUSED(event))
+{
+	wxFileDialog dialog(this, _T("Save Session"), wxEmptyString, wxEmptyString,
+		_T("PointPicker Session (*.pps)|*.pps"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	const SessionFile session(CaptureSession());
+	if (!session.Write(dialog.GetPath().ToStdString()))
+	{
+		wxMessageBox(session.GetErrorString(), _T("Error"));
+		return;
+	}
+
+	statusBar->SetStatusText(_T("Saved session '") + wxFileName(dialog.GetPath()).GetFullName() + _T("'"),
+		StatusExportInfo);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		OpenSessionClicked
+//
+// Description:		Event handler for Open Session button clicks.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::OpenSessionClicked(wxCommandEvent& WXUNUSED(event))
+{
+	wxFileDialog dialog(this, _T("Open Session"), wxEmptyString, wxEmptyString,
+		_T("PointPicker Session (*.pps)|*.pps"), wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	OpenSession(dialog.GetPath());
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CaptureSession
+//
+// Description:		Copies the image reference, panels, calibrations, curves and
+//					export settings into a session.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		SessionFile
+//
+//==========================================================================
+SessionFile ControlsFrame::CaptureSession()
+{
+	SaveCurveLabels();
+
+	SessionFile session;
+	session.imageFileName = imageFileName;
+	session.hasImageHash = hasImageHash;
+	session.imageHash = imageHash;
+
+	session.padding = static_cast<DataExporter::Padding>(paddingChoice->GetSelection());
+	session.resampling.grid = static_cast<CurveResampler::Grid>(alignmentChoice->GetSelection());
+	session.resampling.interpolation = static_cast<CurveResampler::Interpolation>(interpolationChoice->GetSelection());
+	double step;
+	if (gridStepText->GetValue().ToDouble(&step) && step > 0.0)
+		session.resampling.step = step;
+
+	for (const auto& p : panels)
+	{
+		SessionFile::Panel panel;
+		panel.bounds = p.bounds;
+		panel.references = p.picker.GetReferencePairs();
+		panel.regions = p.picker.GetRegions();
+		panel.fitOptions = p.picker.GetFitOptions();
+
+		unsigned int i;
+		for (i = 0; i < p.picker.GetCurveCount(); ++i)
+		{
+			SessionFile::Curve curve;
+			if (i < p.labels.size())
+				curve.label = p.labels[i];
+			curve.points = p.picker.GetCurvePoints(i);
+			panel.curves.push_back(std::move(curve));
+		}
+
+		session.panels.push_back(std::move(panel));
+	}
+
+	return session;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		RestoreSession
+//
+// Description:		Replaces the panels and export settings with those from the
+//					session (the image is not changed).  Each panel is refit
+//					once, on the compute worker.
+//
+// Input Arguments:
+//		session	= SessionFile&&, curves are moved out of it
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::RestoreSession(SessionFile&& session)
+{
+	ResetPanels();
+	GetPicker().Reset();
+
+	unsigned int i;
+	for (i = 0; i < session.panels.size(); ++i)
+	{
+		SessionFile::Panel& saved(session.panels[i]);
+		if (i > 0)
+			AddPanel(saved.bounds);
+
+		Panel& panel(panels[i]);
+		panel.picker.SetCalibration(saved.references, saved.regions, saved.fitOptions);
+		panel.labels.clear();
+
+		unsigned int c;
+		for (c = 0; c < saved.curves.size(); ++c)
+		{
+			panel.picker.SetCurvePoints(c, std::move(saved.curves[c].points));
+			panel.labels.push_back(saved.curves[c].label);
+		}
+	}
+
+	paddingChoice->SetSelection(static_cast<int>(session.padding));
+	alignmentChoice->SetSelection(static_cast<int>(session.resampling.grid));
+	interpolationChoice->SetSelection(static_cast<int>(session.resampling.interpolation));
+	gridStepText->ChangeValue(wxString::Format(_T("%g"), session.resampling.step));
+
+	UpdatePanelChoice();
+	UpdateFitOptionControls();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CacheSession
+//
+// Description:		Saves the current session to the image cache.  Failures
+//					are ignored; the work is only lost from the cache.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CacheSession()
+{
+	if (hasImageHash)
+		ImageCache::WriteSession(imageHash, CaptureSession());
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		RecoverSession
+//
+// Description:		Restores the work left in the journal by a run that
+//					crashed, then starts a new journal.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::RecoverSession()
+{
+	SessionFile session;
+	if (journal.Recover(session) && !session.IsEmpty())
+	{
+		const wxString note(OpenSessionImage(session, wxEmptyString));
+		RestoreSession(std::move(session));
+
+		UpdateCurveGrid();
+		UpdateReferenceGrid();
+		statusBar->SetStatusText(_T("Recovered the previous session") + note, StatusExportInfo);
+	}
+
+	CheckpointJournal();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CheckpointJournal
+//
+// Description:		Replaces the journal with a snapshot of the current session
+//					(for changes that aren't logged one at a time).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CheckpointJournal()
+{
+	if (!journal.IsEnabled())
+		return;
+
+	Profiler::ScopedTimer timer(Profiler::Probe::JournalCheckpoint);
+	journal.Checkpoint(CaptureSession());
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		CompactJournal
+//
+// Description:		Checkpoints the journal if the log has grown larger than
+//					the last snapshot.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::CompactJournal()
+{
+	if (journal.NeedsCompaction())
+		CheckpointJournal();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		AddPanel
+//
+// Description:		Adds a plot panel.  New panels take their settings from
+//					panel 0.
+//
+// Input Arguments:
+//		bounds	= const RegionIndex::Bounds&, ignored for panel 0
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::AddPanel(const RegionIndex::Bounds& bounds)
+{
+	Panel panel;
+	panel.id = nextPanelId++;
+	panel.bounds = bounds;
+	if (!panels.empty())
+	{
+		const PointPicker& settings(panels.front().picker);
+		panel.picker.SetFitOptions(settings.GetFitOptions());
+		panel.picker.SetClipboardMode(settings.GetClipboardMode());
+		panel.picker.SetDataExtractionMode(settings.GetDataExtractionMode());
+		panel.picker.SetReferenceEntry(settings.GetReferenceEntry());
+	}
+
+	// Fits run on the compute worker; results for references that have since
+	// changed (or for panels that have since been removed) are dropped when
+	// they get back to the UI thread
+	const unsigned int id(panel.id);
+	panel.picker.SetFitRequestHandler([this, id]()
+	{
+		const Panel* requester(FindPanelById(id));
+		assert(requester);
+		const PointPicker& picker(requester->picker);
+		computeWorker.RequestFit(id, picker.GetReferencePairs(), picker.GetRegions(), picker.GetFitOptions(),
+			picker.GetReferenceVersion(), [this, id](const PointPicker::TransformationSet& transformations,
+			const unsigned int& version)
+		{
+			CallAfter([this, id, transformations, version]()
+			{
+				OnTransformationFitted(id, transformations, version);
+			});
+		});
+	});
+
+	panels.push_back(panel);
+
+	std::vector<RegionIndex::Bounds> bounded;
+	unsigned int i;
+	for (i = 1; i < panels.size(); ++i)
+		bounded.push_back(panels[i].bounds);
+	panelIndex.Build(bounded);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		ResetPanels
+//
+// Description:		Removes all of the user-drawn panels, leaving panel 0 (which
+//					then covers the whole image).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::ResetPanels()
+{
+	hasPanelCorner = false;
+	history.Clear();
+	if (panels.size() > 1)
+	{
+		panels.erase(panels.begin() + 1, panels.end());
+		panelIndex.Build(std::vector<RegionIndex::Bounds>());
+	}
+
+	UpdatePanelChoice();
+	SetActivePanel(0);
+	UpdateOverlay();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		FindPanel
+//
+// Description:		Returns the panel containing the specified image location.
+//					Where panels overlap, the one drawn last wins.
+//
+// Input Arguments:
+//		x	= const double&
+//		y	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int ControlsFrame::FindPanel(const double& x, const double& y) const
+{
+	const std::size_t bounded(panelIndex.Find(x, y));
+	if (bounded == RegionIndex::none)
+		return 0;
+	return static_cast<unsigned int>(bounded) + 1;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		FindPanelById
+//
+// Description:		Returns the panel with the specified ID.
+//
+// Input Arguments:
+//		id	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Panel*, nullptr if the panel has been removed
+//
+//==========================================================================
+ControlsFrame::Panel* ControlsFrame::FindPanelById(const unsigned int& id)
+{
+	auto it(std::find_if(panels.begin(), panels.end(), [&id](const Panel& panel)
+	{
+		return panel.id == id;
+	}));
+
+	if (it == panels.end())
+		return nullptr;
+	return &*it;
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		SetActivePanel
+//
+// Description:		Makes the specified panel the one shown in the grids.
+//
+// Input Arguments:
+//		panel	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::SetActivePanel(const unsigned int& panel)
+{
+	assert(panel < panels.size());
+	panelChoice->SetSelection(panel);
+	if (panel == activePanel)
+		return;
+
+	// A name still being edited belongs to the panel being switched away from
+	if (activePanel < panels.size())
+		SaveCurveLabels();
+
+	activePanel = panel;
+	UpdateCurveGrid();
+	UpdateReferenceGrid();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		SaveCurveLabels
+//
+// Description:		Commits a curve name that is still being edited in the grid
+//					(names are otherwise stored as soon as they are entered).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::SaveCurveLabels()
+{
+	if (curveGrid->IsCellEditControlEnabled())
+		curveGrid->SaveEditControlValue();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdatePanelChoice
+//
+// Description:		Refills the panel selector.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdatePanelChoice()
+{
+	panelChoice->Clear();
+	unsigned int i;
+	for (i = 0; i < panels.size(); ++i)
+		panelChoice->Append(GetPanelName(i));
+	panelChoice->SetSelection(std::min(activePanel, static_cast<unsigned int>(panels.size()) - 1));
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		GetPanelName
+//
+// Description:		Returns the name shown for the specified panel.
+//
+// Input Arguments:
+//		panel	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString ControlsFrame::GetPanelName(const unsigned int& panel) const
+{
+	if (panel > 0)
+		return wxString::Format(_T("Panel %u"), panel);
+	else if (panels.size() > 1)
+		return _T("Outside panels");
+	return _T("Whole image");
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdateCurveGrid
+//
+// Description:		Redraws the curve grid from the active panel's curves.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdateCurveGrid()
+{
+	curveGridTable->Update();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdateReferenceGrid
+//
+// Description:		Updates the reference grid to match the picker references.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdateReferenceGrid()
+{
+	const PointPicker& picker(GetPicker());
+	const auto refs(picker.GetReferences());
+	const std::vector<PointPicker::ReferencePair>& pending(picker.GetPendingReferences());
+	const std::size_t rowCount(refs.size() + pending.size());
+	referenceGrid->BeginBatch();
+	if (static_cast<size_t>(referenceGrid->GetNumberRows()) > rowCount)
+		referenceGrid->DeleteRows(0, referenceGrid->GetNumberRows() - rowCount);
+	if (static_cast<size_t>(referenceGrid->GetNumberRows()) < rowCount)
+		referenceGrid->AppendRows(rowCount - referenceGrid->GetNumberRows());
+
+	// References rejected by the robust fit are highlighted
+	const std::vector<bool>& inliers(picker.GetReferenceInliers());
+	const wxColour outlierColour(255, 200, 200);
+	unsigned int inlierCount(0);
+	for (unsigned int r = 0; r < refs.size(); ++r)
+	{
+		referenceGrid->SetCellValue(r, 0, wxString::Format(_T("%f"), refs[r].x));
+		referenceGrid->SetCellValue(r, 1, wxString::Format(_T("%f"), refs[r].y));
+
+		const bool isOutlier(r < inliers.size() && !inliers[r]);
+		const wxColour colour(isOutlier ? outlierColour : referenceGrid->GetDefaultCellBackgroundColour());
+		referenceGrid->SetCellBackgroundColour(r, 0, colour);
+		referenceGrid->SetCellBackgroundColour(r, 1, colour);
+		referenceGrid->SetReadOnly(r, 0);
+		referenceGrid->SetReadOnly(r, 1);
+		if (!isOutlier)
+			++inlierCount;
+	}
+
+	// References still waiting for values are typed in place
+	auto formatPending([](const double& value)
+	{
+		return std::isfinite(value) ? wxString::Format(_T("%f"), value) : wxString();
+	});
+
+	const wxColour pendingColour(255, 255, 200);
+	for (unsigned int i = 0; i < pending.size(); ++i)
+	{
+		const int r(static_cast<int>(refs.size() + i));
+		referenceGrid->SetCellSize(r, 0, 1, 1);
+		referenceGrid->SetCellValue(r, 0, formatPending(pending[i].valueCoords.x));
+		referenceGrid->SetCellValue(r, 1, formatPending(pending[i].valueCoords.y));
+		referenceGrid->SetCellBackgroundColour(r, 0, pendingColour);
+		referenceGrid->SetCellBackgroundColour(r, 1, pendingColour);
+		referenceGrid->SetReadOnly(r, 0, false);
+		referenceGrid->SetReadOnly(r, 1, false);
+	}
+
+	referenceGrid->EndBatch();
+
+	if (inliers.empty())
+		inlierCountText->SetLabel(wxEmptyString);
+	else
+		inlierCountText->SetLabel(wxString::Format(_T("%u of %u references are inliers"),
+			inlierCount, static_cast<unsigned int>(refs.size())));
+	inlierCountText->GetParent()->Layout();
+
+	UpdateOverlay();
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdateOverlay
+//
+// Description:		Rebuilds the calibration grid drawn over the image if any
+//					panel's fit (or the image) changed since it was last built.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdateOverlay()
+{
+	if (!imageFrame)
+		return;
+
+	if (!showGridCheckBox->GetValue())
+	{
+		if (!overlayVersions.empty())
+		{
+			overlayVersions.clear();
+			imageFrame->SetOverlay(nullptr);
+		}
+		return;
+	}
+
+	std::vector<std::pair<unsigned int, unsigned int>> versions;
+	versions.reserve(panels.size() + 1);
+	versions.emplace_back(imageWidth, imageHeight);
+	for (const auto& panel : panels)
+		versions.emplace_back(panel.id, panel.picker.GetTransformationVersion());
+	if (versions == overlayVersions)
+		return;
+	overlayVersions = std::move(versions);
+
+	// Each region's grid covers its own bounds; panel 0 and region 0 are
+	// whatever isn't claimed by a bounded panel or region
+	auto grid(std::make_shared<CalibrationGrid>());
+	for (unsigned int p = 0; p < panels.size(); ++p)
+	{
+		const PointPicker& picker(panels[p].picker);
+		for (unsigned int r = 0; r < picker.GetRegionCount(); ++r)
+		{
+			if (!picker.GetTransformation(r).IsFit())
+				continue;
+
+			RegionIndex::Bounds bounds;
+			if (r > 0)
+				bounds = picker.GetRegions()[r - 1];
+			else if (p > 0)
+				bounds = panels[p].bounds;
+			else
+				bounds = RegionIndex::Bounds(0.0, 0.0, imageWidth, imageHeight);
+
+			grid->Add(picker.GetTransformation(r), bounds, [this, p, r, &picker](const PointPicker::Point& point)
+			{
+				return FindPanel(point.x, point.y) == p && picker.FindRegion(point) == r;
+			});
+		}
+	}
+
+	imageFrame->SetOverlay(grid);
+}
+
+//==========================================================================
+// Class:			ControlsFrame
+// Function:		UpdateStatusBar
+//
+// Description:		Updates the status bar text with information for the current
+//					cursor position.
+//
+// Input Arguments:
+//		rawX	= const double&
+//		rawY	= const double&
+//		xScale	= const double&
+//		yScale	= const double&
+//		xOffset	= const double&
+//		yOffset	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ControlsFrame::UpdateStatusBar(const double& rawX, const double& rawY,
 	const double& xScale, const double& yScale,
 	const double& xOffset, const double& yOffset)
 {
+	// Values come from the panel under the cursor
+	const PointPicker& picker(panels[FindPanel(rawX * xScale + xOffset, rawY * yScale + yOffset)].picker);
+
 	double x, y;
 	PointPicker::Point p(picker.ScaleSinglePoint(rawX, rawY, xScale, yScale, xOffset, yOffset, x, y));
 	statusBar->SetStatusText(wxString::Format(_T("(%d, %d)"), (int)x, (int)y), StatusRaw);
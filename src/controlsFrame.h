@@ -6,15 +6,31 @@
 #ifndef CONTROLS_FRAME_H_
 #define CONTROLS_FRAME_H_
 
+// Standard C++ headers
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <string>
+
 // wxWidgets headers
 #include <wx/wx.h>
 #include <wx/grid.h>
 
 // Local headers
 #include "pointPicker.h"
+#include "exportJob.h"
+#include "computeWorker.h"
+#include "chartTemplate.h"
+#include "imagePyramid.h"
+#include "sessionFile.h"
+#include "sessionJournal.h"
+#include "editHistory.h"
 
 // Local forware declarations
 class ImageFrame;
+class CurveGridTable;
+class PanelSet;
 
 class ControlsFrame : public wxFrame
 {
@@ -23,20 +39,113 @@ public:
 
 	bool LoadFiles(const wxArrayString &fileList);
 
-	inline PointPicker& GetPicker() { return picker; }
+	void AddPoint(const double& rawX, const double& rawY,
+		const double& xScale, const double& yScale,
+		const double& xOffset, const double& yOffset);
 	void UpdateStatusBar(const double& rawX, const double& rawY,
 		const double& xScale, const double& yScale,
 		const double& xOffset, const double& yOffset);
-	void AddNewPoint();
+
+	void Undo();
+	void Redo();
 
 private:
 	void CreateControls();
 	wxStatusBar* BuildStatusBar();
 	void SetProperties();
-	void ResetGrids();
+	void UpdateCurveGrid();
 	void UpdateReferenceGrid();
+	void AddNewPoint();
+
+	// Moves pending references (clicked with deferred entry) that have values
+	// into the active panel's references, with one fit for all of them
+	void CommitPendingReferences();
+
+	// Curves of every panel (or just the active one) for exporting or copying
+	bool CollectCurves(const bool& activePanelOnly, PanelSet& panelSet, std::vector<std::string>& labels);
+	void CopyCurves(const bool& activePanelOnly, const int& curve);
+
+	// Each plot panel in the image has its own references, regions and curves.
+	// Panel 0 is the part of the image outside of the user-drawn panels.
+	struct Panel
+	{
+		unsigned int id;// Identifies the panel's fits; never reused
+		RegionIndex::Bounds bounds;
+		PointPicker picker;
+		std::vector<wxString> labels;// Curve names from the grid
+	};
+
+	std::vector<Panel> panels;
+	RegionIndex panelIndex;// Over the bounds of panels 1 and up
+	unsigned int activePanel;
+	unsigned int nextPanelId;
+
+	bool pointsArePanelCorners;
+	bool hasPanelCorner;
+	PointPicker::Point panelCorner;
 
-	PointPicker picker;
+	PointPicker& GetPicker() { return panels[activePanel].picker; }
+	void AddPanel(const RegionIndex::Bounds& bounds);
+	void ResetPanels();
+	unsigned int FindPanel(const double& x, const double& y) const;
+	Panel* FindPanelById(const unsigned int& id);
+	void SetActivePanel(const unsigned int& panel);
+	void SaveCurveLabels();
+	void UpdatePanelChoice();
+	wxString GetPanelName(const unsigned int& panel) const;
+
+	// Options apply to all of the panels
+	void UpdateDataExtractionMode();
+	void SetFitOptions(const PointPicker::FitOptions& options);
+
+	// Coarse copy of the current image, for aligning templates
+	ImagePyramid::Level alignmentImage;
+	unsigned int imageWidth;
+	unsigned int imageHeight;
+
+	std::unique_ptr<ChartTemplate> chartTemplate;// Selected template, if any
+	void UpdateTemplateChoice(const wxString& selection);
+	void ApplyTemplate();
+	void UpdateFitOptionControls();
+	void SelectScaleChoice(wxChoice* choice, const unsigned int& mask);
+
+	// The calibration grid is rebuilt only when a fit or the image changes;
+	// this is the image size and each panel's (ID, transformation version)
+	std::vector<std::pair<unsigned int, unsigned int>> overlayVersions;
+	void UpdateOverlay();
+
+	// Key of the current image in the image cache; the session is cached when
+	// the image is replaced or the application is closed
+	wxString imageFileName;
+	bool hasImageHash;
+	std::uint64_t imageHash;
+	bool OpenImage(const wxString& fileName);
+	bool OpenCachedImage(const std::uint64_t& hash, const wxString& fileName);
+	void ShowImage(const wxImage& image, const ImagePyramid::Level& alignment);
+
+	bool OpenSession(const wxString& fileName);
+	wxString OpenSessionImage(const SessionFile& session, const wxString& directory);
+	SessionFile CaptureSession();
+	void RestoreSession(SessionFile&& session);
+	void CacheSession();
+
+	// Edits are logged as they are made, so they can be recovered if the
+	// application crashes; other changes are saved with a checkpoint
+	SessionJournal journal;
+	void RecoverSession();
+	void CheckpointJournal();
+	void CompactJournal();
+
+	EditHistory history;
+	void ShowEdit(const EditHistory::Command& command);
+
+	ComputeWorker computeWorker;
+	void OnTransformationFitted(const unsigned int& panelId,
+		const PointPicker::TransformationSet& transformations, const unsigned int& version);
+
+	std::unique_ptr<ExportJob> exportJob;
+	void OnExportProgress(const int& percent);
+	void OnExportComplete(const ExportJob::Result& result);
 
 	enum EventIDs
 	{
@@ -44,32 +153,106 @@ private:
 		idExtractPlotData,
 
 		idResetReferences,
+		idResetRegions,
+		idResetPanels,
+		idPanel,
 		idSavePlotData,
+		idSaveSession,
+		idOpenSession,
 
 		idCurveGrid,
 		idReferenceGrid,
+		idDeferReferences,
+		idImportReferences,
 
 		idPointsAreReferences,
 		idPointsAreCurveData,
+		idPointsAreRegionCorners,
+		idPointsArePanelCorners,
+
+		idCalibrationModel,
+		idXScales,
+		idYScales,
+		idRobustFit,
+		idInlierThreshold,
+		idBootstrap,
+		idShowGrid,
+
+		idTemplate,
+		idApplyTemplate,
+		idSaveTemplate,
+		idDeleteTemplate,
 
-		idMenuRemoveReference
+		idMenuRemoveReference,
+		idMenuRemoveCurve,
+		idMenuCopyCurve,
+		idMenuCopyAllCurves,
+		idMenuCopyReferences
 	};
 
 	void CopyToClipboardToggle(wxCommandEvent& event);
 	void ExtractPlotDataToggle(wxCommandEvent& event);
 	void ResetReferencesClicked(wxCommandEvent& event);
+	void ResetRegionsClicked(wxCommandEvent& event);
+	void ResetPanelsClicked(wxCommandEvent& event);
+	void PanelChanged(wxCommandEvent& event);
 	void SavePlotDataClicked(wxCommandEvent& event);
+	void SaveSessionClicked(wxCommandEvent& event);
+	void OpenSessionClicked(wxCommandEvent& event);
+	void UndoClicked(wxCommandEvent& event);
+	void RedoClicked(wxCommandEvent& event);
+	void OnUpdateUndo(wxUpdateUIEvent& event);
+	void OnUpdateRedo(wxUpdateUIEvent& event);
 	void PointAreReferencesClicked(wxCommandEvent& event);
 	void PointAreCurveDataClicked(wxCommandEvent& event);
+	void PointAreRegionCornersClicked(wxCommandEvent& event);
+	void PointArePanelCornersClicked(wxCommandEvent& event);
 	void CurveGridClicked(wxGridEvent& event);
+	void CurveGridRightClicked(wxGridEvent& event);
+	void CurveGridChanged(wxGridEvent& event);
+	void RemoveCurveMenuClicked(wxCommandEvent& event);
+	void CopyCurveMenuClicked(wxCommandEvent& event);
+	void CopyAllCurvesMenuClicked(wxCommandEvent& event);
+	void CopyReferencesMenuClicked(wxCommandEvent& event);
 	void ReferenceGridRightClicked(wxGridEvent& event);
 	void RemoveReferenceMenuClicked(wxCommandEvent& event);
+	void ReferenceGridChanged(wxGridEvent& event);
+	void DeferReferencesChanged(wxCommandEvent& event);
+	void ImportReferencesClicked(wxCommandEvent& event);
+	void CalibrationModelChanged(wxCommandEvent& event);
+	void ScalesChanged(wxCommandEvent& event);
+	void RobustFitChanged(wxCommandEvent& event);
+	void InlierThresholdChanged(wxCommandEvent& event);
+	void BootstrapChanged(wxCommandEvent& event);
+	void ShowGridChanged(wxCommandEvent& event);
+	void TemplateChanged(wxCommandEvent& event);
+	void ApplyTemplateClicked(wxCommandEvent& event);
+	void SaveTemplateClicked(wxCommandEvent& event);
+	void DeleteTemplateClicked(wxCommandEvent& event);
 	void OnActivate(wxActivateEvent& event);
 	void OnClose(wxCloseEvent& event);
 
 	wxStaticBoxSizer* plotDataGroup;
 	wxGrid* curveGrid;
+	CurveGridTable* curveGridTable;// Owned by curveGrid
 	wxGrid* referenceGrid;
+	wxCheckBox* deferReferencesCheckBox;
+	wxChoice* panelChoice;
+	wxChoice* paddingChoice;
+	wxChoice* alignmentChoice;
+	wxTextCtrl* gridStepText;
+	wxChoice* interpolationChoice;
+	wxChoice* calibrationModelChoice;
+	wxChoice* xScaleChoice;
+	wxChoice* yScaleChoice;
+	wxCheckBox* robustFitCheckBox;
+	wxTextCtrl* inlierThresholdText;
+	wxStaticText* inlierCountText;
+	wxChoice* bootstrapChoice;
+	wxCheckBox* showGridCheckBox;
+	wxChoice* templateChoice;
+	wxCheckBox* alignTemplateCheckBox;
+	wxCheckBox* autoApplyTemplateCheckBox;
 	wxStatusBar* statusBar;
 
 	ImageFrame* imageFrame;
@@ -80,6 +263,7 @@ private:
 		StatusRaw,
 		StatusProcessedLabel,
 		StatusProcessed,
+		StatusExportInfo,
 		StatusVersionInfo,
 
 		StatusFieldCount
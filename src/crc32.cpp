@@ -0,0 +1,123 @@
+// File:  crc32.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Incremental CRC-32 (IEEE 802.3, as used by zip) computation.
+
+// Local headers
+#include "crc32.h"
+
+//==========================================================================
+// Class:			CRC32
+// Function:		Update
+//
+// Description:		Adds the specified bytes to the checksum.  Uses the
+//					slicing-by-8 method to process eight bytes per iteration.
+//
+// Input Arguments:
+//		data	= const void*
+//		length	= std::size_t
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CRC32::Update(const void* data, std::size_t length)
+{
+	const Table& t(GetTable());
+	const unsigned char* p(static_cast<const unsigned char*>(data));
+
+	while (length >= 8)
+	{
+		const std::uint32_t one(value ^ (static_cast<std::uint32_t>(p[0])
+			| (static_cast<std::uint32_t>(p[1]) << 8)
+			| (static_cast<std::uint32_t>(p[2]) << 16)
+			| (static_cast<std::uint32_t>(p[3]) << 24)));
+		const std::uint32_t two(static_cast<std::uint32_t>(p[4])
+			| (static_cast<std::uint32_t>(p[5]) << 8)
+			| (static_cast<std::uint32_t>(p[6]) << 16)
+			| (static_cast<std::uint32_t>(p[7]) << 24));
+
+		value = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF]
+			^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+			^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF]
+			^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+
+		p += 8;
+		length -= 8;
+	}
+
+	while (length-- > 0)
+		value = (value >> 8) ^ t[0][(value ^ *p++) & 0xFF];
+}
+
+//==========================================================================
+// Class:			CRC32
+// Function:		Compute
+//
+// Description:		Computes the checksum of a single block of data.
+//
+// Input Arguments:
+//		data	= const void*
+//		length	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint32_t
+//
+//==========================================================================
+std::uint32_t CRC32::Compute(const void* data, const std::size_t& length)
+{
+	CRC32 crc;
+	crc.Update(data, length);
+	return crc.Get();
+}
+
+//==========================================================================
+// Class:			CRC32
+// Function:		GetTable
+//
+// Description:		Returns the lookup tables, building them on first use.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Table&
+//
+//==========================================================================
+const CRC32::Table& CRC32::GetTable()
+{
+	static const struct Builder
+	{
+		Builder()
+		{
+			const std::uint32_t polynomial(0xEDB88320);
+			unsigned int i, j;
+			for (i = 0; i < 256; ++i)
+			{
+				std::uint32_t c(i);
+				for (j = 0; j < 8; ++j)
+					c = (c & 1) ? (polynomial ^ (c >> 1)) : (c >> 1);
+				table[0][i] = c;
+			}
+
+			for (i = 0; i < 256; ++i)
+			{
+				for (j = 1; j < 8; ++j)
+					table[j][i] = (table[j - 1][i] >> 8) ^ table[0][table[j - 1][i] & 0xFF];
+			}
+		}
+
+		Table table;
+	} builder;
+
+	return builder.table;
+}
@@ -0,0 +1,30 @@
+// File:  crc32.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Incremental CRC-32 (IEEE 802.3, as used by zip) computation.
+
+#ifndef CRC32_H_
+#define CRC32_H_
+
+// Standard C++ headers
+#include <cstdint>
+#include <cstddef>
+
+class CRC32
+{
+public:
+	CRC32() : value(0xFFFFFFFF) {}
+
+	void Update(const void* data, std::size_t length);
+	std::uint32_t Get() const { return ~value; }
+
+	static std::uint32_t Compute(const void* data, const std::size_t& length);
+
+private:
+	std::uint32_t value;
+
+	typedef std::uint32_t Table[8][256];
+	static const Table& GetTable();
+};
+
+#endif// CRC32_H_
@@ -0,0 +1,289 @@
+// File:  curveGridTable.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Virtual table behind the curve grid.
+
+// Standard C++ headers
+#include <algorithm>
+
+// Local headers
+#include "curveGridTable.h"
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		CurveGridTable
+//
+// Description:		Constructor for CurveGridTable class.
+//
+// Input Arguments:
+//		picker	= const PickerAccessor&
+//		labels	= const LabelAccessor&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CurveGridTable::CurveGridTable(const PickerAccessor& picker, const LabelAccessor& labels)
+	: picker(picker), labels(labels), rowCount(0), colCount(0)
+{
+	rowCount = GetNumberRows();
+	colCount = GetNumberCols();
+
+	nameAttr = new wxGridCellAttr;
+	nameAttr->SetSize(1, 2);
+
+	// Same as what wxGrid::SetCellSize() gives the cells a span covers
+	coveredAttr = new wxGridCellAttr;
+	coveredAttr->SetSize(0, -1);
+
+	pointAttr = new wxGridCellAttr;
+	pointAttr->SetReadOnly();
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		~CurveGridTable
+//
+// Description:		Destructor for CurveGridTable class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CurveGridTable::~CurveGridTable()
+{
+	nameAttr->DecRef();
+	coveredAttr->DecRef();
+	pointAttr->DecRef();
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		GetNumberRows
+//
+// Description:		Returns the number of rows (one more than the longest
+//					curve).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int
+//
+//==========================================================================
+int CurveGridTable::GetNumberRows()
+{
+	const PointPicker& p(picker());
+	std::size_t longest(0);
+	unsigned int c;
+	for (c = 0; c < p.GetCurveCount(); ++c)
+		longest = std::max(longest, p.GetCurveSize(c));
+
+	return static_cast<int>(longest) + 1;
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		GetNumberCols
+//
+// Description:		Returns the number of columns.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int
+//
+//==========================================================================
+int CurveGridTable::GetNumberCols()
+{
+	return static_cast<int>(picker().GetCurveCount() + 1) * 2;
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		IsEmptyCell
+//
+// Description:		Checks whether the cell has no value.
+//
+// Input Arguments:
+//		row	= int
+//		col	= int
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool CurveGridTable::IsEmptyCell(int row, int col)
+{
+	const unsigned int curve(col / 2);
+	if (row == 0)
+		return col % 2 == 1 || curve >= labels().size() || labels()[curve].IsEmpty();
+
+	const PointPicker& p(picker());
+	return curve >= p.GetCurveCount() || static_cast<std::size_t>(row) > p.GetCurveSize(curve);
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		GetValue
+//
+// Description:		Returns the text for the cell.
+//
+// Input Arguments:
+//		row	= int
+//		col	= int
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString CurveGridTable::GetValue(int row, int col)
+{
+	if (IsEmptyCell(row, col))
+		return wxEmptyString;
+
+	const unsigned int curve(col / 2);
+	if (row == 0)
+		return labels()[curve];
+
+	const PointPicker::Point& point(picker().GetCurvePoints(curve)[row - 1]);
+	return wxString::Format(_T("%f"), col % 2 == 0 ? point.x : point.y);
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		SetValue
+//
+// Description:		Stores an edited curve name.  Other cells are read only.
+//
+// Input Arguments:
+//		row		= int
+//		col		= int
+//		value	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveGridTable::SetValue(int row, int col, const wxString& value)
+{
+	if (row != 0 || col % 2 != 0)
+		return;
+
+	std::vector<wxString>& names(labels());
+	const unsigned int curve(col / 2);
+	if (names.size() <= curve)
+		names.resize(curve + 1);
+	names[curve] = value;
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		GetAttr
+//
+// Description:		Returns the attributes for the cell (with a reference held
+//					for the caller).
+//
+// Input Arguments:
+//		row		= int
+//		col		= int
+//		kind	= wxGridCellAttr::wxAttrKind
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxGridCellAttr*
+//
+//==========================================================================
+wxGridCellAttr* CurveGridTable::GetAttr(int row, int col, wxGridCellAttr::wxAttrKind WXUNUSED(kind))
+{
+	wxGridCellAttr* attr;
+	if (row > 0)
+		attr = pointAttr;
+	else if (col % 2 == 0)
+		attr = nameAttr;
+	else
+		attr = coveredAttr;
+
+	attr->IncRef();
+	return attr;
+}
+
+//==========================================================================
+// Class:			CurveGridTable
+// Function:		Update
+//
+// Description:		Sends the grid messages for the change in size since the
+//					last update, then redraws it.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveGridTable::Update()
+{
+	wxGrid* grid(GetView());
+	if (!grid)
+		return;
+
+	const int rows(GetNumberRows()), cols(GetNumberCols());
+	grid->BeginBatch();
+	if (rows < rowCount)
+	{
+		wxGridTableMessage message(this, wxGRIDTABLE_NOTIFY_ROWS_DELETED, rows, rowCount - rows);
+		grid->ProcessTableMessage(message);
+	}
+	else if (rows > rowCount)
+	{
+		wxGridTableMessage message(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED, rows - rowCount);
+		grid->ProcessTableMessage(message);
+	}
+
+	if (cols < colCount)
+	{
+		wxGridTableMessage message(this, wxGRIDTABLE_NOTIFY_COLS_DELETED, cols, colCount - cols);
+		grid->ProcessTableMessage(message);
+	}
+	else if (cols > colCount)
+	{
+		wxGridTableMessage message(this, wxGRIDTABLE_NOTIFY_COLS_APPENDED, cols - colCount);
+		grid->ProcessTableMessage(message);
+	}
+
+	rowCount = rows;
+	colCount = cols;
+	grid->EndBatch();
+	grid->ForceRefresh();
+}
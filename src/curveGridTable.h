@@ -0,0 +1,59 @@
+// File:  curveGridTable.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Virtual table behind the curve grid.  Cells are formatted from the
+//        picker's points only when the grid draws them, so curves with
+//        millions of points can be shown without filling the grid first.
+//        Row 0 holds the (editable) curve names; each curve has an x and a y
+//        column, and there is always an empty column pair at the end for
+//        starting a new curve.
+
+#ifndef CURVE_GRID_TABLE_H_
+#define CURVE_GRID_TABLE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <functional>
+
+// wxWidgets headers
+#include <wx/grid.h>
+
+// Local headers
+#include "pointPicker.h"
+
+class CurveGridTable : public wxGridTableBase
+{
+public:
+	// The picker and names are looked up on every access, so the table follows
+	// the active panel (and survives panels being added or removed)
+	typedef std::function<const PointPicker&()> PickerAccessor;
+	typedef std::function<std::vector<wxString>&()> LabelAccessor;
+
+	CurveGridTable(const PickerAccessor& picker, const LabelAccessor& labels);
+	~CurveGridTable();
+
+	int GetNumberRows() override;
+	int GetNumberCols() override;
+	bool IsEmptyCell(int row, int col) override;
+	wxString GetValue(int row, int col) override;
+	void SetValue(int row, int col, const wxString& value) override;
+	wxGridCellAttr* GetAttr(int row, int col, wxGridCellAttr::wxAttrKind kind) override;
+
+	// Tells the grid about rows and columns added or removed since the last
+	// update, and redraws it
+	void Update();
+
+private:
+	const PickerAccessor picker;
+	const LabelAccessor labels;
+
+	// Size last reported to the grid
+	int rowCount;
+	int colCount;
+
+	wxGridCellAttr* nameAttr;// Spans the curve's two columns
+	wxGridCellAttr* coveredAttr;// Second column of a name cell
+	wxGridCellAttr* pointAttr;// Read only
+};
+
+#endif// CURVE_GRID_TABLE_H_
@@ -0,0 +1,356 @@
+// File:  curveResampler.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Interpolates curves onto a shared x grid so that multiple curves can be
+//        written side by side with a single x column.
+
+// Standard C++ headers
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cassert>
+#include <limits>
+#include <iterator>
+
+// Local headers
+#include "curveResampler.h"
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the CurveResampler class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const std::size_t CurveResampler::maxGridSize(100000000);
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		CurveResampler
+//
+// Description:		Constructor for CurveResampler class.
+//
+// Input Arguments:
+//		x				= std::vector<double>&&
+//		y				= std::vector<double>&&
+//		interpolation	= const Interpolation&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CurveResampler::CurveResampler(std::vector<double>&& x, std::vector<double>&& y,
+	const Interpolation& interpolation) : x(std::move(x)), y(std::move(y)),
+	interpolation(interpolation), cursor(0)
+{
+	assert(this->x.size() == this->y.size());
+	Prepare();
+	ComputeTangents();
+}
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		Prepare
+//
+// Description:		Puts the data into a form suitable for interpolation.  Points
+//					are usually picked in order, so the sort is skipped when the
+//					data is already sorted.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveResampler::Prepare()
+{
+	std::size_t i, count(0);
+	for (i = 0; i < x.size(); ++i)
+	{
+		if (std::isfinite(x[i]) && std::isfinite(y[i]))
+		{
+			x[count] = x[i];
+			y[count] = y[i];
+			++count;
+		}
+	}
+	x.resize(count);
+	y.resize(count);
+
+	if (!std::is_sorted(x.begin(), x.end()))
+	{
+		std::vector<std::size_t> order(x.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [this](const std::size_t& a, const std::size_t& b)
+		{
+			return x[a] < x[b];
+		});
+
+		std::vector<double> sortedX(x.size()), sortedY(y.size());
+		for (i = 0; i < order.size(); ++i)
+		{
+			sortedX[i] = x[order[i]];
+			sortedY[i] = y[order[i]];
+		}
+
+		x.swap(sortedX);
+		y.swap(sortedY);
+	}
+
+	// Average any points sharing an x value
+	count = 0;
+	for (i = 0; i < x.size();)
+	{
+		std::size_t j(i + 1);
+		double sum(y[i]);
+		while (j < x.size() && x[j] == x[i])
+			sum += y[j++];
+
+		x[count] = x[i];
+		y[count] = sum / (j - i);
+		++count;
+		i = j;
+	}
+	x.resize(count);
+	y.resize(count);
+}
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		ComputeTangents
+//
+// Description:		Computes the tangents for monotone cubic Hermite interpolation
+//					using the Fritsch-Butland weighted harmonic mean, which
+//					preserves monotonicity of the data.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveResampler::ComputeTangents()
+{
+	if (interpolation != Interpolation::MonotoneCubic || x.size() < 2)
+		return;
+
+	const std::size_t n(x.size());
+	std::vector<double> h(n - 1), d(n - 1);
+	std::size_t i;
+	for (i = 0; i < n - 1; ++i)
+	{
+		h[i] = x[i + 1] - x[i];
+		d[i] = (y[i + 1] - y[i]) / h[i];
+	}
+
+	tangents.resize(n);
+	tangents.front() = d.front();
+	tangents.back() = d.back();
+	for (i = 1; i < n - 1; ++i)
+	{
+		if (d[i - 1] * d[i] <= 0.0)
+			tangents[i] = 0.0;
+		else
+			tangents[i] = 3.0 * (h[i - 1] + h[i])
+				/ ((2.0 * h[i] + h[i - 1]) / d[i - 1] + (h[i] + 2.0 * h[i - 1]) / d[i]);
+	}
+}
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		Evaluate
+//
+// Description:		Evaluates the curve at the specified grid points.  The work
+//					is split into a merge-style sweep that locates the interval
+//					for each grid point, followed by a branch-free evaluation
+//					loop over the located intervals.
+//
+// Input Arguments:
+//		grid			= const double*, increasing
+//		count			= const std::size_t&
+//		outsideValue	= const double&
+//
+// Output Arguments:
+//		out				= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveResampler::Evaluate(const double* grid, const std::size_t& count,
+	double* out, const double& outsideValue)
+{
+	std::fill(out, out + count, outsideValue);
+	if (x.empty())
+		return;
+
+	// Grid points before the first curve point stay outside
+	std::size_t first(0);
+	while (first < count && grid[first] < x.front())
+		++first;
+
+	// Sweep; the cursor persists between calls since the grid only increases
+	intervals.resize(count);
+	std::size_t last(first);
+	for (; last < count && grid[last] <= x.back(); ++last)
+	{
+		while (cursor + 2 < x.size() && x[cursor + 1] < grid[last])
+			++cursor;
+		intervals[last] = cursor;
+	}
+
+	if (x.size() == 1)
+	{
+		for (std::size_t i = first; i < last; ++i)
+			out[i] = y.front();
+		return;
+	}
+
+	const double* xData(x.data());
+	const double* yData(y.data());
+	const std::size_t* index(intervals.data());
+	std::size_t i;
+	if (interpolation == Interpolation::Linear)
+	{
+		for (i = first; i < last; ++i)
+		{
+			const std::size_t k(index[i]);
+			const double t((grid[i] - xData[k]) / (xData[k + 1] - xData[k]));
+			out[i] = yData[k] + t * (yData[k + 1] - yData[k]);
+		}
+	}
+	else
+	{
+		const double* m(tangents.data());
+		for (i = first; i < last; ++i)
+		{
+			const std::size_t k(index[i]);
+			const double h(xData[k + 1] - xData[k]);
+			const double t((grid[i] - xData[k]) / h);
+			const double t2(t * t);
+			const double t3(t2 * t);
+			out[i] = (2.0 * t3 - 3.0 * t2 + 1.0) * yData[k]
+				+ (t3 - 2.0 * t2 + t) * h * m[k]
+				+ (3.0 * t2 - 2.0 * t3) * yData[k + 1]
+				+ (t3 - t2) * h * m[k + 1];
+		}
+	}
+}
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		BuildUniformGrid
+//
+// Description:		Builds an evenly spaced grid covering all of the curves.
+//
+// Input Arguments:
+//		curves	= const std::vector<CurveResampler>&
+//		step	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<double>, empty if the step is invalid or would produce too
+//		many points
+//
+//==========================================================================
+std::vector<double> CurveResampler::BuildUniformGrid(
+	const std::vector<CurveResampler>& curves, const double& step)
+{
+	double minX(std::numeric_limits<double>::max());
+	double maxX(std::numeric_limits<double>::lowest());
+	for (const auto& c : curves)
+	{
+		if (c.IsEmpty())
+			continue;
+
+		minX = std::min(minX, c.GetMinimumX());
+		maxX = std::max(maxX, c.GetMaximumX());
+	}
+
+	if (minX > maxX || !(step > 0.0))
+		return std::vector<double>();
+
+	// Start on a multiple of the step so the grid values are round numbers
+	const double start(std::ceil(minX / step) * step);
+	const double pointCount(std::floor((maxX - start) / step) + 1.0);
+	if (!(pointCount >= 0.0) || pointCount > static_cast<double>(maxGridSize))
+		return std::vector<double>();
+
+	std::vector<double> grid(static_cast<std::size_t>(pointCount));
+	for (std::size_t i = 0; i < grid.size(); ++i)
+		grid[i] = start + step * i;
+
+	return grid;
+}
+
+//==========================================================================
+// Class:			CurveResampler
+// Function:		BuildUnionGrid
+//
+// Description:		Builds a grid containing every x value from every curve by
+//					merging the (already sorted) curves pairwise.
+//
+// Input Arguments:
+//		curves	= const std::vector<CurveResampler>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<double>
+//
+//==========================================================================
+std::vector<double> CurveResampler::BuildUnionGrid(const std::vector<CurveResampler>& curves)
+{
+	std::vector<std::vector<double>> runs;
+	for (const auto& c : curves)
+	{
+		if (!c.IsEmpty())
+			runs.push_back(c.GetX());
+	}
+
+	if (runs.empty())
+		return std::vector<double>();
+
+	while (runs.size() > 1)
+	{
+		std::vector<std::vector<double>> merged;
+		for (std::size_t i = 0; i + 1 < runs.size(); i += 2)
+		{
+			std::vector<double> m;
+			m.reserve(runs[i].size() + runs[i + 1].size());
+			std::set_union(runs[i].begin(), runs[i].end(),
+				runs[i + 1].begin(), runs[i + 1].end(), std::back_inserter(m));
+			merged.push_back(std::move(m));
+		}
+
+		if (runs.size() % 2 == 1)
+			merged.push_back(std::move(runs.back()));
+
+		runs.swap(merged);
+	}
+
+	return runs.front();
+}
@@ -0,0 +1,69 @@
+// File:  curveResampler.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Interpolates curves onto a shared x grid so that multiple curves can be
+//        written side by side with a single x column.
+
+#ifndef CURVE_RESAMPLER_H_
+#define CURVE_RESAMPLER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+
+class CurveResampler
+{
+public:
+	enum class Grid
+	{
+		None,// Curves are lined up by point index instead
+		UniformStep,
+		UnionOfX
+	};
+
+	enum class Interpolation
+	{
+		Linear,
+		MonotoneCubic
+	};
+
+	struct Settings
+	{
+		Grid grid = Grid::None;
+		double step = 1.0;
+		Interpolation interpolation = Interpolation::Linear;
+	};
+
+	// Takes ownership of the curve data; points are sorted by x (if necessary),
+	// non-finite points are dropped and points with equal x are averaged
+	CurveResampler(std::vector<double>&& x, std::vector<double>&& y, const Interpolation& interpolation);
+
+	// Evaluates the curve at grid points, which must increase across successive
+	// calls; points outside the range of the curve are set to outsideValue
+	void Evaluate(const double* grid, const std::size_t& count, double* out, const double& outsideValue);
+
+	bool IsEmpty() const { return x.empty(); }
+	double GetMinimumX() const { return x.front(); }
+	double GetMaximumX() const { return x.back(); }
+	const std::vector<double>& GetX() const { return x; }
+
+	static std::vector<double> BuildUniformGrid(const std::vector<CurveResampler>& curves, const double& step);
+	static std::vector<double> BuildUnionGrid(const std::vector<CurveResampler>& curves);
+
+	// Upper limit on generated grid size, to catch unreasonable step sizes
+	static const std::size_t maxGridSize;
+
+private:
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> tangents;
+	const Interpolation interpolation;
+
+	std::size_t cursor;
+	std::vector<std::size_t> intervals;
+
+	void Prepare();
+	void ComputeTangents();
+};
+
+#endif// CURVE_RESAMPLER_H_
@@ -0,0 +1,34 @@
+// File:  curveSource.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Interface to converted curve data, as read by the exporters.  A
+//        single picker is a source, and so is a set of pickers (one for each
+//        plot panel in an image) exported together.
+
+#ifndef CURVE_SOURCE_H_
+#define CURVE_SOURCE_H_
+
+// Standard C++ headers
+#include <cstddef>
+
+class CurveSource
+{
+public:
+	virtual ~CurveSource() = default;
+
+	virtual unsigned int GetCurveCount() const = 0;
+	virtual std::size_t GetCurveSize(const unsigned int& curve) const = 0;
+
+	// Converts a block of points into plot coordinates; x and y must have room
+	// for count values
+	virtual void ConvertCurve(const unsigned int& curve, const std::size_t& start,
+		const std::size_t& count, double* x, double* y) const = 0;
+
+	// Standard deviations of the converted points (NaN without uncertainty
+	// estimates)
+	virtual bool HasUncertainty() const = 0;
+	virtual void ConvertCurveDeviation(const unsigned int& curve, const std::size_t& start,
+		const std::size_t& count, double* xDeviation, double* yDeviation) const = 0;
+};
+
+#endif// CURVE_SOURCE_H_
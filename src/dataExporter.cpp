@@ -0,0 +1,160 @@
+// File:  dataExporter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Base class for objects that write converted curve data to file.
+
+// Standard C++ headers
+#include <limits>
+
+// Local headers
+#include "dataExporter.h"
+#include "plotDataExporter.h"
+#include "binaryDataExporter.h"
+#include "resampledDataExporter.h"
+#include "curveSource.h"
+
+//==========================================================================
+// Class:			DataExporter
+// Function:		DataExporter
+//
+// Description:		Constructor for DataExporter class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DataExporter::DataExporter() : bytesWritten(0), rowsWritten(0), cancelled(false)
+{
+}
+
+//==========================================================================
+// Class:			DataExporter
+// Function:		Create
+//
+// Description:		Factory method for exporters.  Unrecognized extensions are
+//					written as comma-separated values.  Resampled data can only
+//					be written to text and .npy files.
+//
+// Input Arguments:
+//		extension	= const std::string&, lower case, without the dot
+//		padding		= const Padding&
+//		resampling	= const CurveResampler::Settings&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<DataExporter>
+//
+//==========================================================================
+std::unique_ptr<DataExporter> DataExporter::Create(const std::string& extension, const Padding& padding,
+	const CurveResampler::Settings& resampling)
+{
+	if (resampling.grid != CurveResampler::Grid::None)
+	{
+		if (extension == "npz" || extension == "ppc")
+			return nullptr;
+
+		return std::make_unique<ResampledDataExporter>(resampling,
+			extension == "txt" ? '\t' : ',', padding, extension == "npy");
+	}
+
+	// Binary files have no notion of an empty cell
+	const double padValue(padding == Padding::Zero ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+
+	if (extension == "npy")
+		return std::make_unique<BinaryDataExporter>(BinaryDataExporter::Format::NumPy, padValue);
+	else if (extension == "npz")
+		return std::make_unique<BinaryDataExporter>(BinaryDataExporter::Format::NumPyArchive, padValue);
+	else if (extension == "ppc")
+		return std::make_unique<BinaryDataExporter>(BinaryDataExporter::Format::Columnar, padValue);
+	else if (extension == "txt")
+		return std::make_unique<PlotDataExporter>('\t', padding);
+
+	return std::make_unique<PlotDataExporter>(',', padding);
+}
+
+//==========================================================================
+// Class:			DataExporter
+// Function:		ResetStatus
+//
+// Description:		Clears the results of any previous export.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataExporter::ResetStatus()
+{
+	bytesWritten = 0;
+	rowsWritten = 0;
+	errorString.clear();
+	cancelled = false;
+}
+
+//==========================================================================
+// Class:			DataExporter
+// Function:		ReportProgress
+//
+// Description:		Passes progress to the callback, if one was provided.
+//
+// Input Arguments:
+//		pointsDone	= const std::uint64_t&
+//		pointsTotal	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if the export should stop
+//
+//==========================================================================
+bool DataExporter::ReportProgress(const std::uint64_t& pointsDone, const std::uint64_t& pointsTotal)
+{
+	if (!progressCallback)
+		return true;
+
+	const double fraction(pointsTotal > 0 ? static_cast<double>(pointsDone) / pointsTotal : 1.0);
+	if (progressCallback(fraction))
+		return true;
+
+	cancelled = true;
+	errorString = "Export cancelled.";
+	return false;
+}
+
+//==========================================================================
+// Class:			DataExporter
+// Function:		GetTotalPointCount
+//
+// Description:		Returns the number of points in all curves.
+//
+// Input Arguments:
+//		source	= const CurveSource&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t DataExporter::GetTotalPointCount(const CurveSource& source)
+{
+	std::uint64_t count(0);
+	for (unsigned int i = 0; i < source.GetCurveCount(); ++i)
+		count += source.GetCurveSize(i);
+	return count;
+}
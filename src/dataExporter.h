@@ -0,0 +1,68 @@
+// File:  dataExporter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Base class for objects that write converted curve data to file.
+
+#ifndef DATA_EXPORTER_H_
+#define DATA_EXPORTER_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+// Local headers
+#include "curveResampler.h"
+
+// Local forward declarations
+class CurveSource;
+
+class DataExporter
+{
+public:
+	virtual ~DataExporter() = default;
+
+	enum class Padding
+	{
+		Empty,
+		NaN,
+		Zero
+	};
+
+	// Creates the appropriate exporter for the specified file extension (without the dot);
+	// returns nullptr if the format does not support the requested resampling
+	static std::unique_ptr<DataExporter> Create(const std::string& extension, const Padding& padding,
+		const CurveResampler::Settings& resampling = CurveResampler::Settings());
+
+	virtual bool Export(const std::string& fileName, const CurveSource& source,
+		const std::vector<std::string>& labels) = 0;
+
+	// Callback receives the completed fraction and returns false to cancel the export
+	typedef std::function<bool(const double&)> ProgressCallback;
+	void SetProgressCallback(const ProgressCallback& callback) { progressCallback = callback; }
+
+	std::uint64_t GetBytesWritten() const { return bytesWritten; }
+	std::uint64_t GetRowsWritten() const { return rowsWritten; }
+	std::string GetErrorString() const { return errorString; }
+	bool WasCancelled() const { return cancelled; }
+
+protected:
+	DataExporter();
+
+	void ResetStatus();
+	bool ReportProgress(const std::uint64_t& pointsDone, const std::uint64_t& pointsTotal);
+
+	static std::uint64_t GetTotalPointCount(const CurveSource& source);
+
+	std::uint64_t bytesWritten;
+	std::uint64_t rowsWritten;
+	std::string errorString;
+
+private:
+	ProgressCallback progressCallback;
+	bool cancelled;
+};
+
+#endif// DATA_EXPORTER_H_
@@ -0,0 +1,353 @@
+// File:  diagnosticsPanel.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Notebook page showing the timings and counters collected by the profiler,
+//        with controls for recording a timeline trace.
+
+// Local headers
+#include "diagnosticsPanel.h"
+#include "profiler.h"
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the DiagnosticsPanel class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const int DiagnosticsPanel::refreshInterval(500);// [msec]
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		DiagnosticsPanel
+//
+// Description:		Constructor for DiagnosticsPanel class.
+//
+// Input Arguments:
+//		parent	= wxWindow*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DiagnosticsPanel::DiagnosticsPanel(wxWindow* parent) : wxPanel(parent),
+	refreshTimer(this, idRefreshTimer)
+{
+	CreateControls();
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		~DiagnosticsPanel
+//
+// Description:		Destructor for DiagnosticsPanel class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DiagnosticsPanel::~DiagnosticsPanel()
+{
+	Profiler::SetEnabled(false);
+	TraceRecorder::Stop();
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		Event Table
+//
+// Description:		Links GUI events with event handler functions.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BEGIN_EVENT_TABLE(DiagnosticsPanel, wxPanel)
+	EVT_CHECKBOX(idEnable, DiagnosticsPanel::EnableToggled)
+	EVT_BUTTON(idReset, DiagnosticsPanel::ResetClicked)
+	EVT_BUTTON(idSave, DiagnosticsPanel::SaveClicked)
+	EVT_CHECKBOX(idTrace, DiagnosticsPanel::TraceToggled)
+	EVT_BUTTON(idSaveTrace, DiagnosticsPanel::SaveTraceClicked)
+	EVT_TIMER(idRefreshTimer, DiagnosticsPanel::OnRefreshTimer)
+END_EVENT_TABLE()
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		CreateControls
+//
+// Description:		Creates sizers and controls and lays them out in the window.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::CreateControls()
+{
+	wxSizer* mainSizer(new wxBoxSizer(wxVERTICAL));
+	wxSizer* buttonSizer(new wxBoxSizer(wxHORIZONTAL));
+	mainSizer->Add(buttonSizer, wxSizerFlags().Expand().Border(wxALL, 5));
+
+	traceCheckBox = new wxCheckBox(this, idTrace, _T("Record trace"));
+	buttonSizer->Add(new wxCheckBox(this, idEnable, _T("Record timings")), wxSizerFlags().CenterVertical());
+	buttonSizer->AddSpacer(10);
+	buttonSizer->Add(traceCheckBox, wxSizerFlags().CenterVertical());
+	buttonSizer->AddStretchSpacer();
+	buttonSizer->Add(new wxButton(this, idReset, _T("Reset")));
+	buttonSizer->Add(new wxButton(this, idSave, _T("Save Report")));
+	buttonSizer->Add(new wxButton(this, idSaveTrace, _T("Save Trace")));
+
+	const int probeCount(static_cast<int>(Profiler::Probe::Count));
+	const int counterCount(static_cast<int>(Profiler::Counter::Count));
+
+	grid = new wxGrid(this, wxID_ANY);
+	grid->BeginBatch();
+	grid->CreateGrid(probeCount + counterCount, 5);
+	grid->EnableEditing(false);
+	grid->SetColLabelValue(0, _T("Count"));
+	grid->SetColLabelValue(1, _T("p50 (ms)"));
+	grid->SetColLabelValue(2, _T("p99 (ms)"));
+	grid->SetColLabelValue(3, _T("Max (ms)"));
+	grid->SetColLabelValue(4, _T("Total (ms)"));
+
+	int i;
+	for (i = 0; i < probeCount; ++i)
+		grid->SetRowLabelValue(i, wxString::FromUTF8(Profiler::GetName(static_cast<Profiler::Probe>(i))));
+	for (i = 0; i < counterCount; ++i)
+		grid->SetRowLabelValue(probeCount + i, wxString::FromUTF8(Profiler::GetName(static_cast<Profiler::Counter>(i))));
+	grid->SetRowLabelSize(wxGRID_AUTOSIZE);
+	grid->EndBatch();
+
+	mainSizer->Add(grid, wxSizerFlags().Expand().Proportion(1));
+
+	UpdateGrid();
+	SetSizer(mainSizer);
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		UpdateGrid
+//
+// Description:		Refreshes the grid with the current profiler data.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::UpdateGrid()
+{
+	const int probeCount(static_cast<int>(Profiler::Probe::Count));
+	const int counterCount(static_cast<int>(Profiler::Counter::Count));
+
+	grid->BeginBatch();
+
+	int i;
+	for (i = 0; i < probeCount; ++i)
+	{
+		const Profiler::Statistics s(Profiler::GetStatistics(static_cast<Profiler::Probe>(i)));
+		grid->SetCellValue(i, 0, wxString::Format(_T("%llu"), static_cast<unsigned long long>(s.count)));
+		grid->SetCellValue(i, 1, wxString::Format(_T("%.3f"), s.p50Seconds * 1.0e3));
+		grid->SetCellValue(i, 2, wxString::Format(_T("%.3f"), s.p99Seconds * 1.0e3));
+		grid->SetCellValue(i, 3, wxString::Format(_T("%.3f"), s.maximumSeconds * 1.0e3));
+		grid->SetCellValue(i, 4, wxString::Format(_T("%.3f"), s.totalSeconds * 1.0e3));
+	}
+
+	for (i = 0; i < counterCount; ++i)
+		grid->SetCellValue(probeCount + i, 0, wxString::Format(_T("%llu"),
+			static_cast<unsigned long long>(Profiler::GetCount(static_cast<Profiler::Counter>(i)))));
+
+	grid->EndBatch();
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		EnableToggled
+//
+// Description:		Turns data collection on or off.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::EnableToggled(wxCommandEvent& event)
+{
+	Profiler::SetEnabled(event.IsChecked());
+	if (event.IsChecked())
+		refreshTimer.Start(refreshInterval);
+	else
+	{
+		refreshTimer.Stop();
+		UpdateGrid();
+	}
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		ResetClicked
+//
+// Description:		Clears the collected data.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::ResetClicked(wxCommandEvent& WXUNUSED(event))
+{
+	Profiler::Reset();
+	UpdateGrid();
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		SaveClicked
+//
+// Description:		Writes the collected data to a text file.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::SaveClicked(wxCommandEvent& WXUNUSED(event))
+{
+	wxFileDialog dialog(this, _T("Save Diagnostics Report"), wxEmptyString, _T("diagnostics.txt"),
+		_T("Text Files (*.txt)|*.txt"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	if (!Profiler::WriteReport(dialog.GetPath().ToUTF8().data()))
+		wxMessageBox(_T("Failed to write '") + dialog.GetPath() + _T("'."), _T("Error"));
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		TraceToggled
+//
+// Description:		Starts or stops recording a trace.  Starting discards the
+//					previous trace.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::TraceToggled(wxCommandEvent& event)
+{
+	if (event.IsChecked())
+		TraceRecorder::Start();
+	else
+		TraceRecorder::Stop();
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		SaveTraceClicked
+//
+// Description:		Stops recording and writes the trace to a JSON file which
+//					can be opened in Perfetto or chrome://tracing.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::SaveTraceClicked(wxCommandEvent& WXUNUSED(event))
+{
+	TraceRecorder::Stop();
+	traceCheckBox->SetValue(false);
+
+	wxFileDialog dialog(this, _T("Save Trace"), wxEmptyString, _T("trace.json"),
+		_T("JSON Files (*.json)|*.json"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	if (!TraceRecorder::Write(dialog.GetPath().ToUTF8().data()))
+		wxMessageBox(_T("Failed to write '") + dialog.GetPath() + _T("'."), _T("Error"));
+}
+
+//==========================================================================
+// Class:			DiagnosticsPanel
+// Function:		OnRefreshTimer
+//
+// Description:		Periodically refreshes the grid while the page is visible.
+//
+// Input Arguments:
+//		event	= wxTimerEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DiagnosticsPanel::OnRefreshTimer(wxTimerEvent& WXUNUSED(event))
+{
+	if (IsShownOnScreen())
+		UpdateGrid();
+}
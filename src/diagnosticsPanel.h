@@ -0,0 +1,51 @@
+// File:  diagnosticsPanel.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Notebook page showing the timings and counters collected by the profiler,
+//        with controls for recording a timeline trace.
+
+#ifndef DIAGNOSTICS_PANEL_H_
+#define DIAGNOSTICS_PANEL_H_
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/grid.h>
+
+class DiagnosticsPanel : public wxPanel
+{
+public:
+	explicit DiagnosticsPanel(wxWindow* parent);
+	virtual ~DiagnosticsPanel();
+
+private:
+	void CreateControls();
+	void UpdateGrid();
+
+	wxGrid* grid;
+	wxCheckBox* traceCheckBox;
+	wxTimer refreshTimer;
+
+	enum EventIDs
+	{
+		idEnable = wxID_HIGHEST + 200,
+		idReset,
+		idSave,
+		idTrace,
+		idSaveTrace,
+		idRefreshTimer
+	};
+
+	void EnableToggled(wxCommandEvent& event);
+	void ResetClicked(wxCommandEvent& event);
+	void SaveClicked(wxCommandEvent& event);
+	void TraceToggled(wxCommandEvent& event);
+	void SaveTraceClicked(wxCommandEvent& event);
+	void OnRefreshTimer(wxTimerEvent& event);
+
+	// Display refreshes only while recording
+	static const int refreshInterval;// [msec]
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif// DIAGNOSTICS_PANEL_H_
@@ -0,0 +1,913 @@
+// File:  digitizationService.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Headless service that converts curve pixel data for other programs on
+//        the same host.
+
+// Standard C++ headers
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+
+// POSIX headers
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// wxWidgets headers
+#include <wx/log.h>
+
+// Local headers
+#include "digitizationService.h"
+#include "serviceRequest.h"
+#include "binaryDataExporter.h"
+#include "bufferedWriter.h"
+#include "profiler.h"
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the DigitizationService class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+volatile std::sig_atomic_t DigitizationService::stopSignal(0);
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		DigitizationService
+//
+// Description:		Constructor for DigitizationService class.
+//
+// Input Arguments:
+//		address	= const std::string&, "unix:<path>", "tcp:<port>" or a path
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DigitizationService::DigitizationService(const std::string& address) : address(address),
+	listenSocket(-1), stopping(false), useCounter(0)
+{
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		~DigitizationService
+//
+// Description:		Destructor for DigitizationService class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DigitizationService::~DigitizationService()
+{
+	CloseSocket();
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		OnStopSignal
+//
+// Description:		Signal handler for SIGINT and SIGTERM.
+//
+// Input Arguments:
+//		signal	= int
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DigitizationService::OnStopSignal(int WXUNUSED(signal))
+{
+	stopSignal = 1;
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		Run
+//
+// Description:		Opens the socket, starts the worker pool and accepts
+//					connections until a stop signal is received.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool DigitizationService::Run()
+{
+#ifdef _WIN32
+	errorString = "Service mode is not supported on this platform.";
+	return false;
+#else
+	if (!OpenSocket())
+		return false;
+
+	stopSignal = 0;
+	std::signal(SIGINT, OnStopSignal);
+	std::signal(SIGTERM, OnStopSignal);
+	std::signal(SIGPIPE, SIG_IGN);// Clients that disconnect early are handled where send() fails
+
+	const unsigned int threadCount(std::max(1U, std::thread::hardware_concurrency()));
+	for (unsigned int i = 0; i < threadCount; ++i)
+		workers.push_back(std::thread(&DigitizationService::WorkerLoop, this));
+
+	while (!stopSignal)
+	{
+		pollfd p;
+		p.fd = listenSocket;
+		p.events = POLLIN;
+		p.revents = 0;
+
+		// Time out periodically to check for the stop signal
+		const int ready(poll(&p, 1, 500));
+		if (ready < 0 && errno != EINTR)
+		{
+			errorString = std::string("Failed waiting for connections: ") + std::strerror(errno);
+			break;
+		}
+		else if (ready <= 0)
+			continue;
+
+		const int connection(accept(listenSocket, nullptr, nullptr));
+		if (connection < 0)
+			continue;
+
+		{
+			std::lock_guard<std::mutex> lock(connectionMutex);
+			connections.push_back(connection);
+		}
+		connectionCondition.notify_one();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(connectionMutex);
+		stopping = true;
+
+		// Wake workers that are waiting on idle clients
+		for (const auto& c : activeConnections)
+			shutdown(c, SHUT_RDWR);
+	}
+	connectionCondition.notify_all();
+
+	for (auto& w : workers)
+		w.join();
+	workers.clear();
+
+	for (const auto& c : connections)
+		close(c);
+	connections.clear();
+
+	CloseSocket();
+	return errorString.empty();
+#endif
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		OpenSocket
+//
+// Description:		Creates the listening socket.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool DigitizationService::OpenSocket()
+{
+#ifdef _WIN32
+	return false;
+#else
+	const std::string tcpPrefix("tcp:");
+	const std::string unixPrefix("unix:");
+
+	if (address.compare(0, tcpPrefix.length(), tcpPrefix) == 0)
+	{
+		std::istringstream ss(address.substr(tcpPrefix.length()));
+		unsigned int port;
+		if (!(ss >> port) || port == 0 || port > std::numeric_limits<std::uint16_t>::max())
+		{
+			errorString = "Invalid port in '" + address + "'.";
+			return false;
+		}
+
+		listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+		if (listenSocket < 0)
+		{
+			errorString = std::string("Failed to create socket: ") + std::strerror(errno);
+			return false;
+		}
+
+		const int reuse(1);
+		setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+		// Only accept connections from this host
+		sockaddr_in socketAddress;
+		std::memset(&socketAddress, 0, sizeof(socketAddress));
+		socketAddress.sin_family = AF_INET;
+		socketAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		socketAddress.sin_port = htons(static_cast<std::uint16_t>(port));
+		if (bind(listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0)
+		{
+			errorString = "Failed to bind to " + address + ": " + std::strerror(errno);
+			CloseSocket();
+			return false;
+		}
+	}
+	else
+	{
+		const std::string path(address.compare(0, unixPrefix.length(), unixPrefix) == 0 ?
+			address.substr(unixPrefix.length()) : address);
+
+		sockaddr_un socketAddress;
+		std::memset(&socketAddress, 0, sizeof(socketAddress));
+		socketAddress.sun_family = AF_UNIX;
+		if (path.empty() || path.length() >= sizeof(socketAddress.sun_path))
+		{
+			errorString = "Invalid socket path '" + path + "'.";
+			return false;
+		}
+		std::memcpy(socketAddress.sun_path, path.c_str(), path.length());
+
+		listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listenSocket < 0)
+		{
+			errorString = std::string("Failed to create socket: ") + std::strerror(errno);
+			return false;
+		}
+
+		// A socket file left behind by a previous run can be removed, but not one
+		// that another instance is still listening on
+		if (connect(listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) == 0)
+		{
+			errorString = "Another service is already listening on '" + path + "'.";
+			CloseSocket();
+			return false;
+		}
+		close(listenSocket);
+		listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+		unlink(path.c_str());
+
+		if (listenSocket < 0 ||
+			bind(listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0)
+		{
+			errorString = "Failed to bind to '" + path + "': " + std::strerror(errno);
+			CloseSocket();
+			return false;
+		}
+		socketPath = path;
+	}
+
+	if (listen(listenSocket, SOMAXCONN) != 0)
+	{
+		errorString = std::string("Failed to listen: ") + std::strerror(errno);
+		CloseSocket();
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		CloseSocket
+//
+// Description:		Closes the listening socket, removing the socket file if
+//					there is one.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DigitizationService::CloseSocket()
+{
+#ifndef _WIN32
+	if (listenSocket >= 0)
+		close(listenSocket);
+
+	if (!socketPath.empty())
+		unlink(socketPath.c_str());
+#endif
+
+	listenSocket = -1;
+	socketPath.clear();
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		WorkerLoop
+//
+// Description:		Worker thread entry point.  Serves one connection at a time.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DigitizationService::WorkerLoop()
+{
+#ifndef _WIN32
+	TraceRecorder::SetThreadName("Service worker");
+	while (true)
+	{
+		int connection;
+		{
+			std::unique_lock<std::mutex> lock(connectionMutex);
+			connectionCondition.wait(lock, [this]()
+			{
+				return stopping || !connections.empty();
+			});
+
+			if (stopping)
+				return;
+
+			connection = connections.front();
+			connections.pop_front();
+			activeConnections.insert(connection);
+		}
+
+		HandleConnection(connection);
+
+		{
+			std::lock_guard<std::mutex> lock(connectionMutex);
+			activeConnections.erase(connection);
+		}
+		close(connection);
+	}
+#endif
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		HandleConnection
+//
+// Description:		Reads requests from the connection and sends the responses
+//					until the client disconnects.
+//
+// Input Arguments:
+//		connection	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DigitizationService::HandleConnection(const int& connection)
+{
+#ifndef _WIN32
+	auto sendAll([connection](const std::string& data)
+	{
+		std::size_t sent(0);
+		while (sent < data.size())
+		{
+			const ssize_t count(send(connection, data.data() + sent, data.size() - sent, 0));
+			if (count < 0 && errno == EINTR)
+				continue;
+			else if (count <= 0)
+				return false;
+			sent += count;
+		}
+		return true;
+	});
+
+	std::unique_ptr<ServiceRequest> request(std::make_unique<ServiceRequest>());
+	std::string firstError;
+	std::string buffer;
+	std::size_t lineStart(0), searchFrom(0);
+	std::vector<char> chunk(1 << 16);
+
+	while (true)
+	{
+		const std::string::size_type lineEnd(buffer.find('\n', searchFrom));
+		if (lineEnd == std::string::npos)
+		{
+			buffer.erase(0, lineStart);
+			lineStart = 0;
+			searchFrom = buffer.size();
+			if (buffer.size() > maxLineLength)
+			{
+				sendAll(BuildErrorResponse("Line is too long."));
+				return;
+			}
+
+			const ssize_t count(recv(connection, chunk.data(), chunk.size(), 0));
+			if (count < 0 && errno == EINTR)
+				continue;
+			else if (count <= 0)
+				return;
+
+			buffer.append(chunk.data(), count);
+			continue;
+		}
+
+		const std::string line(buffer, lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+		searchFrom = lineStart;
+
+		// Keep parsing after an error so we can find the end of the request
+		if (!request->ParseLine(line) && firstError.empty())
+			firstError = request->GetErrorString();
+
+		if (!request->IsComplete())
+			continue;
+
+		std::string response;
+		if (firstError.empty())
+			response = Process(*request);
+		else
+			response = BuildErrorResponse(firstError);
+
+		if (!sendAll(response))
+			return;
+
+		request = std::make_unique<ServiceRequest>();
+		firstError.clear();
+	}
+#endif
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		Process
+//
+// Description:		Converts the curves in a complete request.
+//
+// Input Arguments:
+//		request	= const ServiceRequest&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string, response including the format/length line
+//
+//==========================================================================
+std::string DigitizationService::Process(const ServiceRequest& request)
+{
+	TraceRecorder::Scope trace("Request", "service");
+	std::string error;
+	std::shared_ptr<const wxImage> image;
+	if (!request.GetImagePath().empty())
+	{
+		image = GetImage(request.GetImagePath(), error);
+		if (!image)
+			return BuildErrorResponse(error);
+	}
+
+	std::vector<PointPicker::ReferencePair> references(request.GetReferences());
+	if (!request.GetTemplateName().empty())
+	{
+		std::lock_guard<std::mutex> lock(templateMutex);
+		if (!references.empty())
+			templates[request.GetTemplateName()] = references;
+		else
+		{
+			const auto it(templates.find(request.GetTemplateName()));
+			if (it == templates.end())
+				return BuildErrorResponse("Unknown template '" + request.GetTemplateName() + "'.");
+			references = it->second;
+		}
+	}
+
+	if (references.size() < 4)
+		return BuildErrorResponse("At least four references are required.");
+
+	if (image)
+	{
+		const double width(image->GetWidth()), height(image->GetHeight());
+		auto isInside([width, height](const PointPicker::Point& p)
+		{
+			return p.x >= 0.0 && p.x <= width && p.y >= 0.0 && p.y <= height;
+		});
+
+		for (const auto& r : references)
+		{
+			if (!isInside(r.imageCoords))
+				return BuildErrorResponse("Reference lies outside of the image.");
+		}
+
+		for (const auto& curve : request.GetCurves())
+		{
+			for (const auto& p : curve)
+			{
+				if (!isInside(p))
+					return BuildErrorResponse("Curve point lies outside of the image.");
+			}
+		}
+	}
+
+	PointPicker picker;
+	picker.SetFitRequestHandler([]()
+	{
+		// Fit once, below, after all of the references have been added
+	});
+
+	for (const auto& r : request.GetRegions())
+		picker.AddRegion(PointPicker::Point(r.xMin, r.yMin), PointPicker::Point(r.xMax, r.yMax));
+	for (const auto& r : references)
+		picker.AddReference(r.imageCoords, r.valueCoords, r.weight);
+	picker.ApplyTransformations(GetTransformations(references, request.GetRegions(),
+		request.GetFitOptions()), picker.GetReferenceVersion());
+	if (!picker.GetErrorString().empty())
+		return BuildErrorResponse(std::string(picker.GetErrorString().ToUTF8()) + '.');
+
+	const std::vector<std::vector<PointPicker::Point>>& curves(request.GetCurves());
+	unsigned int i;
+	for (i = 0; i < curves.size(); ++i)
+	{
+		for (const auto& p : curves[i])
+			picker.AddCurvePoint(i, p);
+	}
+
+	if (request.GetFormat() == ServiceRequest::Format::NumPy)
+	{
+		std::ostringstream ss;
+		BinaryDataExporter exporter(BinaryDataExporter::Format::NumPy, std::numeric_limits<double>::quiet_NaN());
+		if (!exporter.Write(ss, picker, request.GetLabels()))
+			return BuildErrorResponse(exporter.GetErrorString());
+
+		const std::string payload(ss.str());
+		return "npy " + std::to_string(payload.size()) + "\n" + payload;
+	}
+
+	std::string json("{\"status\":\"ok\"");
+	if (image)
+	{
+		json.append(",\"image\":{\"width\":" + std::to_string(image->GetWidth())
+			+ ",\"height\":" + std::to_string(image->GetHeight()) + "}");
+	}
+
+	// The top level scales are for the rest of the image (region 0)
+	const PointPicker::Transformation& transformation(picker.GetTransformation(0));
+	json.append(",\"xLogarithmic\":");
+	json.append(transformation.xScale == AxisScale::Type::Logarithmic ? "true" : "false");
+	json.append(",\"yLogarithmic\":");
+	json.append(transformation.yScale == AxisScale::Type::Logarithmic ? "true" : "false");
+	json.append(",\"xScale\":\"");
+	json.append(AxisScale::GetName(transformation.xScale));
+	json.append("\",\"yScale\":\"");
+	json.append(AxisScale::GetName(transformation.yScale));
+	json.push_back('"');
+
+	if (picker.GetRegionCount() > 1)
+	{
+		// One entry per REGION, in request order
+		json.append(",\"regions\":[");
+		for (i = 1; i < picker.GetRegionCount(); ++i)
+		{
+			const PointPicker::Transformation& regionTransformation(picker.GetTransformation(i));
+			if (i > 1)
+				json.push_back(',');
+			json.append("{\"fit\":");
+			json.append(regionTransformation.IsFit() ? "true" : "false");
+			json.append(",\"xScale\":\"");
+			json.append(AxisScale::GetName(regionTransformation.xScale));
+			json.append("\",\"yScale\":\"");
+			json.append(AxisScale::GetName(regionTransformation.yScale));
+			json.append("\"}");
+		}
+		json.push_back(']');
+	}
+
+	const std::vector<bool>& inliers(picker.GetReferenceInliers());
+	if (!inliers.empty())
+	{
+		// Indices of the references rejected by the robust fit
+		json.append(",\"outliers\":[");
+		bool first(true);
+		for (i = 0; i < inliers.size(); ++i)
+		{
+			if (inliers[i])
+				continue;
+			if (!first)
+				json.push_back(',');
+			json.append(std::to_string(i));
+			first = false;
+		}
+		json.push_back(']');
+	}
+	json.append(",\"curves\":[");
+
+	std::vector<double> x, y;
+	for (i = 0; i < curves.size(); ++i)
+	{
+		const std::size_t size(i < picker.GetCurveCount() ? picker.GetCurveSize(i) : 0);
+		x.resize(size);
+		y.resize(size);
+		if (size > 0)
+			picker.ConvertCurve(i, 0, size, x.data(), y.data());
+
+		if (i > 0)
+			json.push_back(',');
+		json.append("{\"label\":");
+		AppendJsonString(json, request.GetLabels()[i]);
+
+		json.append(",\"x\":[");
+		std::size_t j;
+		for (j = 0; j < size; ++j)
+		{
+			if (j > 0)
+				json.push_back(',');
+			AppendJsonNumber(json, x[j]);
+		}
+
+		json.append("],\"y\":[");
+		for (j = 0; j < size; ++j)
+		{
+			if (j > 0)
+				json.push_back(',');
+			AppendJsonNumber(json, y[j]);
+		}
+		json.append("]}");
+	}
+	json.append("]}");
+
+	return "json " + std::to_string(json.size()) + "\n" + json;
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		GetImage
+//
+// Description:		Returns the decoded image, loading it if it is not cached or
+//					if the file has changed since it was cached.
+//
+// Input Arguments:
+//		path	= const std::string&
+//
+// Output Arguments:
+//		error	= std::string&
+//
+// Return Value:
+//		std::shared_ptr<const wxImage>, null on error
+//
+//==========================================================================
+std::shared_ptr<const wxImage> DigitizationService::GetImage(const std::string& path, std::string& error)
+{
+	std::error_code fileError;
+	const std::filesystem::file_time_type modified(std::filesystem::last_write_time(path, fileError));
+	if (fileError)
+	{
+		error = "Failed to open '" + path + "': " + fileError.message();
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(imageMutex);
+		const auto it(images.find(path));
+		if (it != images.end() && it->second.modified == modified)
+		{
+			it->second.lastUse = ++useCounter;
+			return it->second.image;
+		}
+	}
+
+	// Decode without holding the lock so other requests are not held up
+	std::shared_ptr<wxImage> image(std::make_shared<wxImage>());
+	{
+		Profiler::ScopedTimer timer(Profiler::Probe::ImageDecode);
+		wxLogNull suppressLogging;
+		if (!image->LoadFile(wxString::FromUTF8(path.c_str())) || !image->IsOk())
+		{
+			error = "Failed to load image '" + path + "'.";
+			return nullptr;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(imageMutex);
+	CachedImage& entry(images[path]);
+	entry.image = image;
+	entry.modified = modified;
+	entry.lastUse = ++useCounter;
+
+	if (images.size() > imageCacheSize)
+	{
+		images.erase(std::min_element(images.begin(), images.end(), [](const auto& a, const auto& b)
+		{
+			return a.second.lastUse < b.second.lastUse;
+		}));
+	}
+
+	return image;
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		GetTransformations
+//
+// Description:		Returns the transformations for the specified references and
+//					regions, fitting them only if the same references and
+//					regions have not been seen recently.
+//
+// Input Arguments:
+//		references	= const std::vector<PointPicker::ReferencePair>&
+//		regions		= const std::vector<RegionIndex::Bounds>&
+//		options		= const PointPicker::FitOptions&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PointPicker::TransformationSet
+//
+//==========================================================================
+PointPicker::TransformationSet DigitizationService::GetTransformations(
+	const std::vector<PointPicker::ReferencePair>& references,
+	const std::vector<RegionIndex::Bounds>& regions, const PointPicker::FitOptions& options)
+{
+	std::string key(reinterpret_cast<const char*>(references.data()),
+		references.size() * sizeof(PointPicker::ReferencePair));
+	if (!regions.empty())
+	{
+		key.push_back('G');
+		key.append(reinterpret_cast<const char*>(regions.data()), regions.size() * sizeof(RegionIndex::Bounds));
+	}
+	if (options.xScales != AxisScale::defaultMask || options.yScales != AxisScale::defaultMask)
+	{
+		key.push_back('S');
+		key.append(reinterpret_cast<const char*>(&options.xScales), sizeof(options.xScales));
+		key.append(reinterpret_cast<const char*>(&options.yScales), sizeof(options.yScales));
+	}
+	if (options.robust)
+	{
+		key.push_back('R');
+		key.append(reinterpret_cast<const char*>(&options.inlierThreshold), sizeof(options.inlierThreshold));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(transformationMutex);
+		const auto it(transformations.find(key));
+		if (it != transformations.end())
+		{
+			it->second.lastUse = ++useCounter;
+			return it->second.transformations;
+		}
+	}
+
+	const PointPicker::TransformationSet fitted(PointPicker::FitTransformations(references, regions, options));
+
+	std::lock_guard<std::mutex> lock(transformationMutex);
+	CachedTransformation& entry(transformations[key]);
+	entry.transformations = fitted;
+	entry.lastUse = ++useCounter;
+
+	if (transformations.size() > transformationCacheSize)
+	{
+		transformations.erase(std::min_element(transformations.begin(), transformations.end(),
+			[](const auto& a, const auto& b)
+		{
+			return a.second.lastUse < b.second.lastUse;
+		}));
+	}
+
+	return fitted;
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		BuildErrorResponse
+//
+// Description:		Builds a JSON error response.
+//
+// Input Arguments:
+//		message	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string, response including the format/length line
+//
+//==========================================================================
+std::string DigitizationService::BuildErrorResponse(const std::string& message)
+{
+	std::string json("{\"status\":\"error\",\"message\":");
+	AppendJsonString(json, message);
+	json.push_back('}');
+
+	return "json " + std::to_string(json.size()) + "\n" + json;
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		AppendJsonString
+//
+// Description:		Appends a quoted and escaped JSON string.
+//
+// Input Arguments:
+//		s		= const std::string&, UTF-8
+//
+// Output Arguments:
+//		json	= std::string&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DigitizationService::AppendJsonString(std::string& json, const std::string& s)
+{
+	json.push_back('"');
+	for (const auto& c : s)
+	{
+		if (c == '"' || c == '\\')
+		{
+			json.push_back('\\');
+			json.push_back(c);
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			char escape[8];
+			std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned int>(c));
+			json.append(escape);
+		}
+		else
+			json.push_back(c);
+	}
+	json.push_back('"');
+}
+
+//==========================================================================
+// Class:			DigitizationService
+// Function:		AppendJsonNumber
+//
+// Description:		Appends a number.  JSON has no representation for non-finite
+//					values, so they are written as null.
+//
+// Input Arguments:
+//		value	= const double&
+//
+// Output Arguments:
+//		json	= std::string&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DigitizationService::AppendJsonNumber(std::string& json, const double& value)
+{
+	if (!std::isfinite(value))
+	{
+		json.append("null");
+		return;
+	}
+
+	char s[BufferedWriter::maxNumberLength];
+	json.append(s, BufferedWriter::FormatNumber(s, value));
+}
@@ -0,0 +1,112 @@
+// File:  digitizationService.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Headless service that converts curve pixel data for other programs on
+//        the same host.  Listens on a Unix domain socket ("unix:<path>" or just
+//        a path) or on a localhost TCP port ("tcp:<port>").  See
+//        serviceRequest.h for the request format.
+//
+//        Each response is a single line giving the payload format and length
+//        ("json <bytes>" or "npy <bytes>"), followed by the payload.  Errors are
+//        always returned as JSON with "status" set to "error".  A connection
+//        may send any number of requests.
+
+#ifndef DIGITIZATION_SERVICE_H_
+#define DIGITIZATION_SERVICE_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <csignal>
+#include <filesystem>
+
+// wxWidgets headers
+#include <wx/image.h>
+
+// Local headers
+#include "pointPicker.h"
+
+// Local forward declarations
+class ServiceRequest;
+
+class DigitizationService
+{
+public:
+	explicit DigitizationService(const std::string& address);
+	~DigitizationService();
+
+	// Blocks until interrupted (SIGINT or SIGTERM)
+	bool Run();
+
+	std::string GetErrorString() const { return errorString; }
+
+	static constexpr std::size_t imageCacheSize = 8;
+	static constexpr std::size_t transformationCacheSize = 256;
+	static constexpr std::size_t maxLineLength = 1 << 24;
+
+private:
+	const std::string address;
+	std::string errorString;
+
+	int listenSocket;
+	std::string socketPath;// Removed on exit for Unix domain sockets
+
+	bool OpenSocket();
+	void CloseSocket();
+
+	// Worker pool; connections are handed out as they are accepted
+	std::vector<std::thread> workers;
+	std::deque<int> connections;
+	std::set<int> activeConnections;
+	bool stopping;
+	std::mutex connectionMutex;
+	std::condition_variable connectionCondition;
+
+	void WorkerLoop();
+	void HandleConnection(const int& connection);
+	std::string Process(const ServiceRequest& request);
+
+	// Decoded images and fitted transformations are kept between requests
+	struct CachedImage
+	{
+		std::shared_ptr<const wxImage> image;
+		std::filesystem::file_time_type modified;
+		std::uint64_t lastUse;
+	};
+
+	struct CachedTransformation
+	{
+		PointPicker::TransformationSet transformations;
+		std::uint64_t lastUse;
+	};
+
+	std::map<std::string, CachedImage> images;
+	std::mutex imageMutex;
+	std::map<std::string, CachedTransformation> transformations;
+	std::mutex transformationMutex;
+	std::map<std::string, std::vector<PointPicker::ReferencePair>> templates;
+	std::mutex templateMutex;
+	std::atomic<std::uint64_t> useCounter;
+
+	std::shared_ptr<const wxImage> GetImage(const std::string& path, std::string& error);
+	PointPicker::TransformationSet GetTransformations(const std::vector<PointPicker::ReferencePair>& references,
+		const std::vector<RegionIndex::Bounds>& regions, const PointPicker::FitOptions& options);
+
+	static volatile std::sig_atomic_t stopSignal;
+	static void OnStopSignal(int signal);
+
+	static std::string BuildErrorResponse(const std::string& message);
+	static void AppendJsonString(std::string& json, const std::string& s);
+	static void AppendJsonNumber(std::string& json, const double& value);
+};
+
+#endif// DIGITIZATION_SERVICE_H_
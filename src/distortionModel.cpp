@@ -0,0 +1,595 @@
+// File:  distortionModel.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Nonlinear correction applied to image coordinates before the projective
+//        transformation.
+
+// Standard C++ headers
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+
+// Local headers
+#include "distortionModel.h"
+#include "levenbergMarquardt.h"
+
+//==========================================================================
+// Class:			DistortionModel::FitModel
+//
+// Description:		Residuals for the combined distortion and projective fit.
+//					The first eight parameters are the transformation matrix
+//					(with the last element fixed at one); the rest are the
+//					distortion coefficients.  Each residual is the plot-space
+//					error mapped back to the image through the inverse of the
+//					local Jacobian, which is the image distance to the point
+//					that maps exactly onto the reference value (to first order,
+//					as in one Newton step of Invert()).  Each residual is scaled
+//					by the square root of the reference's weight.
+//
+//==========================================================================
+template <int CoefficientCount>
+class DistortionModel::FitModel
+{
+public:
+	typedef LevenbergMarquardt<8 + CoefficientCount> Solver;
+
+	FitModel(const Type& type, const std::vector<Eigen::Vector2d>& imagePoints,
+		const std::vector<Eigen::Vector2d>& plotPoints, const std::vector<double>& weights) : type(type),
+		imagePoints(imagePoints), plotPoints(plotPoints), scales(weights.size())
+	{
+		std::size_t i;
+		for (i = 0; i < weights.size(); ++i)
+			scales[i] = std::sqrt(std::max(weights[i], 0.0));
+	}
+
+	std::size_t GetObservationCount() const { return imagePoints.size(); }
+
+	void Evaluate(const typename Solver::Parameters& p, const std::size_t& i,
+		typename Solver::Residual& r, typename Solver::Jacobian* j) const
+	{
+		auto residual([this, &i](const typename Solver::Parameters& p, typename Solver::Residual& r)
+		{
+			const double* c(p.data() + 8);
+			double u, v;
+			Warp(type, c, imagePoints[i].x(), imagePoints[i].y(), u, v);
+			const double w(p(6) * u + p(7) * v + 1.0);
+			const Eigen::Vector2d plot((p(0) * u + p(1) * v + p(2)) / w, (p(3) * u + p(4) * v + p(5)) / w);
+
+			Eigen::Matrix2d projectionJacobian;
+			projectionJacobian << p(0) - plot.x() * p(6), p(1) - plot.x() * p(7),
+				p(3) - plot.y() * p(6), p(4) - plot.y() * p(7);
+			projectionJacobian /= w;
+
+			// A singular Jacobian gives a non-finite cost, so the step is rejected
+			Eigen::Matrix2d warpJacobian;
+			WarpJacobian(type, c, imagePoints[i].x(), imagePoints[i].y(), warpJacobian);
+			const Eigen::Matrix2d jacobian(projectionJacobian * warpJacobian);
+			r = scales[i] * (jacobian.inverse() * (plot - plotPoints[i]));
+		});
+
+		residual(p, r);
+		if (j)
+			Solver::NumericalJacobian(residual, p, *j);
+	}
+
+private:
+	const Type type;
+	const std::vector<Eigen::Vector2d>& imagePoints;
+	const std::vector<Eigen::Vector2d>& plotPoints;
+	std::vector<double> scales;
+};
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		DistortionModel
+//
+// Description:		Constructor for DistortionModel class.  Creates a model
+//					that does nothing.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DistortionModel::DistortionModel() : type(Type::None), centerX(0.0), centerY(0.0), inverseScale(1.0)
+{
+	for (auto& c : coefficients)
+		c = 0.0;
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		GetCoefficientCount
+//
+// Description:		Returns the number of distortion coefficients used by the
+//					specified model.
+//
+// Input Arguments:
+//		type	= const Type&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int DistortionModel::GetCoefficientCount(const Type& type)
+{
+	switch (type)
+	{
+	case Type::Polynomial2:
+		return 6;// x^2, xy, y^2 terms for each ordinate
+	case Type::Polynomial3:
+		return 14;// Plus x^3, x^2 y, x y^2, y^3
+	case Type::Radial:
+		return 4;// k1, k2, p1, p2
+	default:
+		return 0;
+	}
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		GetMinimumReferenceCount
+//
+// Description:		Returns the number of references required to fit the
+//					specified model with at least one degree of freedom left
+//					over.
+//
+// Input Arguments:
+//		type	= const Type&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int DistortionModel::GetMinimumReferenceCount(const Type& type)
+{
+	// Two equations per reference, eight parameters in the transformation
+	return (8 + GetCoefficientCount(type)) / 2 + 1;
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		GetName
+//
+// Description:		Returns the display name for the specified model.
+//
+// Input Arguments:
+//		type	= const Type&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char*
+//
+//==========================================================================
+const char* DistortionModel::GetName(const Type& type)
+{
+	switch (type)
+	{
+	case Type::None:
+		return "Projective";
+	case Type::Polynomial2:
+		return "2nd-order polynomial";
+	case Type::Polynomial3:
+		return "3rd-order polynomial";
+	case Type::Radial:
+		return "Radial (Brown-Conrady)";
+	default:
+		return "";
+	}
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		Warp
+//
+// Description:		Applies the distortion to normalized coordinates.
+//
+// Input Arguments:
+//		type	= const Type&
+//		c		= const double*, coefficients
+//		x		= const double&
+//		y		= const double&
+//
+// Output Arguments:
+//		u		= double&
+//		v		= double&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DistortionModel::Warp(const Type& type, const double* c,
+	const double& x, const double& y, double& u, double& v)
+{
+	if (type == Type::Polynomial2)
+	{
+		u = x + c[0] * x * x + c[1] * x * y + c[2] * y * y;
+		v = y + c[3] * x * x + c[4] * x * y + c[5] * y * y;
+	}
+	else if (type == Type::Polynomial3)
+	{
+		u = x + c[0] * x * x + c[1] * x * y + c[2] * y * y
+			+ c[3] * x * x * x + c[4] * x * x * y + c[5] * x * y * y + c[6] * y * y * y;
+		v = y + c[7] * x * x + c[8] * x * y + c[9] * y * y
+			+ c[10] * x * x * x + c[11] * x * x * y + c[12] * x * y * y + c[13] * y * y * y;
+	}
+	else if (type == Type::Radial)
+	{
+		const double r2(x * x + y * y);
+		const double radial(1.0 + r2 * (c[0] + r2 * c[1]));
+		u = x * radial + 2.0 * c[2] * x * y + c[3] * (r2 + 2.0 * x * x);
+		v = y * radial + c[2] * (r2 + 2.0 * y * y) + 2.0 * c[3] * x * y;
+	}
+	else
+	{
+		u = x;
+		v = y;
+	}
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		WarpJacobian
+//
+// Description:		Computes the derivatives of the warp with respect to the
+//					normalized coordinates.
+//
+// Input Arguments:
+//		type		= const Type&
+//		c			= const double*, coefficients
+//		x			= const double&
+//		y			= const double&
+//
+// Output Arguments:
+//		jacobian	= Eigen::Matrix2d&, rows are u and v, columns x and y
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DistortionModel::WarpJacobian(const Type& type, const double* c,
+	const double& x, const double& y, Eigen::Matrix2d& jacobian)
+{
+	if (type == Type::Polynomial2)
+	{
+		jacobian << 1.0 + 2.0 * c[0] * x + c[1] * y, c[1] * x + 2.0 * c[2] * y,
+			2.0 * c[3] * x + c[4] * y, 1.0 + c[4] * x + 2.0 * c[5] * y;
+	}
+	else if (type == Type::Polynomial3)
+	{
+		jacobian << 1.0 + 2.0 * c[0] * x + c[1] * y + 3.0 * c[3] * x * x + 2.0 * c[4] * x * y + c[5] * y * y,
+			c[1] * x + 2.0 * c[2] * y + c[4] * x * x + 2.0 * c[5] * x * y + 3.0 * c[6] * y * y,
+			2.0 * c[7] * x + c[8] * y + 3.0 * c[10] * x * x + 2.0 * c[11] * x * y + c[12] * y * y,
+			1.0 + c[8] * x + 2.0 * c[9] * y + c[11] * x * x + 2.0 * c[12] * x * y + 3.0 * c[13] * y * y;
+	}
+	else if (type == Type::Radial)
+	{
+		const double r2(x * x + y * y);
+		const double radial(1.0 + r2 * (c[0] + r2 * c[1]));
+		const double radialSlope(2.0 * (c[0] + 2.0 * r2 * c[1]));// d(radial)/dx = x * radialSlope
+		jacobian << radial + x * x * radialSlope + 2.0 * c[2] * y + 6.0 * c[3] * x,
+			x * y * radialSlope + 2.0 * c[2] * x + 2.0 * c[3] * y,
+			x * y * radialSlope + 2.0 * c[2] * x + 2.0 * c[3] * y,
+			radial + y * y * radialSlope + 6.0 * c[2] * y + 2.0 * c[3] * x;
+	}
+	else
+		jacobian.setIdentity();
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		Apply
+//
+// Description:		Normalizes and warps a single point.
+//
+// Input Arguments:
+//		x	= const double&
+//		y	= const double&
+//
+// Output Arguments:
+//		u	= double&
+//		v	= double&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DistortionModel::Apply(const double& x, const double& y, double& u, double& v) const
+{
+	Warp(type, coefficients, (x - centerX) * inverseScale, (y - centerY) * inverseScale, u, v);
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		Apply
+//
+// Description:		Normalizes and warps an array of points in place.
+//
+// Input Arguments:
+//		count	= const std::size_t&
+//		x		= double*
+//		y		= double*
+//
+// Output Arguments:
+//		x		= double*
+//		y		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DistortionModel::Apply(const std::size_t& count, double* x, double* y) const
+{
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		x[i] = (x[i] - centerX) * inverseScale;
+		y[i] = (y[i] - centerY) * inverseScale;
+	}
+
+	const double* c(coefficients);
+	if (type == Type::Polynomial2)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			const double xi(x[i]), yi(y[i]);
+			x[i] = xi + c[0] * xi * xi + c[1] * xi * yi + c[2] * yi * yi;
+			y[i] = yi + c[3] * xi * xi + c[4] * xi * yi + c[5] * yi * yi;
+		}
+	}
+	else if (type == Type::Polynomial3)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			const double xi(x[i]), yi(y[i]);
+			x[i] = xi + c[0] * xi * xi + c[1] * xi * yi + c[2] * yi * yi
+				+ c[3] * xi * xi * xi + c[4] * xi * xi * yi + c[5] * xi * yi * yi + c[6] * yi * yi * yi;
+			y[i] = yi + c[7] * xi * xi + c[8] * xi * yi + c[9] * yi * yi
+				+ c[10] * xi * xi * xi + c[11] * xi * xi * yi + c[12] * xi * yi * yi + c[13] * yi * yi * yi;
+		}
+	}
+	else if (type == Type::Radial)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			const double xi(x[i]), yi(y[i]);
+			const double r2(xi * xi + yi * yi);
+			const double radial(1.0 + r2 * (c[0] + r2 * c[1]));
+			x[i] = xi * radial + 2.0 * c[2] * xi * yi + c[3] * (r2 + 2.0 * xi * xi);
+			y[i] = yi * radial + c[2] * (r2 + 2.0 * yi * yi) + 2.0 * c[3] * xi * yi;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		Invert
+//
+// Description:		Maps an array of points on the plane the transformation
+//					matrix acts on back to image coordinates, in place.
+//
+// Input Arguments:
+//		count	= const std::size_t&
+//		u		= double*
+//		v		= double*
+//
+// Output Arguments:
+//		u		= double*, image x
+//		v		= double*, image y
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DistortionModel::Invert(const std::size_t& count, double* u, double* v) const
+{
+	const unsigned int maxIterations(20);
+	const double tolerance(1.0e-12);// [normalized units]
+	const double step(1.0e-7);// For the Jacobian [normalized units]
+
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		// The warp is close to the identity, so the target is a good start
+		const double targetU(u[i]), targetV(v[i]);
+		double x(targetU), y(targetV);
+		bool converged(false);
+		unsigned int iteration;
+		for (iteration = 0; iteration < maxIterations && std::isfinite(x) && std::isfinite(y); ++iteration)
+		{
+			double wu, wv;
+			Warp(type, coefficients, x, y, wu, wv);
+			const double ru(wu - targetU), rv(wv - targetV);
+			if (ru * ru + rv * rv < tolerance * tolerance)
+			{
+				converged = true;
+				break;
+			}
+
+			double xu, xv, yu, yv;
+			Warp(type, coefficients, x + step, y, xu, xv);
+			Warp(type, coefficients, x, y + step, yu, yv);
+			const double j00((xu - wu) / step), j01((yu - wu) / step);
+			const double j10((xv - wv) / step), j11((yv - wv) / step);
+			const double determinant(j00 * j11 - j01 * j10);
+			if (std::abs(determinant) < tolerance)
+				break;
+
+			x -= (j11 * ru - j01 * rv) / determinant;
+			y -= (j00 * rv - j10 * ru) / determinant;
+		}
+
+		if (converged)
+		{
+			u[i] = x / inverseScale + centerX;
+			v[i] = y / inverseScale + centerY;
+		}
+		else
+		{
+			u[i] = std::numeric_limits<double>::quiet_NaN();
+			v[i] = std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		Fit
+//
+// Description:		Fits the specified model to the references.
+//
+// Input Arguments:
+//		type			= const Type&
+//		imagePoints		= const std::vector<Eigen::Vector2d>&
+//		plotPoints		= const std::vector<Eigen::Vector2d>&, linearized
+//		weights			= const std::vector<double>&
+//		initialMatrix	= const Eigen::Matrix3d&, DLT result
+//
+// Output Arguments:
+//		model			= DistortionModel&
+//		matrix			= Eigen::Matrix3d&
+//
+// Return Value:
+//		bool, false if there are not enough references or the fit failed
+//
+//==========================================================================
+bool DistortionModel::Fit(const Type& type, const std::vector<Eigen::Vector2d>& imagePoints,
+	const std::vector<Eigen::Vector2d>& plotPoints, const std::vector<double>& weights,
+	const Eigen::Matrix3d& initialMatrix, DistortionModel& model, Eigen::Matrix3d& matrix)
+{
+	assert(imagePoints.size() == plotPoints.size());
+	assert(imagePoints.size() == weights.size());
+	if (imagePoints.size() < GetMinimumReferenceCount(type))
+		return false;
+
+	switch (type)
+	{
+	case Type::Polynomial2:
+		return Fit<6>(type, imagePoints, plotPoints, weights, initialMatrix, model, matrix);
+	case Type::Polynomial3:
+		return Fit<14>(type, imagePoints, plotPoints, weights, initialMatrix, model, matrix);
+	case Type::Radial:
+		return Fit<4>(type, imagePoints, plotPoints, weights, initialMatrix, model, matrix);
+	default:
+		return false;
+	}
+}
+
+//==========================================================================
+// Class:			DistortionModel
+// Function:		Fit
+//
+// Description:		Fits a model with the specified number of coefficients.
+//					Image points are normalized to have zero mean and an RMS
+//					distance of one from the origin; plot points are normalized
+//					the same way, but separately for each axis.
+//
+// Input Arguments:
+//		type			= const Type&
+//		imagePoints		= const std::vector<Eigen::Vector2d>&
+//		plotPoints		= const std::vector<Eigen::Vector2d>&, linearized
+//		weights			= const std::vector<double>&
+//		initialMatrix	= const Eigen::Matrix3d&, DLT result
+//
+// Output Arguments:
+//		model			= DistortionModel&
+//		matrix			= Eigen::Matrix3d&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+template <int CoefficientCount>
+bool DistortionModel::Fit(const Type& type, const std::vector<Eigen::Vector2d>& imagePoints,
+	const std::vector<Eigen::Vector2d>& plotPoints, const std::vector<double>& weights,
+	const Eigen::Matrix3d& initialMatrix, DistortionModel& model, Eigen::Matrix3d& matrix)
+{
+	const std::size_t count(imagePoints.size());
+
+	Eigen::Vector2d imageCenter(Eigen::Vector2d::Zero());
+	Eigen::Vector2d plotCenter(Eigen::Vector2d::Zero());
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		imageCenter += imagePoints[i];
+		plotCenter += plotPoints[i];
+	}
+	imageCenter /= static_cast<double>(count);
+	plotCenter /= static_cast<double>(count);
+
+	double imageSpread(0.0);
+	Eigen::Vector2d plotSpread(Eigen::Vector2d::Zero());
+	for (i = 0; i < count; ++i)
+	{
+		imageSpread += (imagePoints[i] - imageCenter).squaredNorm();
+		plotSpread += (plotPoints[i] - plotCenter).cwiseAbs2();
+	}
+	imageSpread = std::sqrt(imageSpread / count);
+	plotSpread = (plotSpread / static_cast<double>(count)).cwiseSqrt();
+
+	if (imageSpread <= 0.0 || plotSpread.minCoeff() <= 0.0)
+		return false;
+
+	std::vector<Eigen::Vector2d> normalizedImage(count), normalizedPlot(count);
+	for (i = 0; i < count; ++i)
+	{
+		normalizedImage[i] = (imagePoints[i] - imageCenter) / imageSpread;
+		normalizedPlot[i] = (plotPoints[i] - plotCenter).cwiseQuotient(plotSpread);
+	}
+
+	Eigen::Matrix3d normalizedToImage(Eigen::Matrix3d::Identity());
+	normalizedToImage(0,0) = imageSpread;
+	normalizedToImage(1,1) = imageSpread;
+	normalizedToImage.block<2,1>(0,2) = imageCenter;
+
+	Eigen::Matrix3d plotToNormalized(Eigen::Matrix3d::Identity());
+	plotToNormalized(0,0) = 1.0 / plotSpread.x();
+	plotToNormalized(1,1) = 1.0 / plotSpread.y();
+	plotToNormalized.block<2,1>(0,2) = -plotCenter.cwiseQuotient(plotSpread);
+
+	// Express the DLT result in normalized coordinates
+	Eigen::Matrix3d initial(plotToNormalized * initialMatrix * normalizedToImage);
+	if (std::abs(initial(2,2)) < 1.0e-12)
+		return false;
+	initial /= initial(2,2);
+
+	typedef typename FitModel<CoefficientCount>::Solver Solver;
+	typename Solver::Parameters p;
+	p << initial(0,0), initial(0,1), initial(0,2),
+		initial(1,0), initial(1,1), initial(1,2),
+		initial(2,0), initial(2,1), Eigen::Matrix<double, CoefficientCount, 1>::Zero();
+
+	const FitModel<CoefficientCount> fitModel(type, normalizedImage, normalizedPlot, weights);
+	const typename Solver::Result result(Solver::Minimize(fitModel, p));
+	if (!std::isfinite(result.finalCost) || !p.allFinite())
+		return false;
+
+	model.type = type;
+	model.centerX = imageCenter.x();
+	model.centerY = imageCenter.y();
+	model.inverseScale = 1.0 / imageSpread;
+	for (i = 0; i < maxCoefficients; ++i)
+		model.coefficients[i] = i < static_cast<std::size_t>(CoefficientCount) ? p(8 + i) : 0.0;
+
+	Eigen::Matrix3d normalizedMatrix;
+	normalizedMatrix << p(0), p(1), p(2),
+		p(3), p(4), p(5),
+		p(6), p(7), 1.0;
+	matrix = plotToNormalized.inverse() * normalizedMatrix;
+
+	return true;
+}
@@ -0,0 +1,93 @@
+// File:  distortionModel.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Nonlinear correction applied to image coordinates before the projective
+//        transformation, for images (i.e. photos of printed plots) where a
+//        homography alone leaves curvature error.  Coordinates are first
+//        normalized about the centroid of the reference points, then warped by
+//        either a 2nd/3rd-order polynomial or the Brown-Conrady radial and
+//        tangential model.
+
+#ifndef DISTORTION_MODEL_H_
+#define DISTORTION_MODEL_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+
+// Eigen headers
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4018)// signed/unsigned mismatch
+#pragma warning(disable:4456)// declaration hides previous local declaration
+#pragma warning(disable:4714)// function marked as __forceinline not inlined
+#pragma warning(disable:4800)// forcing value to bool 'true' or 'false'
+#endif
+#include <Eigen/Dense>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+class DistortionModel
+{
+public:
+	enum class Type
+	{
+		None,
+		Polynomial2,
+		Polynomial3,
+		Radial
+	};
+
+	DistortionModel();
+
+	Type GetType() const { return type; }
+
+	static unsigned int GetCoefficientCount(const Type& type);
+	static unsigned int GetMinimumReferenceCount(const Type& type);
+	static const char* GetName(const Type& type);
+
+	// Maps image coordinates to the plane the transformation matrix acts on
+	void Apply(const double& x, const double& y, double& u, double& v) const;
+
+	// Same as above for many points, in place.  Each step is a separate,
+	// branch-free pass over the arrays so the compiler can vectorize it.
+	void Apply(const std::size_t& count, double* x, double* y) const;
+
+	// Inverse of Apply(), in place.  The warp has no closed-form inverse, so
+	// each point is found by Newton iteration; points where it doesn't
+	// converge (far outside the references) are set to NaN.
+	void Invert(const std::size_t& count, double* u, double* v) const;
+
+	// Fits the distortion together with the projective transformation, starting
+	// from the DLT result, to minimize the error in image coordinates.  Plot
+	// points must already be linearized (for log axes, log10 of the value).  On
+	// success, matrix maps the output of model.Apply() to (linearized) plot
+	// coordinates.  Weights scale each reference's squared residual.
+	static bool Fit(const Type& type, const std::vector<Eigen::Vector2d>& imagePoints,
+		const std::vector<Eigen::Vector2d>& plotPoints, const std::vector<double>& weights,
+		const Eigen::Matrix3d& initialMatrix, DistortionModel& model, Eigen::Matrix3d& matrix);
+
+private:
+	static constexpr unsigned int maxCoefficients = 14;
+
+	Type type;
+	double centerX;
+	double centerY;
+	double inverseScale;
+	double coefficients[maxCoefficients];
+
+	static void Warp(const Type& type, const double* c, const double& x, const double& y, double& u, double& v);
+	static void WarpJacobian(const Type& type, const double* c, const double& x, const double& y,
+		Eigen::Matrix2d& jacobian);
+
+	template <int CoefficientCount>
+	class FitModel;
+
+	template <int CoefficientCount>
+	static bool Fit(const Type& type, const std::vector<Eigen::Vector2d>& imagePoints,
+		const std::vector<Eigen::Vector2d>& plotPoints, const std::vector<double>& weights,
+		const Eigen::Matrix3d& initialMatrix, DistortionModel& model, Eigen::Matrix3d& matrix);
+};
+
+#endif// DISTORTION_MODEL_H_
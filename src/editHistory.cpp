@@ -0,0 +1,99 @@
+// File:  editHistory.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Undo and redo lists for the edits made while digitizing.
+
+// Local headers
+#include "editHistory.h"
+
+//==========================================================================
+// Class:			EditHistory
+// Function:		Add
+//
+// Description:		Adds a command that has just been done.
+//
+// Input Arguments:
+//		command	= Command&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void EditHistory::Add(Command&& command)
+{
+	undoCommands.push_back(std::move(command));
+	redoCommands.clear();
+}
+
+//==========================================================================
+// Class:			EditHistory
+// Function:		Undo
+//
+// Description:		Moves the newest command onto the redo list.  Must not be
+//					called unless CanUndo() is true.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Command&, valid until the history is next changed
+//
+//==========================================================================
+EditHistory::Command& EditHistory::Undo()
+{
+	redoCommands.push_back(std::move(undoCommands.back()));
+	undoCommands.pop_back();
+	return redoCommands.back();
+}
+
+//==========================================================================
+// Class:			EditHistory
+// Function:		Redo
+//
+// Description:		Moves the most recently undone command back onto the undo
+//					list.  Must not be called unless CanRedo() is true.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Command&, valid until the history is next changed
+//
+//==========================================================================
+EditHistory::Command& EditHistory::Redo()
+{
+	undoCommands.push_back(std::move(redoCommands.back()));
+	redoCommands.pop_back();
+	return undoCommands.back();
+}
+
+//==========================================================================
+// Class:			EditHistory
+// Function:		Clear
+//
+// Description:		Discards all commands.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void EditHistory::Clear()
+{
+	undoCommands.clear();
+	redoCommands.clear();
+}
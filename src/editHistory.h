@@ -0,0 +1,74 @@
+// File:  editHistory.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Undo and redo lists for the edits made while digitizing.  Commands
+//        record what changed (a point, a reference, a removed curve) rather
+//        than copies of the session, so adding, undoing and redoing a command
+//        each take constant time.
+
+#ifndef EDIT_HISTORY_H_
+#define EDIT_HISTORY_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "pointPicker.h"
+
+class EditHistory
+{
+public:
+	enum class Type
+	{
+		AddCurvePoint,
+		AddReference,
+		RemoveReference,
+		ResetCurveData
+	};
+
+	struct Command
+	{
+		Command(const Type& type, const unsigned int& panel, const unsigned int& index)
+			: type(type), panel(panel), index(index) {}
+
+		Type type;
+		unsigned int panel;
+		unsigned int index;// Curve or reference
+		PointPicker::ReferencePair reference;// Only imageCoords is used for curve points
+
+		// Only reference and curve removal commands need these, so they are
+		// kept out of line to keep point commands small
+		struct Detail
+		{
+			PointPicker::SavedFit fit;// Shared with the picker, for the references on the other side
+			std::vector<PointPicker::Point> points;
+			wxString label;
+		};
+
+		std::unique_ptr<Detail> detail;
+	};
+
+	// Discards anything that could have been redone
+	void Add(Command&& command);
+
+	bool CanUndo() const { return !undoCommands.empty(); }
+	bool CanRedo() const { return !redoCommands.empty(); }
+
+	// Moves the newest command to the other list and returns it; the caller
+	// reverses (or repeats) it
+	Command& Undo();
+	Command& Redo();
+
+	// For changes that commands can't be undone across (i.e. panels removed)
+	void Clear();
+
+private:
+	std::vector<Command> undoCommands;
+	std::vector<Command> redoCommands;
+};
+
+#endif// EDIT_HISTORY_H_
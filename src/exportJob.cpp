@@ -0,0 +1,180 @@
+// File:  exportJob.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Runs a data export on a worker thread using a snapshot of the plot panels.
+
+// Standard C++ headers
+#include <filesystem>
+#include <cmath>
+
+// Local headers
+#include "exportJob.h"
+#include "profiler.h"
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			ExportJob
+// Function:		ExportJob
+//
+// Description:		Constructor for ExportJob class.
+//
+// Input Arguments:
+//		snapshot	= const PanelSet&, copied so the caller may continue to
+//					  modify its pickers while the export runs
+//		exporter	= std::unique_ptr<DataExporter>
+//		fileName	= const std::string&
+//		labels		= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ExportJob::ExportJob(const PanelSet& snapshot, std::unique_ptr<DataExporter> exporter,
+	const std::string& fileName, const std::vector<std::string>& labels)
+	: panels(snapshot), exporter(std::move(exporter)), fileName(fileName), labels(labels),
+	cancelRequested(false)
+{
+}
+
+//==========================================================================
+// Class:			ExportJob
+// Function:		~ExportJob
+//
+// Description:		Destructor for ExportJob class.  Stops the export if it is
+//					still running.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ExportJob::~ExportJob()
+{
+	Cancel();
+	Wait();
+}
+
+//==========================================================================
+// Class:			ExportJob
+// Function:		Start
+//
+// Description:		Starts the worker thread.
+//
+// Input Arguments:
+//		progressCallback	= const ProgressCallback&, called each time the
+//							  completed percentage changes
+//		completionCallback	= const CompletionCallback&, called once when the
+//							  export finishes, fails or is cancelled
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ExportJob::Start(const ProgressCallback& progressCallback, const CompletionCallback& completionCallback)
+{
+	thread = std::thread(&ExportJob::Run, this, progressCallback, completionCallback);
+}
+
+//==========================================================================
+// Class:			ExportJob
+// Function:		Wait
+//
+// Description:		Blocks until the worker thread exits.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ExportJob::Wait()
+{
+	if (thread.joinable())
+		thread.join();
+}
+
+//==========================================================================
+// Class:			ExportJob
+// Function:		Run
+//
+// Description:		Worker thread entry point.  Data is written to a temporary
+//					file next to the destination, which is renamed over the
+//					destination only after the export succeeds.
+//
+// Input Arguments:
+//		progressCallback	= const ProgressCallback&
+//		completionCallback	= const CompletionCallback&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ExportJob::Run(const ProgressCallback& progressCallback, const CompletionCallback& completionCallback)
+{
+	TraceRecorder::SetThreadName("Export");
+	int lastPercent(-1);
+	exporter->SetProgressCallback([this, &lastPercent, &progressCallback](const double& fraction)
+	{
+		const int percent(static_cast<int>(std::floor(fraction * 100.0)));
+		if (percent != lastPercent)
+		{
+			lastPercent = percent;
+			if (progressCallback)
+				progressCallback(percent);
+		}
+
+		return !cancelRequested;
+	});
+
+	// The snapshot may have been taken while a fit was still pending
+	panels.UpdateTransformations();
+
+	const std::string temporaryFileName(fileName + ".partial");
+
+	Result result;
+	{
+		Profiler::ScopedTimer timer(Profiler::Probe::Export);
+		result.success = !cancelRequested && exporter->Export(temporaryFileName, panels, labels);
+	}
+	result.cancelled = cancelRequested || exporter->WasCancelled();
+	result.rowsWritten = exporter->GetRowsWritten();
+	result.bytesWritten = exporter->GetBytesWritten();
+	result.errorString = result.cancelled ? std::string("Export cancelled.") : exporter->GetErrorString();
+	Profiler::Increment(Profiler::Counter::RowsExported, result.rowsWritten);
+	Profiler::Increment(Profiler::Counter::BytesExported, result.bytesWritten);
+
+	std::error_code error;
+	if (result.success)
+	{
+		std::filesystem::rename(temporaryFileName, fileName, error);
+		if (error)
+		{
+			result.success = false;
+			result.errorString = "Failed to replace '" + fileName + "': " + error.message();
+		}
+	}
+
+	if (!result.success)
+		std::filesystem::remove(temporaryFileName, error);
+
+	if (completionCallback)
+		completionCallback(result);
+}
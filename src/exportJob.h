@@ -0,0 +1,58 @@
+// File:  exportJob.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Runs a data export on a worker thread using a snapshot of the plot panels.
+
+#ifndef EXPORT_JOB_H_
+#define EXPORT_JOB_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+// Local headers
+#include "panelSet.h"
+#include "dataExporter.h"
+
+class ExportJob
+{
+public:
+	ExportJob(const PanelSet& snapshot, std::unique_ptr<DataExporter> exporter,
+		const std::string& fileName, const std::vector<std::string>& labels);
+	~ExportJob();
+
+	struct Result
+	{
+		bool success;
+		bool cancelled;
+		std::uint64_t rowsWritten;
+		std::uint64_t bytesWritten;
+		std::string errorString;
+	};
+
+	// Both callbacks are invoked on the worker thread
+	typedef std::function<void(const int& percent)> ProgressCallback;
+	typedef std::function<void(const Result& result)> CompletionCallback;
+
+	void Start(const ProgressCallback& progressCallback, const CompletionCallback& completionCallback);
+	void Cancel() { cancelRequested = true; }
+	void Wait();
+
+private:
+	PanelSet panels;
+	std::unique_ptr<DataExporter> exporter;
+	const std::string fileName;
+	const std::vector<std::string> labels;
+
+	std::atomic<bool> cancelRequested;
+	std::thread thread;
+
+	void Run(const ProgressCallback& progressCallback, const CompletionCallback& completionCallback);
+};
+
+#endif// EXPORT_JOB_H_
@@ -0,0 +1,166 @@
+// File:  fourierTransform.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Radix-2 fast Fourier transforms, in one and two dimensions.
+
+// Standard C++ headers
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+// Local headers
+#include "fourierTransform.h"
+
+//==========================================================================
+// Class:			FourierTransform
+// Function:		Transform
+//
+// Description:		Transforms the data in place.
+//
+// Input Arguments:
+//		data		= std::vector<Complex>&, size must be a power of two
+//		direction	= const Direction&
+//
+// Output Arguments:
+//		data		= std::vector<Complex>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void FourierTransform::Transform(std::vector<Complex>& data, const Direction& direction)
+{
+	Transform(data.data(), data.size(), direction);
+}
+
+//==========================================================================
+// Class:			FourierTransform
+// Function:		Transform2D
+//
+// Description:		Transforms row-major data in place, rows first and then
+//					columns.  Each column is copied into a contiguous buffer,
+//					which is much faster than transforming it with a stride.
+//
+// Input Arguments:
+//		data		= std::vector<Complex>&, width * height values
+//		width		= const std::size_t&, must be a power of two
+//		height		= const std::size_t&, must be a power of two
+//		direction	= const Direction&
+//
+// Output Arguments:
+//		data		= std::vector<Complex>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void FourierTransform::Transform2D(std::vector<Complex>& data, const std::size_t& width,
+	const std::size_t& height, const Direction& direction)
+{
+	assert(data.size() == width * height);
+
+	std::size_t i, j;
+	for (i = 0; i < height; ++i)
+		Transform(data.data() + i * width, width, direction);
+
+	std::vector<Complex> column(height);
+	for (j = 0; j < width; ++j)
+	{
+		for (i = 0; i < height; ++i)
+			column[i] = data[i * width + j];
+
+		Transform(column.data(), height, direction);
+
+		for (i = 0; i < height; ++i)
+			data[i * width + j] = column[i];
+	}
+}
+
+//==========================================================================
+// Class:			FourierTransform
+// Function:		NextPowerOfTwo
+//
+// Description:		Returns the smallest power of two that is not less than n.
+//
+// Input Arguments:
+//		n	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t
+//
+//==========================================================================
+std::size_t FourierTransform::NextPowerOfTwo(const std::size_t& n)
+{
+	std::size_t power(1);
+	while (power < n)
+		power <<= 1;
+	return power;
+}
+
+//==========================================================================
+// Class:			FourierTransform
+// Function:		Transform
+//
+// Description:		Iterative Cooley-Tukey transform (bit-reversal permutation,
+//					then butterflies).
+//
+// Input Arguments:
+//		data		= Complex*
+//		count		= const std::size_t&, must be a power of two
+//		direction	= const Direction&
+//
+// Output Arguments:
+//		data		= Complex*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void FourierTransform::Transform(Complex* data, const std::size_t& count, const Direction& direction)
+{
+	assert(IsPowerOfTwo(count));
+
+	std::size_t i, j(0);
+	for (i = 1; i < count; ++i)
+	{
+		std::size_t bit(count >> 1);
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+
+		if (i < j)
+			std::swap(data[i], data[j]);
+	}
+
+	const double pi(std::acos(-1.0));
+	const double sign(direction == Direction::Forward ? -1.0 : 1.0);
+	std::size_t length, k;
+	for (length = 2; length <= count; length <<= 1)
+	{
+		const double angle(sign * 2.0 * pi / length);
+		const Complex step(std::cos(angle), std::sin(angle));
+		const std::size_t half(length / 2);
+		for (i = 0; i < count; i += length)
+		{
+			Complex twiddle(1.0, 0.0);
+			for (k = 0; k < half; ++k)
+			{
+				const Complex even(data[i + k]);
+				const Complex odd(data[i + k + half] * twiddle);
+				data[i + k] = even + odd;
+				data[i + k + half] = even - odd;
+				twiddle *= step;
+			}
+		}
+	}
+
+	if (direction == Direction::Inverse)
+	{
+		const double scale(1.0 / count);
+		for (i = 0; i < count; ++i)
+			data[i] *= scale;
+	}
+}
@@ -0,0 +1,40 @@
+// File:  fourierTransform.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Radix-2 fast Fourier transforms, in one and two dimensions.  Sizes
+//        must be powers of two; callers pad their data as needed.
+
+#ifndef FOURIER_TRANSFORM_H_
+#define FOURIER_TRANSFORM_H_
+
+// Standard C++ headers
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+class FourierTransform
+{
+public:
+	typedef std::complex<double> Complex;
+
+	enum class Direction
+	{
+		Forward,
+		Inverse// Includes the 1/N scaling
+	};
+
+	// In place; data.size() must be a power of two
+	static void Transform(std::vector<Complex>& data, const Direction& direction);
+
+	// In place, row-major; width and height must be powers of two
+	static void Transform2D(std::vector<Complex>& data, const std::size_t& width,
+		const std::size_t& height, const Direction& direction);
+
+	static bool IsPowerOfTwo(const std::size_t& n) { return n > 0 && (n & (n - 1)) == 0; }
+	static std::size_t NextPowerOfTwo(const std::size_t& n);
+
+private:
+	static void Transform(Complex* data, const std::size_t& count, const Direction& direction);
+};
+
+#endif// FOURIER_TRANSFORM_H_
@@ -0,0 +1,415 @@
+// File:  imageCache.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  On-disk cache of decoded images and the work done on them.
+
+// Standard C++ headers
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+// wxWidgets headers
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
+
+// Local headers
+#include "imageCache.h"
+#include "sessionFile.h"
+#include "memoryMappedFile.h"
+#include "littleEndian.h"
+#include "xxHash64.h"
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the ImageCache class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char ImageCache::magic[8] = { 'P', 'P', 'I', 'M', 'A', 'G', 'E', 'S' };
+const std::uint32_t ImageCache::version(1);
+
+//==========================================================================
+// Class:			ImageCache::Entry
+// Function:		Entry
+//
+// Description:		Constructor for ImageCache::Entry class.  Copies the image
+//					data.
+//
+// Input Arguments:
+//		image			= const wxImage&
+//		alignmentImage	= const ImagePyramid::Level&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ImageCache::Entry::Entry(const wxImage& image, const ImagePyramid::Level& alignmentImage)
+	: width(image.GetWidth()), height(image.GetHeight()), alignmentImage(alignmentImage)
+{
+	const std::size_t pixelCount(static_cast<std::size_t>(width) * height);
+	rgb.assign(image.GetData(), image.GetData() + pixelCount * 3);
+	if (image.HasAlpha())
+		alpha.assign(image.GetAlpha(), image.GetAlpha() + pixelCount);
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		GetDirectory
+//
+// Description:		Returns the folder where cached files are kept.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString ImageCache::GetDirectory()
+{
+	return wxStandardPaths::Get().GetUserDataDir() + wxFileName::GetPathSeparator() + _T("cache");
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		GetFileName
+//
+// Description:		Returns the full path to one of the files for the
+//					specified hash.
+//
+// Input Arguments:
+//		hash		= const std::uint64_t&
+//		extension	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString ImageCache::GetFileName(const std::uint64_t& hash, const wxString& extension)
+{
+	return wxFileName(GetDirectory(), wxString::Format(_T("%016llx"),
+		static_cast<unsigned long long>(hash)), extension).GetFullPath();
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		HashFile
+//
+// Description:		Computes the XXH64 hash of the file contents.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		hash		= std::uint64_t&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageCache::HashFile(const wxString& fileName, std::uint64_t& hash)
+{
+	MemoryMappedFile file(fileName.ToStdString());
+	if (!file.IsOpen())
+		return false;
+
+	hash = XXHash64::Compute(file.GetData(), file.GetSize());
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		ReadImage
+//
+// Description:		Reads the cached copy of an image.  Layout (little-endian):
+//
+//					  magic[8], uint32 version, uint32 flags (1 = has alpha),
+//					  uint32 width, uint32 height,
+//					  uint32 alignment width, uint32 alignment height
+//					  RGB bytes, then alpha bytes (if any), zero padded to a
+//					  multiple of 4
+//					  float alignment pixels
+//
+// Input Arguments:
+//		hash			= const std::uint64_t&
+//
+// Output Arguments:
+//		image			= wxImage&
+//		alignmentImage	= ImagePyramid::Level&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageCache::ReadImage(const std::uint64_t& hash, wxImage& image, ImagePyramid::Level& alignmentImage)
+{
+	const wxString fileName(GetFileName(hash, _T("ppi")));
+	MemoryMappedFile file(fileName.ToStdString());
+	if (!file.IsOpen() || file.GetSize() < headerSize)
+		return false;
+
+	const char* data(file.GetData());
+	if (!std::equal(magic, magic + sizeof(magic), data) ||
+		LittleEndian::Read<std::uint32_t>(data + 8) != version)
+		return false;
+
+	const bool hasAlpha((LittleEndian::Read<std::uint32_t>(data + 12) & 1) != 0);
+	const unsigned int width(LittleEndian::Read<std::uint32_t>(data + 16));
+	const unsigned int height(LittleEndian::Read<std::uint32_t>(data + 20));
+	const unsigned int alignmentWidth(LittleEndian::Read<std::uint32_t>(data + 24));
+	const unsigned int alignmentHeight(LittleEndian::Read<std::uint32_t>(data + 28));
+
+	const std::size_t pixelCount(static_cast<std::size_t>(width) * height);
+	const std::size_t pixelBytes(pixelCount * (hasAlpha ? 4 : 3));
+	const std::size_t alignmentOffset(headerSize + ((pixelBytes + 3) & ~static_cast<std::size_t>(3)));
+	const std::size_t alignmentCount(static_cast<std::size_t>(alignmentWidth) * alignmentHeight);
+	if (width == 0 || height == 0 || file.GetSize() != alignmentOffset + alignmentCount * sizeof(float))
+		return false;
+
+	image.Create(width, height, false);
+	std::memcpy(image.GetData(), data + headerSize, pixelCount * 3);
+	if (hasAlpha)
+	{
+		image.SetAlpha();
+		std::memcpy(image.GetAlpha(), data + headerSize + pixelCount * 3, pixelCount);
+	}
+
+	alignmentImage = ImagePyramid::Level(alignmentWidth, alignmentHeight);
+	std::memcpy(alignmentImage.pixels.data(), data + alignmentOffset, alignmentCount * sizeof(float));
+	LittleEndian::Convert(alignmentImage.pixels.data(), alignmentCount);
+
+	file.Close();
+	Touch(fileName);
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		WriteImage
+//
+// Description:		Writes the image to the cache (see ReadImage() for the
+//					layout).  Safe to call from any thread.
+//
+// Input Arguments:
+//		hash	= const std::uint64_t&
+//		entry	= const Entry&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageCache::WriteImage(const std::uint64_t& hash, const Entry& entry)
+{
+	if (!wxFileName::Mkdir(GetDirectory(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return false;
+
+	const std::string fileName(GetFileName(hash, _T("ppi")).ToStdString());
+	const std::string temporaryFileName(fileName + ".partial");
+	{
+		std::ofstream file(temporaryFileName.c_str(), std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		std::string header(magic, sizeof(magic));
+		LittleEndian::Append(header, version);
+		LittleEndian::Append(header, static_cast<std::uint32_t>(entry.alpha.empty() ? 0 : 1));
+		LittleEndian::Append(header, static_cast<std::uint32_t>(entry.width));
+		LittleEndian::Append(header, static_cast<std::uint32_t>(entry.height));
+		LittleEndian::Append(header, static_cast<std::uint32_t>(entry.alignmentImage.width));
+		LittleEndian::Append(header, static_cast<std::uint32_t>(entry.alignmentImage.height));
+		file.write(header.data(), header.size());
+
+		file.write(reinterpret_cast<const char*>(entry.rgb.data()), entry.rgb.size());
+		file.write(reinterpret_cast<const char*>(entry.alpha.data()), entry.alpha.size());
+
+		const char zeros[4] = {};
+		file.write(zeros, (4 - (entry.rgb.size() + entry.alpha.size()) % 4) % 4);
+
+		std::vector<float> pixels(entry.alignmentImage.pixels);
+		LittleEndian::Convert(pixels.data(), pixels.size());
+		file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size() * sizeof(float));
+
+		if (!file.good())
+		{
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(temporaryFileName, error);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryFileName, fileName, error);
+	if (error)
+	{
+		std::filesystem::remove(temporaryFileName, error);
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		ReadSession
+//
+// Description:		Reads the cached session for the image, if there is one.
+//
+// Input Arguments:
+//		hash	= const std::uint64_t&
+//
+// Output Arguments:
+//		session	= SessionFile&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageCache::ReadSession(const std::uint64_t& hash, SessionFile& session)
+{
+	const wxString fileName(GetFileName(hash, _T("pps")));
+	if (!wxFileExists(fileName) || !session.Read(fileName.ToStdString()))
+		return false;
+
+	Touch(fileName);
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		WriteSession
+//
+// Description:		Writes the session for the image, or removes the cached
+//					one if there is nothing in it.
+//
+// Input Arguments:
+//		hash	= const std::uint64_t&
+//		session	= const SessionFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageCache::WriteSession(const std::uint64_t& hash, const SessionFile& session)
+{
+	const wxString fileName(GetFileName(hash, _T("pps")));
+	if (session.IsEmpty())
+		return !wxFileExists(fileName) || wxRemoveFile(fileName);
+
+	if (!wxFileName::Mkdir(GetDirectory(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return false;
+
+	return session.Write(fileName.ToStdString());
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		Trim
+//
+// Description:		Removes the least recently used files until the cache is
+//					no larger than maxSize.  Safe to call from any thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageCache::Trim()
+{
+	struct CachedFile
+	{
+		std::filesystem::path path;
+		std::uintmax_t size;
+		std::filesystem::file_time_type lastUsed;
+	};
+
+	std::vector<CachedFile> files;
+	std::uint64_t totalSize(0);
+	std::error_code error;
+	for (const auto& f : std::filesystem::directory_iterator(GetDirectory().ToStdString(), error))
+	{
+		const std::string extension(f.path().extension().string());
+		if (extension != ".ppi" && extension != ".pps")
+			continue;
+
+		CachedFile file;
+		file.path = f.path();
+		file.size = f.file_size(error);
+		file.lastUsed = f.last_write_time(error);
+		if (error)
+			continue;
+
+		totalSize += file.size;
+		files.push_back(file);
+	}
+
+	if (totalSize <= maxSize)
+		return;
+
+	std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b)
+	{
+		return a.lastUsed < b.lastUsed;
+	});
+
+	for (const auto& f : files)
+	{
+		if (totalSize <= maxSize)
+			break;
+
+		if (std::filesystem::remove(f.path, error))
+			totalSize -= f.size;
+	}
+}
+
+//==========================================================================
+// Class:			ImageCache
+// Function:		Touch
+//
+// Description:		Marks the file as recently used.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageCache::Touch(const wxString& fileName)
+{
+	std::error_code error;
+	std::filesystem::last_write_time(fileName.ToStdString(), std::filesystem::file_time_type::clock::now(), error);
+}
@@ -0,0 +1,71 @@
+// File:  imageCache.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  On-disk cache of decoded images and the work done on them, keyed by
+//        a hash of the image file's contents.  Reopening a cached image maps
+//        its raw pixels instead of decoding the file, and restores the
+//        previous session.
+//
+//        Entries are kept in the user data directory as <hash>.ppi (pixels
+//        and alignment image) and <hash>.pps (session file).  The least
+//        recently used entries are removed when the cache grows too large.
+
+#ifndef IMAGE_CACHE_H_
+#define IMAGE_CACHE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstdint>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "imagePyramid.h"
+
+// Local forward declarations
+class SessionFile;
+
+class ImageCache
+{
+public:
+	static wxString GetDirectory();
+
+	// Hashes the file contents; false if the file can't be read
+	static bool HashFile(const wxString& fileName, std::uint64_t& hash);
+
+	// Copy of an image's data, so it can be written from another thread
+	struct Entry
+	{
+		Entry() : width(0), height(0) {}
+		Entry(const wxImage& image, const ImagePyramid::Level& alignmentImage);
+
+		unsigned int width;
+		unsigned int height;
+		std::vector<unsigned char> rgb;
+		std::vector<unsigned char> alpha;// Empty if the image has no alpha channel
+		ImagePyramid::Level alignmentImage;
+	};
+
+	static bool ReadImage(const std::uint64_t& hash, wxImage& image, ImagePyramid::Level& alignmentImage);
+	static bool WriteImage(const std::uint64_t& hash, const Entry& entry);
+
+	// Storing an empty session removes the cached one
+	static bool ReadSession(const std::uint64_t& hash, SessionFile& session);
+	static bool WriteSession(const std::uint64_t& hash, const SessionFile& session);
+
+	// Removes least recently used files until the cache fits within maxSize
+	static void Trim();
+
+	static constexpr std::uint64_t maxSize = 1ULL << 30;// [bytes]
+
+private:
+	static const char magic[8];
+	static const std::uint32_t version;
+	static constexpr std::size_t headerSize = 32;
+
+	static wxString GetFileName(const std::uint64_t& hash, const wxString& extension);
+	static void Touch(const wxString& fileName);
+};
+
+#endif// IMAGE_CACHE_H_
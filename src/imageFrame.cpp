@@ -8,17 +8,7 @@
 #include "controlsFrame.h"
 #include "imageObject.h"
 #include "imageDropTarget.h"
-
-// *nix Icons
-#ifdef __WXGTK__
-#include "../res/icons/pointPicker16.xpm"
-#include "../res/icons/pointPicker24.xpm"
-#include "../res/icons/pointPicker32.xpm"
-#include "../res/icons/pointPicker48.xpm"
-#include "../res/icons/pointPicker64.xpm"
-#include "../res/icons/pointPicker128.xpm"
-#include "../res/icons/pointPicker256.xpm"
-#endif
+#include "appResources.h"
 
 //==========================================================================
 // Class:			ImageFrame
@@ -63,6 +53,8 @@ ImageFrame::ImageFrame(ControlsFrame& controlsFrame) : wxFrame(&controlsFrame, w
 BEGIN_EVENT_TABLE(ImageFrame, wxFrame)
 	EVT_CLOSE(ImageFrame::OnClose)
 	EVT_SIZE(ImageFrame::OnResize)
+	EVT_MENU(wxID_UNDO, ImageFrame::OnUndo)
+	EVT_MENU(wxID_REDO, ImageFrame::OnRedo)
 END_EVENT_TABLE()
 
 //==========================================================================
@@ -72,7 +64,7 @@ END_EVENT_TABLE()
 // Description:		Sets a new image to be displayed.
 //
 // Input Arguments:
-//		i	= wxImage&
+//		i	= const wxImage&
 //
 // Output Arguments:
 //		None
@@ -81,11 +73,32 @@ END_EVENT_TABLE()
 //		None
 //
 //==========================================================================
-void ImageFrame::SetImage(wxImage &i)
+void ImageFrame::SetImage(const wxImage &i)
 {
 	image->SetBitmap(i);
 }
 
+//==========================================================================
+// Class:			ImageFrame
+// Function:		SetOverlay
+//
+// Description:		Sets the grid drawn over the image.
+//
+// Input Arguments:
+//		grid	= const std::shared_ptr<const CalibrationGrid>&, nullptr for none
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageFrame::SetOverlay(const std::shared_ptr<const CalibrationGrid>& grid)
+{
+	image->SetOverlay(grid);
+}
+
 //==========================================================================
 // Class:			ImageFrame
 // Function:		SetProperties
@@ -110,17 +123,14 @@ void ImageFrame::SetProperties()
 	position.x += parentWidth;
 	SetPosition(position);
 
-#ifdef __WXMSW__
-	SetIcon(wxIcon(_T("ICON_ID_MAIN"), wxBITMAP_TYPE_ICO_RESOURCE));
-#elif __WXGTK__
-	SetIcon(wxIcon(pointPicker16_xpm));
-	SetIcon(wxIcon(pointPicker24_xpm));
-	SetIcon(wxIcon(pointPicker32_xpm));
-	SetIcon(wxIcon(pointPicker48_xpm));
-	SetIcon(wxIcon(pointPicker64_xpm));
-	SetIcon(wxIcon(pointPicker128_xpm));
-	SetIcon(wxIcon(pointPicker256_xpm));
-#endif
+	SetIcons(AppResources::GetIcons());
+
+	// Same keys as the controls frame, so edits can be undone while picking
+	wxAcceleratorEntry accelerators[3];
+	accelerators[0].Set(wxACCEL_CTRL, static_cast<int>('Z'), wxID_UNDO);
+	accelerators[1].Set(wxACCEL_CTRL, static_cast<int>('Y'), wxID_REDO);
+	accelerators[2].Set(wxACCEL_CTRL | wxACCEL_SHIFT, static_cast<int>('Z'), wxID_REDO);
+	SetAcceleratorTable(wxAcceleratorTable(3, accelerators));
 
 	SetDropTarget(dynamic_cast<wxDropTarget*>(new ImageDropTarget(controlsFrame)));
 }
@@ -169,6 +179,48 @@ void ImageFrame::OnResize(wxSizeEvent& WXUNUSED(event))
 	image->HandleSizeChange();
 }
 
+//==========================================================================
+// Class:			ImageFrame
+// Function:		OnUndo
+//
+// Description:		Handles undo accelerator keys.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageFrame::OnUndo(wxCommandEvent& WXUNUSED(event))
+{
+	controlsFrame.Undo();
+}
+
+//==========================================================================
+// Class:			ImageFrame
+// Function:		OnRedo
+//
+// Description:		Handles redo accelerator keys.
+//
+// Input Arguments:
+//		event	= wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageFrame::OnRedo(wxCommandEvent& WXUNUSED(event))
+{
+	controlsFrame.Redo();
+}
+
 //==========================================================================
 // Class:			ImageFrame
 // Function:		CreateControls
@@ -190,7 +242,7 @@ void ImageFrame::CreateControls()
 	wxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
 
 	wxImage dummyImage(500, 500);
-	image = new ImageObject(controlsFrame.GetPicker(), *this, wxID_ANY,
+	image = new ImageObject(*this, wxID_ANY,
 		dummyImage, wxDefaultPosition, wxDefaultSize, controlsFrame);
 	mainSizer->Add(image, 1, wxGROW);
 
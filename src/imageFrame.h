@@ -6,18 +6,23 @@
 #ifndef IMAGE_FRAME_H_
 #define IMAGE_FRAME_H_
 
+// Standard C++ headers
+#include <memory>
+
 // wxWidgets headers
 #include <wx/wx.h>
 
 class ImageObject;
 class ControlsFrame;
+class CalibrationGrid;
 
 class ImageFrame : public wxFrame
 {
 public:
 	ImageFrame(ControlsFrame& controlsFrame);
 
-	void SetImage(wxImage &image);
+	void SetImage(const wxImage &image);
+	void SetOverlay(const std::shared_ptr<const CalibrationGrid>& grid);
 
 private:
 	void SetProperties();
@@ -25,6 +30,8 @@ private:
 
 	void OnClose(wxCloseEvent& event);
 	void OnResize(wxSizeEvent &event);
+	void OnUndo(wxCommandEvent& event);
+	void OnRedo(wxCommandEvent& event);
 
 	ControlsFrame& controlsFrame;
 
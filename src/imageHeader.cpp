@@ -0,0 +1,269 @@
+// File:  imageHeader.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Reads the dimensions of an image from its file header.
+
+// Standard C++ headers
+#include <fstream>
+#include <cstring>
+
+// Local headers
+#include "imageHeader.h"
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadSize
+//
+// Description:		Reads the image dimensions from the file header.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		width		= unsigned int&
+//		height		= unsigned int&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageHeader::ReadSize(const std::string& fileName, unsigned int& width, unsigned int& height)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	unsigned char signature[8];
+	if (!file.read(reinterpret_cast<char*>(signature), sizeof(signature)))
+		return false;
+	file.seekg(0);
+
+	const unsigned char png[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	bool read;
+	if (std::memcmp(signature, png, sizeof(png)) == 0)
+		read = ReadPng(file, width, height);
+	else if (signature[0] == 0xFF && signature[1] == 0xD8)
+		read = ReadJpeg(file, width, height);
+	else if (std::memcmp(signature, "GIF87a", 6) == 0 || std::memcmp(signature, "GIF89a", 6) == 0)
+		read = ReadGif(file, width, height);
+	else if (signature[0] == 'B' && signature[1] == 'M')
+		read = ReadBmp(file, width, height);
+	else
+		return false;
+
+	return read && width > 0 && height > 0;
+}
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadPng
+//
+// Description:		Reads the dimensions from the IHDR chunk, which must
+//					immediately follow the signature.
+//
+// Input Arguments:
+//		file	= std::istream&
+//
+// Output Arguments:
+//		width	= unsigned int&
+//		height	= unsigned int&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageHeader::ReadPng(std::istream& file, unsigned int& width, unsigned int& height)
+{
+	unsigned char header[24];
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+		std::memcmp(header + 12, "IHDR", 4) != 0)
+		return false;
+
+	width = ReadBigEndian(header + 16, 4);
+	height = ReadBigEndian(header + 20, 4);
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadJpeg
+//
+// Description:		Walks the marker segments up to the start of frame, which
+//					holds the dimensions.
+//
+// Input Arguments:
+//		file	= std::istream&
+//
+// Output Arguments:
+//		width	= unsigned int&
+//		height	= unsigned int&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageHeader::ReadJpeg(std::istream& file, unsigned int& width, unsigned int& height)
+{
+	file.seekg(2);// Start of image
+	while (file)
+	{
+		// Markers may be preceded by any number of 0xFF fill bytes
+		int marker(file.get());
+		if (marker != 0xFF)
+			return false;
+		while (marker == 0xFF)
+			marker = file.get();
+
+		// Markers without a length
+		if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+			continue;
+
+		// End of image or start of scan before any frame header
+		if (marker == std::char_traits<char>::eof() || marker == 0xD9 || marker == 0xDA)
+			return false;
+
+		unsigned char length[2];
+		if (!file.read(reinterpret_cast<char*>(length), sizeof(length)))
+			return false;
+		const unsigned int segmentLength(ReadBigEndian(length, 2));
+		if (segmentLength < 2)
+			return false;
+
+		// Start of frame markers, other than DHT, JPG and DAC which share the range
+		const bool isFrame(marker >= 0xC0 && marker <= 0xCF &&
+			marker != 0xC4 && marker != 0xC8 && marker != 0xCC);
+		if (isFrame)
+		{
+			unsigned char frame[5];
+			if (!file.read(reinterpret_cast<char*>(frame), sizeof(frame)))
+				return false;
+
+			height = ReadBigEndian(frame + 1, 2);
+			width = ReadBigEndian(frame + 3, 2);
+			return true;
+		}
+
+		file.seekg(segmentLength - 2, std::ios::cur);
+	}
+
+	return false;
+}
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadGif
+//
+// Description:		Reads the logical screen size.
+//
+// Input Arguments:
+//		file	= std::istream&
+//
+// Output Arguments:
+//		width	= unsigned int&
+//		height	= unsigned int&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageHeader::ReadGif(std::istream& file, unsigned int& width, unsigned int& height)
+{
+	unsigned char header[10];
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)))
+		return false;
+
+	width = ReadLittleEndian(header + 6, 2);
+	height = ReadLittleEndian(header + 8, 2);
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadBmp
+//
+// Description:		Reads the dimensions from the DIB header.  Both the old
+//					OS/2 header (16-bit sizes) and the Windows headers (signed
+//					32-bit sizes, negative height for top-down rows) are handled.
+//
+// Input Arguments:
+//		file	= std::istream&
+//
+// Output Arguments:
+//		width	= unsigned int&
+//		height	= unsigned int&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ImageHeader::ReadBmp(std::istream& file, unsigned int& width, unsigned int& height)
+{
+	unsigned char header[26];
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)))
+		return false;
+
+	if (ReadLittleEndian(header + 14, 4) == 12)
+	{
+		width = ReadLittleEndian(header + 18, 2);
+		height = ReadLittleEndian(header + 20, 2);
+		return true;
+	}
+
+	const std::int32_t signedWidth(static_cast<std::int32_t>(ReadLittleEndian(header + 18, 4)));
+	const std::int32_t signedHeight(static_cast<std::int32_t>(ReadLittleEndian(header + 22, 4)));
+	if (signedWidth <= 0 || signedHeight == 0 || signedHeight == INT32_MIN)
+		return false;
+
+	width = static_cast<unsigned int>(signedWidth);
+	height = static_cast<unsigned int>(signedHeight < 0 ? -signedHeight : signedHeight);
+	return true;
+}
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadBigEndian
+//
+// Description:		Assembles an unsigned integer from big-endian bytes.
+//
+// Input Arguments:
+//		data	= const unsigned char*
+//		size	= const unsigned int&, number of bytes (at most 4)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint32_t
+//
+//==========================================================================
+std::uint32_t ImageHeader::ReadBigEndian(const unsigned char* data, const unsigned int& size)
+{
+	std::uint32_t value(0);
+	unsigned int i;
+	for (i = 0; i < size; ++i)
+		value = (value << 8) | data[i];
+	return value;
+}
+
+//==========================================================================
+// Class:			ImageHeader
+// Function:		ReadLittleEndian
+//
+// Description:		Assembles an unsigned integer from little-endian bytes.
+//
+// Input Arguments:
+//		data	= const unsigned char*
+//		size	= const unsigned int&, number of bytes (at most 4)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint32_t
+//
+//==========================================================================
+std::uint32_t ImageHeader::ReadLittleEndian(const unsigned char* data, const unsigned int& size)
+{
+	std::uint32_t value(0);
+	unsigned int i;
+	for (i = size; i > 0; --i)
+		value = (value << 8) | data[i - 1];
+	return value;
+}
@@ -0,0 +1,32 @@
+// File:  imageHeader.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Reads the dimensions of an image from its file header without
+//        decoding the pixels.  Handles PNG, JPEG, GIF and BMP; for anything
+//        else, the caller has to decode the image.
+
+#ifndef IMAGE_HEADER_H_
+#define IMAGE_HEADER_H_
+
+// Standard C++ headers
+#include <string>
+#include <istream>
+#include <cstdint>
+
+class ImageHeader
+{
+public:
+	// False if the file can't be read or isn't one of the supported formats
+	static bool ReadSize(const std::string& fileName, unsigned int& width, unsigned int& height);
+
+private:
+	static bool ReadPng(std::istream& file, unsigned int& width, unsigned int& height);
+	static bool ReadJpeg(std::istream& file, unsigned int& width, unsigned int& height);
+	static bool ReadGif(std::istream& file, unsigned int& width, unsigned int& height);
+	static bool ReadBmp(std::istream& file, unsigned int& width, unsigned int& height);
+
+	static std::uint32_t ReadBigEndian(const unsigned char* data, const unsigned int& size);
+	static std::uint32_t ReadLittleEndian(const unsigned char* data, const unsigned int& size);
+};
+
+#endif// IMAGE_HEADER_H_
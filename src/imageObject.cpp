@@ -3,10 +3,20 @@
 // Auth:  K. Loux
 // Desc:  Frame object for displaying the images.
 
+// Standard C++ headers
+#include <vector>
+#include <algorithm>
+
+// wxWidgets headers
+#include <wx/dcmemory.h>
+#include <wx/math.h>
+
 // Local headers
 #include "imageObject.h"
-#include "pointPicker.h"
+#include "calibrationGrid.h"
 #include "controlsFrame.h"
+#include "profiler.h"
+#include "traceRecorder.h"
 
 //==========================================================================
 // Class:			ImageObject
@@ -15,7 +25,6 @@
 // Description:		Constructor for ImageObject class.
 //
 // Input Arguments:
-//		picker			= PointPicker&
 //		parent			= wxWindow&
 //		id				= wxWindowID
 //		image			= const wxBitmap&
@@ -30,10 +39,10 @@
 //		None
 //
 //==========================================================================
-ImageObject::ImageObject(PointPicker& picker, wxWindow &parent, wxWindowID id,
+ImageObject::ImageObject(wxWindow &parent, wxWindowID id,
 	const wxBitmap &image, const wxPoint &pos, const wxSize &size,
 	ControlsFrame& controlsFrame) : wxStaticBitmap(&parent, id, image, pos, size),
-	picker(picker), controlsFrame(controlsFrame)
+	controlsFrame(controlsFrame)
 {
 	mouseMoved = false;
 	originalImage = image;
@@ -79,16 +88,16 @@ END_EVENT_TABLE()
 //==========================================================================
 void ImageObject::OnClick(wxMouseEvent &event)
 {
+	TraceRecorder::Scope trace("Mouse click", "input");
 	if (mouseMoved)
 	{
 		mouseMoved = false;
 		return;
 	}
 
-	picker.AddPoint(event.GetX(), event.GetY(),
+	controlsFrame.AddPoint(event.GetX(), event.GetY(),
 		(double)originalImage.GetWidth() / GetBitmap().GetWidth(),
 		(double)originalImage.GetHeight() / GetBitmap().GetHeight(), 0.0, 0.0);
-	controlsFrame.AddNewPoint();
 }
 
 //==========================================================================
@@ -109,6 +118,7 @@ void ImageObject::OnClick(wxMouseEvent &event)
 //==========================================================================
 void ImageObject::OnDrag(wxMouseEvent& event)
 {
+	TraceRecorder::Scope trace("Mouse move", "input");
 	controlsFrame.UpdateStatusBar(event.GetX(), event.GetY(),
 		(double)originalImage.GetWidth() / GetBitmap().GetWidth(),
 		(double)originalImage.GetHeight() / GetBitmap().GetHeight(), 0.0, 0.0);
@@ -163,8 +173,13 @@ void ImageObject::OnZoom(wxMouseEvent& WXUNUSED(event))
 //==========================================================================
 void ImageObject::HandleSizeChange()
 {
-	wxStaticBitmap::SetBitmap(originalImage.ConvertToImage().Scale(
-		GetParent()->GetClientSize().GetWidth(), GetParent()->GetClientSize().GetHeight()));
+	{
+		Profiler::ScopedTimer timer(Profiler::Probe::HandleSizeChange);
+		scaledImage = wxBitmap(originalImage.ConvertToImage().Scale(
+			GetParent()->GetClientSize().GetWidth(), GetParent()->GetClientSize().GetHeight()));
+	}
+
+	Compose();
 }
 
 //==========================================================================
@@ -188,3 +203,106 @@ void ImageObject::SetBitmap(const wxBitmap& bitmap)
 	originalImage = bitmap;
 	HandleSizeChange();
 }
+
+//==========================================================================
+// Class:			ImageObject
+// Function:		SetOverlay
+//
+// Description:		Sets the grid drawn over the image.
+//
+// Input Arguments:
+//		grid	= const std::shared_ptr<const CalibrationGrid>&, nullptr for none
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageObject::SetOverlay(const std::shared_ptr<const CalibrationGrid>& grid)
+{
+	overlay = grid;
+	Compose();
+}
+
+//==========================================================================
+// Class:			ImageObject
+// Function:		Compose
+//
+// Description:		Draws the overlay on a copy of the scaled image and displays
+//					the result.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ImageObject::Compose()
+{
+	if (!overlay || !scaledImage.IsOk() || originalImage.GetWidth() == 0 || originalImage.GetHeight() == 0)
+	{
+		wxStaticBitmap::SetBitmap(scaledImage);
+		return;
+	}
+
+	Profiler::ScopedTimer timer(Profiler::Probe::CalibrationOverlay);
+	const int width(scaledImage.GetWidth());
+	const int height(scaledImage.GetHeight());
+	wxBitmap layer(scaledImage.GetSubBitmap(wxRect(0, 0, width, height)));
+
+	const double xScale(static_cast<double>(width) / originalImage.GetWidth());
+	const double yScale(static_cast<double>(height) / originalImage.GetHeight());
+	const wxColour colour(0, 150, 255);
+
+	{
+		wxMemoryDC dc(layer);
+		dc.SetPen(wxPen(colour, 1));
+
+		std::vector<wxPoint> points;
+		for (const auto& line : overlay->GetLines())
+		{
+			points.resize(line.size());
+			std::size_t i;
+			for (i = 0; i < line.size(); ++i)
+				points[i] = wxPoint(wxRound(line[i].x * xScale), wxRound(line[i].y * yScale));
+			dc.DrawLines(static_cast<int>(points.size()), points.data());
+		}
+
+		// Labels sit just inside the ends of their lines, on an opaque
+		// background so they stay readable over the plot
+		dc.SetFont(*wxSMALL_FONT);
+		dc.SetTextForeground(colour);
+		dc.SetTextBackground(*wxWHITE);
+		dc.SetBackgroundMode(wxSOLID);
+		const int margin(2);
+		for (const auto& label : overlay->GetLabels())
+		{
+			const wxString text(wxString::FromUTF8(label.text.c_str()));
+			const wxSize extent(dc.GetTextExtent(text));
+			int x(wxRound(label.position.x * xScale));
+			int y(wxRound(label.position.y * yScale));
+			if (label.isX)
+			{
+				x -= extent.GetWidth() / 2;
+				y -= extent.GetHeight() + margin;
+			}
+			else
+			{
+				x += margin;
+				y -= extent.GetHeight() / 2;
+			}
+
+			x = std::max(0, std::min(x, width - extent.GetWidth()));
+			y = std::max(0, std::min(y, height - extent.GetHeight()));
+			dc.DrawText(text, x, y);
+		}
+	}
+
+	wxStaticBitmap::SetBitmap(layer);
+}
@@ -6,17 +6,20 @@
 #ifndef IMAGE_OBJECT_H_
 #define IMAGE_OBJECT_H_
 
+// Standard C++ headers
+#include <memory>
+
 // wxWidgets headers
 #include <wx/statbmp.h>
 
 // Local forward declarations
-class PointPicker;
 class ControlsFrame;
+class CalibrationGrid;
 
 class ImageObject : public wxStaticBitmap
 {
 public:
-	ImageObject(PointPicker& picker, wxWindow &parent, wxWindowID id, const wxBitmap &image,
+	ImageObject(wxWindow &parent, wxWindowID id, const wxBitmap &image,
 		const wxPoint &pos, const wxSize &size, ControlsFrame& controlsFrame);
 
 	virtual ~ImageObject() {}
@@ -24,11 +27,19 @@ public:
 	virtual void SetBitmap(const wxBitmap& bitmap);
 	void HandleSizeChange();
 
+	// Drawn over the image (in image coordinates); nullptr for none
+	void SetOverlay(const std::shared_ptr<const CalibrationGrid>& grid);
+
 private:
-	PointPicker &picker;
 	ControlsFrame& controlsFrame;
 	wxBitmap originalImage;
 
+	// The displayed bitmap is the scaled image with the overlay drawn on it,
+	// rebuilt only when the overlay or the size changes
+	wxBitmap scaledImage;
+	std::shared_ptr<const CalibrationGrid> overlay;
+	void Compose();
+
 	void OnClick(wxMouseEvent &event);
 	void OnDrag(wxMouseEvent& event);
 	void OnZoom(wxMouseEvent& event);
@@ -0,0 +1,248 @@
+// File:  imagePyramid.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Grayscale image pyramid and phase correlation.
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+// Local headers
+#include "imagePyramid.h"
+#include "fourierTransform.h"
+
+//==========================================================================
+// Class:			ImagePyramid
+// Function:		ImagePyramid
+//
+// Description:		Constructor for ImagePyramid class.  Level 0 is the full
+//					resolution image.
+//
+// Input Arguments:
+//		image	= const wxImage&
+//		maxSize	= const unsigned int&, largest dimension of the coarsest level
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ImagePyramid::ImagePyramid(const wxImage& image, const unsigned int& maxSize)
+{
+	if (!image.IsOk())
+	{
+		levels.push_back(Level());
+		return;
+	}
+
+	Level full(image.GetWidth(), image.GetHeight());
+	const unsigned char* rgb(image.GetData());
+	std::size_t i;
+	for (i = 0; i < full.pixels.size(); ++i)
+		full.pixels[i] = (0.299f * rgb[3 * i] + 0.587f * rgb[3 * i + 1] + 0.114f * rgb[3 * i + 2]) / 255.0f;
+	levels.push_back(std::move(full));
+
+	while ((levels.back().width > maxSize || levels.back().height > maxSize) &&
+		levels.back().width > 1 && levels.back().height > 1)
+		levels.push_back(Reduce(levels.back()));
+}
+
+//==========================================================================
+// Class:			ImagePyramid
+// Function:		Reduce
+//
+// Description:		Halves the resolution by averaging 2x2 blocks.  An odd last
+//					row or column is dropped.
+//
+// Input Arguments:
+//		level	= const Level&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Level
+//
+//==========================================================================
+ImagePyramid::Level ImagePyramid::Reduce(const Level& level)
+{
+	Level reduced(std::max(level.width / 2, 1U), std::max(level.height / 2, 1U));
+	const unsigned int xLast(level.width - 1), yLast(level.height - 1);
+	unsigned int x, y;
+	for (y = 0; y < reduced.height; ++y)
+	{
+		const unsigned int y0(std::min(2 * y, yLast)), y1(std::min(2 * y + 1, yLast));
+		for (x = 0; x < reduced.width; ++x)
+		{
+			const unsigned int x0(std::min(2 * x, xLast)), x1(std::min(2 * x + 1, xLast));
+			reduced(x, y) = 0.25f * (level(x0, y0) + level(x1, y0) + level(x0, y1) + level(x1, y1));
+		}
+	}
+
+	return reduced;
+}
+
+//==========================================================================
+// Class:			ImagePyramid
+// Function:		Resample
+//
+// Description:		Bilinear resampling to the specified size.
+//
+// Input Arguments:
+//		level	= const Level&
+//		width	= const unsigned int&
+//		height	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Level
+//
+//==========================================================================
+ImagePyramid::Level ImagePyramid::Resample(const Level& level, const unsigned int& width, const unsigned int& height)
+{
+	if (level.width == width && level.height == height)
+		return level;
+
+	Level resampled(width, height);
+	if (level.pixels.empty())
+		return resampled;
+
+	const double xRatio(static_cast<double>(level.width) / width);
+	const double yRatio(static_cast<double>(level.height) / height);
+	unsigned int x, y;
+	for (y = 0; y < height; ++y)
+	{
+		const double sy(std::min(std::max((y + 0.5) * yRatio - 0.5, 0.0), level.height - 1.0));
+		const unsigned int y0(static_cast<unsigned int>(sy)), y1(std::min(y0 + 1, level.height - 1));
+		const float fy(static_cast<float>(sy - y0));
+		for (x = 0; x < width; ++x)
+		{
+			const double sx(std::min(std::max((x + 0.5) * xRatio - 0.5, 0.0), level.width - 1.0));
+			const unsigned int x0(static_cast<unsigned int>(sx)), x1(std::min(x0 + 1, level.width - 1));
+			const float fx(static_cast<float>(sx - x0));
+			const float top(level(x0, y0) + fx * (level(x1, y0) - level(x0, y0)));
+			const float bottom(level(x0, y1) + fx * (level(x1, y1) - level(x0, y1)));
+			resampled(x, y) = top + fy * (bottom - top);
+		}
+	}
+
+	return resampled;
+}
+
+//==========================================================================
+// Class:			ImagePyramid
+// Function:		PhaseCorrelate
+//
+// Description:		Finds the translation between the images from the peak of
+//					the inverse transform of their normalized cross-power
+//					spectrum.  The images are mean-subtracted and Hann windowed
+//					(so the edges don't dominate), then zero padded to powers
+//					of two.  The peak is located to a fraction of a pixel from
+//					its neighbors.
+//
+// Input Arguments:
+//		reference	= const Level&
+//		image		= const Level&
+//
+// Output Arguments:
+//		dx			= double&
+//		dy			= double&
+//		peak		= double&
+//
+// Return Value:
+//		bool, false if either image is empty
+//
+//==========================================================================
+bool ImagePyramid::PhaseCorrelate(const Level& reference, const Level& image,
+	double& dx, double& dy, double& peak)
+{
+	if (reference.pixels.empty() || image.pixels.empty())
+		return false;
+
+	const unsigned int width(reference.width), height(reference.height);
+	const Level resampled(Resample(image, width, height));
+	const std::size_t paddedWidth(FourierTransform::NextPowerOfTwo(width));
+	const std::size_t paddedHeight(FourierTransform::NextPowerOfTwo(height));
+
+	const double pi(std::acos(-1.0));
+	std::vector<double> xWindow(width), yWindow(height);
+	unsigned int x, y;
+	for (x = 0; x < width; ++x)
+		xWindow[x] = 0.5 - 0.5 * std::cos(2.0 * pi * (x + 0.5) / width);
+	for (y = 0; y < height; ++y)
+		yWindow[y] = 0.5 - 0.5 * std::cos(2.0 * pi * (y + 0.5) / height);
+
+	auto prepare([&](const Level& level)
+	{
+		double mean(0.0);
+		for (const auto& p : level.pixels)
+			mean += p;
+		mean /= level.pixels.size();
+
+		std::vector<FourierTransform::Complex> data(paddedWidth * paddedHeight);
+		for (y = 0; y < height; ++y)
+		{
+			for (x = 0; x < width; ++x)
+				data[y * paddedWidth + x] = (level(x, y) - mean) * xWindow[x] * yWindow[y];
+		}
+
+		FourierTransform::Transform2D(data, paddedWidth, paddedHeight, FourierTransform::Direction::Forward);
+		return data;
+	});
+
+	const std::vector<FourierTransform::Complex> referenceSpectrum(prepare(reference));
+	std::vector<FourierTransform::Complex> crossPower(prepare(resampled));
+
+	std::size_t i;
+	for (i = 0; i < crossPower.size(); ++i)
+	{
+		crossPower[i] *= std::conj(referenceSpectrum[i]);
+		const double magnitude(std::abs(crossPower[i]));
+		if (magnitude > 1.0e-12)
+			crossPower[i] /= magnitude;
+		else
+			crossPower[i] = 0.0;
+	}
+
+	FourierTransform::Transform2D(crossPower, paddedWidth, paddedHeight, FourierTransform::Direction::Inverse);
+
+	std::size_t peakIndex(0);
+	for (i = 1; i < crossPower.size(); ++i)
+	{
+		if (crossPower[i].real() > crossPower[peakIndex].real())
+			peakIndex = i;
+	}
+
+	const std::size_t peakX(peakIndex % paddedWidth), peakY(peakIndex / paddedWidth);
+	peak = crossPower[peakIndex].real();
+
+	auto at([&](const std::size_t& px, const std::size_t& py)
+	{
+		return crossPower[(py % paddedHeight) * paddedWidth + px % paddedWidth].real();
+	});
+
+	// For a pure translation the peak is a sampled sinc, so the fraction
+	// comes from the ratio of the peak to its larger neighbor
+	auto refine([](const double& before, const double& center, const double& after)
+	{
+		if (after > before && after > 0.0)
+			return after / (after + center);
+		else if (before > 0.0)
+			return -before / (before + center);
+		return 0.0;
+	});
+
+	// Indices past the middle are negative shifts
+	dx = static_cast<double>(peakX) + refine(at(peakX + paddedWidth - 1, peakY), peak, at(peakX + 1, peakY));
+	dy = static_cast<double>(peakY) + refine(at(peakX, peakY + paddedHeight - 1), peak, at(peakX, peakY + 1));
+	if (peakX > paddedWidth / 2)
+		dx -= paddedWidth;
+	if (peakY > paddedHeight / 2)
+		dy -= paddedHeight;
+
+	return true;
+}
@@ -0,0 +1,57 @@
+// File:  imagePyramid.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Grayscale copies of an image at successively halved resolutions, and
+//        phase correlation for finding the offset between two images of the
+//        same layout.  Coarse levels are small enough to align in a few
+//        milliseconds and are less sensitive to noise and anti-aliasing.
+
+#ifndef IMAGE_PYRAMID_H_
+#define IMAGE_PYRAMID_H_
+
+// Standard C++ headers
+#include <vector>
+
+// wxWidgets headers
+#include <wx/image.h>
+
+class ImagePyramid
+{
+public:
+	struct Level
+	{
+		Level() : width(0), height(0) {}
+		Level(const unsigned int& width, const unsigned int& height)
+			: width(width), height(height), pixels(width * height, 0.0f) {}
+
+		unsigned int width;
+		unsigned int height;
+		std::vector<float> pixels;// Row-major, 0 (black) to 1 (white)
+
+		float& operator()(const unsigned int& x, const unsigned int& y) { return pixels[y * width + x]; }
+		const float& operator()(const unsigned int& x, const unsigned int& y) const { return pixels[y * width + x]; }
+	};
+
+	// Halves the image until neither dimension is larger than maxSize
+	ImagePyramid(const wxImage& image, const unsigned int& maxSize);
+
+	std::size_t GetLevelCount() const { return levels.size(); }
+	const Level& GetLevel(const std::size_t& i) const { return levels[i]; }
+	const Level& GetCoarsest() const { return levels.back(); }
+
+	static Level Reduce(const Level& level);// 2x2 box filter
+	static Level Resample(const Level& level, const unsigned int& width, const unsigned int& height);
+
+	// Returns the shift of the image content relative to the reference (in
+	// pixels of the reference level), so that image(x + dx, y + dy) matches
+	// reference(x, y).  The image is resampled to the reference size first.
+	// The peak height is between 0 and 1; values near zero mean there was no
+	// clear match.
+	static bool PhaseCorrelate(const Level& reference, const Level& image,
+		double& dx, double& dy, double& peak);
+
+private:
+	std::vector<Level> levels;
+};
+
+#endif// IMAGE_PYRAMID_H_
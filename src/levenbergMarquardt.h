@@ -0,0 +1,249 @@
+// File:  levenbergMarquardt.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Levenberg-Marquardt least-squares solver for small, fixed numbers of
+//        parameters.  The model supplies one fixed-size residual (and its
+//        Jacobian) per observation, so the normal equations are accumulated in
+//        fixed-size matrices and nothing is allocated while iterating.
+
+#ifndef LEVENBERG_MARQUARDT_H_
+#define LEVENBERG_MARQUARDT_H_
+
+// Standard C++ headers
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+// Eigen headers
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4018)// signed/unsigned mismatch
+#pragma warning(disable:4456)// declaration hides previous local declaration
+#pragma warning(disable:4714)// function marked as __forceinline not inlined
+#pragma warning(disable:4800)// forcing value to bool 'true' or 'false'
+#endif
+#include <Eigen/Dense>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+// The Model type must provide:
+//   std::size_t GetObservationCount() const;
+//   void Evaluate(const Parameters& p, const std::size_t& i, Residual& r, Jacobian* j) const;
+// where the Jacobian is only requested when j is not null.  NumericalJacobian()
+// can be used by models without analytic derivatives.
+template <int ParameterCount, int ResidualSize = 2>
+class LevenbergMarquardt
+{
+public:
+	typedef Eigen::Matrix<double, ParameterCount, 1> Parameters;
+	typedef Eigen::Matrix<double, ResidualSize, 1> Residual;
+	typedef Eigen::Matrix<double, ResidualSize, ParameterCount> Jacobian;
+
+	struct Settings
+	{
+		unsigned int maxIterations = 50;
+		double costTolerance = 1.0e-12;// Relative decrease in cost
+		double stepTolerance = 1.0e-12;// Relative size of step
+	};
+
+	struct Result
+	{
+		double initialCost;// Sum of squared residuals
+		double finalCost;
+		unsigned int iterations;
+		bool converged;
+	};
+
+	template <typename Model>
+	static Result Minimize(const Model& model, Parameters& parameters, const Settings& settings = Settings());
+
+	template <typename Model>
+	static double ComputeCost(const Model& model, const Parameters& parameters);
+
+	// Central differences; evaluate(p, r) must compute the residual for one
+	// observation
+	template <typename Function>
+	static void NumericalJacobian(const Function& evaluate, const Parameters& parameters, Jacobian& jacobian);
+
+private:
+	static constexpr double initialDamping = 1.0e-3;
+	static constexpr double maxDamping = 1.0e12;
+};
+
+//==========================================================================
+// Class:			LevenbergMarquardt
+// Function:		Minimize
+//
+// Description:		Adjusts the parameters to minimize the sum of the squared
+//					residuals.  Steps that increase the cost are rejected and
+//					retried with more damping.
+//
+// Input Arguments:
+//		model		= const Model&
+//		parameters	= Parameters&, initial guess
+//		settings	= const Settings&
+//
+// Output Arguments:
+//		parameters	= Parameters&
+//
+// Return Value:
+//		Result
+//
+//==========================================================================
+template <int ParameterCount, int ResidualSize>
+template <typename Model>
+typename LevenbergMarquardt<ParameterCount, ResidualSize>::Result
+	LevenbergMarquardt<ParameterCount, ResidualSize>::Minimize(
+	const Model& model, Parameters& parameters, const Settings& settings)
+{
+	typedef Eigen::Matrix<double, ParameterCount, ParameterCount> NormalMatrix;
+
+	Result result;
+	result.initialCost = ComputeCost(model, parameters);
+	result.finalCost = result.initialCost;
+	result.iterations = 0;
+	result.converged = false;
+
+	double damping(initialDamping);
+	Residual residual;
+	Jacobian jacobian;
+
+	while (result.iterations < settings.maxIterations && !result.converged)
+	{
+		if (result.finalCost <= 0.0)// Exact fit
+		{
+			result.converged = true;
+			break;
+		}
+
+		++result.iterations;
+
+		NormalMatrix jtj(NormalMatrix::Zero());
+		Parameters jtr(Parameters::Zero());
+		std::size_t i;
+		for (i = 0; i < model.GetObservationCount(); ++i)
+		{
+			model.Evaluate(parameters, i, residual, &jacobian);
+			jtj.noalias() += jacobian.transpose() * jacobian;
+			jtr.noalias() += jacobian.transpose() * residual;
+		}
+
+		bool improved(false);
+		while (!improved && damping < maxDamping)
+		{
+			// Scaling the damping by the diagonal keeps the step invariant to
+			// the units of each parameter
+			NormalMatrix damped(jtj);
+			int j;
+			for (j = 0; j < ParameterCount; ++j)
+				damped(j, j) += damping * std::max(jtj(j, j), 1.0e-12);
+
+			const Parameters step(damped.ldlt().solve(-jtr));
+			if (!step.allFinite())
+			{
+				damping *= 10.0;
+				continue;
+			}
+
+			if (step.norm() <= settings.stepTolerance * (parameters.norm() + settings.stepTolerance))
+			{
+				result.converged = true;
+				break;
+			}
+
+			const Parameters candidate(parameters + step);
+			const double cost(ComputeCost(model, candidate));
+			if (std::isfinite(cost) && cost < result.finalCost)
+			{
+				improved = true;
+				result.converged = result.finalCost - cost <= settings.costTolerance * result.finalCost;
+				result.finalCost = cost;
+				parameters = candidate;
+				damping = std::max(damping * 0.1, 1.0e-15);
+			}
+			else
+				damping *= 10.0;
+		}
+
+		// Can't make any more progress
+		if (!improved)
+			result.converged = true;
+	}
+
+	return result;
+}
+
+//==========================================================================
+// Class:			LevenbergMarquardt
+// Function:		ComputeCost
+//
+// Description:		Returns the sum of the squared residuals.
+//
+// Input Arguments:
+//		model		= const Model&
+//		parameters	= const Parameters&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+template <int ParameterCount, int ResidualSize>
+template <typename Model>
+double LevenbergMarquardt<ParameterCount, ResidualSize>::ComputeCost(const Model& model, const Parameters& parameters)
+{
+	double cost(0.0);
+	Residual residual;
+	std::size_t i;
+	for (i = 0; i < model.GetObservationCount(); ++i)
+	{
+		model.Evaluate(parameters, i, residual, nullptr);
+		cost += residual.squaredNorm();
+	}
+
+	return cost;
+}
+
+//==========================================================================
+// Class:			LevenbergMarquardt
+// Function:		NumericalJacobian
+//
+// Description:		Estimates the Jacobian of one residual by central
+//					differences.
+//
+// Input Arguments:
+//		evaluate	= const Function&
+//		parameters	= const Parameters&
+//
+// Output Arguments:
+//		jacobian	= Jacobian&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <int ParameterCount, int ResidualSize>
+template <typename Function>
+void LevenbergMarquardt<ParameterCount, ResidualSize>::NumericalJacobian(
+	const Function& evaluate, const Parameters& parameters, Jacobian& jacobian)
+{
+	Parameters perturbed(parameters);
+	Residual plus, minus;
+	int j;
+	for (j = 0; j < ParameterCount; ++j)
+	{
+		const double step(1.0e-6 * (std::abs(parameters(j)) + 1.0e-3));
+		perturbed(j) = parameters(j) + step;
+		evaluate(perturbed, plus);
+		perturbed(j) = parameters(j) - step;
+		evaluate(perturbed, minus);
+		perturbed(j) = parameters(j);
+
+		jacobian.col(j) = (plus - minus) / (2.0 * step);
+	}
+}
+
+#endif// LEVENBERG_MARQUARDT_H_
@@ -0,0 +1,141 @@
+// File:  littleEndian.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Helpers for reading and writing little-endian binary data independent
+//        of the host byte order.
+
+// Standard C++ headers
+#include <algorithm>
+
+// Local headers
+#include "littleEndian.h"
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		Append
+//
+// Description:		Appends the specified value to the buffer.
+//
+// Input Arguments:
+//		buffer	= std::string&
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void LittleEndian::Append(std::string& buffer, const double& value)
+{
+	std::uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	Append(buffer, bits);
+}
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		ReadDouble
+//
+// Description:		Reads a double from the buffer.
+//
+// Input Arguments:
+//		data	= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double LittleEndian::ReadDouble(const char* data)
+{
+	const std::uint64_t bits(Read<std::uint64_t>(data));
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		HostIsLittleEndian
+//
+// Description:		Checks the byte order of the host.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool LittleEndian::HostIsLittleEndian()
+{
+	const std::uint16_t value(1);
+	unsigned char firstByte;
+	std::memcpy(&firstByte, &value, 1);
+	return firstByte == 1;
+}
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		Convert
+//
+// Description:		Swaps the byte order of each value if the host is big-endian.
+//
+// Input Arguments:
+//		values	= double*
+//		count	= const std::size_t&
+//
+// Output Arguments:
+//		values	= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void LittleEndian::Convert(double* values, const std::size_t& count)
+{
+	if (HostIsLittleEndian())
+		return;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		unsigned char* bytes(reinterpret_cast<unsigned char*>(values + i));
+		std::reverse(bytes, bytes + sizeof(double));
+	}
+}
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		Convert
+//
+// Description:		Swaps the byte order of each value if the host is big-endian.
+//
+// Input Arguments:
+//		values	= float*
+//		count	= const std::size_t&
+//
+// Output Arguments:
+//		values	= float*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void LittleEndian::Convert(float* values, const std::size_t& count)
+{
+	if (HostIsLittleEndian())
+		return;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		unsigned char* bytes(reinterpret_cast<unsigned char*>(values + i));
+		std::reverse(bytes, bytes + sizeof(float));
+	}
+}
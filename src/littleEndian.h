@@ -0,0 +1,85 @@
+// File:  littleEndian.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Helpers for reading and writing little-endian binary data independent
+//        of the host byte order.
+
+#ifndef LITTLE_ENDIAN_H_
+#define LITTLE_ENDIAN_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+class LittleEndian
+{
+public:
+	template<typename T>
+	static void Append(std::string& buffer, const T& value);
+	static void Append(std::string& buffer, const double& value);
+
+	template<typename T>
+	static T Read(const char* data);
+	static double ReadDouble(const char* data);
+
+	static bool HostIsLittleEndian();
+
+	// Converts between host and little-endian order in place (no-op on little-endian hosts)
+	static void Convert(double* values, const std::size_t& count);
+	static void Convert(float* values, const std::size_t& count);
+};
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		Append
+//
+// Description:		Appends the specified unsigned integer to the buffer.
+//
+// Input Arguments:
+//		buffer	= std::string&
+//		value	= const T&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template<typename T>
+void LittleEndian::Append(std::string& buffer, const T& value)
+{
+	static_assert(std::is_unsigned<T>::value, "Only unsigned integers may be appended");
+	for (unsigned int i = 0; i < sizeof(T); ++i)
+		buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+//==========================================================================
+// Class:			LittleEndian
+// Function:		Read
+//
+// Description:		Reads an unsigned integer from the buffer.
+//
+// Input Arguments:
+//		data	= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		T
+//
+//==========================================================================
+template<typename T>
+T LittleEndian::Read(const char* data)
+{
+	static_assert(std::is_unsigned<T>::value, "Only unsigned integers may be read");
+	T value(0);
+	for (unsigned int i = 0; i < sizeof(T); ++i)
+		value |= static_cast<T>(static_cast<unsigned char>(data[i])) << (8 * i);
+	return value;
+}
+
+#endif// LITTLE_ENDIAN_H_
@@ -0,0 +1,206 @@
+// File:  memoryMappedFile.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Read-only view of a whole file mapped into memory.
+
+// Platform headers
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Local headers
+#include "memoryMappedFile.h"
+
+//==========================================================================
+// Class:			MemoryMappedFile
+// Function:		MemoryMappedFile
+//
+// Description:		Constructor for MemoryMappedFile class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MemoryMappedFile::MemoryMappedFile() : isOpen(false), data(nullptr), size(0)
+#ifdef _WIN32
+	, fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#endif
+{
+}
+
+//==========================================================================
+// Class:			MemoryMappedFile
+// Function:		MemoryMappedFile
+//
+// Description:		Constructor for MemoryMappedFile class.  Check IsOpen() to
+//					see if the file was mapped.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName) : MemoryMappedFile()
+{
+	Open(fileName);
+}
+
+//==========================================================================
+// Class:			MemoryMappedFile
+// Function:		~MemoryMappedFile
+//
+// Description:		Destructor for MemoryMappedFile class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+//==========================================================================
+// Class:			MemoryMappedFile
+// Function:		Open
+//
+// Description:		Maps the specified file, closing any file that was already
+//					open.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool MemoryMappedFile::Open(const std::string& fileName)
+{
+	Close();
+
+#ifdef _WIN32
+	fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		Close();
+		return false;
+	}
+
+	size = static_cast<std::size_t>(fileSize.QuadPart);
+	if (size > 0)
+	{
+		mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mappingHandle)
+		{
+			Close();
+			return false;
+		}
+
+		data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (!data)
+		{
+			Close();
+			return false;
+		}
+	}
+#else
+	const int descriptor(open(fileName.c_str(), O_RDONLY));
+	if (descriptor < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(descriptor, &status) != 0)
+	{
+		close(descriptor);
+		return false;
+	}
+
+	size = static_cast<std::size_t>(status.st_size);
+	if (size > 0)
+	{
+		void* mapped(mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0));
+		if (mapped == MAP_FAILED)
+		{
+			size = 0;
+			close(descriptor);
+			return false;
+		}
+
+		data = static_cast<const char*>(mapped);
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	close(descriptor);
+#endif
+
+	isOpen = true;
+	return true;
+}
+
+//==========================================================================
+// Class:			MemoryMappedFile
+// Function:		Close
+//
+// Description:		Unmaps the file, if one is open.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedFile::Close()
+{
+#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mappingHandle)
+		CloseHandle(mappingHandle);
+	if (fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle);
+
+	mappingHandle = nullptr;
+	fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (data)
+		munmap(const_cast<char*>(data), size);
+#endif
+
+	data = nullptr;
+	size = 0;
+	isOpen = false;
+}
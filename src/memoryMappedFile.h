@@ -0,0 +1,45 @@
+// File:  memoryMappedFile.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Read-only view of a whole file mapped into memory.  Pages are read by
+//        the OS as they are touched (and shared with its file cache), so large
+//        files can be used without first copying them into a buffer.
+
+#ifndef MEMORY_MAPPED_FILE_H_
+#define MEMORY_MAPPED_FILE_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstddef>
+
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile();
+	explicit MemoryMappedFile(const std::string& fileName);
+	~MemoryMappedFile();
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	bool Open(const std::string& fileName);
+	void Close();
+
+	bool IsOpen() const { return isOpen; }
+
+	// Null for empty files
+	const char* GetData() const { return data; }
+	std::size_t GetSize() const { return size; }
+
+private:
+	bool isOpen;
+	const char* data;
+	std::size_t size;
+
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+};
+
+#endif// MEMORY_MAPPED_FILE_H_
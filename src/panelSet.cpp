@@ -0,0 +1,162 @@
+// File:  panelSet.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Curves from several pickers presented as a single source.
+
+// Standard C++ headers
+#include <algorithm>
+
+// Local headers
+#include "panelSet.h"
+
+//==========================================================================
+// Class:			PanelSet
+// Function:		Add
+//
+// Description:		Appends a copy of the panel's picker; its curves follow those
+//					of the panels already in the set.
+//
+// Input Arguments:
+//		picker	= const PointPicker&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PanelSet::Add(const PointPicker& picker)
+{
+	const unsigned int panel(static_cast<unsigned int>(panels.size()));
+	panels.push_back(picker);
+
+	unsigned int i;
+	for (i = 0; i < picker.GetCurveCount(); ++i)
+	{
+		curvePanels.push_back(panel);
+		panelCurves.push_back(i);
+	}
+}
+
+//==========================================================================
+// Class:			PanelSet
+// Function:		UpdateTransformations
+//
+// Description:		Fits any panel whose transformation is out of date.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PanelSet::UpdateTransformations()
+{
+	for (auto& panel : panels)
+	{
+		if (!panel.IsTransformationCurrent())
+			panel.UpdateTransformation();
+	}
+}
+
+//==========================================================================
+// Class:			PanelSet
+// Function:		GetCurveSize
+//
+// Description:		Returns the number of points in the specified curve.
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t
+//
+//==========================================================================
+std::size_t PanelSet::GetCurveSize(const unsigned int& curve) const
+{
+	return panels[curvePanels[curve]].GetCurveSize(panelCurves[curve]);
+}
+
+//==========================================================================
+// Class:			PanelSet
+// Function:		ConvertCurve
+//
+// Description:		Converts a block of points with the transformation of the
+//					panel the curve belongs to.
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//		start	= const std::size_t&, index of first point to convert
+//		count	= const std::size_t&, number of points to convert
+//
+// Output Arguments:
+//		x		= double*, must have room for count values
+//		y		= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PanelSet::ConvertCurve(const unsigned int& curve, const std::size_t& start,
+	const std::size_t& count, double* x, double* y) const
+{
+	panels[curvePanels[curve]].ConvertCurve(panelCurves[curve], start, count, x, y);
+}
+
+//==========================================================================
+// Class:			PanelSet
+// Function:		HasUncertainty
+//
+// Description:		Checks for uncertainty estimates in any of the panels.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool PanelSet::HasUncertainty() const
+{
+	return std::any_of(panels.begin(), panels.end(), [](const PointPicker& panel)
+	{
+		return panel.HasUncertainty();
+	});
+}
+
+//==========================================================================
+// Class:			PanelSet
+// Function:		ConvertCurveDeviation
+//
+// Description:		Computes the standard deviations for a block of points with
+//					the replicates of the panel the curve belongs to.
+//
+// Input Arguments:
+//		curve		= const unsigned int&
+//		start		= const std::size_t&, index of first point to convert
+//		count		= const std::size_t&, number of points to convert
+//
+// Output Arguments:
+//		xDeviation	= double*, must have room for count values
+//		yDeviation	= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PanelSet::ConvertCurveDeviation(const unsigned int& curve, const std::size_t& start,
+	const std::size_t& count, double* xDeviation, double* yDeviation) const
+{
+	panels[curvePanels[curve]].ConvertCurveDeviation(panelCurves[curve], start, count, xDeviation, yDeviation);
+}
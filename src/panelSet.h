@@ -0,0 +1,44 @@
+// File:  panelSet.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Curves from several pickers (one for each plot panel in an image)
+//        presented as a single source, so all of the panels are exported
+//        together in one pass.  Curves are numbered panel by panel.
+
+#ifndef PANEL_SET_H_
+#define PANEL_SET_H_
+
+// Standard C++ headers
+#include <vector>
+
+// Local headers
+#include "pointPicker.h"
+#include "curveSource.h"
+
+class PanelSet : public CurveSource
+{
+public:
+	// Panels are copied, so the originals can keep changing
+	void Add(const PointPicker& picker);
+
+	// Fits any panel whose transformation is out of date, on the calling thread
+	void UpdateTransformations();
+
+	unsigned int GetCurveCount() const override { return static_cast<unsigned int>(curvePanels.size()); }
+	std::size_t GetCurveSize(const unsigned int& curve) const override;
+	void ConvertCurve(const unsigned int& curve, const std::size_t& start,
+		const std::size_t& count, double* x, double* y) const override;
+
+	bool HasUncertainty() const override;
+	void ConvertCurveDeviation(const unsigned int& curve, const std::size_t& start,
+		const std::size_t& count, double* xDeviation, double* yDeviation) const override;
+
+private:
+	std::vector<PointPicker> panels;
+
+	// Panel and panel curve index for each curve in the set
+	std::vector<unsigned int> curvePanels;
+	std::vector<unsigned int> panelCurves;
+};
+
+#endif// PANEL_SET_H_
@@ -0,0 +1,194 @@
+// File:  plotDataExporter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming writer for delimited text files containing converted curve data.
+
+// Standard C++ headers
+#include <fstream>
+#include <algorithm>
+
+// Local headers
+#include "plotDataExporter.h"
+#include "bufferedWriter.h"
+
+//==========================================================================
+// Class:			PlotDataExporter
+// Function:		PlotDataExporter
+//
+// Description:		Constructor for PlotDataExporter class.
+//
+// Input Arguments:
+//		delimiter	= const char&
+//		padding		= const Padding&, used in place of values for curves with
+//					  fewer points than the longest curve
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PlotDataExporter::PlotDataExporter(const char& delimiter, const Padding& padding)
+	: delimiter(delimiter), padding(padding)
+{
+}
+
+//==========================================================================
+// Class:			PlotDataExporter
+// Function:		Export
+//
+// Description:		Writes the specified curve data to file.  Curves are written
+//					as X/Y column pairs and are lined up by point index.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//		source		= const CurveSource&
+//		labels		= const std::vector<std::string>&, empty entries are replaced
+//					  with default column names
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool PlotDataExporter::Export(const std::string& fileName, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	ResetStatus();
+
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	if (!file.is_open() || !file.good())
+	{
+		errorString = "Failed to open '" + fileName + "' for output.";
+		return false;
+	}
+
+	BufferedWriter writer(file);
+
+	// With bootstrap results, each curve also gets standard deviation columns
+	const bool includeDeviation(source.HasUncertainty());
+	const unsigned int curveCount(source.GetCurveCount());
+	unsigned int i;
+	for (i = 0; i < curveCount; ++i)
+	{
+		if (i > 0)
+			writer.Write(delimiter);
+
+		std::string xName, yName;
+		if (i >= labels.size() || labels[i].empty())
+		{
+			const std::string index(std::to_string(i));
+			xName = "X" + index;
+			yName = "Y" + index;
+		}
+		else
+		{
+			xName = labels[i] + " X";
+			yName = labels[i] + " Y";
+		}
+
+		writer.Write(xName);
+		writer.Write(delimiter);
+		writer.Write(yName);
+		if (includeDeviation)
+		{
+			writer.Write(delimiter);
+			writer.Write(xName + " SD");
+			writer.Write(delimiter);
+			writer.Write(yName + " SD");
+		}
+	}
+	writer.Write('\n');
+
+	std::string padText;
+	if (padding == Padding::NaN)
+		padText = "NaN";
+	else if (padding == Padding::Zero)
+		padText = "0";
+
+	std::size_t rowCount(0);
+	for (i = 0; i < curveCount; ++i)
+		rowCount = std::max(rowCount, source.GetCurveSize(i));
+
+	// Convert one block of rows at a time so we never hold a full copy of the data
+	std::vector<std::vector<double>> x(curveCount, std::vector<double>(blockSize));
+	std::vector<std::vector<double>> y(curveCount, std::vector<double>(blockSize));
+	std::vector<std::vector<double>> xDeviation(includeDeviation ? curveCount : 0, std::vector<double>(blockSize));
+	std::vector<std::vector<double>> yDeviation(includeDeviation ? curveCount : 0, std::vector<double>(blockSize));
+	std::vector<std::size_t> available(curveCount);
+	const std::uint64_t totalPoints(GetTotalPointCount(source));
+	std::uint64_t pointsDone(0);
+
+	for (std::size_t blockStart = 0; blockStart < rowCount; blockStart += blockSize)
+	{
+		for (i = 0; i < curveCount; ++i)
+		{
+			const std::size_t curveSize(source.GetCurveSize(i));
+			if (curveSize > blockStart)
+			{
+				available[i] = std::min(blockSize, curveSize - blockStart);
+				source.ConvertCurve(i, blockStart, available[i], x[i].data(), y[i].data());
+				if (includeDeviation)
+					source.ConvertCurveDeviation(i, blockStart, available[i], xDeviation[i].data(), yDeviation[i].data());
+				pointsDone += available[i];
+			}
+			else
+				available[i] = 0;
+		}
+
+		const std::size_t blockRows(std::min(blockSize, rowCount - blockStart));
+		for (std::size_t j = 0; j < blockRows; ++j)
+		{
+			for (i = 0; i < curveCount; ++i)
+			{
+				if (i > 0)
+					writer.Write(delimiter);
+
+				if (j < available[i])
+				{
+					writer.Write(x[i][j]);
+					writer.Write(delimiter);
+					writer.Write(y[i][j]);
+					if (includeDeviation)
+					{
+						writer.Write(delimiter);
+						writer.Write(xDeviation[i][j]);
+						writer.Write(delimiter);
+						writer.Write(yDeviation[i][j]);
+					}
+				}
+				else
+				{
+					writer.Write(padText);
+					writer.Write(delimiter);
+					writer.Write(padText);
+					if (includeDeviation)
+					{
+						writer.Write(delimiter);
+						writer.Write(padText);
+						writer.Write(delimiter);
+						writer.Write(padText);
+					}
+				}
+			}
+			writer.Write('\n');
+		}
+
+		if (!ReportProgress(pointsDone, totalPoints))
+			return false;
+	}
+
+	const bool ok(writer.Flush());
+	bytesWritten = writer.GetBytesWritten();
+	if (!ok)
+	{
+		errorString = "Failed while writing to '" + fileName + "'.";
+		return false;
+	}
+
+	rowsWritten = rowCount;
+	return true;
+}
@@ -0,0 +1,33 @@
+// File:  plotDataExporter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming writer for delimited text files containing converted curve data.
+
+#ifndef PLOT_DATA_EXPORTER_H_
+#define PLOT_DATA_EXPORTER_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "dataExporter.h"
+#include "curveSource.h"
+
+class PlotDataExporter : public DataExporter
+{
+public:
+	PlotDataExporter(const char& delimiter, const Padding& padding);
+
+	bool Export(const std::string& fileName, const CurveSource& source,
+		const std::vector<std::string>& labels) override;
+
+private:
+	const char delimiter;
+	const Padding padding;
+
+	// Number of rows converted at a time
+	static constexpr std::size_t blockSize = 4096;
+};
+
+#endif// PLOT_DATA_EXPORTER_H_
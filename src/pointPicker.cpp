@@ -8,6 +8,8 @@
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <utility>
 
 // wxWidgets headers
 #include <wx/clipbrd.h>
@@ -29,6 +31,11 @@
 // Local headers
 #include "pointPicker.h"
 #include "pointEntryDialog.h"
+#include "profiler.h"
+#include "levenbergMarquardt.h"
+#include "ransacEstimator.h"
+#include "bootstrapEstimator.h"
+#include "threadPool.h"
 
 //==========================================================================
 // Class:			PointPicker
@@ -51,6 +58,13 @@ PointPicker::PointPicker()
 	clipMode = ClipboardMode::None;
 	dataMode = DataExtractionMode::None;
 	curveIndex = 0;
+	referenceEntry = ReferenceEntry::Dialog;
+	referenceVersion = 0;
+	fittedVersion = 0;
+	calibrationVersion = 0;
+	transformationVersion = 0;
+	hasRegionCorner = false;
+	ResetTransformations();
 	ResetErrorString();
 }
 
@@ -142,6 +156,22 @@ void PointPicker::HandleDataMode(const double& x, const double& y)
 	if (dataMode == DataExtractionMode::None)
 		return;
 
+	if (dataMode == DataExtractionMode::Regions)
+	{
+		lastPoint.x = x;
+		lastPoint.y = y;
+		if (!hasRegionCorner)
+		{
+			regionCorner = lastPoint;
+			hasRegionCorner = true;
+			return;
+		}
+
+		hasRegionCorner = false;
+		AddRegion(regionCorner, lastPoint);
+		return;
+	}
+
 	if (dataMode == DataExtractionMode::Curve)
 	{
 		while (curvePoints.size() <= curveIndex)
@@ -150,6 +180,14 @@ void PointPicker::HandleDataMode(const double& x, const double& y)
 		lastPoint.x = x;
 		lastPoint.y = y;
 		curvePoints[curveIndex].push_back(lastPoint);
+		Profiler::Increment(Profiler::Counter::PointsAdded);
+		return;
+	}
+
+	if (referenceEntry == ReferenceEntry::Deferred)
+	{
+		const double nan(std::numeric_limits<double>::quiet_NaN());
+		pendingReferences.push_back(ReferencePair(Point(x, y), Point(nan, nan)));
 		return;
 	}
 
@@ -161,8 +199,43 @@ void PointPicker::HandleDataMode(const double& x, const double& y)
 	{
 		lastPoint = dialog.GetPoint();
 		referencePoints.push_back(ReferencePair(Point(x, y), lastPoint));
+		ReferencesChanged();
+	}
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ReferencesChanged
+//
+// Description:		Marks the current transformation as out of date and requests
+//					a new fit.  If a fit request handler is installed, the fit is
+//					left to it and the previous transformation (if any) remains
+//					in use until the new result is applied.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ReferencesChanged()
+{
+	++referenceVersion;
+	if (referencePoints.size() < 4 || !fitRequestHandler)
+	{
 		UpdateTransformation();
+		return;
 	}
+
+	if (!errorString.empty())
+		errorString = _T("Computing transformation");
+
+	Profiler::Increment(Profiler::Counter::FitsRequested);
+	fitRequestHandler();
 }
 
 //==========================================================================
@@ -170,7 +243,7 @@ void PointPicker::HandleDataMode(const double& x, const double& y)
 // Function:		UpdateTransformation
 //
 // Description:		Updates the transformation matrix according to all stored
-//					reference points.
+//					reference points.  The fit is done on the calling thread.
 //
 // Input Arguments:
 //		None
@@ -186,257 +259,392 @@ void PointPicker::UpdateTransformation()
 {
 	if (referencePoints.size() < 4)
 	{
+		ResetTransformations();
 		ResetErrorString();
+		fittedVersion = referenceVersion;
 		return;
 	}
-	else
-		errorString.clear();
-
-	// Use the Direct Linear Transform approach to solve for the unknown
-	// projective transforms.  Solve for the transforms assuming all different
-	// combination of linear and logarithmic scales in order to determine
-	// which combination provides the lowest error.
-	double xLinYLinError;
-	Eigen::MatrixXd xLinYLinTransformation(ComputeTransformation(referencePoints, PlotScaling::Linear, xLinYLinError));
-	if (referencePoints.size() == 4)// Not enough information to determine if scaling is logarithmic
-	{
-		transformationMatrix = xLinYLinTransformation;
-		xIsLogarithmic = false;
-		yIsLogarithmic = false;
-		return;
-	}
 
-	bool xLogIsOption(true);
-	bool yLogIsOption(true);
+	ApplyTransformations(FitTransformations(referencePoints, regions, fitOptions), referenceVersion);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ResetTransformations
+//
+// Description:		Replaces the transformations with unfit ones, one for each
+//					region.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ResetTransformations()
+{
+	auto state(std::make_shared<FitState>());
+	state->transformations.assign(GetRegionCount(), Transformation());
+	fitState = std::move(state);
+	++transformationVersion;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		SetFitOptions
+//
+// Description:		Sets the options used when fitting the transformation.
+//
+// Input Arguments:
+//		options	= const FitOptions&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::SetFitOptions(const FitOptions& options)
+{
+	fitOptions = options;
+	++calibrationVersion;
+	ReferencesChanged();
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ApplyTransformations
+//
+// Description:		Applies transformations computed by FitTransformations.
+//					Results fit to an out-of-date set of references or regions
+//					are ignored.  Regions that have references but could not
+//					be fit are reported in the error string.
+//
+// Input Arguments:
+//		fitted	= const TransformationSet&
+//		version	= const unsigned int&, reference version that was fit
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the transformations were applied
+//
+//==========================================================================
+bool PointPicker::ApplyTransformations(const TransformationSet& fitted, const unsigned int& version)
+{
+	if (version != referenceVersion || referencePoints.size() < 4 || fitted.size() != GetRegionCount())
+		return false;
+
+	auto state(std::make_shared<FitState>());
+	state->transformations = fitted;
 
-	for (unsigned int i = 0; i < referencePoints.size(); i++)
+	// Each region's inliers are in the order of its references; gather them
+	// back into the order of all references
+	const std::vector<unsigned int> assignments(AssignRegions(referencePoints, regionIndex));
+	std::vector<std::size_t> regionReferenceCount(fitted.size(), 0);
+	const bool hasInliers(std::any_of(fitted.begin(), fitted.end(), [](const Transformation& t)
 	{
-		if (referencePoints[i].valueCoords.x <= 0.0)
-			xLogIsOption = false;
-		if (referencePoints[i].valueCoords.y <= 0.0)
-			yLogIsOption = false;
-	}
+		return !t.inliers.empty();
+	}));
+
+	if (hasInliers)
+		state->inliers.assign(referencePoints.size(), true);
 
-	double xLinYLogError(std::numeric_limits<double>::max());
-	double xLogYLinError(std::numeric_limits<double>::max());
-	double xLogYLogError(std::numeric_limits<double>::max());
+	std::size_t i;
+	for (i = 0; i < assignments.size(); ++i)
+	{
+		const std::vector<bool>& inliers(fitted[assignments[i]].inliers);
+		const std::size_t j(regionReferenceCount[assignments[i]]++);
+		if (j < inliers.size())
+			state->inliers[i] = inliers[j];
+	}
 
-	Eigen::MatrixXd xLinYLogTransformation;
-	Eigen::MatrixXd xLogYLinTransformation;
-	Eigen::MatrixXd xLogYLogTransformation;
+	fitState = std::move(state);
+	++transformationVersion;
+	fittedVersion = version;
 
-	if (yLogIsOption)
+	errorString.clear();
+	bool anyFit(false);
+	unsigned int r;
+	for (r = 0; r < fitted.size(); ++r)
 	{
-		xLinYLogTransformation = ComputeTransformation(referencePoints, PlotScaling::SemiLogY, xLinYLogError);
-		if (xLogIsOption)
-			xLogYLogTransformation = ComputeTransformation(referencePoints, PlotScaling::SemiLogX, xLogYLogError);
+		if (fitted[r].IsFit())
+			anyFit = true;
+		else if (regionReferenceCount[r] > 0 && errorString.empty())
+			errorString = wxString::Format(_T("Not enough reference points in region %u"), r);
 	}
 
-	if (xLogIsOption)
-		xLogYLinTransformation = ComputeTransformation(referencePoints, PlotScaling::LogLog, xLogYLinError);
+	if (!anyFit)
+		ResetErrorString();
+
+	return true;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		FitTransformation
+//
+// Description:		Computes the transformation that best fits the specified
+//					reference points.
+//
+// Input Arguments:
+//		pairs	= const std::vector<ReferencePair>&, must have at least 4 entries
+//		options	= const FitOptions&
+//		pool	= ThreadPool*, may be null
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Transformation
+//
+//==========================================================================
+PointPicker::Transformation PointPicker::FitTransformation(const std::vector<ReferencePair>& pairs,
+	const FitOptions& options, ThreadPool* pool)
+{
+	assert(pairs.size() >= 4);
+	if (options.robust && pairs.size() > 4)
+		return FitRobust(pairs, options, pool);
 
-	// For linearly-scaled axes, the log-scaled transforms can have very similar error values to the
-	// proper linear transforms but still give poor results.  When the correct scaling is logarithmic,
-	// however, the linear transform will give an error that is orders of magnitude higher than that
-	// given by the log transform.  So we assume linear unless the error is many times better when
-	// using a log transform.
-	const double linLogErrorRatio(1.0);
+	Profiler::ScopedTimer timer(Profiler::Probe::TransformationFit);
+	Transformation result;
+	result.xScale = AxisScale::Type::Linear;
+	result.yScale = AxisScale::Type::Linear;
 
-	if (xLinYLinError < xLinYLogError * linLogErrorRatio &&
-		xLinYLinError < xLogYLinError * linLogErrorRatio &&
-		xLinYLinError < xLogYLogError * linLogErrorRatio)
+	std::vector<ScaleFit> candidates(GetScaleCandidates(pairs, options.xScales, options.yScales));
+	if (candidates.empty())
+		return result;
+
+	// Not enough information to determine the axis scales, so the first
+	// allowed combination (linear, unless it is excluded) is used
+	if (pairs.size() == 4)
 	{
-		transformationMatrix = xLinYLinTransformation;
-		xIsLogarithmic = false;
-		yIsLogarithmic = false;
+		result.xScale = candidates.front().xScale;
+		result.yScale = candidates.front().yScale;
+		result.matrix = ComputeTransformation(pairs, candidates.front().plotPoints, result.error);
+		return result;
 	}
-	else if (xLinYLogError < xLogYLinError &&
-		xLinYLogError < xLogYLogError)
+
+	// Fit every valid combination of axis scales to determine which provides
+	// the lowest error.  The combinations are independent, so they are fit in
+	// parallel when a pool is available.
+	auto fitCandidate([&pairs](ScaleFit& candidate)
 	{
-		transformationMatrix = xLinYLogTransformation;
-		xIsLogarithmic = false;
-		yIsLogarithmic = true;
-	}
-	else if (xLogYLinError < xLogYLogError)
+		candidate.matrix = ComputeTransformation(pairs, candidate.plotPoints, candidate.error);
+	});
+
+	if (pool && pool->GetThreadCount() > 1 && candidates.size() > 1)
 	{
-		transformationMatrix = xLogYLinTransformation;
-		xIsLogarithmic = true;
-		yIsLogarithmic = false;
+		for (auto& candidate : candidates)
+		{
+			pool->Submit([&fitCandidate, &candidate]()
+			{
+				fitCandidate(candidate);
+			});
+		}
+		pool->WaitIdle();
 	}
 	else
 	{
-		transformationMatrix = xLogYLogTransformation;
-		xIsLogarithmic = true;
-		yIsLogarithmic = true;
+		for (auto& candidate : candidates)
+			fitCandidate(candidate);
 	}
+
+	const ScaleFit& best(candidates[SelectScaleCandidate(candidates)]);
+	result.matrix = best.matrix;
+	result.xScale = best.xScale;
+	result.yScale = best.yScale;
+	result.error = best.error;
+
+	if (options.distortion != DistortionModel::Type::None)
+		FitDistortion(pairs, options.distortion, true, result);
+
+	if (options.bootstrapReplicates > 1)
+		result.replicates = std::make_shared<const std::vector<Transformation>>(
+			BootstrapEstimator::FitReplicates(pairs, result, options.bootstrapReplicates, pool));
+
+	return result;
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		ComputeTransformation
+// Function:		FitScales
 //
-// Description:		Computes the transformation for the specified correspondances.
+// Description:		Fits the transformation with the specified axis scales.
 //
 // Input Arguments:
-//		paris	= const std::vector<ReferencePair>&
-//		scaling	= const PlotScaling&
+//		pairs			= const std::vector<ReferencePair>&, must have at least 4 entries
+//		xScale			= const AxisScale::Type&
+//		yScale			= const AxisScale::Type&
+//		distortion		= const DistortionModel::Type&
 //
 // Output Arguments:
-//		error	= double&
+//		transformation	= Transformation&
 //
 // Return Value:
-//		Eigen::Matrix3d
+//		bool, true for success
 //
 //==========================================================================
-Eigen::Matrix3d PointPicker::ComputeTransformation(
-	const std::vector<ReferencePair>& pairs, const PlotScaling& scaling, double& error)
+bool PointPicker::FitScales(const std::vector<ReferencePair>& pairs, const AxisScale::Type& xScale,
+	const AxisScale::Type& yScale, const DistortionModel::Type& distortion, Transformation& transformation)
 {
-	Eigen::Matrix<double, Eigen::Dynamic, 9> model(2 * pairs.size(), 9);
-
-	// Set up columns that will all have the same value
-	model.block(0,2,pairs.size(),1).setOnes();
-	model.block(0,3,pairs.size(),3).setZero();
-	model.block(pairs.size(),0,pairs.size(),3).setZero();
-	model.block(pairs.size(),5,pairs.size(),1).setOnes();
-
-	const bool xLog(scaling == PlotScaling::LogLog || scaling == PlotScaling::SemiLogX);
-	const bool yLog(scaling == PlotScaling::LogLog || scaling == PlotScaling::SemiLogY);
+	assert(pairs.size() >= 4);
+	std::vector<Eigen::Vector2d> plotPoints;
+	if (!GetPlotPoints(pairs, xScale, yScale, plotPoints))
+		return false;
 
-	for (unsigned int i = 0; i < pairs.size(); i++)
-	{
-		auto adjustValue([](const double& v, const bool& isLog)
-		{
-			if (isLog)
-				return log10(v);
-			return v;
-		});
-
-		const double xVal(adjustValue(pairs[i].valueCoords.x, xLog));
-		const double yVal(adjustValue(pairs[i].valueCoords.y, yLog));
+	transformation.xScale = xScale;
+	transformation.yScale = yScale;
+	transformation.matrix = ComputeTransformation(pairs, plotPoints, transformation.error);
 
-		// X-ordinate
-		model(i,0) = pairs[i].imageCoords.x;
-		model(i,1) = pairs[i].imageCoords.y;
-
-		model(i,6) = -xVal * pairs[i].imageCoords.x;
-		model(i,7) = -xVal * pairs[i].imageCoords.y;
-		model(i,8) = -xVal;
+	if (distortion != DistortionModel::Type::None && transformation.IsFit())
+		FitDistortion(pairs, distortion, false, transformation);
 
-		// Y-ordinate
-		model(i + pairs.size(),3) = pairs[i].imageCoords.x;
-		model(i + pairs.size(),4) = pairs[i].imageCoords.y;
+	return transformation.IsFit();
+}
 
-		model(i + pairs.size(),6) = -yVal * pairs[i].imageCoords.x;
-		model(i + pairs.size(),7) = -yVal * pairs[i].imageCoords.y;
-		model(i + pairs.size(),8) = -yVal;
+//==========================================================================
+// Class:			PointPicker
+// Function:		FitTransformations
+//
+// Description:		Fits a transformation for each region to the references
+//					that lie inside of it.  The regions are fit one after
+//					another, since each fit already spreads its work over the
+//					pool.
+//
+// Input Arguments:
+//		pairs	= const std::vector<ReferencePair>&
+//		regions	= const std::vector<RegionIndex::Bounds>&, bounded regions
+//		options	= const FitOptions&
+//		pool	= ThreadPool*, may be null
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		TransformationSet, one entry more than there are bounded regions
+//
+//==========================================================================
+PointPicker::TransformationSet PointPicker::FitTransformations(const std::vector<ReferencePair>& pairs,
+	const std::vector<RegionIndex::Bounds>& regions, const FitOptions& options, ThreadPool* pool)
+{
+	TransformationSet fitted(regions.size() + 1);
+	if (regions.empty())
+	{
+		if (pairs.size() >= 4)
+			fitted.front() = FitTransformation(pairs, options, pool);
+		return fitted;
 	}
 
-	Eigen::JacobiSVD<Eigen::Matrix<double, Eigen::Dynamic, 9>> svd(model, Eigen::ComputeFullV);
-	Eigen::Matrix<double, 9, 1> nullspace(svd.matrixV().col(8));
-	Eigen::Matrix3d transform;
-	transform.row(0) = nullspace.head<3>();
-	transform.row(1) = nullspace.segment<3>(3);
-	transform.row(2) = nullspace.tail<3>();
+	RegionIndex index;
+	index.Build(regions);
+	const std::vector<unsigned int> assignments(AssignRegions(pairs, index));
 
-	// This doesn't work for log-scaled axes
-	/*Eigen::VectorXd errorVector(model * nullspace);
-	error = errorVector.dot(errorVector);*/
+	std::vector<std::vector<ReferencePair>> regionPairs(fitted.size());
+	std::size_t i;
+	for (i = 0; i < pairs.size(); ++i)
+		regionPairs[assignments[i]].push_back(pairs[i]);
 
-	error = 0.0;
-	for (const auto& p : pairs)
+	for (i = 0; i < fitted.size(); ++i)
 	{
-		Eigen::Vector3d imagePoint(p.imageCoords.x, p.imageCoords.y, 1.0);
-		Eigen::Vector3d plotPoint(transform * imagePoint);
-		Point result(plotPoint(0) / plotPoint(2), plotPoint(1) / plotPoint(2));
-		if (xLog)
-			result.x = pow(10, result.x);
-		if (yLog)
-			result.y = pow(10, result.y);
-
-		error += (result.x - p.valueCoords.x) * (result.x - p.valueCoords.x) + (result.y - p.valueCoords.y) * (result.y - p.valueCoords.y);
+		if (regionPairs[i].size() >= 4)
+			fitted[i] = FitTransformation(regionPairs[i], options, pool);
 	}
 
-	return transform;
+	return fitted;
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		GetReferences
+// Function:		AssignRegions
 //
-// Description:		Returns list of references.
+// Description:		Looks up the region containing each reference.
 //
 // Input Arguments:
-//		None
+//		pairs	= const std::vector<ReferencePair>&
+//		index	= const RegionIndex&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		std::vector<PointPicker::Point>
+//		std::vector<unsigned int>, region for each reference
 //
 //==========================================================================
-std::vector<PointPicker::Point> PointPicker::GetReferences() const
+std::vector<unsigned int> PointPicker::AssignRegions(const std::vector<ReferencePair>& pairs,
+	const RegionIndex& index)
 {
-	std::vector<Point> refs(referencePoints.size());
-	for (unsigned int i = 0; i < refs.size(); ++i)
-		refs[i] = referencePoints[i].valueCoords;
+	std::vector<unsigned int> assignments(pairs.size());
+	std::size_t i;
+	for (i = 0; i < pairs.size(); ++i)
+		assignments[i] = LookUpRegion(index, pairs[i].imageCoords);
 
-	return refs;
+	return assignments;
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		RemoveReference
+// Function:		LookUpRegion
 //
-// Description:		Removes the specified element from the list of references.
+// Description:		Returns the region containing the point.
 //
 // Input Arguments:
-//		i	= const unsigned int&
+//		index		= const RegionIndex&
+//		imagePoint	= const Point&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		unsigned int, zero if no bounded region contains the point
 //
 //==========================================================================
-void PointPicker::RemoveReference(const unsigned int& i)
+unsigned int PointPicker::LookUpRegion(const RegionIndex& index, const Point& imagePoint)
 {
-	referencePoints.erase(referencePoints.begin() + i);
+	const std::size_t found(index.Find(imagePoint.x, imagePoint.y));
+	if (found == RegionIndex::none)
+		return 0;
+
+	return static_cast<unsigned int>(found) + 1;
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		ScaleOrdinate
+// Function:		FindRegion
 //
-// Description:		Scales the value according to the specified length and offset.
+// Description:		Returns the region containing the point.
 //
 // Input Arguments:
-//		value	= const double&
-//		scale	= const double&
-//		offset	= const double&
+//		imagePoint	= const Point&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		double
+//		unsigned int, zero if no bounded region contains the point
 //
 //==========================================================================
-double PointPicker::ScaleOrdinate(const double& value, const double& scale,
-	const double& offset)
+unsigned int PointPicker::FindRegion(const Point& imagePoint) const
 {
-	return value * scale + offset;
+	return LookUpRegion(regionIndex, imagePoint);
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		ResetReferences
+// Function:		AddRegion
 //
-// Description:		Resets the stored reference data.
+// Description:		Adds a separately calibrated region.  Where regions overlap,
+//					the newest one takes precedence.
 //
 // Input Arguments:
-//		None
+//		corner1	= const Point&, image coordinates
+//		corner2	= const Point&, image coordinates of the opposite corner
 //
 // Output Arguments:
 //		None
@@ -445,20 +653,22 @@ double PointPicker::ScaleOrdinate(const double& value, const double& scale,
 //		None
 //
 //==========================================================================
-void PointPicker::ResetReferences()
+void PointPicker::AddRegion(const Point& corner1, const Point& corner2)
 {
-	referencePoints.clear();
-	ResetErrorString();
+	regions.push_back(RegionIndex::Bounds(corner1.x, corner1.y, corner2.x, corner2.y));
+	RegionsChanged();
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		ResetCurveData
+// Function:		RemoveRegion
 //
-// Description:		Resets the stored curve data.
+// Description:		Removes the specified bounded region; its references and
+//					curve points fall back to whichever region now contains
+//					them.
 //
 // Input Arguments:
-//		curve	= const unsigned int&
+//		region	= const unsigned int&, at least one
 //
 // Output Arguments:
 //		None
@@ -467,16 +677,18 @@ void PointPicker::ResetReferences()
 //		None
 //
 //==========================================================================
-void PointPicker::ResetCurveData(const unsigned int& curve)
+void PointPicker::RemoveRegion(const unsigned int& region)
 {
-	curvePoints.erase(curvePoints.begin() + curve);
+	assert(region > 0 && region <= regions.size());
+	regions.erase(regions.begin() + region - 1);
+	RegionsChanged();
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		Reset
+// Function:		ResetRegions
 //
-// Description:		Resets all stored data.
+// Description:		Removes all of the bounded regions.
 //
 // Input Arguments:
 //		None
@@ -488,19 +700,48 @@ void PointPicker::ResetCurveData(const unsigned int& curve)
 //		None
 //
 //==========================================================================
-void PointPicker::Reset()
+void PointPicker::ResetRegions()
 {
-	ResetReferences();
+	regions.clear();
+	hasRegionCorner = false;
+	RegionsChanged();
+}
 
-	curvePoints.clear();
-	curveIndex = 0;
+//==========================================================================
+// Class:			PointPicker
+// Function:		SetCalibration
+//
+// Description:		Replaces the references, regions and fit options.
+//
+// Input Arguments:
+//		pairs		= const std::vector<ReferencePair>&
+//		newRegions	= const std::vector<RegionIndex::Bounds>&
+//		options		= const FitOptions&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::SetCalibration(const std::vector<ReferencePair>& pairs,
+	const std::vector<RegionIndex::Bounds>& newRegions, const FitOptions& options)
+{
+	referencePoints = pairs;
+	regions = newRegions;
+	hasRegionCorner = false;
+	fitOptions = options;
+	RegionsChanged();
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		GetCurveData
+// Function:		RegionsChanged
 //
-// Description:		Returns processed curve data.
+// Description:		Rebuilds the region index and refits.  The previous
+//					transformations no longer line up with the regions, so
+//					they are dropped right away.
 //
 // Input Arguments:
 //		None
@@ -509,52 +750,1626 @@ void PointPicker::Reset()
 //		None
 //
 // Return Value:
-//		std::vector<std::vector<PointPicker::Point>>
+//		None
 //
 //==========================================================================
-std::vector<std::vector<PointPicker::Point>> PointPicker::GetCurveData() const
+void PointPicker::RegionsChanged()
 {
-	if (!errorString.empty())
-		return std::vector<std::vector<Point>>(0);
-
-	std::vector<std::vector<Point>> data(curvePoints);
-	for (unsigned int i = 0; i < curvePoints.size(); i++)
-	{
-		for (unsigned int j = 0; j < curvePoints[i].size(); j++)
-			data[i][j] = ScalePoint(curvePoints[i][j]);
-	}
-
-	return data;
+	regionIndex.Build(regions);
+	++calibrationVersion;
+	ResetTransformations();
+	ResetErrorString();
+	ReferencesChanged();
 }
 
 //==========================================================================
 // Class:			PointPicker
-// Function:		ScalePoint
+// Function:		FitRobust
 //
-// Description:		Converts the specified point from image to plot coordinates.
+// Description:		Separates mislabeled references from the rest using RANSAC
+//					(for each valid combination of axis scales), then fits the
+//					inliers of the best consensus.  With a distortion model, the
+//					inliers are then found again with the full model.  If no
+//					consistent subset is found, all of the references are used.
 //
 // Input Arguments:
-//		imagePointIn	= const Point&
+//		pairs	= const std::vector<ReferencePair>&, must have more than 4 entries
+//		options	= const FitOptions&
+//		pool	= ThreadPool*, may be null
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		PointPicker::Point
+//		Transformation
 //
 //==========================================================================
-PointPicker::Point PointPicker::ScalePoint(const Point& imagePointIn) const
+PointPicker::Transformation PointPicker::FitRobust(const std::vector<ReferencePair>& pairs,
+	const FitOptions& options, ThreadPool* pool)
 {
-	Eigen::Vector3d imagePoint(imagePointIn.x, imagePointIn.y, 1.0);
-	Eigen::Vector3d plotPoint(transformationMatrix * imagePoint);
+	RansacEstimator::Settings settings;
+	settings.inlierThreshold = options.inlierThreshold;
+	settings.maxHypotheses = options.maxHypotheses;
 
-	Point p(plotPoint(0) / plotPoint(2), plotPoint(1) / plotPoint(2));
+	std::vector<Eigen::Vector2d> imagePoints(pairs.size());
+	unsigned int i;
+	for (i = 0; i < pairs.size(); ++i)
+		imagePoints[i] = Eigen::Vector2d(pairs[i].imageCoords.x, pairs[i].imageCoords.y);
+
+	std::vector<bool> inliers;
+	double bestCost(std::numeric_limits<double>::max());
+	AxisScale::Type xScale(AxisScale::Type::Linear), yScale(AxisScale::Type::Linear);
+	for (const auto& candidate : GetScaleCandidates(pairs, options.xScales, options.yScales))
+	{
+		std::vector<bool> scalingInliers;
+		double cost;
+		if (RansacEstimator::Estimate(imagePoints, candidate.plotPoints, settings, pool, scalingInliers, cost) && cost < bestCost)
+		{
+			inliers.swap(scalingInliers);
+			bestCost = cost;
+			xScale = candidate.xScale;
+			yScale = candidate.yScale;
+		}
+	}
 
-	if (xIsLogarithmic)
-		p.x = pow(10.0, p.x);
+	FitOptions inlierOptions(options);
+	inlierOptions.robust = false;
+	if (inliers.empty())
+		return FitTransformation(pairs, inlierOptions, pool);
+
+	// Replicates are fit once the inliers are settled
+	inlierOptions.bootstrapReplicates = 0;
+	auto fitInliers([&](const std::vector<bool>& mask, std::vector<ReferencePair>& maskPairs, Transformation& fit)
+	{
+		std::size_t j;
+		for (j = 0; j < pairs.size(); ++j)
+		{
+			if (mask[j])
+				maskPairs.push_back(pairs[j]);
+		}
+
+		// With more than the minimum number of inliers, the scales are chosen
+		// again from their pixel error, the same way as without outliers.  Four
+		// inliers fit every combination exactly, so then the scales they were
+		// found with are kept.
+		if (maskPairs.size() > 4)
+			fit = FitTransformation(maskPairs, inlierOptions, pool);
+		else
+		{
+			Profiler::ScopedTimer timer(Profiler::Probe::TransformationFit);
+			FitScales(maskPairs, xScale, yScale, options.distortion, fit);
+		}
+		return fit.IsFit();
+	});
+
+	std::vector<ReferencePair> inlierPairs;
+	Transformation result;
+	if (!fitInliers(inliers, inlierPairs, result))
+		return FitTransformation(pairs, inlierOptions, pool);
+
+	// The consensus only has the projective part of the model, so with
+	// distortion, references far from the center can be rejected even though
+	// the full model fits them.  The references are measured against the full
+	// model until the inliers stop changing.
+	if (result.distortion.GetType() != DistortionModel::Type::None)
+	{
+		const unsigned int maxPasses(5);
+		unsigned int pass;
+		for (pass = 0; pass < maxPasses; ++pass)
+		{
+			std::vector<bool> refined(FindInliers(pairs, result, options.inlierThreshold));
+			if (refined == inliers || std::count(refined.begin(), refined.end(), true) <= 4)
+				break;
+
+			std::vector<ReferencePair> refinedPairs;
+			Transformation refit;
+			if (!fitInliers(refined, refinedPairs, refit))
+				break;
+
+			inliers.swap(refined);
+			inlierPairs.swap(refinedPairs);
+			result = std::move(refit);
+		}
+	}
+
+	if (options.bootstrapReplicates > 1)
+		result.replicates = std::make_shared<const std::vector<Transformation>>(
+			BootstrapEstimator::FitReplicates(inlierPairs, result, options.bootstrapReplicates, pool));
+
+	result.inliers.swap(inliers);
+	return result;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		FindInliers
+//
+// Description:		Finds the references that map back (through the inverse
+//					transformation) to within the threshold of their image
+//					locations.
+//
+// Input Arguments:
+//		pairs			= const std::vector<ReferencePair>&
+//		transformation	= const Transformation&
+//		threshold		= const double& [pixels]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<bool>, one per reference
+//
+//==========================================================================
+std::vector<bool> PointPicker::FindInliers(const std::vector<ReferencePair>& pairs,
+	const Transformation& transformation, const double& threshold)
+{
+	std::vector<double> x(pairs.size()), y(pairs.size());
+	std::size_t i;
+	for (i = 0; i < pairs.size(); ++i)
+	{
+		x[i] = pairs[i].valueCoords.x;
+		y[i] = pairs[i].valueCoords.y;
+	}
+
+	std::vector<Point> reprojected(pairs.size());
+	Invert(transformation, pairs.size(), x.data(), y.data(), reprojected.data());
+
+	std::vector<bool> inliers(pairs.size());
+	for (i = 0; i < pairs.size(); ++i)
+	{
+		const double dx(reprojected[i].x - pairs[i].imageCoords.x);
+		const double dy(reprojected[i].y - pairs[i].imageCoords.y);
+		inliers[i] = dx * dx + dy * dy < threshold * threshold;// False for NaN
+	}
+
+	return inliers;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		FitDistortion
+//
+// Description:		Refines the transformation to include the specified
+//					distortion model.  The extra coefficients always lower the
+//					error on the references, so when selecting, the model is
+//					kept only if it lowers the error by more than they account
+//					for (by the small-sample Akaike information criterion).
+//					Otherwise (or if the model can't be fit) the transformation
+//					is left unchanged.
+//
+// Input Arguments:
+//		pairs			= const std::vector<ReferencePair>&
+//		type			= const DistortionModel::Type&
+//		select			= const bool&, false to keep the model whenever it fits
+//		transformation	= Transformation&, projective fit with axis scales chosen
+//
+// Output Arguments:
+//		transformation	= Transformation&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::FitDistortion(const std::vector<ReferencePair>& pairs,
+	const DistortionModel::Type& type, const bool& select, Transformation& transformation)
+{
+	std::vector<Eigen::Vector2d> plotPoints;
+	if (!GetPlotPoints(pairs, transformation.xScale, transformation.yScale, plotPoints))
+		return;
+
+	std::vector<Eigen::Vector2d> imagePoints(pairs.size());
+	std::vector<double> weights(pairs.size());
+	for (unsigned int i = 0; i < pairs.size(); ++i)
+	{
+		imagePoints[i] = Eigen::Vector2d(pairs[i].imageCoords.x, pairs[i].imageCoords.y);
+		weights[i] = pairs[i].weight;
+	}
+
+	DistortionModel model;
+	Eigen::Matrix3d matrix;
+	if (!DistortionModel::Fit(type, imagePoints, plotPoints, weights, transformation.matrix, model, matrix))
+		return;
+
+	Transformation distorted(transformation);
+	distorted.distortion = model;
+	distorted.matrix = matrix;
+	distorted.error = ComputeReprojectionError(pairs, distorted);
+	if (!distorted.IsFit())
+		return;
+
+	const unsigned int projectiveParameters(8);
+	if (!select || ComputeInformationCriterion(distorted.error, pairs.size(),
+		projectiveParameters + DistortionModel::GetCoefficientCount(type)) <
+		ComputeInformationCriterion(transformation.error, pairs.size(), projectiveParameters))
+		transformation = std::move(distorted);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ComputeInformationCriterion
+//
+// Description:		Computes the corrected Akaike information criterion for a
+//					fit, assuming Gaussian errors (up to a constant that is the
+//					same for every fit to the same references).  Lower is better.
+//
+// Input Arguments:
+//		error			= const double&, weighted RMS reprojection error [pixels]
+//		referenceCount	= const std::size_t&
+//		parameterCount	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, the maximum double if the error isn't finite or there are too
+//		few references for the parameters
+//
+//==========================================================================
+double PointPicker::ComputeInformationCriterion(const double& error,
+	const std::size_t& referenceCount, const unsigned int& parameterCount)
+{
+	// Two observations (x and y) per reference
+	const double n(2.0 * referenceCount);
+	const double k(parameterCount);
+	if (!(error < std::numeric_limits<double>::max()) || n - k - 1.0 <= 0.0)
+		return std::numeric_limits<double>::max();
+
+	if (error <= 0.0)
+		return -std::numeric_limits<double>::max();
+
+	return n * std::log(error * error) + 2.0 * k + 2.0 * k * (k + 1.0) / (n - k - 1.0);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ComputeReprojectionError
+//
+// Description:		Measures how far each reference's value maps (through the
+//					inverse transformation) from its image location, in the
+//					same terms as RefineTransformation() so the two can be
+//					compared.
+//
+// Input Arguments:
+//		pairs			= const std::vector<ReferencePair>&
+//		transformation	= const Transformation&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, weighted RMS reprojection error [pixels]; the maximum double
+//		if any reference can't be mapped back to the image
+//
+//==========================================================================
+double PointPicker::ComputeReprojectionError(const std::vector<ReferencePair>& pairs,
+	const Transformation& transformation)
+{
+	std::vector<double> x(pairs.size()), y(pairs.size());
+	std::size_t i;
+	for (i = 0; i < pairs.size(); ++i)
+	{
+		x[i] = pairs[i].valueCoords.x;
+		y[i] = pairs[i].valueCoords.y;
+	}
+
+	std::vector<Point> reprojected(pairs.size());
+	Invert(transformation, pairs.size(), x.data(), y.data(), reprojected.data());
+
+	double sum(0.0), weightSum(0.0);
+	for (i = 0; i < pairs.size(); ++i)
+	{
+		if (!std::isfinite(reprojected[i].x))
+			return std::numeric_limits<double>::max();
+
+		const double weight(std::max(pairs[i].weight, 0.0));
+		const double dx(reprojected[i].x - pairs[i].imageCoords.x);
+		const double dy(reprojected[i].y - pairs[i].imageCoords.y);
+		sum += weight * (dx * dx + dy * dy);
+		weightSum += weight;
+	}
+
+	if (weightSum <= 0.0)
+		return std::numeric_limits<double>::max();
+
+	return sqrt(sum / weightSum);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ComputeTransformation
+//
+// Description:		Computes the transformation for the specified correspondances.
+//					The Direct Linear Transform gives an initial estimate, which
+//					is then refined to minimize the geometric error.
+//
+// Input Arguments:
+//		paris		= const std::vector<ReferencePair>&
+//		plotPoints	= const std::vector<Eigen::Vector2d>&, linearized reference values
+//
+// Output Arguments:
+//		error		= double&, weighted RMS reprojection error [pixels]
+//
+// Return Value:
+//		Eigen::Matrix3d
+//
+//==========================================================================
+Eigen::Matrix3d PointPicker::ComputeTransformation(const std::vector<ReferencePair>& pairs,
+	const std::vector<Eigen::Vector2d>& plotPoints, double& error)
+{
+	Eigen::Matrix<double, Eigen::Dynamic, 9> model(2 * pairs.size(), 9);
+
+	// Set up columns that will all have the same value
+	model.block(0,3,pairs.size(),3).setZero();
+	model.block(pairs.size(),0,pairs.size(),3).setZero();
+
+	for (unsigned int i = 0; i < pairs.size(); i++)
+	{
+		const double xVal(plotPoints[i].x());
+		const double yVal(plotPoints[i].y());
+
+		// Each equation is scaled so that its squared residual is weighted
+		const double s(sqrt(pairs[i].weight));
+
+		// X-ordinate
+		model(i,0) = s * pairs[i].imageCoords.x;
+		model(i,1) = s * pairs[i].imageCoords.y;
+		model(i,2) = s;
+
+		model(i,6) = -s * xVal * pairs[i].imageCoords.x;
+		model(i,7) = -s * xVal * pairs[i].imageCoords.y;
+		model(i,8) = -s * xVal;
+
+		// Y-ordinate
+		model(i + pairs.size(),3) = s * pairs[i].imageCoords.x;
+		model(i + pairs.size(),4) = s * pairs[i].imageCoords.y;
+		model(i + pairs.size(),5) = s;
+
+		model(i + pairs.size(),6) = -s * yVal * pairs[i].imageCoords.x;
+		model(i + pairs.size(),7) = -s * yVal * pairs[i].imageCoords.y;
+		model(i + pairs.size(),8) = -s * yVal;
+	}
+
+	Eigen::JacobiSVD<Eigen::Matrix<double, Eigen::Dynamic, 9>> svd(model, Eigen::ComputeFullV);
+	Eigen::Matrix<double, 9, 1> nullspace(svd.matrixV().col(8));
+	Eigen::Matrix3d transform;
+	transform.row(0) = nullspace.head<3>();
+	transform.row(1) = nullspace.segment<3>(3);
+	transform.row(2) = nullspace.tail<3>();
+
+	return RefineTransformation(pairs, plotPoints, transform, error);
+}
+
+//==========================================================================
+// Class:			PointPicker::ProjectiveFitModel
+//
+// Description:		Reprojection residuals for refining the transformation.
+//					The parameters are the inverse (plot to image) matrix in
+//					normalized coordinates, with the last element fixed at one.
+//					The error is measured in the image because that's where the
+//					noise is (reference values are typed in exactly).
+//
+//==========================================================================
+class PointPicker::ProjectiveFitModel
+{
+public:
+	typedef LevenbergMarquardt<8> Solver;
+
+	ProjectiveFitModel(const std::vector<Eigen::Vector2d>& plotPoints,
+		const std::vector<Eigen::Vector2d>& imagePoints, const std::vector<double>& weights)
+		: plotPoints(plotPoints), imagePoints(imagePoints), scales(weights.size())
+	{
+		for (unsigned int i = 0; i < weights.size(); ++i)
+			scales[i] = sqrt(weights[i]);
+	}
+
+	std::size_t GetObservationCount() const { return plotPoints.size(); }
+
+	void Evaluate(const Solver::Parameters& g, const std::size_t& i,
+		Solver::Residual& r, Solver::Jacobian* j) const
+	{
+		const double a(plotPoints[i].x());
+		const double b(plotPoints[i].y());
+		const double inverseW(1.0 / (g(6) * a + g(7) * b + 1.0));
+		const double x((g(0) * a + g(1) * b + g(2)) * inverseW);
+		const double y((g(3) * a + g(4) * b + g(5)) * inverseW);
+
+		r(0) = scales[i] * (x - imagePoints[i].x());
+		r(1) = scales[i] * (y - imagePoints[i].y());
+
+		if (!j)
+			return;
+
+		const double f(scales[i] * inverseW);
+		*j << f * a, f * b, f, 0.0, 0.0, 0.0, -f * x * a, -f * x * b,
+			0.0, 0.0, 0.0, f * a, f * b, f, -f * y * a, -f * y * b;
+	}
+
+private:
+	const std::vector<Eigen::Vector2d>& plotPoints;
+	const std::vector<Eigen::Vector2d>& imagePoints;
+	std::vector<double> scales;
+};
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		RefineTransformation
+//
+// Description:		Adjusts the transformation to minimize the weighted squared
+//					distance (in pixels) between each reference's image location
+//					and the location its value maps to.  Starting from the DLT
+//					result, this typically converges in two or three iterations.
+//
+// Input Arguments:
+//		pairs			= const std::vector<ReferencePair>&
+//		plotPointsIn	= const std::vector<Eigen::Vector2d>&, linearized reference values
+//		initial			= const Eigen::Matrix3d&, image to plot transformation
+//
+// Output Arguments:
+//		error			= double&, weighted RMS reprojection error [pixels]
+//
+// Return Value:
+//		Eigen::Matrix3d
+//
+//==========================================================================
+Eigen::Matrix3d PointPicker::RefineTransformation(const std::vector<ReferencePair>& pairs,
+	const std::vector<Eigen::Vector2d>& plotPointsIn, const Eigen::Matrix3d& initial, double& error)
+{
+	error = std::numeric_limits<double>::max();
+
+	const std::size_t count(pairs.size());
+	std::vector<Eigen::Vector2d> imagePoints(count), plotPoints(plotPointsIn);
+	std::vector<double> weights(count);
+	Eigen::Vector2d imageCenter(Eigen::Vector2d::Zero());
+	Eigen::Vector2d plotCenter(Eigen::Vector2d::Zero());
+	double weightSum(0.0);
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		imagePoints[i] = Eigen::Vector2d(pairs[i].imageCoords.x, pairs[i].imageCoords.y);
+		weights[i] = std::max(pairs[i].weight, 0.0);
+		weightSum += weights[i];
+		imageCenter += imagePoints[i];
+		plotCenter += plotPoints[i];
+	}
+	imageCenter /= static_cast<double>(count);
+	plotCenter /= static_cast<double>(count);
+
+	// Normalize so that all of the parameters have similar magnitudes
+	double imageSpread(0.0);
+	Eigen::Vector2d plotSpread(Eigen::Vector2d::Zero());
+	for (i = 0; i < count; ++i)
+	{
+		imageSpread += (imagePoints[i] - imageCenter).squaredNorm();
+		plotSpread += (plotPoints[i] - plotCenter).cwiseAbs2();
+	}
+	imageSpread = sqrt(imageSpread / count);
+	plotSpread = (plotSpread / static_cast<double>(count)).cwiseSqrt();
+
+	const Eigen::FullPivLU<Eigen::Matrix3d> lu(initial);
+	if (weightSum <= 0.0 || imageSpread <= 0.0 || plotSpread.minCoeff() <= 0.0 ||
+		!plotSpread.allFinite() || !lu.isInvertible())
+		return initial;
+
+	for (i = 0; i < count; ++i)
+	{
+		imagePoints[i] = (imagePoints[i] - imageCenter) / imageSpread;
+		plotPoints[i] = (plotPoints[i] - plotCenter).cwiseQuotient(plotSpread);
+	}
+
+	Eigen::Matrix3d imageToNormalized(Eigen::Matrix3d::Identity());
+	imageToNormalized(0,0) = 1.0 / imageSpread;
+	imageToNormalized(1,1) = 1.0 / imageSpread;
+	imageToNormalized.block<2,1>(0,2) = -imageCenter / imageSpread;
+
+	Eigen::Matrix3d normalizedToPlot(Eigen::Matrix3d::Identity());
+	normalizedToPlot(0,0) = plotSpread.x();
+	normalizedToPlot(1,1) = plotSpread.y();
+	normalizedToPlot.block<2,1>(0,2) = plotCenter;
+
+	Eigen::Matrix3d g(imageToNormalized * lu.inverse() * normalizedToPlot);
+	if (std::abs(g(2,2)) < 1.0e-12 * g.norm())
+		return initial;
+	g /= g(2,2);
+
+	ProjectiveFitModel::Solver::Parameters p;
+	p << g(0,0), g(0,1), g(0,2), g(1,0), g(1,1), g(1,2), g(2,0), g(2,1);
+
+	ProjectiveFitModel::Solver::Settings settings;
+	settings.maxIterations = 20;
+	settings.costTolerance = 1.0e-10;
+	const ProjectiveFitModel::Solver::Result result(
+		ProjectiveFitModel::Solver::Minimize(ProjectiveFitModel(plotPoints, imagePoints, weights), p, settings));
+	if (!std::isfinite(result.finalCost))
+		return initial;
+
+	g << p(0), p(1), p(2), p(3), p(4), p(5), p(6), p(7), 1.0;
+	const Eigen::FullPivLU<Eigen::Matrix3d> refined(imageToNormalized.inverse() * g * normalizedToPlot.inverse());
+	if (!refined.isInvertible())
+		return initial;
+
+	error = imageSpread * sqrt(result.finalCost / weightSum);
+	return refined.inverse();
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		GetScaleCandidates
+//
+// Description:		Returns every allowed combination of axis scales for which
+//					all of the reference values are valid, with the values
+//					linearized.  Linear comes first on both axes.
+//
+// Input Arguments:
+//		pairs	= const std::vector<ReferencePair>&
+//		xScales	= const unsigned int&, mask of allowed x-axis scales
+//		yScales	= const unsigned int&, mask of allowed y-axis scales
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<ScaleFit>, matrix and error are not set
+//
+//==========================================================================
+std::vector<PointPicker::ScaleFit> PointPicker::GetScaleCandidates(const std::vector<ReferencePair>& pairs,
+	const unsigned int& xScales, const unsigned int& yScales)
+{
+	std::vector<ScaleFit> candidates;
+	unsigned int x, y;
+	for (x = 0; x < AxisScale::typeCount; ++x)
+	{
+		for (y = 0; y < AxisScale::typeCount; ++y)
+		{
+			ScaleFit candidate;
+			candidate.xScale = static_cast<AxisScale::Type>(x);
+			candidate.yScale = static_cast<AxisScale::Type>(y);
+			if ((xScales & AxisScale::Mask(candidate.xScale)) == 0 ||
+				(yScales & AxisScale::Mask(candidate.yScale)) == 0)
+				continue;
+
+			if (GetPlotPoints(pairs, candidate.xScale, candidate.yScale, candidate.plotPoints))
+				candidates.push_back(std::move(candidate));
+		}
+	}
+
+	return candidates;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		SelectScaleCandidate
+//
+// Description:		Chooses the combination of axis scales with the lowest
+//					error, except that linear on both axes is kept unless the
+//					best of the others beats it by a clear margin.  The errors
+//					are measured in image pixels for every combination, so they
+//					can be compared directly.
+//
+// Input Arguments:
+//		candidates	= const std::vector<ScaleFit>&, must not be empty and fit
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t, index of the chosen candidate
+//
+//==========================================================================
+std::size_t PointPicker::SelectScaleCandidate(const std::vector<ScaleFit>& candidates)
+{
+	assert(!candidates.empty());
+	std::size_t best(0), i;
+	for (i = 1; i < candidates.size(); ++i)
+	{
+		if (candidates[i].error < candidates[best].error)
+			best = i;
+	}
+
+	// Linear comes first when it is valid
+	const bool linearIsCandidate(candidates.front().xScale == AxisScale::Type::Linear &&
+		candidates.front().yScale == AxisScale::Type::Linear);
+	if (linearIsCandidate && best != 0 && !(candidates[best].error < nonlinearErrorRatio * candidates.front().error))
+		return 0;
+
+	return best;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		GetPlotPoints
+//
+// Description:		Converts the reference values to the linear space the
+//					transformation matrix maps to (i.e. takes log10 of
+//					log-scaled values).
+//
+// Input Arguments:
+//		pairs		= const std::vector<ReferencePair>&
+//		xScale		= const AxisScale::Type&
+//		yScale		= const AxisScale::Type&
+//
+// Output Arguments:
+//		plotPoints	= std::vector<Eigen::Vector2d>&
+//
+// Return Value:
+//		bool, false if any value is outside the domain of its scale
+//
+//==========================================================================
+bool PointPicker::GetPlotPoints(const std::vector<ReferencePair>& pairs, const AxisScale::Type& xScale,
+	const AxisScale::Type& yScale, std::vector<Eigen::Vector2d>& plotPoints)
+{
+	std::vector<double> x(pairs.size()), y(pairs.size());
+	std::size_t i;
+	for (i = 0; i < pairs.size(); ++i)
+	{
+		x[i] = pairs[i].valueCoords.x;
+		y[i] = pairs[i].valueCoords.y;
+	}
+
+	if (!AxisScale::AreValid(xScale, x.size(), x.data()) || !AxisScale::AreValid(yScale, y.size(), y.data()))
+		return false;
+
+	AxisScale::Forward(xScale, x.size(), x.data());
+	AxisScale::Forward(yScale, y.size(), y.data());
+
+	plotPoints.resize(pairs.size());
+	for (i = 0; i < pairs.size(); ++i)
+		plotPoints[i] = Eigen::Vector2d(x[i], y[i]);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		GetReferences
+//
+// Description:		Returns list of references.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<PointPicker::Point>
+//
+//==========================================================================
+std::vector<PointPicker::Point> PointPicker::GetReferences() const
+{
+	std::vector<Point> refs(referencePoints.size());
+	for (unsigned int i = 0; i < refs.size(); ++i)
+		refs[i] = referencePoints[i].valueCoords;
+
+	return refs;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		AddReference
+//
+// Description:		Adds a reference point without prompting for its value.
+//
+// Input Arguments:
+//		imagePoint	= const Point&
+//		valuePoint	= const Point&
+//		weight		= const double&, relative confidence in this reference
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::AddReference(const Point& imagePoint, const Point& valuePoint, const double& weight)
+{
+	referencePoints.push_back(ReferencePair(imagePoint, valuePoint, weight));
+	ReferencesChanged();
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		RemovePendingReference
+//
+// Description:		Removes the specified element from the list of references
+//					that are waiting for values.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::RemovePendingReference(const unsigned int& i)
+{
+	pendingReferences.erase(pendingReferences.begin() + i);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		PendingReferencesComplete
+//
+// Description:		Checks whether every pending reference has a value.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if there are no pending references
+//
+//==========================================================================
+bool PointPicker::PendingReferencesComplete() const
+{
+	if (pendingReferences.empty())
+		return false;
+
+	return std::all_of(pendingReferences.begin(), pendingReferences.end(), [](const ReferencePair& pair)
+	{
+		return std::isfinite(pair.valueCoords.x) && std::isfinite(pair.valueCoords.y);
+	});
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		CommitPendingReferences
+//
+// Description:		Moves the pending references that have values onto the end
+//					of the reference list (in the order they were clicked) and
+//					refits once.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, number of references committed
+//
+//==========================================================================
+unsigned int PointPicker::CommitPendingReferences()
+{
+	const std::size_t referenceCount(referencePoints.size());
+	auto stillPending(std::stable_partition(pendingReferences.begin(), pendingReferences.end(),
+		[](const ReferencePair& pair)
+	{
+		return std::isfinite(pair.valueCoords.x) && std::isfinite(pair.valueCoords.y);
+	}));
+
+	referencePoints.insert(referencePoints.end(), pendingReferences.begin(), stillPending);
+	pendingReferences.erase(pendingReferences.begin(), stillPending);
+
+	const unsigned int committed(static_cast<unsigned int>(referencePoints.size() - referenceCount));
+	if (committed > 0)
+		ReferencesChanged();
+	return committed;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		AddCurvePoint
+//
+// Description:		Adds a point to the specified curve, creating the curve
+//					(and any before it) if necessary.
+//
+// Input Arguments:
+//		curve		= const unsigned int&
+//		imagePoint	= const Point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::AddCurvePoint(const unsigned int& curve, const Point& imagePoint)
+{
+	while (curvePoints.size() <= curve)
+		curvePoints.push_back(std::vector<Point>(0));
+
+	curvePoints[curve].push_back(imagePoint);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		SetCurvePoints
+//
+// Description:		Replaces the points of the specified curve (i.e. when
+//					restoring a session), adding empty curves before it as
+//					needed.
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//		points	= std::vector<Point>&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::SetCurvePoints(const unsigned int& curve, std::vector<Point>&& points)
+{
+	if (curvePoints.size() <= curve)
+		curvePoints.resize(curve + 1);
+
+	curvePoints[curve] = std::move(points);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		RemoveNewestCurvePoint
+//
+// Description:		Removes the last point of the specified curve (the curve
+//					itself is kept).
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::RemoveNewestCurvePoint(const unsigned int& curve)
+{
+	curvePoints[curve].pop_back();
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		InsertCurve
+//
+// Description:		Inserts a curve before the specified curve (later curves
+//					move up one).
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//		points	= std::vector<Point>&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::InsertCurve(const unsigned int& curve, std::vector<Point>&& points)
+{
+	if (curvePoints.size() < curve)
+		curvePoints.resize(curve);
+
+	curvePoints.insert(curvePoints.begin() + curve, std::move(points));
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		RemoveReference
+//
+// Description:		Removes the specified element from the list of references.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::RemoveReference(const unsigned int& i)
+{
+	referencePoints.erase(referencePoints.begin() + i);
+	ReferencesChanged();
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		RemoveReference
+//
+// Description:		Removes the specified reference, exchanging the fit with
+//					the specified one (see ExchangeFit()).
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//		fit	= SavedFit&
+//
+// Output Arguments:
+//		fit	= SavedFit&, the fit from before the reference was removed
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::RemoveReference(const unsigned int& i, SavedFit& fit)
+{
+	referencePoints.erase(referencePoints.begin() + i);
+	ExchangeFit(fit);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		InsertReference
+//
+// Description:		Inserts a reference before the specified reference,
+//					exchanging the fit with the specified one (see
+//					ExchangeFit()).
+//
+// Input Arguments:
+//		i		= const unsigned int&
+//		pair	= const ReferencePair&
+//		fit		= SavedFit&
+//
+// Output Arguments:
+//		fit		= SavedFit&, the fit from before the reference was inserted
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::InsertReference(const unsigned int& i, const ReferencePair& pair, SavedFit& fit)
+{
+	referencePoints.insert(referencePoints.begin() + i, pair);
+	ExchangeFit(fit);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		SaveFit
+//
+// Description:		Returns the current fit.  The fit is shared, not copied.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		SavedFit
+//
+//==========================================================================
+PointPicker::SavedFit PointPicker::SaveFit() const
+{
+	SavedFit fit;
+	fit.current = IsTransformationCurrent();
+	fit.calibrationVersion = calibrationVersion;
+	fit.state = fitState;
+	fit.errorString = errorString;
+	return fit;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		GetReferenceInliers
+//
+// Description:		Returns which references the robust fit kept, in the order
+//					of all references.  Empty unless the robust fit is in use
+//					and up to date with the references.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const std::vector<bool>&
+//
+//==========================================================================
+const std::vector<bool>& PointPicker::GetReferenceInliers() const
+{
+	static const std::vector<bool> none;
+	if (!IsTransformationCurrent())
+		return none;
+	return fitState->inliers;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ExchangeFit
+//
+// Description:		Called after the references were changed by undo or redo.
+//					If the specified fit is up to date for the new references,
+//					it is swapped in (no refit); otherwise the references are
+//					refit as usual.  The fit that was in use is handed back.
+//
+// Input Arguments:
+//		fit	= SavedFit&
+//
+// Output Arguments:
+//		fit	= SavedFit&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ExchangeFit(SavedFit& fit)
+{
+	if (!fit.current || fit.calibrationVersion != calibrationVersion)
+	{
+		fit = SaveFit();
+		ReferencesChanged();
+		return;
+	}
+
+	fit.current = IsTransformationCurrent();
+	++referenceVersion;// Any fit still running is for other references
+	fittedVersion = referenceVersion;
+	std::swap(fitState, fit.state);
+	++transformationVersion;
+	std::swap(errorString, fit.errorString);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ScaleOrdinate
+//
+// Description:		Scales the value according to the specified length and offset.
+//
+// Input Arguments:
+//		value	= const double&
+//		scale	= const double&
+//		offset	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double PointPicker::ScaleOrdinate(const double& value, const double& scale,
+	const double& offset)
+{
+	return value * scale + offset;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ResetReferences
+//
+// Description:		Resets the stored reference data.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ResetReferences()
+{
+	referencePoints.clear();
+	pendingReferences.clear();
+	ReferencesChanged();
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ResetCurveData
+//
+// Description:		Resets the stored curve data.
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<Point>, the curve's points
+//
+//==========================================================================
+std::vector<PointPicker::Point> PointPicker::ResetCurveData(const unsigned int& curve)
+{
+	std::vector<Point> points(std::move(curvePoints[curve]));
+	curvePoints.erase(curvePoints.begin() + curve);
+	return points;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		Reset
+//
+// Description:		Resets all stored data.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::Reset()
+{
+	regions.clear();
+	regionIndex.Build(regions);
+	++calibrationVersion;
+	hasRegionCorner = false;
+	ResetTransformations();
+	ResetReferences();
+
+	curvePoints.clear();
+	curveIndex = 0;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		GetCurveData
+//
+// Description:		Returns processed curve data.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<std::vector<PointPicker::Point>>
+//
+//==========================================================================
+std::vector<std::vector<PointPicker::Point>> PointPicker::GetCurveData() const
+{
+	if (!errorString.empty())
+		return std::vector<std::vector<Point>>(0);
+
+	std::vector<std::vector<Point>> data(curvePoints);
+	for (unsigned int i = 0; i < curvePoints.size(); i++)
+	{
+		for (unsigned int j = 0; j < curvePoints[i].size(); j++)
+			data[i][j] = ScalePoint(curvePoints[i][j]);
+	}
+
+	return data;
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ConvertCurve
+//
+// Description:		Converts a block of points from the specified curve into plot
+//					coordinates.  Output is written to separate x and y arrays so
+//					callers can convert large curves in pieces without copying.
+//					Each point is converted with the transformation for the
+//					region that contains it.
+//
+// Input Arguments:
+//		curve	= const unsigned int&
+//		start	= const std::size_t&, index of first point to convert
+//		count	= const std::size_t&, number of points to convert
+//
+// Output Arguments:
+//		x		= double*, must have room for count values
+//		y		= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ConvertCurve(const unsigned int& curve, const std::size_t& start,
+	const std::size_t& count, double* x, double* y) const
+{
+	assert(start + count <= curvePoints[curve].size());
+	ConvertByRegion(curvePoints[curve].data() + start, count, x, y,
+		[](const Transformation& transformation, const Point* points,
+		const std::size_t& regionCount, double* regionX, double* regionY)
+	{
+		ConvertPoints(transformation.distortion, transformation.matrix, transformation.xScale,
+			transformation.yScale, points, regionCount, regionX, regionY);
+	});
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		HasUncertainty
+//
+// Description:		Checks for bootstrap replicates in any of the regions.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool PointPicker::HasUncertainty() const
+{
+	return std::any_of(fitState->transformations.begin(), fitState->transformations.end(), [](const Transformation& t)
+	{
+		return t.replicates && t.replicates->size() > 1;
+	});
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ConvertCurveDeviation
+//
+// Description:		Computes the standard deviation of the converted location of
+//					each point across the bootstrap replicates of the region
+//					that contains it.
+//
+// Input Arguments:
+//		curve		= const unsigned int&
+//		start		= const std::size_t&, index of first point to convert
+//		count		= const std::size_t&, number of points to convert
+//
+// Output Arguments:
+//		xDeviation	= double*, must have room for count values
+//		yDeviation	= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ConvertCurveDeviation(const unsigned int& curve, const std::size_t& start,
+	const std::size_t& count, double* xDeviation, double* yDeviation) const
+{
+	assert(start + count <= curvePoints[curve].size());
+	ConvertByRegion(curvePoints[curve].data() + start, count, xDeviation, yDeviation,
+		[](const Transformation& transformation, const Point* points,
+		const std::size_t& regionCount, double* regionX, double* regionY)
+	{
+		ConvertDeviation(transformation, points, regionCount, regionX, regionY);
+	});
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ConvertByRegion
+//
+// Description:		Groups the points by region (counting sort on the region
+//					index), runs each group through the converter, and
+//					scatters the results back into point order.  Blocks that
+//					lie in a single region are converted in place.
+//
+// Input Arguments:
+//		points	= const Point*
+//		count	= const std::size_t&
+//		convert	= Converter
+//
+// Output Arguments:
+//		x		= double*, must have room for count values
+//		y		= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <typename Converter>
+void PointPicker::ConvertByRegion(const Point* points, const std::size_t& count,
+	double* x, double* y, Converter convert) const
+{
+	if (regions.empty())
+	{
+		convert(fitState->transformations.front(), points, count, x, y);
+		return;
+	}
+
+	std::vector<unsigned int> pointRegions(count);
+	std::vector<std::size_t> offsets(fitState->transformations.size() + 1, 0);
+	RegionIndex::Hint hint;
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		const std::size_t found(regionIndex.Find(points[i].x, points[i].y, hint));
+		pointRegions[i] = found == RegionIndex::none ? 0 : static_cast<unsigned int>(found) + 1;
+		++offsets[pointRegions[i] + 1];
+	}
+
+	unsigned int r;
+	for (r = 0; r < fitState->transformations.size(); ++r)
+	{
+		if (offsets[r + 1] == count)
+		{
+			convert(fitState->transformations[r], points, count, x, y);
+			return;
+		}
+		offsets[r + 1] += offsets[r];
+	}
+
+	std::vector<std::size_t> order(count);
+	std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+	for (i = 0; i < count; ++i)
+		order[next[pointRegions[i]]++] = i;
+
+	std::vector<Point> groupPoints(count);
+	for (i = 0; i < count; ++i)
+		groupPoints[i] = points[order[i]];
+
+	std::vector<double> groupX(count), groupY(count);
+	for (r = 0; r < fitState->transformations.size(); ++r)
+	{
+		const std::size_t groupCount(offsets[r + 1] - offsets[r]);
+		if (groupCount > 0)
+			convert(fitState->transformations[r], groupPoints.data() + offsets[r], groupCount,
+				groupX.data() + offsets[r], groupY.data() + offsets[r]);
+	}
+
+	for (i = 0; i < count; ++i)
+	{
+		x[order[i]] = groupX[i];
+		y[order[i]] = groupY[i];
+	}
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ConvertDeviation
+//
+// Description:		Computes the standard deviation of the converted location of
+//					each point across the transformation's bootstrap replicates.
+//					Each replicate converts the whole block with the same kernel
+//					as ConvertCurve(), and the statistics are accumulated with
+//					Welford's method in separate passes over the arrays.
+//
+// Input Arguments:
+//		transformation	= const Transformation&
+//		points			= const Point*
+//		count			= const std::size_t&
+//
+// Output Arguments:
+//		xDeviation		= double*, must have room for count values (NaN
+//						  without replicates)
+//		yDeviation		= double*, must have room for count values (NaN
+//						  without replicates)
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ConvertDeviation(const Transformation& transformation, const Point* points,
+	const std::size_t& count, double* xDeviation, double* yDeviation)
+{
+	std::size_t i;
+	if (!transformation.replicates || transformation.replicates->size() < 2)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			xDeviation[i] = std::numeric_limits<double>::quiet_NaN();
+			yDeviation[i] = std::numeric_limits<double>::quiet_NaN();
+		}
+		return;
+	}
+
+	std::vector<double> x(count), y(count), xMean(count, 0.0), yMean(count, 0.0);
+	for (i = 0; i < count; ++i)
+	{
+		xDeviation[i] = 0.0;
+		yDeviation[i] = 0.0;
+	}
+
+	unsigned int n(0);
+	for (const auto& replicate : *transformation.replicates)
+	{
+		ConvertPoints(replicate.distortion, replicate.matrix, replicate.xScale,
+			replicate.yScale, points, count, x.data(), y.data());
+
+		// The deviation arrays hold the running sums of squared differences
+		const double scale(1.0 / ++n);
+		for (i = 0; i < count; ++i)
+		{
+			const double dx(x[i] - xMean[i]);
+			const double dy(y[i] - yMean[i]);
+			xMean[i] += dx * scale;
+			yMean[i] += dy * scale;
+			xDeviation[i] += dx * (x[i] - xMean[i]);
+			yDeviation[i] += dy * (y[i] - yMean[i]);
+		}
+	}
+
+	const double scale(1.0 / (n - 1));
+	for (i = 0; i < count; ++i)
+	{
+		xDeviation[i] = sqrt(xDeviation[i] * scale);
+		yDeviation[i] = sqrt(yDeviation[i] * scale);
+	}
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		Convert
+//
+// Description:		Converts image points to plot values with the specified
+//					transformation.
+//
+// Input Arguments:
+//		transformation	= const Transformation&
+//		points			= const Point*
+//		count			= const std::size_t&
+//
+// Output Arguments:
+//		x				= double*, must have room for count values
+//		y				= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::Convert(const Transformation& transformation, const Point* points,
+	const std::size_t& count, double* x, double* y)
+{
+	ConvertPoints(transformation.distortion, transformation.matrix,
+		transformation.xScale, transformation.yScale, points, count, x, y);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		Invert
+//
+// Description:		Converts plot values to image points with the specified
+//					transformation (the inverse of Convert()).  Values are
+//					linearized by the axis scales, mapped through the inverse
+//					matrix, then undistorted.
+//
+// Input Arguments:
+//		transformation	= const Transformation&
+//		count			= const std::size_t&
+//		x				= const double*
+//		y				= const double*
+//
+// Output Arguments:
+//		points			= Point*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::Invert(const Transformation& transformation, const std::size_t& count,
+	const double* x, const double* y, Point* points)
+{
+	std::vector<double> u(x, x + count);
+	std::vector<double> v(y, y + count);
+
+	// Forward maps are defined everywhere, but give NaN or infinity outside
+	// the scale's domain; mark those so they don't map to real locations
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		if (!AxisScale::IsValid(transformation.xScale, u[i]) || !AxisScale::IsValid(transformation.yScale, v[i]))
+			u[i] = std::numeric_limits<double>::quiet_NaN();
+	}
+
+	AxisScale::Forward(transformation.xScale, count, u.data());
+	AxisScale::Forward(transformation.yScale, count, v.data());
+
+	const Eigen::Matrix3d t(transformation.matrix.inverse());
+	for (i = 0; i < count; ++i)
+	{
+		const double a(u[i]), b(v[i]);
+		const double w(t(2,0) * a + t(2,1) * b + t(2,2));
+		u[i] = (t(0,0) * a + t(0,1) * b + t(0,2)) / w;
+		v[i] = (t(1,0) * a + t(1,1) * b + t(1,2)) / w;
+	}
+
+	if (transformation.distortion.GetType() != DistortionModel::Type::None)
+		transformation.distortion.Invert(count, u.data(), v.data());
+
+	for (i = 0; i < count; ++i)
+	{
+		if (std::isfinite(u[i]) && std::isfinite(v[i]))
+			points[i] = Point(u[i], v[i]);
+		else
+			points[i] = Point(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+	}
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ConvertPoints
+//
+// Description:		Batch conversion kernel.  Output is written to separate x and
+//					y arrays, and each step is a separate pass so the compiler can
+//					vectorize it.
+//
+// Input Arguments:
+//		distortion		= const DistortionModel&
+//		matrix			= const Eigen::Matrix3d&
+//		xScale			= const AxisScale::Type&
+//		yScale			= const AxisScale::Type&
+//		points			= const Point*
+//		count			= const std::size_t&
+//
+// Output Arguments:
+//		x				= double*, must have room for count values
+//		y				= double*, must have room for count values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPicker::ConvertPoints(const DistortionModel& distortion, const Eigen::Matrix3d& matrix,
+	const AxisScale::Type& xScale, const AxisScale::Type& yScale, const Point* points,
+	const std::size_t& count, double* x, double* y)
+{
+	const Eigen::Matrix3d& t(matrix);
+
+	std::size_t i;
+	if (distortion.GetType() == DistortionModel::Type::None)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			const double w(t(2,0) * points[i].x + t(2,1) * points[i].y + t(2,2));
+			x[i] = (t(0,0) * points[i].x + t(0,1) * points[i].y + t(0,2)) / w;
+			y[i] = (t(1,0) * points[i].x + t(1,1) * points[i].y + t(1,2)) / w;
+		}
+	}
+	else
+	{
+		// The output arrays hold the intermediate (undistorted) coordinates
+		for (i = 0; i < count; ++i)
+		{
+			x[i] = points[i].x;
+			y[i] = points[i].y;
+		}
+
+		distortion.Apply(count, x, y);
+
+		for (i = 0; i < count; ++i)
+		{
+			const double u(x[i]), v(y[i]);
+			const double w(t(2,0) * u + t(2,1) * v + t(2,2));
+			x[i] = (t(0,0) * u + t(0,1) * v + t(0,2)) / w;
+			y[i] = (t(1,0) * u + t(1,1) * v + t(1,2)) / w;
+		}
+	}
+
+	AxisScale::Inverse(xScale, count, x);
+	AxisScale::Inverse(yScale, count, y);
+}
+
+//==========================================================================
+// Class:			PointPicker
+// Function:		ScalePoint
+//
+// Description:		Converts the specified point from image to plot coordinates,
+//					using the transformation for the region that contains it.
+//
+// Input Arguments:
+//		imagePointIn	= const Point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PointPicker::Point
+//
+//==========================================================================
+PointPicker::Point PointPicker::ScalePoint(const Point& imagePointIn) const
+{
+	const Transformation& transformation(fitState->transformations[FindRegion(imagePointIn)]);
+
+	Eigen::Vector3d imagePoint(imagePointIn.x, imagePointIn.y, 1.0);
+	if (transformation.distortion.GetType() != DistortionModel::Type::None)
+		transformation.distortion.Apply(imagePointIn.x, imagePointIn.y, imagePoint(0), imagePoint(1));
+	Eigen::Vector3d plotPoint(transformation.matrix * imagePoint);
+
+	Point p(plotPoint(0) / plotPoint(2), plotPoint(1) / plotPoint(2));
 
-	if (yIsLogarithmic)
-		p.y = pow(10.0, p.y);
+	p.x = AxisScale::Inverse(transformation.xScale, p.x);
+	p.y = AxisScale::Inverse(transformation.yScale, p.y);
 
 	return p;
 }
@@ -8,6 +8,9 @@
 
 // Standard C++ headers
 #include <vector>
+#include <memory>
+#include <functional>
+#include <limits>
 
 // wxWidgets headers
 #include <wx/wx.h>
@@ -25,7 +28,16 @@
 #pragma warning(pop)
 #endif
 
-class PointPicker
+// Local headers
+#include "distortionModel.h"
+#include "axisScale.h"
+#include "regionIndex.h"
+#include "curveSource.h"
+
+// Local forward declarations
+class ThreadPool;
+
+class PointPicker : public CurveSource
 {
 public:
 	PointPicker();
@@ -46,11 +58,13 @@ public:
 	{
 		None,
 		References,
-		Curve
+		Curve,
+		Regions// Pairs of clicks are opposite corners of a new region
 	};
 
 	void SetClipboardMode(const ClipboardMode& mode) { clipMode = mode; }
-	void SetDataExtractionMode(const DataExtractionMode& mode) { dataMode = mode; }
+	ClipboardMode GetClipboardMode() const { return clipMode; }
+	void SetDataExtractionMode(const DataExtractionMode& mode) { dataMode = mode; hasRegionCorner = false; }
 	void SetCurveIndex(const unsigned int& curve) { curveIndex = curve; }
 
 	DataExtractionMode GetDataExtractionMode() const { return dataMode; }
@@ -58,7 +72,6 @@ public:
 
 	void RemoveReference(const unsigned int& i);
 	void ResetReferences();
-	void ResetCurveData(const unsigned int& curve);
 	void Reset();
 
 	struct Point
@@ -72,78 +85,314 @@ public:
 		}
 
 		double x, y;
+	};
 
-		Point& operator=(const Point& p)
-		{
-			if (&p == this)
-				return *this;
+	// For building pickers without user interaction (coordinates are image pixels)
+	void AddReference(const Point& imagePoint, const Point& valuePoint, const double& weight = 1.0);
+	void AddCurvePoint(const unsigned int& curve, const Point& imagePoint);
+	void SetCurvePoints(const unsigned int& curve, std::vector<Point>&& points);
+	std::vector<Point> ResetCurveData(const unsigned int& curve);// Returns the removed points
 
-			x = p.x;
-			y = p.y;
-
-			return *this;
-		}
-	};
+	// For undoing AddCurvePoint() and ResetCurveData()
+	void RemoveNewestCurvePoint(const unsigned int& curve);
+	void InsertCurve(const unsigned int& curve, std::vector<Point>&& points);
 
 	Point GetNewestPoint() const { return lastPoint; }
 	std::vector<Point> GetReferences() const;
 
 	std::vector<std::vector<PointPicker::Point>> GetCurveData() const;
+	const std::vector<Point>& GetCurvePoints(const unsigned int& curve) const { return curvePoints[curve]; }
+	unsigned int GetCurveCount() const override { return curvePoints.size(); }
+	std::size_t GetCurveSize(const unsigned int& curve) const override { return curvePoints[curve].size(); }
+	void ConvertCurve(const unsigned int& curve, const std::size_t& start,
+		const std::size_t& count, double* x, double* y) const override;
+
+	// Standard deviations across the bootstrap replicates (NaN without them)
+	bool HasUncertainty() const override;
+	void ConvertCurveDeviation(const unsigned int& curve, const std::size_t& start,
+		const std::size_t& count, double* xDeviation, double* yDeviation) const override;
 	Point ScaleSinglePoint(const double& rawX, const double& rawY,
 		const double& xScale, const double& yScale,
 		const double& xOffset, const double& yOffset, double& x, double& y) const;
 
 	wxString GetErrorString() const { return errorString; }
 
-private:
-	static double ScaleOrdinate(const double& value,
-		const double& scale, const double& offset);
-
-	ClipboardMode clipMode;
-	DataExtractionMode dataMode;
-	unsigned int curveIndex;
-
-	mutable wxString errorString;
-	void ResetErrorString() const;
-
 	struct ReferencePair
 	{
-		ReferencePair() {}
-		ReferencePair(const Point& i, const Point& v)
+		ReferencePair() : weight(1.0) {}
+		ReferencePair(const Point& i, const Point& v, const double& w = 1.0)
 		{
 			imageCoords = i;
 			valueCoords = v;
+			weight = w;
 		}
 
 		Point imageCoords;
 		Point valueCoords;
+		double weight;// Relative confidence in this reference's image location
+	};
+
+	// Default constructed transformations are not fit, and convert every
+	// point to NaN
+	struct Transformation
+	{
+		Transformation() : xScale(AxisScale::Type::Linear), yScale(AxisScale::Type::Linear),
+			error(std::numeric_limits<double>::max())
+		{
+			matrix.setConstant(std::numeric_limits<double>::quiet_NaN());
+		}
+
+		bool IsFit() const { return error < std::numeric_limits<double>::max(); }
+
+		DistortionModel distortion;// Applied to image coordinates before the matrix
+		Eigen::Matrix3d matrix;
+		AxisScale::Type xScale;
+		AxisScale::Type yScale;
+		double error;// Weighted RMS reprojection error [pixels]
+		std::vector<bool> inliers;// One entry per reference; empty unless the robust fit was used
+
+		// Fits to resampled references, for uncertainty estimates; null unless requested
+		std::shared_ptr<const std::vector<Transformation>> replicates;
+	};
+
+	struct FitOptions
+	{
+		FitOptions() : xScales(AxisScale::defaultMask), yScales(AxisScale::defaultMask),
+			distortion(DistortionModel::Type::None), robust(false),
+			inlierThreshold(3.0), maxHypotheses(2000), bootstrapReplicates(0) {}
+
+		// Families (AxisScale::Mask() bits) the fit chooses among on each axis
+		unsigned int xScales;
+		unsigned int yScales;
+
+		// Falls back to a projective transformation when there are not enough
+		// references for the requested model
+		DistortionModel::Type distortion;
+
+		// Rejects mislabeled references (RANSAC) before fitting the rest
+		bool robust;
+		double inlierThreshold;// [pixels]
+		unsigned int maxHypotheses;
+
+		// Number of bootstrap refits; zero disables uncertainty estimates
+		unsigned int bootstrapReplicates;
 	};
 
+	// Changing the options refits the transformation
+	void SetFitOptions(const FitOptions& options);
+	const FitOptions& GetFitOptions() const { return fitOptions; }
+
+	// Regions split the image into separately calibrated areas (i.e. the two
+	// sides of a broken axis, or the panels of a split plot).  References and
+	// curve points belong to the region that contains them; region 0 is the
+	// rest of the image, and bounded region i is GetRegions()[i - 1].
+	void AddRegion(const Point& corner1, const Point& corner2);
+	void RemoveRegion(const unsigned int& region);
+	void ResetRegions();
+	const std::vector<RegionIndex::Bounds>& GetRegions() const { return regions; }
+	unsigned int GetRegionCount() const { return static_cast<unsigned int>(regions.size()) + 1; }
+	unsigned int FindRegion(const Point& imagePoint) const;
+
+	// With deferred entry, reference clicks don't ask for values; they wait in
+	// a pending list (with NaN values) until their values are typed in or
+	// imported, and are then committed together with a single refit
+	enum class ReferenceEntry
+	{
+		Dialog,
+		Deferred
+	};
+
+	void SetReferenceEntry(const ReferenceEntry& entry) { referenceEntry = entry; }
+	ReferenceEntry GetReferenceEntry() const { return referenceEntry; }
+
+	void AddPendingReference(const ReferencePair& pair) { pendingReferences.push_back(pair); }
+	void SetPendingValue(const unsigned int& i, const Point& value) { pendingReferences[i].valueCoords = value; }
+	void RemovePendingReference(const unsigned int& i);
+	const std::vector<ReferencePair>& GetPendingReferences() const { return pendingReferences; }
+	bool PendingReferencesComplete() const;// True if there are some and all have values
+
+	// Commits the pending references that have values (the rest stay pending)
+	// and returns the number committed
+	unsigned int CommitPendingReferences();
+
+	// Replaces the references, regions and fit options together (i.e. from a
+	// template) with a single refit
+	void SetCalibration(const std::vector<ReferencePair>& pairs,
+		const std::vector<RegionIndex::Bounds>& newRegions, const FitOptions& options);
+
+	// One transformation per region, in region order
+	typedef std::vector<Transformation> TransformationSet;
+
+	// Fitting is a pure function of the references so that it can be run on
+	// any thread; the version identifies the set of references it was fit to.
+	// The axis scale search, robust fit and bootstrap spread their work over
+	// the pool, if one is given.  Without one (i.e. the service and batch
+	// fits, which already run one fit per thread) the work stays on the
+	// calling thread.
+	static Transformation FitTransformation(const std::vector<ReferencePair>& pairs,
+		const FitOptions& options = FitOptions(), ThreadPool* pool = nullptr);
+
+	// Fits with the specified axis scales instead of searching for the best
+	// ones; false if a value is outside a scale's domain or the fit fails.  The
+	// distortion model is kept whenever it can be fit (i.e. for refitting a
+	// model that was already chosen).
+	static bool FitScales(const std::vector<ReferencePair>& pairs, const AxisScale::Type& xScale,
+		const AxisScale::Type& yScale, const DistortionModel::Type& distortion, Transformation& transformation);
+
+	// Fits each region to the references inside it; regions with fewer than
+	// four references are left unfit
+	static TransformationSet FitTransformations(const std::vector<ReferencePair>& pairs,
+		const std::vector<RegionIndex::Bounds>& regions, const FitOptions& options = FitOptions(),
+		ThreadPool* pool = nullptr);
+	const Transformation& GetTransformation(const unsigned int& region) const { return fitState->transformations[region]; }
+	const std::vector<ReferencePair>& GetReferencePairs() const { return referencePoints; }
+	unsigned int GetReferenceVersion() const { return referenceVersion; }
+	const std::vector<bool>& GetReferenceInliers() const;
+	bool ApplyTransformations(const TransformationSet& fitted, const unsigned int& version);
+	bool IsTransformationCurrent() const { return fittedVersion == referenceVersion; }
+
+	// Changes whenever the transformations in use do, for caching anything
+	// drawn from them
+	unsigned int GetTransformationVersion() const { return transformationVersion; }
+
+	// Batch conversions with one transformation.  Convert maps image points to
+	// plot values.  Invert maps plot values back to image points; values
+	// outside an axis scale's domain (i.e. zero on a log axis) map to NaN.
+	static void Convert(const Transformation& transformation, const Point* points,
+		const std::size_t& count, double* x, double* y);
+	static void Invert(const Transformation& transformation, const std::size_t& count,
+		const double* x, const double* y, Point* points);
+	void UpdateTransformation();
+
+	// A fit set aside (i.e. by undo), so that going back to the references it
+	// was made for doesn't need a refit.  The fit itself is never modified
+	// once made, so saving it only shares it with the picker.
+	struct FitState
+	{
+		TransformationSet transformations;
+		std::vector<bool> inliers;// In the order of all references; empty unless robust
+	};
+
+	struct SavedFit
+	{
+		SavedFit() : current(false), calibrationVersion(0) {}
+
+		bool current;// False if it was out of date when it was saved
+		unsigned int calibrationVersion;// Regions and fit options it was made with
+		std::shared_ptr<const FitState> state;
+		wxString errorString;
+	};
+
+	SavedFit SaveFit() const;
+
+	// Reference edits for undo and redo.  The fit is exchanged with the
+	// argument's: if that one was made for the resulting references (with the
+	// same regions and options) it is used instead of refitting.  Either way,
+	// the fit from before the edit is handed back.
+	void InsertReference(const unsigned int& i, const ReferencePair& pair, SavedFit& fit);
+	void RemoveReference(const unsigned int& i, SavedFit& fit);
+
+	// When set, the handler is called instead of fitting synchronously whenever
+	// the references or regions change
+	typedef std::function<void()> FitRequestHandler;
+	void SetFitRequestHandler(const FitRequestHandler& handler) { fitRequestHandler = handler; }
+
+private:
+	static double ScaleOrdinate(const double& value,
+		const double& scale, const double& offset);
+
+	ClipboardMode clipMode;
+	DataExtractionMode dataMode;
+	unsigned int curveIndex;
+
+	mutable wxString errorString;
+	void ResetErrorString() const;
+
 	std::vector<ReferencePair> referencePoints;
 	std::vector<std::vector<Point>> curvePoints;
 
+	ReferenceEntry referenceEntry;
+	std::vector<ReferencePair> pendingReferences;
+
 	Point lastPoint;
 
+	std::vector<RegionIndex::Bounds> regions;
+	RegionIndex regionIndex;
+	bool hasRegionCorner;
+	Point regionCorner;
+	void RegionsChanged();
+	static unsigned int LookUpRegion(const RegionIndex& index, const Point& imagePoint);
+	static std::vector<unsigned int> AssignRegions(const std::vector<ReferencePair>& pairs,
+		const RegionIndex& index);
+
 	void HandleClipboardMode(const double& x, const double& y) const;
 	void HandleDataMode(const double& x, const double& y);
-	void UpdateTransformation();
 
-	Eigen::Matrix3d transformationMatrix;
-	bool xIsLogarithmic;
-	bool yIsLogarithmic;
+	unsigned int referenceVersion;
+	unsigned int fittedVersion;
+	unsigned int calibrationVersion;// Changes with the regions or fit options
+	unsigned int transformationVersion;
+	FitRequestHandler fitRequestHandler;
+	void ReferencesChanged();
+	void ExchangeFit(SavedFit& fit);
+
+	FitOptions fitOptions;
+
+	// Replaced (never changed in place) with each new fit; never null
+	std::shared_ptr<const FitState> fitState;
+	void ResetTransformations();
 
 	Point ScalePoint(const Point& imagePointIn) const;
 
-	enum class PlotScaling
+	// Calls convert(transformation, points, count, x, y) once per region, with
+	// the points in that region gathered into contiguous arrays
+	template <typename Converter>
+	void ConvertByRegion(const Point* points, const std::size_t& count,
+		double* x, double* y, Converter convert) const;
+	static void ConvertPoints(const DistortionModel& distortion, const Eigen::Matrix3d& matrix,
+		const AxisScale::Type& xScale, const AxisScale::Type& yScale, const Point* points,
+		const std::size_t& count, double* x, double* y);
+	static void ConvertDeviation(const Transformation& transformation, const Point* points,
+		const std::size_t& count, double* xDeviation, double* yDeviation);
+
+	// Fit of the references for one combination of axis scales
+	struct ScaleFit
 	{
-		Linear,
-		SemiLogX,
-		SemiLogY,
-		LogLog
+		AxisScale::Type xScale;
+		AxisScale::Type yScale;
+		std::vector<Eigen::Vector2d> plotPoints;// Linearized reference values
+		Eigen::Matrix3d matrix;
+		double error;
 	};
 
+	static std::vector<ScaleFit> GetScaleCandidates(const std::vector<ReferencePair>& pairs,
+		const unsigned int& xScales, const unsigned int& yScales);
+
+	// Every combination of scales has the same number of parameters, so with
+	// few references a wrong one often fits the noise slightly better than
+	// the right one.  Anything other than linear on both axes must have an
+	// error below this fraction of the linear fit's to be chosen.
+	static constexpr double nonlinearErrorRatio = 0.6;
+	static std::size_t SelectScaleCandidate(const std::vector<ScaleFit>& candidates);
+	static bool GetPlotPoints(const std::vector<ReferencePair>& pairs, const AxisScale::Type& xScale,
+		const AxisScale::Type& yScale, std::vector<Eigen::Vector2d>& plotPoints);
+
 	static Eigen::Matrix3d ComputeTransformation(const std::vector<ReferencePair>& pairs,
-		const PlotScaling& scaling, double& error);
+		const std::vector<Eigen::Vector2d>& plotPoints, double& error);
+	static Eigen::Matrix3d RefineTransformation(const std::vector<ReferencePair>& pairs,
+		const std::vector<Eigen::Vector2d>& plotPoints, const Eigen::Matrix3d& initial, double& error);
+
+	class ProjectiveFitModel;
+	static Transformation FitRobust(const std::vector<ReferencePair>& pairs,
+		const FitOptions& options, ThreadPool* pool);
+	static std::vector<bool> FindInliers(const std::vector<ReferencePair>& pairs,
+		const Transformation& transformation, const double& threshold);
+	static void FitDistortion(const std::vector<ReferencePair>& pairs,
+		const DistortionModel::Type& type, const bool& select, Transformation& transformation);
+	static double ComputeReprojectionError(const std::vector<ReferencePair>& pairs,
+		const Transformation& transformation);
+	static double ComputeInformationCriterion(const double& error,
+		const std::size_t& referenceCount, const unsigned int& parameterCount);
 };
 
 #endif// POINT_PICKER_H_
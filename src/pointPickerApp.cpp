@@ -3,12 +3,123 @@
 // Auth:  K. Loux
 // Desc:  Application object for point picker.
 
+// Standard C++ headers
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+
+// wxWidgets headers
+#include <wx/init.h>
+
 // Local headers
 #include "pointPickerApp.h"
 #include "controlsFrame.h"
+#include "digitizationService.h"
+#include "batchProcessor.h"
+#include "traceRecorder.h"
+#include "appResources.h"
 
+#ifdef __WXMSW__
 // Implement the application (have wxWidgets set up the appropriate entry points, etc.)
 IMPLEMENT_APP(PointPickerApp)
+#else
+// We provide main() ourselves so that the service and batch modes can run without
+// initializing the GUI
+IMPLEMENT_APP_NO_MAIN(PointPickerApp)
+
+//==========================================================================
+// Class:			None
+// Function:		main
+//
+// Description:		Application entry point.  With "--serve <address>", runs the
+//					digitization service instead of the GUI, and with
+//					"--batch <manifest> <output directory> [format]", processes
+//					the images listed in the manifest.  In either mode, setting
+//					POINTPICKER_TRACE to a file name records a timeline of the
+//					run to that file.
+//
+// Input Arguments:
+//		argc	= int
+//		argv	= char*[]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, zero for success
+//
+//==========================================================================
+int main(int argc, char* argv[])
+{
+	const bool serve(argc >= 2 && std::strcmp(argv[1], "--serve") == 0);
+	const bool batch(argc >= 2 && std::strcmp(argv[1], "--batch") == 0);
+	if (!serve && !batch)
+		return wxEntry(argc, argv);
+
+	if ((serve && argc != 3) || (batch && (argc < 4 || argc > 5)))
+	{
+		std::cerr << "Usage: " << argv[0] << " --serve unix:<path>|tcp:<port>" << std::endl;
+		std::cerr << "       " << argv[0] << " --batch <manifest> <output directory> [csv|txt|npy|npz|ppc]" << std::endl;
+		return 1;
+	}
+
+	wxInitializer initializer(argc, argv);
+	if (!initializer.IsOk())
+	{
+		std::cerr << "Failed to initialize wxWidgets" << std::endl;
+		return 1;
+	}
+	// Images are decoded on several threads at once here, so all handlers must be
+	// registered up front (the GUI registers them lazily instead)
+	wxInitAllImageHandlers();
+
+	const char* traceFileName(std::getenv("POINTPICKER_TRACE"));
+	if (traceFileName)
+	{
+		TraceRecorder::SetThreadName("Main");
+		TraceRecorder::Start();
+	}
+
+	bool success;
+	if (serve)
+	{
+		DigitizationService service(argv[2]);
+		success = service.Run();
+		if (!success)
+			std::cerr << service.GetErrorString() << std::endl;
+	}
+	else
+	{
+		BatchProcessor processor(argv[3], argc == 5 ? argv[4] : "csv");
+		if (processor.LoadManifest(argv[2]))
+		{
+			success = processor.Run([](const BatchProcessor::Result& result)
+			{
+				if (result.success)
+					std::cout << result.imagePath << " -> " << result.outputPath << std::endl;
+				else
+					std::cout << result.imagePath << ": " << result.errorString << std::endl;
+			});
+
+			if (!processor.GetErrorString().empty())
+				std::cerr << processor.GetErrorString() << std::endl;
+			std::cout << processor.GetReport();
+		}
+		else
+		{
+			success = false;
+			std::cerr << processor.GetErrorString() << std::endl;
+		}
+	}
+
+	if (traceFileName && !TraceRecorder::Write(traceFileName))
+		std::cerr << "Failed to write trace to '" << traceFileName << "'" << std::endl;
+
+	return success ? 0 : 1;
+}
+#endif
 
 //==========================================================================
 // Class:			PointPickerApp
@@ -29,6 +140,27 @@ IMPLEMENT_APP(PointPickerApp)
 const wxString PointPickerApp::title = _T("Point Picker");
 const wxString PointPickerApp::name = _T("PointPickerApplication");
 const wxString PointPickerApp::creator = _T("Kerry Loux");
+const std::chrono::steady_clock::time_point PointPickerApp::launchTime(std::chrono::steady_clock::now());
+
+//==========================================================================
+// Class:			PointPickerApp
+// Function:		Event Table
+//
+// Description:		Links GUI events with event handler functions.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BEGIN_EVENT_TABLE(PointPickerApp, wxApp)
+	EVT_IDLE(PointPickerApp::OnIdle)
+END_EVENT_TABLE()
 
 //==========================================================================
 // Class:			PointPickerApp
@@ -48,9 +180,12 @@ const wxString PointPickerApp::creator = _T("Kerry Loux");
 //==========================================================================
 bool PointPickerApp::OnInit()
 {
+	initStartTime = std::chrono::steady_clock::now();
+
 	// Set the application's name and the vendor's name
 	SetAppName(name);
 	SetVendorName(creator);
+	TraceRecorder::SetThreadName("UI");
 
 	// Create the MainFrame object - this is the parent for all other objects
 	mainFrame = new ControlsFrame();
@@ -58,9 +193,107 @@ bool PointPickerApp::OnInit()
 	// Make sure the MainFrame was successfully created
 	if (!mainFrame)
 		return false;
+	framesCreatedTime = std::chrono::steady_clock::now();
 
 	// Make the window visible
 	mainFrame->Show(true);
+	framesShownTime = std::chrono::steady_clock::now();
 
 	return true;
 }
+
+//==========================================================================
+// Class:			PointPickerApp
+// Function:		OnExit
+//
+// Description:		Cleans up before wxWidgets shuts down.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, exit code
+//
+//==========================================================================
+int PointPickerApp::OnExit()
+{
+	AppResources::Release();
+	return wxApp::OnExit();
+}
+
+//==========================================================================
+// Class:			PointPickerApp
+// Function:		OnIdle
+//
+// Description:		The first idle event marks the end of startup (the windows
+//					have been drawn and we're waiting for user input).
+//
+// Input Arguments:
+//		event	= wxIdleEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPickerApp::OnIdle(wxIdleEvent& event)
+{
+	event.Skip();
+	if (startupReported)
+		return;
+
+	startupReported = true;
+	WriteStartupReport(std::chrono::steady_clock::now());
+}
+
+//==========================================================================
+// Class:			PointPickerApp
+// Function:		WriteStartupReport
+//
+// Description:		When POINTPICKER_STARTUP_REPORT is set, appends a line with
+//					the duration of each phase of startup to the named file (or
+//					to stderr if the value is "-").  Appending allows cold-start
+//					time to be tracked over many launches.
+//
+// Input Arguments:
+//		firstIdleTime	= const std::chrono::steady_clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PointPickerApp::WriteStartupReport(const std::chrono::steady_clock::time_point& firstIdleTime) const
+{
+	const char* fileName(std::getenv("POINTPICKER_STARTUP_REPORT"));
+	if (!fileName || *fileName == '\0')
+		return;
+
+	auto toMilliseconds([](const std::chrono::steady_clock::duration& d)
+	{
+		return std::chrono::duration<double, std::milli>(d).count();
+	});
+
+	char line[256];
+	std::snprintf(line, sizeof(line), "%s init_ms=%.1f frames_ms=%.1f show_ms=%.1f first_idle_ms=%.1f total_ms=%.1f\n",
+		wxDateTime::Now().FormatISOCombined().ToUTF8().data(),
+		toMilliseconds(initStartTime - launchTime), toMilliseconds(framesCreatedTime - initStartTime),
+		toMilliseconds(framesShownTime - framesCreatedTime), toMilliseconds(firstIdleTime - framesShownTime),
+		toMilliseconds(firstIdleTime - launchTime));
+
+	if (std::strcmp(fileName, "-") == 0)
+	{
+		std::cerr << line;
+		return;
+	}
+
+	std::ofstream file(fileName, std::ios::app);
+	file << line;
+}
@@ -6,6 +6,9 @@
 #ifndef POINT_PICKER_APP_H_
 #define POINT_PICKER_APP_H_
 
+// Standard C++ headers
+#include <chrono>
+
 // wxWidgets headers
 #include <wx/wx.h>
 
@@ -17,6 +20,7 @@ class PointPickerApp : public wxApp
 {
 public:
 	bool OnInit();
+	int OnExit();
 
 	static const wxString title;// As displayed
 	static const wxString name;// Internal
@@ -26,6 +30,19 @@ public:
 
 private:
 	ControlsFrame *mainFrame;
+
+	// Set during static initialization, as close to process start as we can get
+	static const std::chrono::steady_clock::time_point launchTime;
+
+	std::chrono::steady_clock::time_point initStartTime;
+	std::chrono::steady_clock::time_point framesCreatedTime;
+	std::chrono::steady_clock::time_point framesShownTime;
+	bool startupReported = false;
+
+	void OnIdle(wxIdleEvent& event);
+	void WriteStartupReport(const std::chrono::steady_clock::time_point& firstIdleTime) const;
+
+	DECLARE_EVENT_TABLE()
 };
 
 // Declare the application object (have wxWidgets create the wxGetApp() function)
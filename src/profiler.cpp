@@ -0,0 +1,415 @@
+// File:  profiler.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Lightweight timers and counters for the expensive paths in the
+//        application.
+
+// Standard C++ headers
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Local headers
+#include "profiler.h"
+
+//==========================================================================
+// Class:			Profiler
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the Profiler class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+std::atomic<bool> Profiler::enabled(false);
+Profiler::Histogram Profiler::histograms[static_cast<int>(Probe::Count)];
+std::atomic<std::uint64_t> Profiler::counters[static_cast<int>(Counter::Count)];
+
+//==========================================================================
+// Class:			Profiler
+// Function:		Record
+//
+// Description:		Adds a timing sample to the histogram for the specified probe.
+//
+// Input Arguments:
+//		probe		= const Probe&
+//		nanoseconds	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Profiler::Record(const Probe& probe, const std::uint64_t& nanoseconds)
+{
+	Histogram& h(histograms[static_cast<int>(probe)]);
+	h.buckets[GetBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+	h.total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+	// The first sample sets the minimum (which starts out as zero)
+	if (h.count.fetch_add(1, std::memory_order_relaxed) == 0)
+		h.minimum.store(nanoseconds, std::memory_order_relaxed);
+
+	std::uint64_t current(h.minimum.load(std::memory_order_relaxed));
+	while (nanoseconds < current && !h.minimum.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+	{
+	}
+
+	current = h.maximum.load(std::memory_order_relaxed);
+	while (nanoseconds > current && !h.maximum.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+	{
+	}
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		Reset
+//
+// Description:		Clears all timings and counters.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Profiler::Reset()
+{
+	for (auto& h : histograms)
+	{
+		for (auto& b : h.buckets)
+			b = 0;
+		h.count = 0;
+		h.total = 0;
+		h.minimum = 0;
+		h.maximum = 0;
+	}
+
+	for (auto& c : counters)
+		c = 0;
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetBucket
+//
+// Description:		Returns the histogram bucket for the specified duration.
+//					Values below four are exact; above that, each power of two
+//					is split into four buckets.
+//
+// Input Arguments:
+//		nanoseconds	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int Profiler::GetBucket(const std::uint64_t& nanoseconds)
+{
+	const std::uint64_t subBucketCount(1 << subBucketBits);
+	if (nanoseconds < subBucketCount)
+		return static_cast<unsigned int>(nanoseconds);
+
+	unsigned int msb(0);
+	while ((nanoseconds >> (msb + 1)) != 0)
+		++msb;
+
+	const unsigned int sub(static_cast<unsigned int>((nanoseconds >> (msb - subBucketBits)) & (subBucketCount - 1)));
+	return ((msb - subBucketBits + 1) << subBucketBits) + sub;
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetBucketMidpoint
+//
+// Description:		Returns the duration in the middle of the specified bucket.
+//
+// Input Arguments:
+//		bucket	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, nanoseconds
+//
+//==========================================================================
+double Profiler::GetBucketMidpoint(const unsigned int& bucket)
+{
+	const unsigned int subBucketCount(1 << subBucketBits);
+	if (bucket < subBucketCount)
+		return bucket;
+
+	const unsigned int shift((bucket >> subBucketBits) - 1);
+	const double lower(std::ldexp(static_cast<double>(subBucketCount + (bucket & (subBucketCount - 1))), shift));
+	return lower + std::ldexp(0.5, shift);
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetPercentile
+//
+// Description:		Estimates the specified percentile from the histogram.
+//
+// Input Arguments:
+//		histogram	= const Histogram&
+//		fraction	= const double&, e.g. 0.99 for the 99th percentile
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, nanoseconds
+//
+//==========================================================================
+double Profiler::GetPercentile(const Histogram& histogram, const double& fraction)
+{
+	std::uint64_t total(0);
+	unsigned int i;
+	for (i = 0; i < bucketCount; ++i)
+		total += histogram.buckets[i].load(std::memory_order_relaxed);
+
+	if (total == 0)
+		return 0.0;
+
+	const std::uint64_t target(static_cast<std::uint64_t>(std::ceil(fraction * total)));
+	std::uint64_t sum(0);
+	for (i = 0; i < bucketCount; ++i)
+	{
+		sum += histogram.buckets[i].load(std::memory_order_relaxed);
+		if (sum >= target)
+			break;
+	}
+
+	// Don't report a value outside of what was actually observed
+	const double midpoint(GetBucketMidpoint(i));
+	return std::min(std::max(midpoint, static_cast<double>(histogram.minimum)), static_cast<double>(histogram.maximum));
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetStatistics
+//
+// Description:		Returns the summary statistics for the specified probe.
+//
+// Input Arguments:
+//		probe	= const Probe&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Statistics
+//
+//==========================================================================
+Profiler::Statistics Profiler::GetStatistics(const Probe& probe)
+{
+	const Histogram& h(histograms[static_cast<int>(probe)]);
+	const double toSeconds(1.0e-9);
+
+	Statistics s;
+	s.count = h.count;
+	s.totalSeconds = h.total * toSeconds;
+	s.minimumSeconds = h.minimum * toSeconds;
+	s.maximumSeconds = h.maximum * toSeconds;
+	s.p50Seconds = GetPercentile(h, 0.5) * toSeconds;
+	s.p99Seconds = GetPercentile(h, 0.99) * toSeconds;
+
+	return s;
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetCount
+//
+// Description:		Returns the value of the specified counter.
+//
+// Input Arguments:
+//		counter	= const Counter&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t Profiler::GetCount(const Counter& counter)
+{
+	return counters[static_cast<int>(counter)];
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetName
+//
+// Description:		Returns the display name for the specified probe.
+//
+// Input Arguments:
+//		probe	= const Probe&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char*
+//
+//==========================================================================
+const char* Profiler::GetName(const Probe& probe)
+{
+	switch (probe)
+	{
+	case Probe::LoadFiles:
+		return "Load files";
+	case Probe::ImageDecode:
+		return "Image decode";
+	case Probe::HandleSizeChange:
+		return "Image rescale";
+	case Probe::TransformationFit:
+		return "Transformation fit";
+	case Probe::AddNewPoint:
+		return "Grid update";
+	case Probe::Export:
+		return "Export";
+	case Probe::TemplateAlignment:
+		return "Template alignment";
+	case Probe::ImageCache:
+		return "Image cache";
+	case Probe::JournalCheckpoint:
+		return "Journal checkpoint";
+	case Probe::CalibrationOverlay:
+		return "Calibration overlay";
+	default:
+		return "";
+	}
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetName
+//
+// Description:		Returns the display name for the specified counter.
+//
+// Input Arguments:
+//		counter	= const Counter&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char*
+//
+//==========================================================================
+const char* Profiler::GetName(const Counter& counter)
+{
+	switch (counter)
+	{
+	case Counter::PointsAdded:
+		return "Points added";
+	case Counter::FitsRequested:
+		return "Fits requested";
+	case Counter::FitsDiscarded:
+		return "Stale fits discarded";
+	case Counter::RowsExported:
+		return "Rows exported";
+	case Counter::BytesExported:
+		return "Bytes exported";
+	case Counter::ImageCacheHits:
+		return "Image cache hits";
+	case Counter::ImageCacheMisses:
+		return "Image cache misses";
+	default:
+		return "";
+	}
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		GetReport
+//
+// Description:		Formats all timings and counters as a text table.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string Profiler::GetReport()
+{
+	std::string report;
+	char line[160];
+	std::snprintf(line, sizeof(line), "%-20s %10s %12s %12s %12s %12s %12s\n",
+		"Timer", "Count", "Total (ms)", "Min (ms)", "p50 (ms)", "p99 (ms)", "Max (ms)");
+	report.append(line);
+
+	int i;
+	for (i = 0; i < static_cast<int>(Probe::Count); ++i)
+	{
+		const Statistics s(GetStatistics(static_cast<Probe>(i)));
+		std::snprintf(line, sizeof(line), "%-20s %10llu %12.3f %12.3f %12.3f %12.3f %12.3f\n",
+			GetName(static_cast<Probe>(i)), static_cast<unsigned long long>(s.count),
+			s.totalSeconds * 1.0e3, s.minimumSeconds * 1.0e3, s.p50Seconds * 1.0e3,
+			s.p99Seconds * 1.0e3, s.maximumSeconds * 1.0e3);
+		report.append(line);
+	}
+
+	report.append("\n");
+	std::snprintf(line, sizeof(line), "%-20s %10s\n", "Counter", "Value");
+	report.append(line);
+	for (i = 0; i < static_cast<int>(Counter::Count); ++i)
+	{
+		std::snprintf(line, sizeof(line), "%-20s %10llu\n", GetName(static_cast<Counter>(i)),
+			static_cast<unsigned long long>(GetCount(static_cast<Counter>(i))));
+		report.append(line);
+	}
+
+	return report;
+}
+
+//==========================================================================
+// Class:			Profiler
+// Function:		WriteReport
+//
+// Description:		Writes the report to file.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool Profiler::WriteReport(const std::string& fileName)
+{
+	std::ofstream file(fileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	file << GetReport();
+	return file.good();
+}
@@ -0,0 +1,136 @@
+// File:  profiler.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Lightweight timers and counters for the expensive paths in the
+//        application.  Timings are collected into log-scale histograms so that
+//        percentiles can be reported.  Timers also add events to the trace
+//        recorder while it is running.  When both are disabled, a timer costs
+//        two relaxed atomic loads.
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+// Standard C++ headers
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Local headers
+#include "traceRecorder.h"
+
+class Profiler
+{
+public:
+	enum class Probe
+	{
+		LoadFiles,
+		ImageDecode,
+		HandleSizeChange,
+		TransformationFit,
+		AddNewPoint,
+		Export,
+		TemplateAlignment,
+		ImageCache,
+		JournalCheckpoint,
+		CalibrationOverlay,
+
+		Count
+	};
+
+	enum class Counter
+	{
+		PointsAdded,
+		FitsRequested,
+		FitsDiscarded,
+		RowsExported,
+		BytesExported,
+		ImageCacheHits,
+		ImageCacheMisses,
+
+		Count
+	};
+
+	static void SetEnabled(const bool& enable) { enabled.store(enable, std::memory_order_relaxed); }
+	static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+	static void Record(const Probe& probe, const std::uint64_t& nanoseconds);
+	static void Increment(const Counter& counter, const std::uint64_t& amount = 1)
+	{
+		if (IsEnabled())
+			counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+	}
+
+	static void Reset();
+
+	struct Statistics
+	{
+		std::uint64_t count;
+		double totalSeconds;
+		double minimumSeconds;
+		double maximumSeconds;
+		double p50Seconds;// Percentiles are accurate to about 12%
+		double p99Seconds;
+	};
+
+	static Statistics GetStatistics(const Probe& probe);
+	static std::uint64_t GetCount(const Counter& counter);
+
+	static const char* GetName(const Probe& probe);
+	static const char* GetName(const Counter& counter);
+
+	static std::string GetReport();
+	static bool WriteReport(const std::string& fileName);
+
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(const Probe& probe) : probe(probe), active(IsEnabled()), tracing(TraceRecorder::IsEnabled())
+		{
+			if (active || tracing)
+				start = std::chrono::steady_clock::now();
+		}
+
+		~ScopedTimer()
+		{
+			if (!active && !tracing)
+				return;
+
+			const std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+			if (active)
+				Record(probe, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			if (tracing)
+				TraceRecorder::AddComplete(GetName(probe), "app", start, end);
+		}
+
+	private:
+		const Probe probe;
+		const bool active;
+		const bool tracing;
+		std::chrono::steady_clock::time_point start;
+	};
+
+private:
+	// Four buckets per power of two
+	static constexpr unsigned int subBucketBits = 2;
+	static constexpr unsigned int bucketCount = 64 << subBucketBits;
+
+	struct Histogram
+	{
+		std::atomic<std::uint64_t> buckets[bucketCount];
+		std::atomic<std::uint64_t> count;
+		std::atomic<std::uint64_t> total;
+		std::atomic<std::uint64_t> minimum;
+		std::atomic<std::uint64_t> maximum;
+	};
+
+	static std::atomic<bool> enabled;
+	static Histogram histograms[static_cast<int>(Probe::Count)];
+	static std::atomic<std::uint64_t> counters[static_cast<int>(Counter::Count)];
+
+	static unsigned int GetBucket(const std::uint64_t& nanoseconds);
+	static double GetBucketMidpoint(const unsigned int& bucket);
+	static double GetPercentile(const Histogram& histogram, const double& fraction);
+};
+
+#endif// PROFILER_H_
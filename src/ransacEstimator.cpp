@@ -0,0 +1,460 @@
+// File:  ransacEstimator.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Robust estimate of the projective transformation.
+
+// Standard C++ headers
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+// Local headers
+#include "ransacEstimator.h"
+#include "threadPool.h"
+
+//==========================================================================
+// Class:			RansacEstimator::Search
+//
+// Description:		State shared by the threads scoring hypotheses.  Threads
+//					claim hypotheses in small blocks from a common counter; the
+//					number required shrinks as better hypotheses are found.
+//
+//==========================================================================
+class RansacEstimator::Search
+{
+public:
+	Search(const Problem& problem, const Settings& settings) : problem(problem),
+		settings(settings), next(0), required(std::max(settings.maxHypotheses, 1U)),
+		bestCost(std::numeric_limits<double>::infinity()), bestIndex(0) {}
+
+	void Run();
+
+	bool HasResult() const { return std::isfinite(bestCost); }
+	const Hypothesis& GetBest() const { return best; }
+	double GetBestCost() const { return bestCost; }
+
+private:
+	const Problem& problem;
+	const Settings& settings;
+
+	std::atomic<unsigned int> next;
+	std::atomic<unsigned int> required;
+
+	std::mutex mutex;
+	Hypothesis best;
+	double bestCost;
+	unsigned int bestIndex;
+
+	double Offer(const Hypothesis& h, const double& cost, const unsigned int& index);
+};
+
+//==========================================================================
+// Class:			RansacEstimator::Search
+// Function:		Run
+//
+// Description:		Scores hypotheses until the required number have been
+//					claimed.  Called from each participating thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RansacEstimator::Search::Run()
+{
+	const std::size_t count(static_cast<std::size_t>(problem.plotX.size()));
+	std::size_t sample[sampleSize];
+	Hypothesis h;
+	double localBest(std::numeric_limits<double>::infinity());
+
+	while (true)
+	{
+		const unsigned int first(next.fetch_add(hypothesesPerClaim, std::memory_order_relaxed));
+		const unsigned int last(std::min(first + hypothesesPerClaim, required.load(std::memory_order_relaxed)));
+		if (first >= last)
+			return;
+
+		unsigned int n;
+		for (n = first; n < last; ++n)
+		{
+			DrawSample(count, settings.seed, n, sample);
+			if (!SolveMinimal(problem, sample, h))
+				continue;
+
+			// Ties go through to Offer() so the lowest index wins regardless of
+			// which thread finds it
+			const double cost(Score(problem, h));
+			if (cost <= localBest)
+				localBest = Offer(h, cost, n);
+		}
+	}
+}
+
+//==========================================================================
+// Class:			RansacEstimator::Search
+// Function:		Offer
+//
+// Description:		Keeps the hypothesis if it is the best so far and updates
+//					the number of hypotheses required.
+//
+// Input Arguments:
+//		h		= const Hypothesis&
+//		cost	= const double&
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, best cost found so far (by any thread)
+//
+//==========================================================================
+double RansacEstimator::Search::Offer(const Hypothesis& h, const double& cost, const unsigned int& index)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (cost > bestCost || (cost == bestCost && index > bestIndex))
+		return bestCost;
+
+	best = h;
+	bestCost = cost;
+	bestIndex = index;
+
+	const unsigned int newRequired(GetRequiredHypotheses(CountInliers(problem, h),
+		static_cast<std::size_t>(problem.plotX.size()), settings));
+	if (newRequired < required.load(std::memory_order_relaxed))
+		required.store(newRequired, std::memory_order_relaxed);
+
+	return bestCost;
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		Estimate
+//
+// Description:		Finds the transformation with the lowest MSAC cost and
+//					classifies each reference as an inlier or outlier.
+//
+// Input Arguments:
+//		imagePoints	= const std::vector<Eigen::Vector2d>&
+//		plotPoints	= const std::vector<Eigen::Vector2d>&, linearized
+//		settings	= const Settings&
+//		pool		= ThreadPool*, may be null to run on the calling thread
+//
+// Output Arguments:
+//		inliers		= std::vector<bool>&, one entry per reference
+//		cost		= double&, [pixels^2]
+//
+// Return Value:
+//		bool, false if no hypothesis has at least four inliers
+//
+//==========================================================================
+bool RansacEstimator::Estimate(const std::vector<Eigen::Vector2d>& imagePoints,
+	const std::vector<Eigen::Vector2d>& plotPoints, const Settings& settings,
+	ThreadPool* pool, std::vector<bool>& inliers, double& cost)
+{
+	assert(imagePoints.size() == plotPoints.size());
+	const std::size_t count(imagePoints.size());
+	if (count < sampleSize || settings.inlierThreshold <= 0.0)
+		return false;
+
+	Eigen::Vector2d imageCenter(Eigen::Vector2d::Zero());
+	Eigen::Vector2d plotCenter(Eigen::Vector2d::Zero());
+	std::size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		imageCenter += imagePoints[i];
+		plotCenter += plotPoints[i];
+	}
+	imageCenter /= static_cast<double>(count);
+	plotCenter /= static_cast<double>(count);
+
+	double imageSpread(0.0);
+	Eigen::Vector2d plotSpread(Eigen::Vector2d::Zero());
+	for (i = 0; i < count; ++i)
+	{
+		imageSpread += (imagePoints[i] - imageCenter).squaredNorm();
+		plotSpread += (plotPoints[i] - plotCenter).cwiseAbs2();
+	}
+	imageSpread = std::sqrt(imageSpread / count);
+	plotSpread = (plotSpread / static_cast<double>(count)).cwiseSqrt();
+
+	if (imageSpread <= 0.0 || plotSpread.minCoeff() <= 0.0 || !plotSpread.allFinite())
+		return false;
+
+	Problem problem;
+	problem.plotX.resize(count);
+	problem.plotY.resize(count);
+	problem.imageX.resize(count);
+	problem.imageY.resize(count);
+	for (i = 0; i < count; ++i)
+	{
+		problem.plotX(i) = (plotPoints[i].x() - plotCenter.x()) / plotSpread.x();
+		problem.plotY(i) = (plotPoints[i].y() - plotCenter.y()) / plotSpread.y();
+		problem.imageX(i) = (imagePoints[i].x() - imageCenter.x()) / imageSpread;
+		problem.imageY(i) = (imagePoints[i].y() - imageCenter.y()) / imageSpread;
+	}
+
+	const double threshold(settings.inlierThreshold / imageSpread);
+	problem.threshold2 = threshold * threshold;
+
+	Search search(problem, settings);
+	if (pool && pool->GetThreadCount() > 1)
+	{
+		unsigned int t;
+		for (t = 0; t < pool->GetThreadCount(); ++t)
+		{
+			pool->Submit([&search]()
+			{
+				search.Run();
+			});
+		}
+		pool->WaitIdle();
+	}
+	else
+		search.Run();
+
+	if (!search.HasResult())
+		return false;
+
+	const Hypothesis& h(search.GetBest());
+	inliers.resize(count);
+	std::size_t inlierCount(0);
+	for (i = 0; i < count; ++i)
+	{
+		const double a(problem.plotX(i)), b(problem.plotY(i));
+		const double w(h(6) * a + h(7) * b + 1.0);
+		const double dx((h(0) * a + h(1) * b + h(2)) / w - problem.imageX(i));
+		const double dy((h(3) * a + h(4) * b + h(5)) / w - problem.imageY(i));
+		inliers[i] = dx * dx + dy * dy < problem.threshold2;
+		if (inliers[i])
+			++inlierCount;
+	}
+
+	if (inlierCount < sampleSize)
+		return false;
+
+	cost = search.GetBestCost() * imageSpread * imageSpread;
+	return true;
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		DrawSample
+//
+// Description:		Chooses four distinct references for the specified
+//					hypothesis.
+//
+// Input Arguments:
+//		count		= const std::size_t&, number of references
+//		seed		= const std::uint64_t&
+//		hypothesis	= const std::uint64_t&
+//
+// Output Arguments:
+//		sample		= std::size_t*, must have room for sampleSize entries
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RansacEstimator::DrawSample(const std::size_t& count, const std::uint64_t& seed,
+	const std::uint64_t& hypothesis, std::size_t* sample)
+{
+	std::uint64_t state(Mix(seed) ^ (hypothesis * 0x9E3779B97F4A7C15ULL));
+	unsigned int k(0);
+	while (k < sampleSize)
+	{
+		state += 0x9E3779B97F4A7C15ULL;
+		const std::size_t index(static_cast<std::size_t>(Mix(state) % count));
+		if (std::find(sample, sample + k, index) == sample + k)
+			sample[k++] = index;
+	}
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		SolveMinimal
+//
+// Description:		Computes the transformation that maps the four sampled plot
+//					points exactly onto their image points.
+//
+// Input Arguments:
+//		problem	= const Problem&
+//		sample	= const std::size_t*
+//
+// Output Arguments:
+//		h		= Hypothesis&
+//
+// Return Value:
+//		bool, false if the sample is degenerate
+//
+//==========================================================================
+bool RansacEstimator::SolveMinimal(const Problem& problem, const std::size_t* sample, Hypothesis& h)
+{
+	// Reject samples with three (nearly) collinear points in either space
+	auto isCollinear([&sample](const Eigen::ArrayXd& x, const Eigen::ArrayXd& y)
+	{
+		static constexpr double minimumArea = 1.0e-6;
+		unsigned int i, j, k;
+		for (i = 0; i < sampleSize; ++i)
+		{
+			for (j = i + 1; j < sampleSize; ++j)
+			{
+				for (k = j + 1; k < sampleSize; ++k)
+				{
+					const double area((x(sample[j]) - x(sample[i])) * (y(sample[k]) - y(sample[i]))
+						- (x(sample[k]) - x(sample[i])) * (y(sample[j]) - y(sample[i])));
+					if (std::abs(area) < minimumArea)
+						return true;
+				}
+			}
+		}
+		return false;
+	});
+
+	if (isCollinear(problem.plotX, problem.plotY) || isCollinear(problem.imageX, problem.imageY))
+		return false;
+
+	Eigen::Matrix<double, 8, 8> a;
+	Hypothesis b;
+	unsigned int k;
+	for (k = 0; k < sampleSize; ++k)
+	{
+		const double u(problem.plotX(sample[k])), v(problem.plotY(sample[k]));
+		const double x(problem.imageX(sample[k])), y(problem.imageY(sample[k]));
+		a.row(2 * k) << u, v, 1.0, 0.0, 0.0, 0.0, -u * x, -v * x;
+		a.row(2 * k + 1) << 0.0, 0.0, 0.0, u, v, 1.0, -u * y, -v * y;
+		b(2 * k) = x;
+		b(2 * k + 1) = y;
+	}
+
+	h = a.partialPivLu().solve(b);
+	return h.allFinite();
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		Score
+//
+// Description:		Returns the MSAC cost of the hypothesis:  the sum over all
+//					references of the squared reprojection error, truncated at
+//					the squared threshold.  Written as whole-array expressions
+//					so Eigen evaluates it with SIMD instructions.
+//
+// Input Arguments:
+//		problem	= const Problem&
+//		h		= const Hypothesis&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, [normalized units^2]
+//
+//==========================================================================
+double RansacEstimator::Score(const Problem& problem, const Hypothesis& h)
+{
+	const auto inverseW((h(6) * problem.plotX + h(7) * problem.plotY + 1.0).inverse());
+	const auto dx((h(0) * problem.plotX + h(1) * problem.plotY + h(2)) * inverseW - problem.imageX);
+	const auto dy((h(3) * problem.plotX + h(4) * problem.plotY + h(5)) * inverseW - problem.imageY);
+	const double cost((dx.square() + dy.square()).min(problem.threshold2).sum());
+
+	// A reference mapped to the line at infinity gives NaN; such hypotheses
+	// are not useful
+	return std::isnan(cost) ? std::numeric_limits<double>::infinity() : cost;
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		CountInliers
+//
+// Description:		Returns the number of references within the threshold.
+//
+// Input Arguments:
+//		problem	= const Problem&
+//		h		= const Hypothesis&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t
+//
+//==========================================================================
+std::size_t RansacEstimator::CountInliers(const Problem& problem, const Hypothesis& h)
+{
+	const auto inverseW((h(6) * problem.plotX + h(7) * problem.plotY + 1.0).inverse());
+	const auto dx((h(0) * problem.plotX + h(1) * problem.plotY + h(2)) * inverseW - problem.imageX);
+	const auto dy((h(3) * problem.plotX + h(4) * problem.plotY + h(5)) * inverseW - problem.imageY);
+	return static_cast<std::size_t>((dx.square() + dy.square() < problem.threshold2).count());
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		GetRequiredHypotheses
+//
+// Description:		Returns the number of hypotheses needed to draw at least one
+//					all-inlier sample with the requested confidence, given the
+//					inlier ratio of the best hypothesis so far.
+//
+// Input Arguments:
+//		inlierCount	= const std::size_t&
+//		count		= const std::size_t&
+//		settings	= const Settings&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int RansacEstimator::GetRequiredHypotheses(const std::size_t& inlierCount,
+	const std::size_t& count, const Settings& settings)
+{
+	const double inlierRatio(static_cast<double>(inlierCount) / count);
+	const double goodSample(std::pow(inlierRatio, static_cast<double>(sampleSize)));
+	if (goodSample >= 1.0)
+		return 1;
+
+	const double denominator(std::log1p(-goodSample));
+	if (!(denominator < 0.0))
+		return settings.maxHypotheses;
+
+	const double required(std::ceil(std::log1p(-settings.confidence) / denominator));
+	if (!(required < settings.maxHypotheses))
+		return settings.maxHypotheses;
+
+	return std::max(static_cast<unsigned int>(required), 1U);
+}
+
+//==========================================================================
+// Class:			RansacEstimator
+// Function:		Mix
+//
+// Description:		SplitMix64 output function; turns a counter into a
+//					well-distributed pseudo-random number.
+//
+// Input Arguments:
+//		x	= std::uint64_t
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t RansacEstimator::Mix(std::uint64_t x)
+{
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
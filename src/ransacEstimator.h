@@ -0,0 +1,84 @@
+// File:  ransacEstimator.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Robust estimate of the projective transformation for reference sets
+//        that include mislabeled points (i.e. from automatic tick detection).
+//        Hypotheses are computed from random minimal (four point) samples and
+//        scored against every reference with the truncated squared
+//        reprojection error (MSAC).  Samples are drawn from a counter-based
+//        generator, so hypothesis n is the same no matter which thread scores it.
+
+#ifndef RANSAC_ESTIMATOR_H_
+#define RANSAC_ESTIMATOR_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Eigen headers
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4018)// signed/unsigned mismatch
+#pragma warning(disable:4456)// declaration hides previous local declaration
+#pragma warning(disable:4714)// function marked as __forceinline not inlined
+#pragma warning(disable:4800)// forcing value to bool 'true' or 'false'
+#endif
+#include <Eigen/Dense>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+// Local forward declarations
+class ThreadPool;
+
+class RansacEstimator
+{
+public:
+	struct Settings
+	{
+		Settings() : inlierThreshold(3.0), maxHypotheses(2000), confidence(0.999), seed(1) {}
+
+		double inlierThreshold;// [pixels]
+		unsigned int maxHypotheses;// Upper bound; fewer are used once the inlier ratio is known
+		double confidence;// Probability of drawing at least one all-inlier sample
+		std::uint64_t seed;
+	};
+
+	// Plot points must already be linearized (for log axes, log10 of the
+	// value).  When a pool is given, hypotheses are scored on its threads; the
+	// pool must not be busy with other work, since this waits for it to go
+	// idle.  Cost is the MSAC cost of the best hypothesis [pixels^2].
+	static bool Estimate(const std::vector<Eigen::Vector2d>& imagePoints,
+		const std::vector<Eigen::Vector2d>& plotPoints, const Settings& settings,
+		ThreadPool* pool, std::vector<bool>& inliers, double& cost);
+
+private:
+	static constexpr unsigned int sampleSize = 4;
+	static constexpr unsigned int hypothesesPerClaim = 16;
+
+	typedef Eigen::Matrix<double, 8, 1> Hypothesis;// Plot to image matrix, last element fixed at one
+
+	// Normalized coordinates, stored as separate arrays for vectorized scoring
+	struct Problem
+	{
+		Eigen::ArrayXd plotX;
+		Eigen::ArrayXd plotY;
+		Eigen::ArrayXd imageX;
+		Eigen::ArrayXd imageY;
+		double threshold2;
+	};
+
+	class Search;
+
+	static void DrawSample(const std::size_t& count, const std::uint64_t& seed,
+		const std::uint64_t& hypothesis, std::size_t* sample);
+	static bool SolveMinimal(const Problem& problem, const std::size_t* sample, Hypothesis& h);
+	static double Score(const Problem& problem, const Hypothesis& h);
+	static std::size_t CountInliers(const Problem& problem, const Hypothesis& h);
+	static unsigned int GetRequiredHypotheses(const std::size_t& inlierCount,
+		const std::size_t& count, const Settings& settings);
+	static std::uint64_t Mix(std::uint64_t x);
+};
+
+#endif// RANSAC_ESTIMATOR_H_
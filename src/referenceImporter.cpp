@@ -0,0 +1,133 @@
+// File:  referenceImporter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Reads reference values from a delimited text file.
+
+// Standard C++ headers
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+// Local headers
+#include "referenceImporter.h"
+
+//==========================================================================
+// Class:			ReferenceImporter
+// Function:		Read
+//
+// Description:		Reads the specified file.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ReferenceImporter::Read(const std::string& fileName)
+{
+	values.clear();
+	references.clear();
+
+	std::ifstream file(fileName);
+	if (!file.is_open())
+	{
+		errorString = _T("Failed to open '") + wxString(fileName) + _T("'.");
+		return false;
+	}
+
+	std::string line;
+	unsigned int lineNumber(0);
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+		bool isNumeric;
+		const std::vector<double> row(ParseRow(line, isNumeric));
+		if (row.empty())
+			continue;
+		else if (!isNumeric)
+		{
+			// Headers are allowed, but only before the data
+			if (values.empty() && references.empty())
+				continue;
+
+			errorString = wxString::Format(_T("Line %u of '%s' is not a number."), lineNumber, wxString(fileName));
+			return false;
+		}
+
+		if (row.size() == 2)
+			values.push_back(PointPicker::Point(row[0], row[1]));
+		else if (row.size() == 5 && row[4] <= 0.0)
+		{
+			errorString = wxString::Format(_T("Line %u of '%s' has a weight that is not positive."),
+				lineNumber, wxString(fileName));
+			return false;
+		}
+		else if (row.size() == 4 || row.size() == 5)
+			references.push_back(PointPicker::ReferencePair(PointPicker::Point(row[0], row[1]),
+				PointPicker::Point(row[2], row[3]), row.size() == 5 ? row[4] : 1.0));
+		else
+		{
+			errorString = wxString::Format(_T("Line %u of '%s' has %u columns (expected 2, 4 or 5)."),
+				lineNumber, wxString(fileName), static_cast<unsigned int>(row.size()));
+			return false;
+		}
+	}
+
+	if (values.empty() && references.empty())
+	{
+		errorString = _T("'") + wxString(fileName) + _T("' does not contain any references.");
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ReferenceImporter
+// Function:		ParseRow
+//
+// Description:		Splits a line into numbers.
+//
+// Input Arguments:
+//		line		= const std::string&
+//
+// Output Arguments:
+//		isNumeric	= bool&, false if any field is not a finite number
+//
+// Return Value:
+//		std::vector<double>, empty for blank lines; contents are not
+//		meaningful unless isNumeric is true
+//
+//==========================================================================
+std::vector<double> ReferenceImporter::ParseRow(const std::string& line, bool& isNumeric)
+{
+	const char* delimiters(",;\t \r");
+	std::vector<double> row;
+	isNumeric = true;
+
+	const char* position(line.c_str());
+	while (*position != '\0')
+	{
+		position += std::strspn(position, delimiters);
+		if (*position == '\0')
+			break;
+
+		char* end;
+		const double value(std::strtod(position, &end));
+		if (end == position || !std::isfinite(value) || (*end != '\0' && !std::strchr(delimiters, *end)))
+		{
+			isNumeric = false;
+			end = const_cast<char*>(position + std::strcspn(position, delimiters));
+		}
+
+		row.push_back(value);
+		position = end;
+	}
+
+	return row;
+}
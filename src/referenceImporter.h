@@ -0,0 +1,40 @@
+// File:  referenceImporter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Reads reference values from a delimited text file (comma, tab,
+//        semicolon or space separated).  Rows with two columns are the values
+//        of references that have already been clicked, in click order; rows
+//        with four or five columns are complete references (image x, image y,
+//        value x, value y and optionally the weight, which must be positive).
+//        Rows that don't start with a number (i.e. headers) are skipped.
+
+#ifndef REFERENCE_IMPORTER_H_
+#define REFERENCE_IMPORTER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "pointPicker.h"
+
+class ReferenceImporter
+{
+public:
+	bool Read(const std::string& fileName);
+
+	std::vector<PointPicker::Point> values;
+	std::vector<PointPicker::ReferencePair> references;
+
+	wxString GetErrorString() const { return errorString; }
+
+private:
+	wxString errorString;
+
+	static std::vector<double> ParseRow(const std::string& line, bool& isNumeric);
+};
+
+#endif// REFERENCE_IMPORTER_H_
@@ -0,0 +1,210 @@
+// File:  regionIndex.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Spatial index over rectangular image regions.
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+// Local headers
+#include "regionIndex.h"
+
+//==========================================================================
+// Class:			RegionIndex::Bounds
+// Function:		Bounds
+//
+// Description:		Constructor for Bounds class.  The corners may be given in
+//					any order.
+//
+// Input Arguments:
+//		x1	= const double&
+//		y1	= const double&
+//		x2	= const double&
+//		y2	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+RegionIndex::Bounds::Bounds(const double& x1, const double& y1, const double& x2, const double& y2)
+	: xMin(std::min(x1, x2)), yMin(std::min(y1, y2)), xMax(std::max(x1, x2)), yMax(std::max(y1, y2))
+{
+}
+
+//==========================================================================
+// Class:			RegionIndex
+// Function:		Build
+//
+// Description:		Rebuilds the index for the specified regions.  The upper
+//					edges are stored as the next representable value, so the
+//					half-open cells match the closed bounds exactly.
+//
+// Input Arguments:
+//		regions	= const std::vector<Bounds>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RegionIndex::Build(const std::vector<Bounds>& regions)
+{
+	xEdges.clear();
+	slabs.clear();
+	if (regions.empty())
+		return;
+
+	const double infinity(std::numeric_limits<double>::infinity());
+	std::vector<double> xEnds(regions.size()), yEnds(regions.size());
+	std::size_t i;
+	for (i = 0; i < regions.size(); ++i)
+	{
+		xEnds[i] = std::nextafter(regions[i].xMax, infinity);
+		yEnds[i] = std::nextafter(regions[i].yMax, infinity);
+		xEdges.push_back(regions[i].xMin);
+		xEdges.push_back(xEnds[i]);
+	}
+
+	std::sort(xEdges.begin(), xEdges.end());
+	xEdges.erase(std::unique(xEdges.begin(), xEdges.end()), xEdges.end());
+
+	slabs.resize(xEdges.size() - 1);
+	std::vector<std::size_t> spanning;
+	std::size_t s;
+	for (s = 0; s < slabs.size(); ++s)
+	{
+		spanning.clear();
+		for (i = 0; i < regions.size(); ++i)
+		{
+			if (regions[i].xMin <= xEdges[s] && xEnds[i] >= xEdges[s + 1])
+				spanning.push_back(i);
+		}
+
+		Slab& slab(slabs[s]);
+		for (const auto& r : spanning)
+		{
+			slab.yEdges.push_back(regions[r].yMin);
+			slab.yEdges.push_back(yEnds[r]);
+		}
+
+		std::sort(slab.yEdges.begin(), slab.yEdges.end());
+		slab.yEdges.erase(std::unique(slab.yEdges.begin(), slab.yEdges.end()), slab.yEdges.end());
+
+		// Spanning regions are in ascending order, so the last one to cover a
+		// cell is the one that was added last
+		slab.owners.assign(slab.yEdges.size() > 0 ? slab.yEdges.size() - 1 : 0, none);
+		std::size_t c;
+		for (c = 0; c < slab.owners.size(); ++c)
+		{
+			for (const auto& r : spanning)
+			{
+				if (regions[r].yMin <= slab.yEdges[c] && yEnds[r] >= slab.yEdges[c + 1])
+					slab.owners[c] = r;
+			}
+		}
+	}
+}
+
+//==========================================================================
+// Class:			RegionIndex
+// Function:		Find
+//
+// Description:		Returns the index of the region containing the point.
+//
+// Input Arguments:
+//		x	= const double&
+//		y	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t, none if no region contains the point
+//
+//==========================================================================
+std::size_t RegionIndex::Find(const double& x, const double& y) const
+{
+	const std::size_t s(FindInterval(xEdges, x));
+	if (s == none)
+		return none;
+
+	const std::size_t c(FindInterval(slabs[s].yEdges, y));
+	if (c == none)
+		return none;
+
+	return slabs[s].owners[c];
+}
+
+//==========================================================================
+// Class:			RegionIndex
+// Function:		Find
+//
+// Description:		Returns the index of the region containing the point,
+//					checking the hinted cell first.
+//
+// Input Arguments:
+//		x		= const double&
+//		y		= const double&
+//		hint	= Hint&
+//
+// Output Arguments:
+//		hint	= Hint&, updated to the cell containing the point
+//
+// Return Value:
+//		std::size_t, none if no region contains the point
+//
+//==========================================================================
+std::size_t RegionIndex::Find(const double& x, const double& y, Hint& hint) const
+{
+	if (x >= hint.xMin && x < hint.xEnd && y >= hint.yMin && y < hint.yEnd)
+		return hint.owner;
+
+	const std::size_t s(FindInterval(xEdges, x));
+	if (s == none)
+		return none;
+
+	const std::size_t c(FindInterval(slabs[s].yEdges, y));
+	if (c == none)
+		return none;
+
+	hint.xMin = xEdges[s];
+	hint.xEnd = xEdges[s + 1];
+	hint.yMin = slabs[s].yEdges[c];
+	hint.yEnd = slabs[s].yEdges[c + 1];
+	hint.owner = slabs[s].owners[c];
+
+	return hint.owner;
+}
+
+//==========================================================================
+// Class:			RegionIndex
+// Function:		FindInterval
+//
+// Description:		Binary search for the half-open interval between sorted
+//					edges that contains the value.
+//
+// Input Arguments:
+//		edges	= const std::vector<double>&
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t, none if the value is outside of the edges
+//
+//==========================================================================
+std::size_t RegionIndex::FindInterval(const std::vector<double>& edges, const double& value)
+{
+	const auto upper(std::upper_bound(edges.begin(), edges.end(), value));
+	if (upper == edges.begin() || upper == edges.end())
+		return none;
+
+	return static_cast<std::size_t>(upper - edges.begin()) - 1;
+}
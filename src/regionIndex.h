@@ -0,0 +1,69 @@
+// File:  regionIndex.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Spatial index over rectangular image regions.  The x edges of the
+//        regions split the plane into vertical slabs, and the y edges of the
+//        regions spanning each slab split it into cells, each of which is owned
+//        by (at most) one region.  Lookups are two binary searches.  Where
+//        regions overlap, the one added last wins.
+
+#ifndef REGION_INDEX_H_
+#define REGION_INDEX_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+class RegionIndex
+{
+public:
+	// Closed rectangle (edges are inside)
+	struct Bounds
+	{
+		Bounds() : xMin(0.0), yMin(0.0), xMax(0.0), yMax(0.0) {}
+		Bounds(const double& x1, const double& y1, const double& x2, const double& y2);
+
+		double xMin, yMin;
+		double xMax, yMax;
+
+		bool Contains(const double& x, const double& y) const
+		{
+			return x >= xMin && x <= xMax && y >= yMin && y <= yMax;
+		}
+	};
+
+	static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+	void Build(const std::vector<Bounds>& regions);
+
+	// Returns the index of the region containing the point, or none
+	std::size_t Find(const double& x, const double& y) const;
+
+	// Remembers the cell of the last lookup; successive points along a curve
+	// are usually in the same cell, so the binary searches can be skipped
+	struct Hint
+	{
+		Hint() : xMin(1.0), xEnd(0.0), yMin(1.0), yEnd(0.0), owner(none) {}
+
+		double xMin, xEnd;
+		double yMin, yEnd;
+		std::size_t owner;
+	};
+
+	std::size_t Find(const double& x, const double& y, Hint& hint) const;
+
+private:
+	struct Slab
+	{
+		std::vector<double> yEdges;
+		std::vector<std::size_t> owners;// owners[i] covers [yEdges[i], yEdges[i + 1])
+	};
+
+	std::vector<double> xEdges;
+	std::vector<Slab> slabs;// slabs[i] covers [xEdges[i], xEdges[i + 1])
+
+	static std::size_t FindInterval(const std::vector<double>& edges, const double& value);
+};
+
+#endif// REGION_INDEX_H_
@@ -0,0 +1,244 @@
+// File:  resampledDataExporter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Writer for curve data interpolated onto a shared x grid.  Output has a
+//        single x column followed by one y column per curve, either as delimited
+//        text or as a structured .npy array.
+
+// Standard C++ headers
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <cmath>
+
+// Local headers
+#include "resampledDataExporter.h"
+#include "binaryDataExporter.h"
+#include "bufferedWriter.h"
+#include "curveSource.h"
+
+//==========================================================================
+// Class:			ResampledDataExporter
+// Function:		ResampledDataExporter
+//
+// Description:		Constructor for ResampledDataExporter class.
+//
+// Input Arguments:
+//		settings	= const CurveResampler::Settings&
+//		delimiter	= const char&, ignored when writing NumPy files
+//		padding		= const Padding&, used for grid points outside a curve's range
+//		writeNumPy	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ResampledDataExporter::ResampledDataExporter(const CurveResampler::Settings& settings,
+	const char& delimiter, const Padding& padding, const bool& writeNumPy)
+	: settings(settings), delimiter(delimiter), padding(padding), writeNumPy(writeNumPy)
+{
+}
+
+//==========================================================================
+// Class:			ResampledDataExporter
+// Function:		Export
+//
+// Description:		Resamples the curves and writes them to file.  The grid is
+//					processed in blocks, with each curve keeping its own position
+//					so that the total work is linear in grid and curve size.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//		source		= const CurveSource&
+//		labels		= const std::vector<std::string>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ResampledDataExporter::Export(const std::string& fileName, const CurveSource& source,
+	const std::vector<std::string>& labels)
+{
+	ResetStatus();
+
+	std::vector<CurveResampler> curves(BuildCurves(source));
+	std::vector<double> grid;
+	if (settings.grid == CurveResampler::Grid::UniformStep)
+		grid = CurveResampler::BuildUniformGrid(curves, settings.step);
+	else
+		grid = CurveResampler::BuildUnionGrid(curves);
+
+	if (grid.empty())
+	{
+		errorString = "Unable to build the resampling grid; check that the step size is positive and not too small.";
+		return false;
+	}
+
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	if (!file.is_open() || !file.good())
+	{
+		errorString = "Failed to open '" + fileName + "' for output.";
+		return false;
+	}
+
+	BufferedWriter writer(file);
+	writer.Write(BuildHeader(labels, curves.size(), grid.size()));
+
+	std::string padText;
+	if (padding == Padding::NaN)
+		padText = "NaN";
+	else if (padding == Padding::Zero)
+		padText = "0";
+
+	// NaN marks grid points outside a curve (input points are all finite)
+	const double outsideValue(writeNumPy && padding == Padding::Zero ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+
+	const std::size_t columnCount(curves.size() + 1);
+	std::vector<std::vector<double>> columns(curves.size(), std::vector<double>(blockSize));
+	std::vector<double> rows(writeNumPy ? blockSize * columnCount : 0);
+	unsigned int i;
+	for (std::size_t blockStart = 0; blockStart < grid.size(); blockStart += blockSize)
+	{
+		const std::size_t count(std::min(blockSize, grid.size() - blockStart));
+		for (i = 0; i < curves.size(); ++i)
+			curves[i].Evaluate(grid.data() + blockStart, count, columns[i].data(), outsideValue);
+
+		std::size_t j;
+		if (writeNumPy)
+		{
+			for (j = 0; j < count; ++j)
+			{
+				rows[j * columnCount] = grid[blockStart + j];
+				for (i = 0; i < curves.size(); ++i)
+					rows[j * columnCount + i + 1] = columns[i][j];
+			}
+
+			writer.Write(reinterpret_cast<const char*>(rows.data()), count * columnCount * sizeof(double));
+		}
+		else
+		{
+			for (j = 0; j < count; ++j)
+			{
+				writer.Write(grid[blockStart + j]);
+				for (i = 0; i < curves.size(); ++i)
+				{
+					writer.Write(delimiter);
+					if (std::isnan(columns[i][j]))
+						writer.Write(padText);
+					else
+						writer.Write(columns[i][j]);
+				}
+				writer.Write('\n');
+			}
+		}
+
+		if (!ReportProgress(blockStart + count, grid.size()))
+			return false;
+	}
+
+	const bool ok(writer.Flush());
+	bytesWritten = writer.GetBytesWritten();
+	if (!ok)
+	{
+		errorString = "Failed while writing to '" + fileName + "'.";
+		return false;
+	}
+
+	rowsWritten = grid.size();
+	return true;
+}
+
+//==========================================================================
+// Class:			ResampledDataExporter
+// Function:		BuildCurves
+//
+// Description:		Converts each curve into plot coordinates and prepares it for
+//					interpolation.
+//
+// Input Arguments:
+//		source	= const CurveSource&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<CurveResampler>
+//
+//==========================================================================
+std::vector<CurveResampler> ResampledDataExporter::BuildCurves(const CurveSource& source) const
+{
+	std::vector<CurveResampler> curves;
+	curves.reserve(source.GetCurveCount());
+	for (unsigned int i = 0; i < source.GetCurveCount(); ++i)
+	{
+		const std::size_t size(source.GetCurveSize(i));
+		std::vector<double> x(size), y(size);
+		if (size > 0)
+			source.ConvertCurve(i, 0, size, x.data(), y.data());
+		curves.emplace_back(std::move(x), std::move(y), settings.interpolation);
+	}
+
+	return curves;
+}
+
+//==========================================================================
+// Class:			ResampledDataExporter
+// Function:		BuildHeader
+//
+// Description:		Builds the column header line (text) or array header (NumPy).
+//
+// Input Arguments:
+//		labels		= const std::vector<std::string>&
+//		curveCount	= const unsigned int&
+//		gridSize	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string ResampledDataExporter::BuildHeader(const std::vector<std::string>& labels,
+	const unsigned int& curveCount, const std::size_t& gridSize) const
+{
+	std::vector<std::string> names(1, "X");
+	for (unsigned int i = 0; i < curveCount; ++i)
+	{
+		if (i >= labels.size() || labels[i].empty())
+			names.push_back("Y" + std::to_string(i));
+		else
+			names.push_back(labels[i]);
+	}
+
+	if (!writeNumPy)
+	{
+		std::string header(names.front());
+		for (unsigned int i = 1; i < names.size(); ++i)
+			header.append(1, delimiter).append(names[i]);
+		return header + "\n";
+	}
+
+	// NumPy rejects duplicate field names, so make them unique
+	std::set<std::string> usedNames;
+	std::string descr("[");
+	for (const auto& name : names)
+	{
+		std::string candidate(name);
+		unsigned int suffix(2);
+		while (!usedNames.insert(candidate).second)
+			candidate = name + " (" + std::to_string(suffix++) + ")";
+		descr.append("(" + BinaryDataExporter::QuotePythonString(candidate) + ", '"
+			+ BinaryDataExporter::GetNumPyTypeString() + "'), ");
+	}
+	descr.append("]");
+
+	return BinaryDataExporter::BuildNumPyHeader(descr, "(" + std::to_string(gridSize) + ",)");
+}
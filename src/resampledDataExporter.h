@@ -0,0 +1,38 @@
+// File:  resampledDataExporter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Writer for curve data interpolated onto a shared x grid.  Output has a
+//        single x column followed by one y column per curve, either as delimited
+//        text or as a structured .npy array.
+
+#ifndef RESAMPLED_DATA_EXPORTER_H_
+#define RESAMPLED_DATA_EXPORTER_H_
+
+// Local headers
+#include "dataExporter.h"
+#include "curveResampler.h"
+
+class ResampledDataExporter : public DataExporter
+{
+public:
+	ResampledDataExporter(const CurveResampler::Settings& settings,
+		const char& delimiter, const Padding& padding, const bool& writeNumPy);
+
+	bool Export(const std::string& fileName, const CurveSource& source,
+		const std::vector<std::string>& labels) override;
+
+private:
+	const CurveResampler::Settings settings;
+	const char delimiter;
+	const Padding padding;
+	const bool writeNumPy;
+
+	std::vector<CurveResampler> BuildCurves(const CurveSource& source) const;
+	std::string BuildHeader(const std::vector<std::string>& labels, const unsigned int& curveCount,
+		const std::size_t& gridSize) const;
+
+	// Number of grid points evaluated at a time
+	static constexpr std::size_t blockSize = 4096;
+};
+
+#endif// RESAMPLED_DATA_EXPORTER_H_
@@ -0,0 +1,191 @@
+// File:  serviceRequest.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Parser for requests sent to the digitization service.
+
+// Standard C++ headers
+#include <sstream>
+
+// Local headers
+#include "serviceRequest.h"
+
+//==========================================================================
+// Class:			ServiceRequest
+// Function:		ServiceRequest
+//
+// Description:		Constructor for ServiceRequest class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ServiceRequest::ServiceRequest() : complete(false), format(Format::JSON)
+{
+}
+
+//==========================================================================
+// Class:			ServiceRequest
+// Function:		ParseLine
+//
+// Description:		Parses one line of the request.
+//
+// Input Arguments:
+//		line	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ServiceRequest::ParseLine(const std::string& line)
+{
+	const std::string trimmed(Trim(line));
+	if (trimmed.empty() || trimmed[0] == '#')
+		return true;
+
+	const std::string::size_type split(trimmed.find_first_of(" \t"));
+	const std::string command(trimmed.substr(0, split));
+	const std::string arguments(split == std::string::npos ? std::string() : Trim(trimmed.substr(split)));
+	std::istringstream ss(arguments);
+
+	if (command == "IMAGE")
+		imagePath = arguments;
+	else if (command == "TEMPLATE")
+		templateName = arguments;
+	else if (command == "REF")
+	{
+		PointPicker::ReferencePair pair;
+		if (!(ss >> pair.imageCoords.x >> pair.imageCoords.y >> pair.valueCoords.x >> pair.valueCoords.y))
+		{
+			errorString = "REF requires four numbers.";
+			return false;
+		}
+
+		if (!(ss >> pair.weight))
+		{
+			if (!ss.eof())
+			{
+				errorString = "REF weight must be a number.";
+				return false;
+			}
+			pair.weight = 1.0;
+		}
+		else if (pair.weight <= 0.0)
+		{
+			errorString = "REF weight must be positive.";
+			return false;
+		}
+		references.push_back(pair);
+	}
+	else if (command == "CURVE")
+	{
+		labels.push_back(arguments);
+		curves.push_back(std::vector<PointPicker::Point>());
+	}
+	else if (command == "PT")
+	{
+		if (curves.empty())
+		{
+			errorString = "PT must follow CURVE.";
+			return false;
+		}
+
+		std::vector<double> values;
+		double v;
+		while (ss >> v)
+			values.push_back(v);
+
+		if (!ss.eof() || values.size() % 2 != 0)
+		{
+			errorString = "PT requires pairs of numbers.";
+			return false;
+		}
+
+		for (unsigned int i = 0; i < values.size(); i += 2)
+			curves.back().push_back(PointPicker::Point(values[i], values[i + 1]));
+	}
+	else if (command == "SCALES")
+	{
+		std::string xNames, yNames;
+		if (!(ss >> xNames >> yNames) || !AxisScale::ParseMask(xNames, fitOptions.xScales) ||
+			!AxisScale::ParseMask(yNames, fitOptions.yScales))
+		{
+			errorString = "SCALES requires two lists of scale names.";
+			return false;
+		}
+	}
+	else if (command == "ROBUST")
+	{
+		fitOptions.robust = true;
+		if (!arguments.empty() && (!(ss >> fitOptions.inlierThreshold) || fitOptions.inlierThreshold <= 0.0))
+		{
+			errorString = "ROBUST threshold must be a positive number.";
+			return false;
+		}
+	}
+	else if (command == "REGION")
+	{
+		double x1, y1, x2, y2;
+		if (!(ss >> x1 >> y1 >> x2 >> y2))
+		{
+			errorString = "REGION requires four numbers.";
+			return false;
+		}
+		regions.push_back(RegionIndex::Bounds(x1, y1, x2, y2));
+	}
+	else if (command == "FORMAT")
+	{
+		if (arguments == "json")
+			format = Format::JSON;
+		else if (arguments == "npy")
+			format = Format::NumPy;
+		else
+		{
+			errorString = "Unknown format '" + arguments + "'.";
+			return false;
+		}
+	}
+	else if (command == "END")
+		complete = true;
+	else
+	{
+		errorString = "Unknown command '" + command + "'.";
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ServiceRequest
+// Function:		Trim
+//
+// Description:		Removes leading and trailing whitespace.
+//
+// Input Arguments:
+//		s	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string ServiceRequest::Trim(const std::string& s)
+{
+	const char* whitespace(" \t\r\n");
+	const std::string::size_type start(s.find_first_not_of(whitespace));
+	if (start == std::string::npos)
+		return std::string();
+
+	return s.substr(start, s.find_last_not_of(whitespace) - start + 1);
+}
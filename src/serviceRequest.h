@@ -0,0 +1,83 @@
+// File:  serviceRequest.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Parser for requests sent to the digitization service.
+//
+//        Requests are plain text, one command per line, terminated by END:
+//
+//          IMAGE <path>              image the pixel coordinates refer to (optional)
+//          TEMPLATE <name>           with REF lines, saves the references under this
+//                                    name; without, uses the saved references
+//          REF <px> <py> <x> <y> [w] reference pixel location and plot value, with
+//                                    optional relative weight (default 1)
+//          CURVE [label]             starts a new curve
+//          PT <px> <py> [<px> <py> ...]
+//                                    pixel locations of points on the current curve
+//          SCALES <x> <y>            scale families the fit may choose from on each
+//                                    axis, as comma-separated names (Linear,
+//                                    Logarithmic, Reciprocal, Probability) or Any
+//                                    (default Linear,Logarithmic on both)
+//          ROBUST [threshold]        reject mislabeled references (RANSAC); the
+//                                    threshold is in pixels (default 3)
+//          REGION <x1> <y1> <x2> <y2>
+//                                    opposite pixel corners of a separately
+//                                    calibrated region (i.e. one side of a broken
+//                                    axis); fit to the references inside it
+//          FORMAT json|npy           response format (default json)
+//          END
+//
+//        Blank lines and lines starting with # are ignored.
+
+#ifndef SERVICE_REQUEST_H_
+#define SERVICE_REQUEST_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "pointPicker.h"
+
+class ServiceRequest
+{
+public:
+	ServiceRequest();
+
+	enum class Format
+	{
+		JSON,
+		NumPy
+	};
+
+	// Returns false if the line is malformed; IsComplete() becomes true after END
+	bool ParseLine(const std::string& line);
+	bool IsComplete() const { return complete; }
+
+	const std::string& GetImagePath() const { return imagePath; }
+	const std::string& GetTemplateName() const { return templateName; }
+	const std::vector<PointPicker::ReferencePair>& GetReferences() const { return references; }
+	const std::vector<RegionIndex::Bounds>& GetRegions() const { return regions; }
+	const std::vector<std::string>& GetLabels() const { return labels; }
+	const std::vector<std::vector<PointPicker::Point>>& GetCurves() const { return curves; }
+	Format GetFormat() const { return format; }
+	const PointPicker::FitOptions& GetFitOptions() const { return fitOptions; }
+
+	std::string GetErrorString() const { return errorString; }
+
+private:
+	bool complete;
+	std::string imagePath;
+	std::string templateName;
+	std::vector<PointPicker::ReferencePair> references;
+	std::vector<RegionIndex::Bounds> regions;
+	std::vector<std::string> labels;
+	std::vector<std::vector<PointPicker::Point>> curves;
+	Format format;
+	PointPicker::FitOptions fitOptions;
+
+	std::string errorString;
+
+	static std::string Trim(const std::string& s);
+};
+
+#endif// SERVICE_REQUEST_H_
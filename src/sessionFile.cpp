@@ -0,0 +1,552 @@
+// File:  sessionFile.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Saved digitization state.
+
+// Standard C++ headers
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+// Local headers
+#include "sessionFile.h"
+#include "memoryMappedFile.h"
+#include "littleEndian.h"
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the SessionFile class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char SessionFile::magic[8] = { 'P', 'P', 'S', 'E', 'S', 'S', 'O', 'N' };
+const std::uint32_t SessionFile::version(3);
+const wxString SessionFile::extension(_T("pps"));
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		IsEmpty
+//
+// Description:		Checks whether there is anything worth restoring.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool SessionFile::IsEmpty() const
+{
+	if (panels.size() > 1)
+		return false;
+
+	for (const auto& p : panels)
+	{
+		if (!p.references.empty() || !p.regions.empty())
+			return false;
+
+		for (const auto& c : p.curves)
+		{
+			if (!c.points.empty() || !c.label.IsEmpty())
+				return false;
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		Write
+//
+// Description:		Writes the session.  Layout (all values little-endian, and
+//					every block a multiple of 8 bytes long):
+//
+//					  magic[8], uint32 version, uint32 panel count
+//					  uint64 image hash, uint32 flags (1 = hash is valid),
+//					  uint32 image file name length
+//					  image file name (UTF-8, zero padded)
+//					  uint32 padding, uint32 grid, uint32 interpolation,
+//					  uint32 reserved, double step
+//					  For each panel:
+//					    double bounds[4] (x min, y min, x max, y max)
+//					    uint32 model, uint32 robust, double threshold,
+//					    uint32 max hypotheses, uint32 bootstrap replicates
+//					    uint32 reference count (n), uint32 region count (m)
+//					    uint32 x scales, uint32 y scales (AxisScale masks)
+//					    double image x[n], image y[n], x[n], y[n], weight[n]
+//					    double region bounds[4 * m]
+//					    uint32 curve count, uint32 reserved
+//					    For each curve:
+//					      uint64 point count (k), uint32 label length, uint32 reserved
+//					      label (UTF-8, zero padded)
+//					      double x[k], y[k]
+//
+//					Version 1 files (which have no image or export settings)
+//					and version 2 files (which have no axis scales) can still
+//					be read.  The file is written next to the
+//					destination and renamed over it once complete.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionFile::Write(const std::string& fileName) const
+{
+	errorString.Clear();
+	const std::string temporaryFileName(fileName + ".partial");
+	{
+		std::ofstream file(temporaryFileName.c_str(), std::ios::binary);
+		if (!file.is_open())
+		{
+			errorString = _T("Failed to open '") + wxString(temporaryFileName) + _T("' for output.");
+			return false;
+		}
+
+		std::string header(magic, sizeof(magic));
+		LittleEndian::Append(header, version);
+		LittleEndian::Append(header, static_cast<std::uint32_t>(panels.size()));
+		file.write(header.data(), header.size());
+
+		const wxScopedCharBuffer imageName(imageFileName.utf8_str());
+		std::string image;
+		LittleEndian::Append(image, imageHash);
+		LittleEndian::Append(image, static_cast<std::uint32_t>(hasImageHash ? 1 : 0));
+		LittleEndian::Append(image, static_cast<std::uint32_t>(imageName.length()));
+		file.write(image.data(), image.size());
+		WritePadded(file, std::string(imageName.data(), imageName.length()));
+
+		std::string settings;
+		LittleEndian::Append(settings, static_cast<std::uint32_t>(padding));
+		LittleEndian::Append(settings, static_cast<std::uint32_t>(resampling.grid));
+		LittleEndian::Append(settings, static_cast<std::uint32_t>(resampling.interpolation));
+		LittleEndian::Append(settings, static_cast<std::uint32_t>(0));
+		LittleEndian::Append(settings, resampling.step);
+		file.write(settings.data(), settings.size());
+
+		std::vector<double> column;
+		for (const auto& p : panels)
+		{
+			std::string panelHeader;
+			LittleEndian::Append(panelHeader, p.bounds.xMin);
+			LittleEndian::Append(panelHeader, p.bounds.yMin);
+			LittleEndian::Append(panelHeader, p.bounds.xMax);
+			LittleEndian::Append(panelHeader, p.bounds.yMax);
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.fitOptions.distortion));
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.fitOptions.robust ? 1 : 0));
+			LittleEndian::Append(panelHeader, p.fitOptions.inlierThreshold);
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.fitOptions.maxHypotheses));
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.fitOptions.bootstrapReplicates));
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.references.size()));
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.regions.size()));
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.fitOptions.xScales));
+			LittleEndian::Append(panelHeader, static_cast<std::uint32_t>(p.fitOptions.yScales));
+			file.write(panelHeader.data(), panelHeader.size());
+
+			auto writeReferences([&](double PointPicker::Point::*ordinate, const bool& image)
+			{
+				column.resize(p.references.size());
+				std::size_t i;
+				for (i = 0; i < p.references.size(); ++i)
+					column[i] = (image ? p.references[i].imageCoords : p.references[i].valueCoords).*ordinate;
+				WriteColumn(file, column);
+			});
+
+			writeReferences(&PointPicker::Point::x, true);
+			writeReferences(&PointPicker::Point::y, true);
+			writeReferences(&PointPicker::Point::x, false);
+			writeReferences(&PointPicker::Point::y, false);
+
+			column.clear();
+			for (const auto& r : p.references)
+				column.push_back(r.weight);
+			WriteColumn(file, column);
+
+			column.clear();
+			for (const auto& r : p.regions)
+			{
+				column.push_back(r.xMin);
+				column.push_back(r.yMin);
+				column.push_back(r.xMax);
+				column.push_back(r.yMax);
+			}
+			WriteColumn(file, column);
+
+			std::string curveCount;
+			LittleEndian::Append(curveCount, static_cast<std::uint32_t>(p.curves.size()));
+			LittleEndian::Append(curveCount, static_cast<std::uint32_t>(0));
+			file.write(curveCount.data(), curveCount.size());
+
+			for (const auto& c : p.curves)
+			{
+				const wxScopedCharBuffer label(c.label.utf8_str());
+				std::string curveHeader;
+				LittleEndian::Append(curveHeader, static_cast<std::uint64_t>(c.points.size()));
+				LittleEndian::Append(curveHeader, static_cast<std::uint32_t>(label.length()));
+				LittleEndian::Append(curveHeader, static_cast<std::uint32_t>(0));
+				file.write(curveHeader.data(), curveHeader.size());
+				WritePadded(file, std::string(label.data(), label.length()));
+
+				column.resize(c.points.size());
+				std::size_t i;
+				for (i = 0; i < c.points.size(); ++i)
+					column[i] = c.points[i].x;
+				WriteColumn(file, column);
+
+				for (i = 0; i < c.points.size(); ++i)
+					column[i] = c.points[i].y;
+				WriteColumn(file, column);
+			}
+		}
+
+		if (!file.good())
+		{
+			errorString = _T("Failed to write '") + wxString(temporaryFileName) + _T("'.");
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(temporaryFileName, error);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryFileName, fileName, error);
+	if (error)
+	{
+		errorString = _T("Failed to replace '") + wxString(fileName) + _T("': ") + wxString(error.message());
+		std::filesystem::remove(temporaryFileName, error);
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		Read
+//
+// Description:		Reads the session, replacing the current contents.  Columns
+//					are copied out of the mapping; nothing is parsed.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionFile::Read(const std::string& fileName)
+{
+	*this = SessionFile();
+
+	MemoryMappedFile mapping(fileName);
+	if (!mapping.IsOpen())
+	{
+		errorString = _T("Failed to open '") + wxString(fileName) + _T("'.");
+		return false;
+	}
+
+	const char* position(mapping.GetData());
+	const char* end(position + mapping.GetSize());
+	const char* data;
+
+	if (!ReadBytes(position, end, 16, data) || !std::equal(magic, magic + sizeof(magic), data))
+	{
+		errorString = _T("'") + wxString(fileName) + _T("' is not a session file.");
+		return false;
+	}
+
+	const std::uint32_t fileVersion(LittleEndian::Read<std::uint32_t>(data + 8));
+	if (fileVersion > version)
+	{
+		errorString = _T("'") + wxString(fileName) + _T("' was written by a newer version of this program.");
+		return false;
+	}
+
+	auto truncated([this, &fileName]()
+	{
+		errorString = _T("'") + wxString(fileName) + _T("' is truncated or corrupt.");
+		panels.clear();
+		return false;
+	});
+
+	const std::uint32_t panelCount(LittleEndian::Read<std::uint32_t>(data + 12));
+	if (fileVersion >= 2)
+	{
+		if (!ReadBytes(position, end, 16, data))
+			return truncated();
+
+		imageHash = LittleEndian::Read<std::uint64_t>(data);
+		hasImageHash = (LittleEndian::Read<std::uint32_t>(data + 8) & 1) != 0;
+		const std::uint32_t nameLength(LittleEndian::Read<std::uint32_t>(data + 12));
+
+		const char* name;
+		if (!ReadBytes(position, end, (static_cast<std::size_t>(nameLength) + 7) & ~static_cast<std::size_t>(7), name))
+			return truncated();
+		imageFileName = wxString::FromUTF8(name, nameLength);
+
+		if (!ReadBytes(position, end, 24, data))
+			return truncated();
+
+		const std::uint32_t paddingIndex(LittleEndian::Read<std::uint32_t>(data));
+		const std::uint32_t gridIndex(LittleEndian::Read<std::uint32_t>(data + 4));
+		const std::uint32_t interpolationIndex(LittleEndian::Read<std::uint32_t>(data + 8));
+		if (paddingIndex > static_cast<std::uint32_t>(DataExporter::Padding::Zero) ||
+			gridIndex > static_cast<std::uint32_t>(CurveResampler::Grid::UnionOfX) ||
+			interpolationIndex > static_cast<std::uint32_t>(CurveResampler::Interpolation::MonotoneCubic))
+			return truncated();
+
+		padding = static_cast<DataExporter::Padding>(paddingIndex);
+		resampling.grid = static_cast<CurveResampler::Grid>(gridIndex);
+		resampling.interpolation = static_cast<CurveResampler::Interpolation>(interpolationIndex);
+		resampling.step = LittleEndian::ReadDouble(data + 16);
+	}
+
+	unsigned int i;
+	for (i = 0; i < panelCount; ++i)
+	{
+		if (!ReadBytes(position, end, 64, data))
+			return truncated();
+
+		Panel p;
+		p.bounds = RegionIndex::Bounds(LittleEndian::ReadDouble(data), LittleEndian::ReadDouble(data + 8),
+			LittleEndian::ReadDouble(data + 16), LittleEndian::ReadDouble(data + 24));
+
+		const std::uint32_t model(LittleEndian::Read<std::uint32_t>(data + 32));
+		if (model > static_cast<std::uint32_t>(DistortionModel::Type::Radial))
+			return truncated();
+		p.fitOptions.distortion = static_cast<DistortionModel::Type>(model);
+		p.fitOptions.robust = LittleEndian::Read<std::uint32_t>(data + 36) != 0;
+		p.fitOptions.inlierThreshold = LittleEndian::ReadDouble(data + 40);
+		p.fitOptions.maxHypotheses = LittleEndian::Read<std::uint32_t>(data + 48);
+		p.fitOptions.bootstrapReplicates = LittleEndian::Read<std::uint32_t>(data + 52);
+
+		const std::size_t referenceCount(LittleEndian::Read<std::uint32_t>(data + 56));
+		const std::size_t regionCount(LittleEndian::Read<std::uint32_t>(data + 60));
+
+		// Older files use the default scales
+		if (fileVersion >= 3)
+		{
+			if (!ReadBytes(position, end, 8, data))
+				return truncated();
+
+			p.fitOptions.xScales = LittleEndian::Read<std::uint32_t>(data);
+			p.fitOptions.yScales = LittleEndian::Read<std::uint32_t>(data + 4);
+			auto isMask([](const unsigned int& mask)
+			{
+				return mask != 0 && (mask & ~AxisScale::allMask) == 0;
+			});
+			if (!isMask(p.fitOptions.xScales) || !isMask(p.fitOptions.yScales))
+				return truncated();
+		}
+
+		const char* references;
+		if (!ReadBytes(position, end, referenceCount * 5 * sizeof(double), references))
+			return truncated();
+
+		p.references.resize(referenceCount);
+		std::size_t j;
+		for (j = 0; j < referenceCount; ++j)
+		{
+			PointPicker::ReferencePair& r(p.references[j]);
+			r.imageCoords.x = LittleEndian::ReadDouble(references + 8 * j);
+			r.imageCoords.y = LittleEndian::ReadDouble(references + 8 * (referenceCount + j));
+			r.valueCoords.x = LittleEndian::ReadDouble(references + 8 * (2 * referenceCount + j));
+			r.valueCoords.y = LittleEndian::ReadDouble(references + 8 * (3 * referenceCount + j));
+			r.weight = LittleEndian::ReadDouble(references + 8 * (4 * referenceCount + j));
+		}
+
+		const char* regions;
+		if (!ReadBytes(position, end, regionCount * 4 * sizeof(double), regions))
+			return truncated();
+
+		for (j = 0; j < regionCount; ++j)
+			p.regions.push_back(RegionIndex::Bounds(LittleEndian::ReadDouble(regions + 32 * j),
+				LittleEndian::ReadDouble(regions + 32 * j + 8), LittleEndian::ReadDouble(regions + 32 * j + 16),
+				LittleEndian::ReadDouble(regions + 32 * j + 24)));
+
+		if (!ReadBytes(position, end, 8, data))
+			return truncated();
+
+		// Each curve takes at least 16 bytes, so a corrupt count fails here
+		// rather than allocating billions of curves
+		const std::uint32_t curveCount(LittleEndian::Read<std::uint32_t>(data));
+		if (curveCount > static_cast<std::uint64_t>(end - position) / 16)
+			return truncated();
+		p.curves.resize(curveCount);
+		for (auto& c : p.curves)
+		{
+			if (!ReadBytes(position, end, 16, data))
+				return truncated();
+
+			const std::uint64_t pointCount(LittleEndian::Read<std::uint64_t>(data));
+			const std::uint32_t labelLength(LittleEndian::Read<std::uint32_t>(data + 8));
+
+			const char* label;
+			if (!ReadBytes(position, end, (static_cast<std::size_t>(labelLength) + 7) & ~static_cast<std::size_t>(7), label))
+				return truncated();
+			c.label = wxString::FromUTF8(label, labelLength);
+
+			// Checked before multiplying so a corrupt count can't overflow
+			if (pointCount > static_cast<std::uint64_t>(end - position) / (2 * sizeof(double)))
+				return truncated();
+
+			const std::size_t count(static_cast<std::size_t>(pointCount));
+			const char* x;
+			const char* y;
+			if (!ReadBytes(position, end, count * sizeof(double), x) ||
+				!ReadBytes(position, end, count * sizeof(double), y))
+				return truncated();
+
+			c.points.resize(count);
+			ReadColumn(x, count, c.points.data(), &PointPicker::Point::x);
+			ReadColumn(y, count, c.points.data(), &PointPicker::Point::y);
+		}
+
+		panels.push_back(std::move(p));
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		WritePadded
+//
+// Description:		Writes the data followed by zeros up to a multiple of 8
+//					bytes.
+//
+// Input Arguments:
+//		file	= std::ofstream&
+//		data	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionFile::WritePadded(std::ofstream& file, const std::string& data)
+{
+	const char zeros[8] = {};
+	file.write(data.data(), data.size());
+	file.write(zeros, (8 - data.size() % 8) % 8);
+}
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		WriteColumn
+//
+// Description:		Writes the values as little-endian doubles.
+//
+// Input Arguments:
+//		file	= std::ofstream&
+//		column	= const std::vector<double>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionFile::WriteColumn(std::ofstream& file, const std::vector<double>& column)
+{
+	if (LittleEndian::HostIsLittleEndian())
+	{
+		file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(double));
+		return;
+	}
+
+	std::vector<double> swapped(column);
+	LittleEndian::Convert(swapped.data(), swapped.size());
+	file.write(reinterpret_cast<const char*>(swapped.data()), swapped.size() * sizeof(double));
+}
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		ReadBytes
+//
+// Description:		Takes the next count bytes from the buffer.
+//
+// Input Arguments:
+//		position	= const char*&
+//		end			= const char*
+//		count		= const std::size_t&
+//
+// Output Arguments:
+//		position	= const char*&, advanced past the bytes
+//		data		= const char*&, start of the bytes
+//
+// Return Value:
+//		bool, false if there are not enough bytes left
+//
+//==========================================================================
+bool SessionFile::ReadBytes(const char*& position, const char* end, const std::size_t& count, const char*& data)
+{
+	if (static_cast<std::size_t>(end - position) < count)
+		return false;
+
+	data = position;
+	position += count;
+	return true;
+}
+
+//==========================================================================
+// Class:			SessionFile
+// Function:		ReadColumn
+//
+// Description:		Copies a column of little-endian doubles into one ordinate
+//					of the points.  On little-endian hosts this is a plain copy.
+//
+// Input Arguments:
+//		data		= const char*
+//		count		= const std::size_t&
+//		ordinate	= double PointPicker::Point::*, x or y
+//
+// Output Arguments:
+//		points		= PointPicker::Point*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionFile::ReadColumn(const char* data, const std::size_t& count,
+	PointPicker::Point* points, double PointPicker::Point::*ordinate)
+{
+	std::size_t i;
+	if (LittleEndian::HostIsLittleEndian())
+	{
+		for (i = 0; i < count; ++i)
+			std::memcpy(&(points[i].*ordinate), data + i * sizeof(double), sizeof(double));
+	}
+	else
+	{
+		for (i = 0; i < count; ++i)
+			points[i].*ordinate = LittleEndian::ReadDouble(data + i * sizeof(double));
+	}
+}
@@ -0,0 +1,82 @@
+// File:  sessionFile.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Saved digitization state (the image, panels with their calibrations,
+//        curves and curve names, and export settings).  The file is
+//        little-endian binary with every array stored as a raw column, so it
+//        is read straight out of a memory mapping rather than parsed value by
+//        value.
+
+#ifndef SESSION_FILE_H_
+#define SESSION_FILE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <fstream>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "pointPicker.h"
+#include "dataExporter.h"
+#include "curveResampler.h"
+
+class SessionFile
+{
+public:
+	SessionFile() : hasImageHash(false), imageHash(0), padding(DataExporter::Padding::Empty) {}
+
+	static const wxString extension;
+
+	// The image is found by its hash (in the image cache) if the file has
+	// moved or been deleted
+	wxString imageFileName;// Empty if there was no image
+	bool hasImageHash;
+	std::uint64_t imageHash;
+
+	DataExporter::Padding padding;
+	CurveResampler::Settings resampling;
+
+	struct Curve
+	{
+		wxString label;
+		std::vector<PointPicker::Point> points;// Image coordinates
+	};
+
+	struct Panel
+	{
+		RegionIndex::Bounds bounds;// Ignored for panel 0
+		std::vector<PointPicker::ReferencePair> references;
+		std::vector<RegionIndex::Bounds> regions;
+		PointPicker::FitOptions fitOptions;
+		std::vector<Curve> curves;
+	};
+
+	std::vector<Panel> panels;
+
+	// True when there is nothing worth restoring
+	bool IsEmpty() const;
+
+	bool Write(const std::string& fileName) const;
+	bool Read(const std::string& fileName);
+
+	wxString GetErrorString() const { return errorString; }
+
+private:
+	static const char magic[8];
+	static const std::uint32_t version;
+
+	mutable wxString errorString;
+
+	static void WritePadded(std::ofstream& file, const std::string& data);
+	static void WriteColumn(std::ofstream& file, const std::vector<double>& column);
+
+	static bool ReadBytes(const char*& position, const char* end, const std::size_t& count, const char*& data);
+	static void ReadColumn(const char* data, const std::size_t& count,
+		PointPicker::Point* points, double PointPicker::Point::*ordinate);
+};
+
+#endif// SESSION_FILE_H_
@@ -0,0 +1,855 @@
+// File:  sessionJournal.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Crash recovery log of the edits made while digitizing.
+
+// Standard C++ headers
+#include <filesystem>
+#include <algorithm>
+
+// Platform headers
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// wxWidgets headers
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
+
+// Local headers
+#include "sessionJournal.h"
+#include "memoryMappedFile.h"
+#include "littleEndian.h"
+#include "xxHash64.h"
+#include "crc32.h"
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the SessionJournal class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char SessionJournal::magic[8] = { 'P', 'P', 'J', 'O', 'U', 'R', 'N', 'L' };
+const std::uint32_t SessionJournal::version(1);
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		SessionJournal
+//
+// Description:		Constructor for SessionJournal class.  Nothing is written
+//					until the first checkpoint.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SessionJournal::SessionJournal() : enabled(false), stopRequested(false), loggedSize(0), snapshotSize(0), file(nullptr)
+{
+	// A second instance would overwrite the first one's files
+	instanceChecker = std::make_unique<wxSingleInstanceChecker>();
+	if (!instanceChecker->Create(_T("PointPicker-journal-") + wxGetUserId()) || instanceChecker->IsAnotherRunning())
+		return;
+
+	const wxString directory(wxStandardPaths::Get().GetUserDataDir());
+	if (!wxFileName::Mkdir(directory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return;
+
+	snapshotFileName = wxFileName(directory, _T("recovery"), SessionFile::extension).GetFullPath().ToStdString();
+	journalFileName = wxFileName(directory, _T("recovery"), _T("ppj")).GetFullPath().ToStdString();
+
+	enabled = true;
+	thread = std::thread(&SessionJournal::Run, this);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		~SessionJournal
+//
+// Description:		Destructor for SessionJournal class.  Anything still
+//					queued is written, but the files are kept (see Close()).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SessionJournal::~SessionJournal()
+{
+	Stop();
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Recover
+//
+// Description:		Reads the snapshot left by a run that didn't exit normally
+//					and replays the log onto it.  A damaged record (i.e. one
+//					that was only partly written) ends the replay.  Must be
+//					called before the first checkpoint.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		session	= SessionFile&
+//
+// Return Value:
+//		bool, true if there was a snapshot
+//
+//==========================================================================
+bool SessionJournal::Recover(SessionFile& session) const
+{
+	if (!enabled || !wxFileExists(snapshotFileName) || !session.Read(snapshotFileName))
+		return false;
+
+	std::uint64_t snapshotHash;
+	{
+		MemoryMappedFile snapshot(snapshotFileName);
+		if (!snapshot.IsOpen())
+			return false;
+		snapshotHash = XXHash64::Compute(snapshot.GetData(), snapshot.GetSize());
+	}
+
+	MemoryMappedFile journal(journalFileName);
+	if (!journal.IsOpen() || journal.GetSize() < headerSize)
+		return true;
+
+	// A log for a different snapshot is older than the snapshot (the last
+	// checkpoint was interrupted), so its edits are already included
+	const char* data(journal.GetData());
+	if (!std::equal(magic, magic + sizeof(magic), data) ||
+		LittleEndian::Read<std::uint32_t>(data + 8) != version ||
+		LittleEndian::Read<std::uint64_t>(data + 16) != snapshotHash)
+		return true;
+
+	Replay(data + headerSize, journal.GetSize() - headerSize, session);
+	return true;
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Checkpoint
+//
+// Description:		Queues a snapshot to replace the log.  Edits still waiting
+//					to be written are discarded, since the snapshot includes
+//					them.
+//
+// Input Arguments:
+//		snapshot	= SessionFile&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::Checkpoint(SessionFile&& snapshot)
+{
+	if (!enabled)
+		return;
+
+	Batch batch;
+	batch.snapshot = std::make_unique<SessionFile>(std::move(snapshot));
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopRequested)
+			return;
+
+		pending.clear();
+		pending.push_back(std::move(batch));
+	}
+	condition.notify_one();
+
+	loggedSize = 0;
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		AddCurvePoint
+//
+// Description:		Logs a point added to a curve.
+//
+// Input Arguments:
+//		panel		= const unsigned int&
+//		curve		= const unsigned int&
+//		imagePoint	= const PointPicker::Point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::AddCurvePoint(const unsigned int& panel, const unsigned int& curve,
+	const PointPicker::Point& imagePoint)
+{
+	std::string payload;
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(curve));
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(0));
+	LittleEndian::Append(payload, imagePoint.x);
+	LittleEndian::Append(payload, imagePoint.y);
+	Append(RecordType::AddCurvePoint, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		AddReference
+//
+// Description:		Logs a new reference.
+//
+// Input Arguments:
+//		panel		= const unsigned int&
+//		reference	= const PointPicker::ReferencePair&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::AddReference(const unsigned int& panel, const PointPicker::ReferencePair& reference)
+{
+	std::string payload;
+	LittleEndian::Append(payload, reference.imageCoords.x);
+	LittleEndian::Append(payload, reference.imageCoords.y);
+	LittleEndian::Append(payload, reference.valueCoords.x);
+	LittleEndian::Append(payload, reference.valueCoords.y);
+	LittleEndian::Append(payload, reference.weight);
+	Append(RecordType::AddReference, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		RemoveReference
+//
+// Description:		Logs the removal of a reference.
+//
+// Input Arguments:
+//		panel		= const unsigned int&
+//		reference	= const unsigned int&, index
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::RemoveReference(const unsigned int& panel, const unsigned int& reference)
+{
+	std::string payload;
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(reference));
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(0));
+	Append(RecordType::RemoveReference, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		ResetReferences
+//
+// Description:		Logs the removal of all of a panel's references.
+//
+// Input Arguments:
+//		panel	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::ResetReferences(const unsigned int& panel)
+{
+	Append(RecordType::ResetReferences, panel, std::string());
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		ResetCurveData
+//
+// Description:		Logs the removal of a curve (later curves move down one).
+//
+// Input Arguments:
+//		panel	= const unsigned int&
+//		curve	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::ResetCurveData(const unsigned int& panel, const unsigned int& curve)
+{
+	std::string payload;
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(curve));
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(0));
+	Append(RecordType::ResetCurveData, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		SetLabel
+//
+// Description:		Logs a new curve name.
+//
+// Input Arguments:
+//		panel	= const unsigned int&
+//		curve	= const unsigned int&
+//		label	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::SetLabel(const unsigned int& panel, const unsigned int& curve, const wxString& label)
+{
+	const wxScopedCharBuffer utf8(label.utf8_str());
+	std::string payload;
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(curve));
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(utf8.length()));
+	payload.append(utf8.data(), utf8.length());
+	Append(RecordType::SetLabel, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		RemoveNewestCurvePoint
+//
+// Description:		Logs the removal of a curve's last point.
+//
+// Input Arguments:
+//		panel	= const unsigned int&
+//		curve	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::RemoveNewestCurvePoint(const unsigned int& panel, const unsigned int& curve)
+{
+	std::string payload;
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(curve));
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(0));
+	Append(RecordType::RemoveNewestCurvePoint, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		InsertReference
+//
+// Description:		Logs a reference inserted before an existing one.
+//
+// Input Arguments:
+//		panel		= const unsigned int&
+//		reference	= const unsigned int&, index
+//		pair		= const PointPicker::ReferencePair&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::InsertReference(const unsigned int& panel, const unsigned int& reference,
+	const PointPicker::ReferencePair& pair)
+{
+	std::string payload;
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(reference));
+	LittleEndian::Append(payload, static_cast<std::uint32_t>(0));
+	LittleEndian::Append(payload, pair.imageCoords.x);
+	LittleEndian::Append(payload, pair.imageCoords.y);
+	LittleEndian::Append(payload, pair.valueCoords.x);
+	LittleEndian::Append(payload, pair.valueCoords.y);
+	LittleEndian::Append(payload, pair.weight);
+	Append(RecordType::InsertReference, panel, payload);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		NeedsCompaction
+//
+// Description:		Checks whether the log has grown enough to be replaced by
+//					a new snapshot.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool SessionJournal::NeedsCompaction() const
+{
+	return enabled && loggedSize > std::max(minimumCompactionSize, snapshotSize.load(std::memory_order_relaxed));
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Close
+//
+// Description:		Stops logging and removes the files.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::Close()
+{
+	if (!enabled)
+		return;
+
+	Stop();
+	enabled = false;
+
+	std::error_code error;
+	std::filesystem::remove(journalFileName, error);
+	std::filesystem::remove(snapshotFileName, error);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Stop
+//
+// Description:		Waits for the writer thread to finish what is queued and
+//					exit.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopRequested = true;
+	}
+	condition.notify_one();
+
+	if (thread.joinable())
+		thread.join();
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Append
+//
+// Description:		Queues a record for the writer thread.  Layout
+//					(little-endian):
+//
+//					  uint32 size (including this header), uint32 CRC-32 of
+//					  the rest of the record, uint32 type, uint32 panel,
+//					  payload
+//
+// Input Arguments:
+//		type	= const RecordType&
+//		panel	= const unsigned int&
+//		payload	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::Append(const RecordType& type, const unsigned int& panel, const std::string& payload)
+{
+	if (!enabled)
+		return;
+
+	std::string record;
+	record.reserve(recordHeaderSize + payload.size());
+	LittleEndian::Append(record, static_cast<std::uint32_t>(recordHeaderSize + payload.size()));
+	LittleEndian::Append(record, static_cast<std::uint32_t>(0));// CRC, below
+	LittleEndian::Append(record, static_cast<std::uint32_t>(type));
+	LittleEndian::Append(record, static_cast<std::uint32_t>(panel));
+	record.append(payload);
+
+	std::string crc;
+	LittleEndian::Append(crc, CRC32::Compute(record.data() + 8, record.size() - 8));
+	record.replace(4, crc.size(), crc);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopRequested)
+			return;
+
+		if (pending.empty())
+			pending.emplace_back();
+		pending.back().records.append(record);
+	}
+	condition.notify_one();
+
+	loggedSize += record.size();
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Run
+//
+// Description:		Writer thread main loop.  Records made while the previous
+//					batch was being synced are written together.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionJournal::Run()
+{
+	TraceRecorder::SetThreadName("Session journal");
+	while (true)
+	{
+		Batch batch;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]()
+			{
+				return stopRequested || !pending.empty();
+			});
+
+			if (pending.empty())
+				break;
+
+			batch = std::move(pending.front());
+			pending.pop_front();
+		}
+
+		// Failures are ignored (the affected edits can't be recovered); the
+		// next checkpoint starts over
+		if (batch.snapshot)
+			WriteSnapshot(*batch.snapshot);
+		if (!batch.records.empty())
+			WriteRecords(batch.records);
+	}
+
+	if (file)
+	{
+		std::fclose(file);
+		file = nullptr;
+	}
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		WriteSnapshot
+//
+// Description:		Writes the snapshot, then starts a new log for it.  The log
+//					header holds the snapshot's hash, so a crash between the
+//					two steps leaves an old log that recovery knows to ignore.
+//					Layout (little-endian):
+//
+//					  magic[8], uint32 version, uint32 reserved,
+//					  uint64 snapshot hash, records
+//
+// Input Arguments:
+//		snapshot	= const SessionFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionJournal::WriteSnapshot(const SessionFile& snapshot)
+{
+	if (file)
+	{
+		std::fclose(file);
+		file = nullptr;
+	}
+
+	if (!snapshot.Write(snapshotFileName))
+		return false;
+
+	std::uint64_t snapshotHash;
+	{
+		MemoryMappedFile mapped(snapshotFileName);
+		if (!mapped.IsOpen())
+			return false;
+		snapshotHash = XXHash64::Compute(mapped.GetData(), mapped.GetSize());
+		snapshotSize.store(mapped.GetSize(), std::memory_order_relaxed);
+	}
+
+	std::FILE* snapshotFile(std::fopen(snapshotFileName.c_str(), "r+b"));
+	if (!snapshotFile)
+		return false;
+	const bool snapshotSynced(Sync(snapshotFile));
+	std::fclose(snapshotFile);
+	if (!snapshotSynced)
+		return false;
+
+	std::string header(magic, sizeof(magic));
+	LittleEndian::Append(header, version);
+	LittleEndian::Append(header, static_cast<std::uint32_t>(0));
+	LittleEndian::Append(header, snapshotHash);
+
+	const std::string temporaryFileName(journalFileName + ".partial");
+	std::FILE* newFile(std::fopen(temporaryFileName.c_str(), "wb"));
+	if (!newFile)
+		return false;
+	const bool headerWritten(std::fwrite(header.data(), 1, header.size(), newFile) == header.size() && Sync(newFile));
+	std::fclose(newFile);
+	if (!headerWritten)
+		return false;
+
+	std::error_code error;
+	std::filesystem::rename(temporaryFileName, journalFileName, error);
+	if (error)
+		return false;
+
+	file = std::fopen(journalFileName.c_str(), "ab");
+	return file != nullptr;
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		WriteRecords
+//
+// Description:		Appends records to the log and syncs it.
+//
+// Input Arguments:
+//		records	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionJournal::WriteRecords(const std::string& records)
+{
+	if (!file)
+		return false;
+
+	return std::fwrite(records.data(), 1, records.size(), file) == records.size() && Sync(file);
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Sync
+//
+// Description:		Flushes the file all the way to the disk.
+//
+// Input Arguments:
+//		file	= std::FILE*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionJournal::Sync(std::FILE* file)
+{
+	if (std::fflush(file) != 0)
+		return false;
+
+#ifdef _WIN32
+	return _commit(_fileno(file)) == 0;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
+
+//==========================================================================
+// Class:			SessionJournal
+// Function:		Replay
+//
+// Description:		Applies the logged edits to the session, in order.
+//
+// Input Arguments:
+//		data	= const char*, first record
+//		size	= const std::size_t&, [bytes]
+//
+// Output Arguments:
+//		session	= SessionFile&
+//
+// Return Value:
+//		bool, true if every record was applied
+//
+//==========================================================================
+bool SessionJournal::Replay(const char* data, const std::size_t& size, SessionFile& session)
+{
+	const char* position(data);
+	const char* end(data + size);
+	while (static_cast<std::size_t>(end - position) >= recordHeaderSize)
+	{
+		const std::uint32_t recordSize(LittleEndian::Read<std::uint32_t>(position));
+		if (recordSize < recordHeaderSize || recordSize > static_cast<std::size_t>(end - position) ||
+			CRC32::Compute(position + 8, recordSize - 8) != LittleEndian::Read<std::uint32_t>(position + 4))
+			return false;
+
+		const std::uint32_t type(LittleEndian::Read<std::uint32_t>(position + 8));
+		const std::uint32_t panelIndex(LittleEndian::Read<std::uint32_t>(position + 12));
+		if (panelIndex >= session.panels.size())
+			return false;
+
+		SessionFile::Panel& panel(session.panels[panelIndex]);
+		const char* payload(position + recordHeaderSize);
+		const std::size_t payloadSize(recordSize - recordHeaderSize);
+		switch (static_cast<RecordType>(type))
+		{
+		case RecordType::AddCurvePoint:
+		{
+			if (payloadSize < 24)
+				return false;
+
+			const std::uint32_t curve(LittleEndian::Read<std::uint32_t>(payload));
+			if (panel.curves.size() <= curve)
+				panel.curves.resize(curve + 1);
+			panel.curves[curve].points.push_back(PointPicker::Point(
+				LittleEndian::ReadDouble(payload + 8), LittleEndian::ReadDouble(payload + 16)));
+			break;
+		}
+
+		case RecordType::AddReference:
+			if (payloadSize < 40)
+				return false;
+
+			panel.references.push_back(PointPicker::ReferencePair(
+				PointPicker::Point(LittleEndian::ReadDouble(payload), LittleEndian::ReadDouble(payload + 8)),
+				PointPicker::Point(LittleEndian::ReadDouble(payload + 16), LittleEndian::ReadDouble(payload + 24)),
+				LittleEndian::ReadDouble(payload + 32)));
+			break;
+
+		case RecordType::RemoveReference:
+		{
+			if (payloadSize < 8)
+				return false;
+
+			const std::uint32_t reference(LittleEndian::Read<std::uint32_t>(payload));
+			if (reference >= panel.references.size())
+				return false;
+			panel.references.erase(panel.references.begin() + reference);
+			break;
+		}
+
+		case RecordType::ResetReferences:
+			panel.references.clear();
+			break;
+
+		case RecordType::ResetCurveData:
+		{
+			if (payloadSize < 8)
+				return false;
+
+			const std::uint32_t curve(LittleEndian::Read<std::uint32_t>(payload));
+			if (curve >= panel.curves.size())
+				return false;
+			panel.curves.erase(panel.curves.begin() + curve);
+			break;
+		}
+
+		case RecordType::SetLabel:
+		{
+			if (payloadSize < 8)
+				return false;
+
+			const std::uint32_t curve(LittleEndian::Read<std::uint32_t>(payload));
+			const std::uint32_t labelLength(LittleEndian::Read<std::uint32_t>(payload + 4));
+			if (labelLength > payloadSize - 8)
+				return false;
+
+			if (panel.curves.size() <= curve)
+				panel.curves.resize(curve + 1);
+			panel.curves[curve].label = wxString::FromUTF8(payload + 8, labelLength);
+			break;
+		}
+
+		case RecordType::RemoveNewestCurvePoint:
+		{
+			if (payloadSize < 8)
+				return false;
+
+			const std::uint32_t curve(LittleEndian::Read<std::uint32_t>(payload));
+			if (curve >= panel.curves.size() || panel.curves[curve].points.empty())
+				return false;
+			panel.curves[curve].points.pop_back();
+			break;
+		}
+
+		case RecordType::InsertReference:
+		{
+			if (payloadSize < 48)
+				return false;
+
+			const std::uint32_t reference(LittleEndian::Read<std::uint32_t>(payload));
+			if (reference > panel.references.size())
+				return false;
+			panel.references.insert(panel.references.begin() + reference, PointPicker::ReferencePair(
+				PointPicker::Point(LittleEndian::ReadDouble(payload + 8), LittleEndian::ReadDouble(payload + 16)),
+				PointPicker::Point(LittleEndian::ReadDouble(payload + 24), LittleEndian::ReadDouble(payload + 32)),
+				LittleEndian::ReadDouble(payload + 40)));
+			break;
+		}
+
+		default:
+			return false;
+		}
+
+		position += recordSize;
+	}
+
+	return position == end;
+}
@@ -0,0 +1,131 @@
+// File:  sessionJournal.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Crash recovery log of the edits made while digitizing.  Each edit is
+//        appended to a buffer (well under a microsecond) and a background
+//        thread writes and syncs whatever has accumulated in one go, so a
+//        burst of clicks costs one sync.  A checkpoint replaces the log with
+//        a snapshot of the whole session; edits that aren't logged (i.e. new
+//        panels or regions) are saved that way, and it is also how the log is
+//        compacted once it outgrows the snapshot.
+//
+//        The files are kept in the user data directory as recovery.pps (the
+//        snapshot, a session file) and recovery.ppj (the log).  They are
+//        removed when the program closes normally, so finding them at start
+//        up means the previous run crashed.
+
+#ifndef SESSION_JOURNAL_H_
+#define SESSION_JOURNAL_H_
+
+// Standard C++ headers
+#include <deque>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/snglinst.h>
+
+// Local headers
+#include "pointPicker.h"
+#include "sessionFile.h"
+
+class SessionJournal
+{
+public:
+	SessionJournal();
+	~SessionJournal();
+
+	// Only the first running instance keeps a journal
+	bool IsEnabled() const { return enabled; }
+
+	// Reads the snapshot left by a crashed run and replays the log onto it;
+	// false if there is nothing to recover
+	bool Recover(SessionFile& session) const;
+
+	// Starts a new log from the specified state
+	void Checkpoint(SessionFile&& snapshot);
+
+	void AddCurvePoint(const unsigned int& panel, const unsigned int& curve, const PointPicker::Point& imagePoint);
+	void AddReference(const unsigned int& panel, const PointPicker::ReferencePair& reference);
+	void RemoveReference(const unsigned int& panel, const unsigned int& reference);
+	void ResetReferences(const unsigned int& panel);
+	void ResetCurveData(const unsigned int& panel, const unsigned int& curve);
+	void SetLabel(const unsigned int& panel, const unsigned int& curve, const wxString& label);
+
+	// For undo and redo
+	void RemoveNewestCurvePoint(const unsigned int& panel, const unsigned int& curve);
+	void InsertReference(const unsigned int& panel, const unsigned int& reference,
+		const PointPicker::ReferencePair& pair);
+
+	// True once the log is larger than the last snapshot; checkpointing then
+	// keeps the cost of compaction proportional to the number of edits
+	bool NeedsCompaction() const;
+
+	// Finishes writing and removes the files (for a normal exit)
+	void Close();
+
+	static constexpr std::uint64_t minimumCompactionSize = 1 << 20;// [bytes]
+
+private:
+	static const char magic[8];
+	static const std::uint32_t version;
+	static constexpr std::size_t headerSize = 24;
+	static constexpr std::size_t recordHeaderSize = 16;
+
+	enum class RecordType : std::uint32_t
+	{
+		AddCurvePoint,
+		AddReference,
+		RemoveReference,
+		ResetReferences,
+		ResetCurveData,
+		SetLabel,
+		RemoveNewestCurvePoint,
+		InsertReference
+	};
+
+	bool enabled;
+	std::unique_ptr<wxSingleInstanceChecker> instanceChecker;
+
+	std::string snapshotFileName;
+	std::string journalFileName;
+
+	// Checkpoints and records in the order they were made; a batch's snapshot
+	// (if any) is written before its records
+	struct Batch
+	{
+		std::unique_ptr<SessionFile> snapshot;
+		std::string records;
+	};
+
+	std::deque<Batch> pending;
+	bool stopRequested;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::thread thread;
+
+	std::uint64_t loggedSize;// Since the last checkpoint [bytes]
+	std::atomic<std::uint64_t> snapshotSize;// [bytes]
+
+	void Append(const RecordType& type, const unsigned int& panel, const std::string& payload);
+	void Stop();
+
+	// Writer thread
+	std::FILE* file;
+	void Run();
+	bool WriteSnapshot(const SessionFile& snapshot);
+	bool WriteRecords(const std::string& records);
+	static bool Sync(std::FILE* file);
+
+	static bool Replay(const char* data, const std::size_t& size, SessionFile& session);
+};
+
+#endif// SESSION_JOURNAL_H_
@@ -0,0 +1,251 @@
+// File:  threadPool.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Work-stealing thread pool.
+
+// Standard C++ headers
+#include <algorithm>
+
+// Local headers
+#include "threadPool.h"
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the ThreadPool class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+thread_local ThreadPool* ThreadPool::currentPool(nullptr);
+thread_local unsigned int ThreadPool::currentIndex(0);
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ThreadPool
+//
+// Description:		Constructor for ThreadPool class.  Starts the worker threads.
+//
+// Input Arguments:
+//		threadCount	= const unsigned int&, zero for one thread per core
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ThreadPool::ThreadPool(const unsigned int& threadCount) : queuedCount(0),
+	pendingCount(0), nextQueue(0), stopping(false)
+{
+	const unsigned int count(threadCount > 0 ? threadCount :
+		std::max(1U, std::thread::hardware_concurrency()));
+
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		queues.push_back(std::make_unique<WorkQueue>());
+
+	for (i = 0; i < count; ++i)
+		threads.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		~ThreadPool
+//
+// Description:		Destructor for ThreadPool class.  Finishes any queued work
+//					before stopping the threads.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ThreadPool::~ThreadPool()
+{
+	WaitIdle();
+
+	{
+		std::lock_guard<std::mutex> lock(waitMutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+
+	for (auto& t : threads)
+		t.join();
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		Submit
+//
+// Description:		Queues a task.  From a worker thread, the task goes on that
+//					worker's own queue; otherwise queues are chosen round-robin.
+//
+// Input Arguments:
+//		task	= Task
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::Submit(Task task)
+{
+	const unsigned int index(currentPool == this ? currentIndex :
+		nextQueue++ % static_cast<unsigned int>(queues.size()));
+
+	// Counting under the wait mutex avoids missing a worker that is about to
+	// sleep; the count goes up first so it never drops below the number of
+	// tasks actually in the queues
+	++pendingCount;
+	{
+		std::lock_guard<std::mutex> lock(waitMutex);
+		++queuedCount;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->tasks.push_front(std::move(task));
+	}
+	workAvailable.notify_one();
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		WaitIdle
+//
+// Description:		Blocks until all submitted tasks have completed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(waitMutex);
+	idle.wait(lock, [this]()
+	{
+		return pendingCount == 0;
+	});
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		TakeTask
+//
+// Description:		Takes the newest task from this worker's queue, or steals the
+//					oldest task from another worker's queue.
+//
+// Input Arguments:
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		task	= Task&
+//
+// Return Value:
+//		bool, true if a task was found
+//
+//==========================================================================
+bool ThreadPool::TakeTask(const unsigned int& index, Task& task)
+{
+	{
+		WorkQueue& own(*queues[index]);
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.front());
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+
+	const unsigned int count(static_cast<unsigned int>(queues.size()));
+	for (unsigned int i = 1; i < count; ++i)
+	{
+		WorkQueue& victim(*queues[(index + i) % count]);
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.back());
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		WorkerLoop
+//
+// Description:		Worker thread entry point.
+//
+// Input Arguments:
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::WorkerLoop(const unsigned int& index)
+{
+	currentPool = this;
+	currentIndex = index;
+	TraceRecorder::SetThreadName("Pool worker");
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(waitMutex);
+			workAvailable.wait(lock, [this]()
+			{
+				return stopping || queuedCount > 0;
+			});
+
+			if (queuedCount == 0)// stopping
+				return;
+		}
+
+		Task task;
+		if (!TakeTask(index, task))
+			continue;// Another worker got there first, or the task is still on its way in
+
+		--queuedCount;
+		task();
+		task = nullptr;
+
+		if (--pendingCount == 0)
+		{
+			std::lock_guard<std::mutex> lock(waitMutex);
+			idle.notify_all();
+		}
+	}
+}
@@ -0,0 +1,69 @@
+// File:  threadPool.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Work-stealing thread pool.  Each worker has its own task queue; tasks
+//        submitted from a worker go to the front of that worker's queue, and
+//        idle workers steal from the back of the other queues.  This keeps
+//        follow-on work for a task on the same thread while still spreading
+//        uneven work across all cores.
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+// Standard C++ headers
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+
+class ThreadPool
+{
+public:
+	// A thread count of zero uses one thread per core
+	explicit ThreadPool(const unsigned int& threadCount = 0);
+	~ThreadPool();
+
+	typedef std::function<void()> Task;
+
+	// Tasks must not block waiting on other tasks in the same pool
+	void Submit(Task task);
+
+	// Blocks until every submitted task (including tasks they submit) is done;
+	// must not be called from a task
+	void WaitIdle();
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(threads.size()); }
+
+private:
+	struct WorkQueue
+	{
+		std::deque<Task> tasks;
+		std::mutex mutex;
+	};
+
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> threads;
+
+	std::atomic<std::size_t> queuedCount;// Tasks waiting in any queue
+	std::atomic<std::size_t> pendingCount;// Tasks queued or running
+	std::atomic<unsigned int> nextQueue;
+	bool stopping;
+
+	std::mutex waitMutex;
+	std::condition_variable workAvailable;
+	std::condition_variable idle;
+
+	void WorkerLoop(const unsigned int& index);
+	bool TakeTask(const unsigned int& index, Task& task);
+
+	// Identifies the pool and queue belonging to the current thread (if any)
+	static thread_local ThreadPool* currentPool;
+	static thread_local unsigned int currentIndex;
+};
+
+#endif// THREAD_POOL_H_
@@ -0,0 +1,432 @@
+// File:  traceRecorder.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Records timeline events and writes them in the Chrome trace_event
+//        JSON format.
+
+// Standard C++ headers
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+// Local headers
+#include "traceRecorder.h"
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		Constant Declarations
+//
+// Description:		Constant declarations for the TraceRecorder class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+std::atomic<bool> TraceRecorder::enabled(false);
+std::atomic<std::int64_t> TraceRecorder::epoch(0);
+std::atomic<std::uint32_t> TraceRecorder::nextThreadId(1);
+std::mutex TraceRecorder::registryMutex;
+std::vector<std::unique_ptr<TraceRecorder::Buffer>> TraceRecorder::buffers;
+std::vector<TraceRecorder::Buffer*> TraceRecorder::freeBuffers;
+std::vector<TraceRecorder::ThreadName> TraceRecorder::threadNames;
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		Start
+//
+// Description:		Begins recording.  Events from earlier sessions are
+//					discarded.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::Start()
+{
+	// Rather than clearing buffers that other threads may be writing to, older
+	// events are filtered out by their time stamp when the file is written
+	epoch.store(ToNanoseconds(std::chrono::steady_clock::now()), std::memory_order_relaxed);
+	enabled.store(true, std::memory_order_release);
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		Stop
+//
+// Description:		Stops recording.  Recorded events are kept until the next
+//					call to Start().
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::Stop()
+{
+	enabled.store(false, std::memory_order_relaxed);
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		Write
+//
+// Description:		Stops recording and writes the recorded events to file.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool TraceRecorder::Write(const std::string& fileName)
+{
+	Stop();
+
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	file << BuildJson();
+	return file.good();
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		SetThreadName
+//
+// Description:		Sets the name shown for the calling thread in the trace
+//					viewer.  Threads that are not named are shown by number.
+//
+// Input Arguments:
+//		name	= const char*, must be a string literal
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::SetThreadName(const char* name)
+{
+	const std::uint32_t threadId(GetThreadId());
+	std::lock_guard<std::mutex> lock(registryMutex);
+	threadNames.push_back({threadId, name});
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		AddComplete
+//
+// Description:		Records an event with a duration.
+//
+// Input Arguments:
+//		name		= const char*, must be a string literal
+//		category	= const char*, must be a string literal
+//		start		= const std::chrono::steady_clock::time_point&
+//		end			= const std::chrono::steady_clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::AddComplete(const char* name, const char* category,
+	const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end)
+{
+	if (!IsEnabled())
+		return;
+
+	Event event;
+	event.name = name;
+	event.category = category;
+	event.start = ToNanoseconds(start);
+	event.duration = std::max(static_cast<std::int64_t>(0), ToNanoseconds(end) - event.start);
+	event.threadId = GetThreadId();
+	Add(event);
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		AddInstant
+//
+// Description:		Records an event with no duration (i.e. a user input).
+//
+// Input Arguments:
+//		name		= const char*, must be a string literal
+//		category	= const char*, must be a string literal
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::AddInstant(const char* name, const char* category)
+{
+	if (!IsEnabled())
+		return;
+
+	Event event;
+	event.name = name;
+	event.category = category;
+	event.start = ToNanoseconds(std::chrono::steady_clock::now());
+	event.duration = -1;
+	event.threadId = GetThreadId();
+	Add(event);
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		Add
+//
+// Description:		Appends the event to the calling thread's ring buffer.
+//					Only the owning thread writes to a buffer, so publishing the
+//					new write position is the only synchronization required.
+//
+// Input Arguments:
+//		event	= const Event&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::Add(const Event& event)
+{
+	Buffer* buffer(GetBuffer());
+	const std::uint64_t index(buffer->writeIndex.load(std::memory_order_relaxed));
+	buffer->events[index % bufferCapacity] = event;
+	buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		GetBuffer
+//
+// Description:		Returns the calling thread's buffer, claiming one on first
+//					use.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Buffer*
+//
+//==========================================================================
+TraceRecorder::Buffer* TraceRecorder::GetBuffer()
+{
+	thread_local BufferHandle handle;
+	if (handle.buffer)
+		return handle.buffer;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	if (freeBuffers.empty())
+	{
+		buffers.push_back(std::make_unique<Buffer>());
+		handle.buffer = buffers.back().get();
+	}
+	else
+	{
+		handle.buffer = freeBuffers.back();
+		freeBuffers.pop_back();
+	}
+
+	return handle.buffer;
+}
+
+//==========================================================================
+// Class:			TraceRecorder::BufferHandle
+// Function:		~BufferHandle
+//
+// Description:		Destructor for BufferHandle class.  Returns the buffer for
+//					use by another thread when the owning thread exits.  The
+//					events it holds are kept.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+TraceRecorder::BufferHandle::~BufferHandle()
+{
+	if (!buffer)
+		return;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	freeBuffers.push_back(buffer);
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		GetThreadId
+//
+// Description:		Returns a small number identifying the calling thread.
+//					Numbers are never reused, even when a buffer is.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint32_t
+//
+//==========================================================================
+std::uint32_t TraceRecorder::GetThreadId()
+{
+	thread_local const std::uint32_t threadId(nextThreadId.fetch_add(1, std::memory_order_relaxed));
+	return threadId;
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		ToNanoseconds
+//
+// Description:		Converts the time point to nanoseconds.
+//
+// Input Arguments:
+//		time	= const std::chrono::steady_clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::int64_t
+//
+//==========================================================================
+std::int64_t TraceRecorder::ToNanoseconds(const std::chrono::steady_clock::time_point& time)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		BuildJson
+//
+// Description:		Formats the events recorded since the last call to Start()
+//					as a trace_event JSON object.  Time stamps are in
+//					microseconds relative to Start().
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string TraceRecorder::BuildJson()
+{
+	const std::int64_t start(epoch.load(std::memory_order_relaxed));
+	std::string json("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	json.append("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"PointPicker\"}}");
+
+	char line[128];
+	std::lock_guard<std::mutex> lock(registryMutex);
+	for (const auto& t : threadNames)
+	{
+		std::snprintf(line, sizeof(line), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+			static_cast<unsigned int>(t.threadId));
+		json.append(line);
+		AppendJsonString(json, t.name);
+		json.append("}}");
+	}
+
+	for (const auto& buffer : buffers)
+	{
+		const std::uint64_t end(buffer->writeIndex.load(std::memory_order_acquire));
+		const std::uint64_t available(std::min<std::uint64_t>(end, bufferCapacity - readMargin));
+
+		std::uint64_t i;
+		for (i = end - available; i < end; ++i)
+		{
+			const Event& event(buffer->events[i % bufferCapacity]);
+			if (event.start < start)
+				continue;
+
+			json.append(",\n{\"name\":");
+			AppendJsonString(json, event.name);
+			json.append(",\"cat\":");
+			AppendJsonString(json, event.category);
+
+			const double timeStamp((event.start - start) * 1.0e-3);
+			if (event.duration < 0)
+				std::snprintf(line, sizeof(line), ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+					timeStamp, static_cast<unsigned int>(event.threadId));
+			else
+				std::snprintf(line, sizeof(line), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+					timeStamp, event.duration * 1.0e-3, static_cast<unsigned int>(event.threadId));
+			json.append(line);
+		}
+	}
+
+	json.append("\n]}\n");
+	return json;
+}
+
+//==========================================================================
+// Class:			TraceRecorder
+// Function:		AppendJsonString
+//
+// Description:		Appends a quoted and escaped string.
+//
+// Input Arguments:
+//		json	= std::string&
+//		s		= const char*
+//
+// Output Arguments:
+//		json	= std::string&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TraceRecorder::AppendJsonString(std::string& json, const char* s)
+{
+	json.push_back('"');
+	for (; *s; ++s)
+	{
+		if (*s == '"' || *s == '\\')
+			json.push_back('\\');
+		json.push_back(*s);
+	}
+	json.push_back('"');
+}
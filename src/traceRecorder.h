@@ -0,0 +1,116 @@
+// File:  traceRecorder.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Records timeline events and writes them in the Chrome trace_event
+//        JSON format (viewable in Perfetto or chrome://tracing).  Each thread
+//        writes to its own ring buffer without locking; only the first event
+//        recorded on a thread takes a lock (to claim a buffer).  When the
+//        buffer fills, the oldest events are overwritten.
+
+#ifndef TRACE_RECORDER_H_
+#define TRACE_RECORDER_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+class TraceRecorder
+{
+public:
+	static void Start();
+	static void Stop();
+	static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+	// Stops recording and writes everything still held in the buffers
+	static bool Write(const std::string& fileName);
+
+	// Names and categories must be string literals (only the pointers are stored)
+	static void SetThreadName(const char* name);
+	static void AddComplete(const char* name, const char* category,
+		const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end);
+	static void AddInstant(const char* name, const char* category);
+
+	class Scope
+	{
+	public:
+		Scope(const char* name, const char* category) : name(name), category(category), active(IsEnabled())
+		{
+			if (active)
+				start = std::chrono::steady_clock::now();
+		}
+
+		~Scope()
+		{
+			if (active)
+				AddComplete(name, category, start, std::chrono::steady_clock::now());
+		}
+
+	private:
+		const char* const name;
+		const char* const category;
+		const bool active;
+		std::chrono::steady_clock::time_point start;
+	};
+
+private:
+	static constexpr std::size_t bufferCapacity = 1 << 16;// [events per thread]
+
+	// Slots this close behind the write position may be in the middle of
+	// being overwritten, so they are skipped when writing the file
+	static constexpr std::size_t readMargin = 64;
+
+	struct Event
+	{
+		const char* name;
+		const char* category;
+		std::int64_t start;// [nsec, steady clock]
+		std::int64_t duration;// [nsec], negative for instant events
+		std::uint32_t threadId;
+	};
+
+	struct Buffer
+	{
+		Event events[bufferCapacity];
+		std::atomic<std::uint64_t> writeIndex;
+	};
+
+	struct ThreadName
+	{
+		std::uint32_t threadId;
+		const char* name;
+	};
+
+	// Buffers belong to the recorder, not the threads, so events outlive the
+	// threads that recorded them.  Threads that exit return their buffer for
+	// reuse.
+	class BufferHandle
+	{
+	public:
+		~BufferHandle();
+		Buffer* buffer = nullptr;
+	};
+
+	static std::atomic<bool> enabled;
+	static std::atomic<std::int64_t> epoch;// [nsec, steady clock]
+	static std::atomic<std::uint32_t> nextThreadId;
+
+	static std::mutex registryMutex;
+	static std::vector<std::unique_ptr<Buffer>> buffers;
+	static std::vector<Buffer*> freeBuffers;
+	static std::vector<ThreadName> threadNames;
+
+	static Buffer* GetBuffer();
+	static std::uint32_t GetThreadId();
+	static std::int64_t ToNanoseconds(const std::chrono::steady_clock::time_point& time);
+	static void Add(const Event& event);
+
+	static std::string BuildJson();
+	static void AppendJsonString(std::string& json, const char* s);
+};
+
+#endif// TRACE_RECORDER_H_
@@ -0,0 +1,316 @@
+// File:  xxHash64.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Incremental XXH64 hash computation, for identifying files by their
+//        contents.  Produces the same values as the reference implementation.
+
+// Standard C++ headers
+#include <cstring>
+
+// Local headers
+#include "xxHash64.h"
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		XXHash64
+//
+// Description:		Constructor for XXHash64 class.
+//
+// Input Arguments:
+//		seed	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+XXHash64::XXHash64(const std::uint64_t& seed) : seed(seed), totalLength(0), buffered(0)
+{
+	accumulators[0] = seed + prime1 + prime2;
+	accumulators[1] = seed + prime2;
+	accumulators[2] = seed;
+	accumulators[3] = seed - prime1;
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Update
+//
+// Description:		Adds the specified bytes to the hash.  Data is consumed in
+//					32 byte stripes; each of the four lanes depends only on its
+//					own 8 bytes of the stripe, so the compiler is free to
+//					interleave (or vectorize) them.
+//
+// Input Arguments:
+//		data	= const void*
+//		length	= std::size_t
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void XXHash64::Update(const void* data, std::size_t length)
+{
+	const unsigned char* p(static_cast<const unsigned char*>(data));
+	totalLength += length;
+
+	if (buffered > 0)
+	{
+		const std::size_t needed(stripeSize - buffered);
+		if (length < needed)
+		{
+			std::memcpy(buffer + buffered, p, length);
+			buffered += length;
+			return;
+		}
+
+		std::memcpy(buffer + buffered, p, needed);
+		ProcessStripe(buffer);
+		p += needed;
+		length -= needed;
+		buffered = 0;
+	}
+
+	while (length >= stripeSize)
+	{
+		ProcessStripe(p);
+		p += stripeSize;
+		length -= stripeSize;
+	}
+
+	std::memcpy(buffer, p, length);
+	buffered = length;
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Get
+//
+// Description:		Returns the hash of the data added so far.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t XXHash64::Get() const
+{
+	std::uint64_t hash;
+	if (totalLength >= stripeSize)
+	{
+		hash = Rotate(accumulators[0], 1) + Rotate(accumulators[1], 7)
+			+ Rotate(accumulators[2], 12) + Rotate(accumulators[3], 18);
+		hash = Merge(hash, accumulators[0]);
+		hash = Merge(hash, accumulators[1]);
+		hash = Merge(hash, accumulators[2]);
+		hash = Merge(hash, accumulators[3]);
+	}
+	else
+		hash = seed + prime5;
+
+	hash += totalLength;
+
+	const unsigned char* p(buffer);
+	std::size_t remaining(buffered);
+	while (remaining >= 8)
+	{
+		hash ^= Round(0, Read64(p));
+		hash = Rotate(hash, 27) * prime1 + prime4;
+		p += 8;
+		remaining -= 8;
+	}
+
+	if (remaining >= 4)
+	{
+		hash ^= Read32(p) * prime1;
+		hash = Rotate(hash, 23) * prime2 + prime3;
+		p += 4;
+		remaining -= 4;
+	}
+
+	while (remaining-- > 0)
+	{
+		hash ^= *p++ * prime5;
+		hash = Rotate(hash, 11) * prime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	hash *= prime3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Compute
+//
+// Description:		Computes the hash of a single block of data.
+//
+// Input Arguments:
+//		data	= const void*
+//		length	= const std::size_t&
+//		seed	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t XXHash64::Compute(const void* data, const std::size_t& length, const std::uint64_t& seed)
+{
+	XXHash64 hash(seed);
+	hash.Update(data, length);
+	return hash.Get();
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		ProcessStripe
+//
+// Description:		Mixes one 32 byte stripe into the accumulators.
+//
+// Input Arguments:
+//		p	= const unsigned char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void XXHash64::ProcessStripe(const unsigned char* p)
+{
+	accumulators[0] = Round(accumulators[0], Read64(p));
+	accumulators[1] = Round(accumulators[1], Read64(p + 8));
+	accumulators[2] = Round(accumulators[2], Read64(p + 16));
+	accumulators[3] = Round(accumulators[3], Read64(p + 24));
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Round
+//
+// Description:		Mixes eight bytes of input into an accumulator.
+//
+// Input Arguments:
+//		accumulator	= std::uint64_t
+//		input		= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t XXHash64::Round(std::uint64_t accumulator, const std::uint64_t& input)
+{
+	accumulator += input * prime2;
+	accumulator = Rotate(accumulator, 31);
+	return accumulator * prime1;
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Merge
+//
+// Description:		Folds one of the lane accumulators into the final hash.
+//
+// Input Arguments:
+//		hash		= const std::uint64_t&
+//		accumulator	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t XXHash64::Merge(const std::uint64_t& hash, const std::uint64_t& accumulator)
+{
+	return (hash ^ Round(0, accumulator)) * prime1 + prime4;
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Rotate
+//
+// Description:		Rotates the bits to the left.
+//
+// Input Arguments:
+//		value	= const std::uint64_t&
+//		bits	= const unsigned int&, between 1 and 63
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t XXHash64::Rotate(const std::uint64_t& value, const unsigned int& bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Read64
+//
+// Description:		Reads a little-endian 64-bit value.
+//
+// Input Arguments:
+//		p	= const unsigned char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//==========================================================================
+std::uint64_t XXHash64::Read64(const unsigned char* p)
+{
+	return static_cast<std::uint64_t>(Read32(p)) | (static_cast<std::uint64_t>(Read32(p + 4)) << 32);
+}
+
+//==========================================================================
+// Class:			XXHash64
+// Function:		Read32
+//
+// Description:		Reads a little-endian 32-bit value.
+//
+// Input Arguments:
+//		p	= const unsigned char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint32_t
+//
+//==========================================================================
+std::uint32_t XXHash64::Read32(const unsigned char* p)
+{
+	return static_cast<std::uint32_t>(p[0])
+		| (static_cast<std::uint32_t>(p[1]) << 8)
+		| (static_cast<std::uint32_t>(p[2]) << 16)
+		| (static_cast<std::uint32_t>(p[3]) << 24);
+}
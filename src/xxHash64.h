@@ -0,0 +1,49 @@
+// File:  xxHash64.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Incremental XXH64 hash computation, for identifying files by their
+//        contents.  Produces the same values as the reference implementation.
+
+#ifndef XX_HASH_64_H_
+#define XX_HASH_64_H_
+
+// Standard C++ headers
+#include <cstdint>
+#include <cstddef>
+
+class XXHash64
+{
+public:
+	explicit XXHash64(const std::uint64_t& seed = 0);
+
+	void Update(const void* data, std::size_t length);
+	std::uint64_t Get() const;
+
+	static std::uint64_t Compute(const void* data, const std::size_t& length, const std::uint64_t& seed = 0);
+
+private:
+	static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+	static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+	static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+	static constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+	static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+	static constexpr std::size_t stripeSize = 32;
+
+	const std::uint64_t seed;
+	std::uint64_t accumulators[4];// Independent lanes, one per 8 bytes of each stripe
+	std::uint64_t totalLength;
+
+	unsigned char buffer[stripeSize];// Partial stripe left over from the last update
+	std::size_t buffered;
+
+	void ProcessStripe(const unsigned char* p);
+
+	static std::uint64_t Round(std::uint64_t accumulator, const std::uint64_t& input);
+	static std::uint64_t Merge(const std::uint64_t& hash, const std::uint64_t& accumulator);
+	static std::uint64_t Rotate(const std::uint64_t& value, const unsigned int& bits);
+	static std::uint64_t Read64(const unsigned char* p);
+	static std::uint32_t Read32(const unsigned char* p);
+};
+
+#endif// XX_HASH_64_H_